@@ -43,6 +43,8 @@ public class LomoLib : ModuleRules
 				"Engine",
 				"Slate",
 				"SlateCore",
+				"Sockets",
+				"Networking",
 				// ... add private dependencies that you statically link with here ...	
 			}
 			);
@@ -0,0 +1,913 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonDocument.h"
+#include "Algo/BinarySearch.h"
+#include "Async/MappedFileHandle.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace RapidJsonDocumentPrivate
+{
+	bool IsWhitespace(uint8 InChar)
+	{
+		return InChar == ' ' || InChar == '\t' || InChar == '\n' || InChar == '\r';
+	}
+
+	bool IsDigit(TCHAR InChar)
+	{
+		return InChar >= TEXT('0') && InChar <= TEXT('9');
+	}
+
+	/** 按Json语法检查数字：-?(0|[1-9]\d*)(\.\d+)?([eE][+-]?\d+)? */
+	bool IsJsonNumber(FStringView InText)
+	{
+		int32 Pos = 0;
+		const int32 Len = InText.Len();
+
+		if (Pos < Len && InText[Pos] == TEXT('-'))
+		{
+			++Pos;
+		}
+
+		if (Pos >= Len || !IsDigit(InText[Pos]))
+		{
+			return false;
+		}
+
+		if (InText[Pos] == TEXT('0'))
+		{
+			++Pos;
+		}
+		else
+		{
+			while (Pos < Len && IsDigit(InText[Pos]))
+			{
+				++Pos;
+			}
+		}
+
+		if (Pos < Len && InText[Pos] == TEXT('.'))
+		{
+			++Pos;
+			const int32 FractionStart = Pos;
+			while (Pos < Len && IsDigit(InText[Pos]))
+			{
+				++Pos;
+			}
+			if (Pos == FractionStart)
+			{
+				return false;
+			}
+		}
+
+		if (Pos < Len && (InText[Pos] == TEXT('e') || InText[Pos] == TEXT('E')))
+		{
+			++Pos;
+			if (Pos < Len && (InText[Pos] == TEXT('+') || InText[Pos] == TEXT('-')))
+			{
+				++Pos;
+			}
+			const int32 ExponentStart = Pos;
+			while (Pos < Len && IsDigit(InText[Pos]))
+			{
+				++Pos;
+			}
+			if (Pos == ExponentStart)
+			{
+				return false;
+			}
+		}
+
+		return Pos == Len;
+	}
+
+	void AppendUtf8(TArray<ANSICHAR>& OutBytes, uint32 InCodePoint)
+	{
+		if (InCodePoint < 0x80)
+		{
+			OutBytes.Add(static_cast<ANSICHAR>(InCodePoint));
+		}
+		else if (InCodePoint < 0x800)
+		{
+			OutBytes.Add(static_cast<ANSICHAR>(0xC0 | (InCodePoint >> 6)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | (InCodePoint & 0x3F)));
+		}
+		else if (InCodePoint < 0x10000)
+		{
+			OutBytes.Add(static_cast<ANSICHAR>(0xE0 | (InCodePoint >> 12)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | ((InCodePoint >> 6) & 0x3F)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | (InCodePoint & 0x3F)));
+		}
+		else
+		{
+			OutBytes.Add(static_cast<ANSICHAR>(0xF0 | (InCodePoint >> 18)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | ((InCodePoint >> 12) & 0x3F)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | ((InCodePoint >> 6) & 0x3F)));
+			OutBytes.Add(static_cast<ANSICHAR>(0x80 | (InCodePoint & 0x3F)));
+		}
+	}
+
+	/** 读取\u后面的4位十六进制数，格式错误时返回false */
+	bool ParseHex4(TConstArrayView<uint8> InData, int32 InOffset, uint32& OutValue)
+	{
+		if (InOffset + 4 > InData.Num())
+		{
+			return false;
+		}
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const uint8 Char = InData[InOffset + Index];
+			OutValue <<= 4;
+			if (Char >= '0' && Char <= '9')
+			{
+				OutValue |= Char - '0';
+			}
+			else if (Char >= 'a' && Char <= 'f')
+			{
+				OutValue |= Char - 'a' + 10;
+			}
+			else if (Char >= 'A' && Char <= 'F')
+			{
+				OutValue |= Char - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	FString Utf8ToString(const uint8* InData, int32 InLength)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(InData), InLength);
+		return FString(Converter.Length(), Converter.Get());
+	}
+}
+
+FRapidJsonDocument::FRapidJsonDocument()
+{
+}
+
+FRapidJsonDocument::~FRapidJsonDocument()
+{
+	Reset();
+}
+
+bool FRapidJsonDocument::LoadFromFile(const FString& InFilePath)
+{
+	Reset();
+
+	// 优先使用内存映射，只有访问到的页面会被读入
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	MappedFile.Reset(PlatformFile.OpenMapped(*InFilePath));
+	if (MappedFile && MappedFile->GetFileSize() > 0 && MappedFile->GetFileSize() < MAX_int32)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion(0, MappedFile->GetFileSize()));
+	}
+
+	if (MappedRegion)
+	{
+		Data = MakeArrayView(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(OwnedData, *InFilePath))
+		{
+			return SetError(FString::Printf(TEXT("无法读取文件: %s"), *InFilePath));
+		}
+		Data = OwnedData;
+	}
+
+	SourceFilePath = InFilePath;
+	SourceTimeStamp = IFileManager::Get().GetTimeStamp(*InFilePath);
+	return InitializeRoot();
+}
+
+bool FRapidJsonDocument::LoadFromString(const FString& InJsonText)
+{
+	Reset();
+
+	const FTCHARToUTF8 Converter(*InJsonText, InJsonText.Len());
+	OwnedData.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+	Data = OwnedData;
+
+	return InitializeRoot();
+}
+
+bool FRapidJsonDocument::LoadFromUtf8(TArray<uint8>&& InData)
+{
+	Reset();
+
+	OwnedData = MoveTemp(InData);
+	Data = OwnedData;
+
+	return InitializeRoot();
+}
+
+void FRapidJsonDocument::Reset()
+{
+	Data = TConstArrayView<uint8>();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	OwnedData.Empty();
+	Nodes.Empty();
+	Overrides.Empty();
+	SourceFilePath.Reset();
+	SourceTimeStamp = FDateTime::MinValue();
+	LastError.Reset();
+	bModified = false;
+}
+
+bool FRapidJsonDocument::InitializeRoot()
+{
+	Nodes.Reset();
+
+	// 跳过UTF-8 BOM
+	int32 Pos = 0;
+	if (Data.Num() >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+
+	Pos = SkipWhitespace(Pos);
+
+	FRapidJsonNode Root;
+	const int32 End = ScanValue(Pos, Root.Type);
+	if (End == INDEX_NONE)
+	{
+		return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d"), Pos));
+	}
+
+	if (SkipWhitespace(End) != Data.Num())
+	{
+		return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d 之后有多余的内容"), End));
+	}
+
+	Root.ValueOffset = Pos;
+	Root.ValueLength = End - Pos;
+	Nodes.Add(Root);
+	return true;
+}
+
+int32 FRapidJsonDocument::SkipWhitespace(int32 InOffset) const
+{
+	while (InOffset < Data.Num() && RapidJsonDocumentPrivate::IsWhitespace(Data[InOffset]))
+	{
+		++InOffset;
+	}
+	return InOffset;
+}
+
+int32 FRapidJsonDocument::ScanString(int32 InOffset) const
+{
+	for (int32 Pos = InOffset + 1; Pos < Data.Num(); ++Pos)
+	{
+		const uint8 Char = Data[Pos];
+		if (Char == '\\')
+		{
+			++Pos;
+		}
+		else if (Char == '"')
+		{
+			return Pos + 1;
+		}
+	}
+	return INDEX_NONE;
+}
+
+int32 FRapidJsonDocument::ScanValue(int32 InOffset, ERapidJsonNodeType& OutType) const
+{
+	if (InOffset >= Data.Num())
+	{
+		return INDEX_NONE;
+	}
+
+	const uint8 First = Data[InOffset];
+
+	// 容器只匹配括号，不解析内部结构，内部的格式在展开时检查
+	// 括号必须成对，用栈记录期望的右括号，[}这样不匹配的括号直接失败
+	if (First == '{' || First == '[')
+	{
+		OutType = First == '{' ? ERapidJsonNodeType::Object : ERapidJsonNodeType::Array;
+
+		TArray<uint8, TInlineAllocator<64>> ExpectedClosers;
+		for (int32 Pos = InOffset; Pos < Data.Num(); ++Pos)
+		{
+			const uint8 Char = Data[Pos];
+			if (Char == '"')
+			{
+				Pos = ScanString(Pos);
+				if (Pos == INDEX_NONE)
+				{
+					return INDEX_NONE;
+				}
+				--Pos;
+			}
+			else if (Char == '{' || Char == '[')
+			{
+				ExpectedClosers.Add(Char == '{' ? '}' : ']');
+			}
+			else if (Char == '}' || Char == ']')
+			{
+				if (ExpectedClosers.Pop() != Char)
+				{
+					return INDEX_NONE;
+				}
+				if (ExpectedClosers.Num() == 0)
+				{
+					return Pos + 1;
+				}
+			}
+		}
+		return INDEX_NONE;
+	}
+
+	if (First == '"')
+	{
+		OutType = ERapidJsonNodeType::String;
+		return ScanString(InOffset);
+	}
+
+	auto MatchLiteral = [this, InOffset](const ANSICHAR* InLiteral, int32 InLength)
+	{
+		return InOffset + InLength <= Data.Num() && FMemory::Memcmp(Data.GetData() + InOffset, InLiteral, InLength) == 0;
+	};
+
+	if (MatchLiteral("true", 4))
+	{
+		OutType = ERapidJsonNodeType::Bool;
+		return InOffset + 4;
+	}
+	if (MatchLiteral("false", 5))
+	{
+		OutType = ERapidJsonNodeType::Bool;
+		return InOffset + 5;
+	}
+	if (MatchLiteral("null", 4))
+	{
+		OutType = ERapidJsonNodeType::Null;
+		return InOffset + 4;
+	}
+
+	// 数字，完整的语法检查在修改时进行
+	int32 Pos = InOffset;
+	while (Pos < Data.Num())
+	{
+		const uint8 Char = Data[Pos];
+		if ((Char >= '0' && Char <= '9') || Char == '-' || Char == '+' || Char == '.' || Char == 'e' || Char == 'E')
+		{
+			++Pos;
+		}
+		else
+		{
+			break;
+		}
+	}
+
+	OutType = ERapidJsonNodeType::Number;
+	return Pos > InOffset ? Pos : INDEX_NONE;
+}
+
+bool FRapidJsonDocument::IndexChildren(int32 InNodeIndex)
+{
+	if (!Nodes.IsValidIndex(InNodeIndex) || !Nodes[InNodeIndex].IsContainer())
+	{
+		return false;
+	}
+
+	if (Nodes[InNodeIndex].bIndexed)
+	{
+		return true;
+	}
+
+	// 节点数组在追加子节点时可能重新分配，这里使用副本
+	const FRapidJsonNode Node = Nodes[InNodeIndex];
+	const bool bIsObject = Node.Type == ERapidJsonNodeType::Object;
+	const int32 ClosePos = Node.ValueOffset + Node.ValueLength - 1;
+
+	TArray<FRapidJsonNode> Children;
+	int32 Pos = SkipWhitespace(Node.ValueOffset + 1);
+
+	while (Pos < ClosePos)
+	{
+		FRapidJsonNode& Child = Children.AddDefaulted_GetRef();
+		Child.Parent = InNodeIndex;
+		Child.Depth = Node.Depth + 1;
+		Child.IndexInParent = Children.Num() - 1;
+
+		if (bIsObject)
+		{
+			const int32 KeyEnd = Data[Pos] == '"' ? ScanString(Pos) : INDEX_NONE;
+			if (KeyEnd == INDEX_NONE || KeyEnd > ClosePos)
+			{
+				return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d 应为键"), Pos));
+			}
+
+			Child.KeyOffset = Pos;
+			Child.KeyLength = KeyEnd - Pos;
+
+			Pos = SkipWhitespace(KeyEnd);
+			if (Pos >= ClosePos || Data[Pos] != ':')
+			{
+				return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d 应为冒号"), Pos));
+			}
+			Pos = SkipWhitespace(Pos + 1);
+		}
+
+		const int32 ValueEnd = ScanValue(Pos, Child.Type);
+		if (ValueEnd == INDEX_NONE || ValueEnd > ClosePos)
+		{
+			return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d 应为值"), Pos));
+		}
+
+		Child.ValueOffset = Pos;
+		Child.ValueLength = ValueEnd - Pos;
+
+		Pos = SkipWhitespace(ValueEnd);
+		if (Pos < ClosePos)
+		{
+			if (Data[Pos] != ',')
+			{
+				return SetError(FString::Printf(TEXT("Json格式错误: 位置 %d 应为逗号"), Pos));
+			}
+			Pos = SkipWhitespace(Pos + 1);
+		}
+	}
+
+	FRapidJsonNode& IndexedNode = Nodes[InNodeIndex];
+	IndexedNode.bIndexed = true;
+	IndexedNode.NumChildren = Children.Num();
+	IndexedNode.FirstChild = Children.Num() > 0 ? Nodes.Num() : INDEX_NONE;
+	Nodes.Append(MoveTemp(Children));
+	return true;
+}
+
+int32 FRapidJsonDocument::GetChild(int32 InNodeIndex, int32 InChildIndex) const
+{
+	const FRapidJsonNode& Node = Nodes[InNodeIndex];
+	return Node.FirstChild != INDEX_NONE && InChildIndex >= 0 && InChildIndex < Node.NumChildren
+		? Node.FirstChild + InChildIndex
+		: INDEX_NONE;
+}
+
+int32 FRapidJsonDocument::FindChild(int32 InNodeIndex, FStringView InKey)
+{
+	if (!IndexChildren(InNodeIndex) || Nodes[InNodeIndex].Type != ERapidJsonNodeType::Object)
+	{
+		return INDEX_NONE;
+	}
+
+	// 没有转义字符的键直接比较UTF-8字节
+	const FTCHARToUTF8 KeyUtf8(InKey.GetData(), InKey.Len());
+
+	const FRapidJsonNode& Node = Nodes[InNodeIndex];
+	for (int32 ChildIndex = 0; ChildIndex < Node.NumChildren; ++ChildIndex)
+	{
+		const FRapidJsonNode& Child = Nodes[Node.FirstChild + ChildIndex];
+		const uint8* RawKey = Data.GetData() + Child.KeyOffset + 1;
+		const int32 RawKeyLength = Child.KeyLength - 2;
+
+		if (!MakeArrayView(RawKey, RawKeyLength).Contains('\\'))
+		{
+			if (RawKeyLength == KeyUtf8.Length() && FMemory::Memcmp(RawKey, KeyUtf8.Get(), RawKeyLength) == 0)
+			{
+				return Node.FirstChild + ChildIndex;
+			}
+		}
+		else if (GetKey(Node.FirstChild + ChildIndex) == InKey)
+		{
+			return Node.FirstChild + ChildIndex;
+		}
+	}
+
+	return INDEX_NONE;
+}
+
+FString FRapidJsonDocument::GetKey(int32 InNodeIndex) const
+{
+	const FRapidJsonNode& Node = Nodes[InNodeIndex];
+	if (Node.KeyOffset == INDEX_NONE)
+	{
+		return Node.Parent == INDEX_NONE ? FString() : FString::FromInt(Node.IndexInParent);
+	}
+
+	return DecodeString(Data.Slice(Node.KeyOffset, Node.KeyLength));
+}
+
+FString FRapidJsonDocument::GetRawValue(int32 InNodeIndex) const
+{
+	if (const FString* Override = Overrides.Find(InNodeIndex))
+	{
+		return *Override;
+	}
+
+	const FRapidJsonNode& Node = Nodes[InNodeIndex];
+	return RapidJsonDocumentPrivate::Utf8ToString(Data.GetData() + Node.ValueOffset, Node.ValueLength);
+}
+
+FString FRapidJsonDocument::GetDisplayValue(int32 InNodeIndex) const
+{
+	const FRapidJsonNode& Node = Nodes[InNodeIndex];
+	switch (Node.Type)
+	{
+	case ERapidJsonNodeType::Object:
+		return Node.bIndexed ? FString::Printf(TEXT("{%d}"), Node.NumChildren) : TEXT("{...}");
+
+	case ERapidJsonNodeType::Array:
+		return Node.bIndexed ? FString::Printf(TEXT("[%d]"), Node.NumChildren) : TEXT("[...]");
+
+	case ERapidJsonNodeType::String:
+		if (const FString* Override = Overrides.Find(InNodeIndex))
+		{
+			const FTCHARToUTF8 OverrideUtf8(**Override, Override->Len());
+			return DecodeString(MakeArrayView(reinterpret_cast<const uint8*>(OverrideUtf8.Get()), OverrideUtf8.Length()));
+		}
+		return DecodeString(Data.Slice(Node.ValueOffset, Node.ValueLength));
+
+	default:
+		return GetRawValue(InNodeIndex);
+	}
+}
+
+bool FRapidJsonDocument::SetValue(int32 InNodeIndex, const FString& InValue)
+{
+	if (!Nodes.IsValidIndex(InNodeIndex))
+	{
+		return false;
+	}
+
+	if (Nodes[InNodeIndex].Type == ERapidJsonNodeType::String)
+	{
+		return SetRawValue(InNodeIndex, EncodeString(InValue));
+	}
+
+	// 非字符串节点不能通过这个接口变成字符串
+	const FString RawValue = InValue.TrimStartAndEnd();
+	if (RawValue.StartsWith(TEXT("\"")))
+	{
+		return false;
+	}
+	return SetRawValue(InNodeIndex, RawValue);
+}
+
+bool FRapidJsonDocument::SetRawValue(int32 InNodeIndex, const FString& InRawValue)
+{
+	if (!Nodes.IsValidIndex(InNodeIndex) || Nodes[InNodeIndex].IsContainer())
+	{
+		return false;
+	}
+
+	ERapidJsonNodeType Type;
+	if (InRawValue.Len() >= 2 && InRawValue.StartsWith(TEXT("\"")) && InRawValue.EndsWith(TEXT("\"")))
+	{
+		Type = ERapidJsonNodeType::String;
+	}
+	else if (InRawValue == TEXT("true") || InRawValue == TEXT("false"))
+	{
+		Type = ERapidJsonNodeType::Bool;
+	}
+	else if (InRawValue == TEXT("null"))
+	{
+		Type = ERapidJsonNodeType::Null;
+	}
+	else if (RapidJsonDocumentPrivate::IsJsonNumber(InRawValue))
+	{
+		Type = ERapidJsonNodeType::Number;
+	}
+	else
+	{
+		return false;
+	}
+
+	if (InRawValue == GetRawValue(InNodeIndex))
+	{
+		return false;
+	}
+
+	Nodes[InNodeIndex].Type = Type;
+	Overrides.Add(InNodeIndex, InRawValue);
+	bModified = true;
+	return true;
+}
+
+int32 FRapidJsonDocument::SetValues(TConstArrayView<int32> InNodeIndices, const FString& InValue)
+{
+	int32 NumChanged = 0;
+	for (const int32 NodeIndex : InNodeIndices)
+	{
+		if (SetValue(NodeIndex, InValue))
+		{
+			++NumChanged;
+		}
+	}
+	return NumChanged;
+}
+
+bool FRapidJsonDocument::SaveToFile(const FString& InFilePath)
+{
+	if (!IsValid())
+	{
+		return false;
+	}
+
+	// 覆盖正在映射的源文件前先把数据复制到内存
+	const bool bOverwriteSource = !SourceFilePath.IsEmpty() && FPaths::IsSamePath(InFilePath, SourceFilePath);
+	if (bOverwriteSource)
+	{
+		DetachMappedData();
+	}
+
+	// 按位置排序的修改
+	TArray<int32> ModifiedNodes;
+	Overrides.GetKeys(ModifiedNodes);
+	ModifiedNodes.Sort([this](int32 A, int32 B)
+	{
+		return Nodes[A].ValueOffset < Nodes[B].ValueOffset;
+	});
+
+	// 先写入临时文件，成功后再替换，避免写入中途失败破坏原文件
+	const FString TempFilePath = InFilePath + TEXT(".tmp");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+	if (!Writer)
+	{
+		return SetError(FString::Printf(TEXT("无法写入文件: %s"), *TempFilePath));
+	}
+
+	// 覆盖源文件时同时在内存中拼出新的数据，保存后文档以它为准
+	TArray<uint8> NewData;
+	auto Write = [&Writer, &NewData, bOverwriteSource](const void* InBytes, int32 InNum)
+	{
+		Writer->Serialize(const_cast<void*>(InBytes), InNum);
+		if (bOverwriteSource)
+		{
+			NewData.Append(static_cast<const uint8*>(InBytes), InNum);
+		}
+	};
+
+	if (bOverwriteSource)
+	{
+		NewData.Reserve(Data.Num());
+	}
+
+	// 每个修改结束的位置和到此为止累计的长度变化，用于保存后平移节点的偏移
+	TArray<int32> ModifiedEnds;
+	TArray<int32> ShiftsAfter;
+	ModifiedEnds.Reserve(ModifiedNodes.Num());
+	ShiftsAfter.Reserve(ModifiedNodes.Num() + 1);
+	ShiftsAfter.Add(0);
+
+	int32 Pos = 0;
+	for (const int32 NodeIndex : ModifiedNodes)
+	{
+		const FRapidJsonNode& Node = Nodes[NodeIndex];
+		Write(Data.GetData() + Pos, Node.ValueOffset - Pos);
+
+		const FString& RawValue = Overrides[NodeIndex];
+		FTCHARToUTF8 RawValueUtf8(*RawValue, RawValue.Len());
+		Write(RawValueUtf8.Get(), RawValueUtf8.Length());
+
+		Pos = Node.ValueOffset + Node.ValueLength;
+		ModifiedEnds.Add(Pos);
+		ShiftsAfter.Add(ShiftsAfter.Last() + RawValueUtf8.Length() - Node.ValueLength);
+	}
+	Write(Data.GetData() + Pos, Data.Num() - Pos);
+
+	const bool bWriteSucceeded = Writer->Close() && !Writer->IsError();
+	Writer.Reset();
+
+	if (!bWriteSucceeded || !IFileManager::Get().Move(*InFilePath, *TempFilePath, true, true))
+	{
+		IFileManager::Get().Delete(*TempFilePath);
+		return SetError(FString::Printf(TEXT("无法写入文件: %s"), *InFilePath));
+	}
+
+	if (bOverwriteSource)
+	{
+		RebaseOnSavedData(MoveTemp(NewData), ModifiedEnds, ShiftsAfter);
+	}
+
+	bModified = false;
+	return true;
+}
+
+bool FRapidJsonDocument::SaveInPlace()
+{
+	if (!bModified)
+	{
+		return true;
+	}
+
+	if (SourceFilePath.IsEmpty())
+	{
+		return SetError(TEXT("文档不是从文件加载的"));
+	}
+
+	// 把修改转换为UTF-8并补齐到原长度，有更长的值时只能重写整个文件
+	TArray<TPair<int32, TArray<uint8>>> Patches;
+	Patches.Reserve(Overrides.Num());
+	for (const TPair<int32, FString>& Override : Overrides)
+	{
+		const FRapidJsonNode& Node = Nodes[Override.Key];
+		FTCHARToUTF8 RawValueUtf8(*Override.Value, Override.Value.Len());
+		if (RawValueUtf8.Length() > Node.ValueLength)
+		{
+			return SaveToFile(SourceFilePath);
+		}
+
+		TArray<uint8>& Bytes = Patches.Emplace_GetRef(Node.ValueOffset, TArray<uint8>()).Value;
+		Bytes.Append(reinterpret_cast<const uint8*>(RawValueUtf8.Get()), RawValueUtf8.Length());
+		Bytes.SetNumUninitialized(Node.ValueLength);
+		FMemory::Memset(Bytes.GetData() + RawValueUtf8.Length(), ' ', Node.ValueLength - RawValueUtf8.Length());
+	}
+
+	// 文件在加载或上次保存后被外部修改过时偏移已经失效
+	IPlatformFile& PlatformFile = FPlatformFileManager::Get().GetPlatformFile();
+	if (PlatformFile.GetTimeStamp(*SourceFilePath) != SourceTimeStamp)
+	{
+		return SaveToFile(SourceFilePath);
+	}
+
+	TUniquePtr<IFileHandle> FileHandle(PlatformFile.OpenWrite(*SourceFilePath, true, true));
+	if (!FileHandle && MappedRegion)
+	{
+		// 部分平台不允许写入正在映射的文件
+		DetachMappedData();
+		FileHandle.Reset(PlatformFile.OpenWrite(*SourceFilePath, true, true));
+	}
+
+	if (!FileHandle || FileHandle->Size() != Data.Num())
+	{
+		FileHandle.Reset();
+		return SaveToFile(SourceFilePath);
+	}
+
+	for (const TPair<int32, TArray<uint8>>& Patch : Patches)
+	{
+		if (!FileHandle->Seek(Patch.Key) || !FileHandle->Write(Patch.Value.GetData(), Patch.Value.Num()))
+		{
+			return SetError(FString::Printf(TEXT("无法写入文件: %s"), *SourceFilePath));
+		}
+	}
+
+	if (!FileHandle->Flush())
+	{
+		return SetError(FString::Printf(TEXT("无法写入文件: %s"), *SourceFilePath));
+	}
+	FileHandle.Reset();
+
+	// 修改仍保留在Overrides中，之后的读取和保存都以它为准
+	SourceTimeStamp = PlatformFile.GetTimeStamp(*SourceFilePath);
+	bModified = false;
+	return true;
+}
+
+void FRapidJsonDocument::RebaseOnSavedData(TArray<uint8>&& InSavedData, TConstArrayView<int32> InModifiedEnds, TConstArrayView<int32> InShiftsAfter)
+{
+	// 修改都是互不重叠的标量，任何位置只受结束在它之前（含）的修改影响
+	auto Rebase = [InModifiedEnds, InShiftsAfter](int32 InOffset)
+	{
+		const int32 NumBefore = Algo::UpperBound(InModifiedEnds, InOffset);
+		return InOffset + InShiftsAfter[NumBefore];
+	};
+
+	for (FRapidJsonNode& Node : Nodes)
+	{
+		if (Node.KeyOffset != INDEX_NONE)
+		{
+			Node.KeyOffset = Rebase(Node.KeyOffset);
+		}
+
+		const int32 ValueEnd = Rebase(Node.ValueOffset + Node.ValueLength);
+		Node.ValueOffset = Rebase(Node.ValueOffset);
+		Node.ValueLength = ValueEnd - Node.ValueOffset;
+	}
+
+	// 修改已经写入新的数据，节点下标保持不变
+	OwnedData = MoveTemp(InSavedData);
+	Data = OwnedData;
+	Overrides.Empty();
+	SourceTimeStamp = IFileManager::Get().GetTimeStamp(*SourceFilePath);
+}
+
+void FRapidJsonDocument::DetachMappedData()
+{
+	if (!MappedRegion)
+	{
+		return;
+	}
+
+	OwnedData = TArray<uint8>(Data.GetData(), Data.Num());
+	Data = OwnedData;
+	MappedRegion.Reset();
+	MappedFile.Reset();
+}
+
+FString FRapidJsonDocument::DecodeString(TConstArrayView<uint8> InRawString)
+{
+	if (InRawString.Num() < 2)
+	{
+		return FString();
+	}
+
+	TArray<ANSICHAR> Bytes;
+	Bytes.Reserve(InRawString.Num());
+
+	// 跳过首尾的引号
+	const int32 End = InRawString.Num() - 1;
+	for (int32 Pos = 1; Pos < End; ++Pos)
+	{
+		const uint8 Char = InRawString[Pos];
+		if (Char != '\\' || Pos + 1 >= End)
+		{
+			Bytes.Add(static_cast<ANSICHAR>(Char));
+			continue;
+		}
+
+		const uint8 Escaped = InRawString[++Pos];
+		switch (Escaped)
+		{
+		case 'n': Bytes.Add('\n'); break;
+		case 't': Bytes.Add('\t'); break;
+		case 'r': Bytes.Add('\r'); break;
+		case 'b': Bytes.Add('\b'); break;
+		case 'f': Bytes.Add('\f'); break;
+		case 'u':
+			{
+				uint32 CodePoint = 0;
+				if (!RapidJsonDocumentPrivate::ParseHex4(InRawString, Pos + 1, CodePoint))
+				{
+					Bytes.Add('?');
+					break;
+				}
+				Pos += 4;
+
+				// 代理对
+				uint32 LowSurrogate = 0;
+				if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF
+					&& Pos + 2 < End && InRawString[Pos + 1] == '\\' && InRawString[Pos + 2] == 'u'
+					&& RapidJsonDocumentPrivate::ParseHex4(InRawString, Pos + 3, LowSurrogate)
+					&& LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+				{
+					CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+					Pos += 6;
+				}
+
+				RapidJsonDocumentPrivate::AppendUtf8(Bytes, CodePoint);
+				break;
+			}
+		default:
+			// \" \\ \/
+			Bytes.Add(static_cast<ANSICHAR>(Escaped));
+			break;
+		}
+	}
+
+	return RapidJsonDocumentPrivate::Utf8ToString(reinterpret_cast<const uint8*>(Bytes.GetData()), Bytes.Num());
+}
+
+FString FRapidJsonDocument::EncodeString(const FString& InValue)
+{
+	FString Result;
+	Result.Reserve(InValue.Len() + 2);
+	Result.AppendChar(TEXT('"'));
+
+	for (const TCHAR Char : InValue)
+	{
+		switch (Char)
+		{
+		case TEXT('"'): Result += TEXT("\\\""); break;
+		case TEXT('\\'): Result += TEXT("\\\\"); break;
+		case TEXT('\n'): Result += TEXT("\\n"); break;
+		case TEXT('\r'): Result += TEXT("\\r"); break;
+		case TEXT('\t'): Result += TEXT("\\t"); break;
+		case TEXT('\b'): Result += TEXT("\\b"); break;
+		case TEXT('\f'): Result += TEXT("\\f"); break;
+		default:
+			if (Char < 0x20)
+			{
+				Result += FString::Printf(TEXT("\\u%04x"), static_cast<uint32>(Char));
+			}
+			else
+			{
+				Result.AppendChar(Char);
+			}
+			break;
+		}
+	}
+
+	Result.AppendChar(TEXT('"'));
+	return Result;
+}
+
+bool FRapidJsonDocument::SetError(const FString& InError)
+{
+	LastError = InError;
+	UE_LOG(LogTemp, Warning, TEXT("RapidJsonDocument: %s"), *InError);
+	return false;
+}
@@ -2,3 +2,482 @@
 
 
 #include "RapidUI/JsonPanel/RapidJsonPanel.h"
+#include "RapidUI/JsonPanel/RapidJsonRowWidget.h"
+#include "RapidUI/JsonPanel/RapidJsonQuery.h"
+#include "RapidUI/JsonPanel/RapidJsonStructSchema.h"
+#include "RapidUI/JsonPanel/RapidJsonStructWriter.h"
+#include "Components/ListView.h"
+
+bool URapidJsonPanel::LoadFromFile(const FString& FilePath)
+{
+	UnbindStruct();
+	const bool bLoaded = Document.LoadFromFile(FilePath);
+	ResetRows();
+	return bLoaded;
+}
+
+bool URapidJsonPanel::LoadFromString(const FString& JsonText)
+{
+	UnbindStruct();
+	const bool bLoaded = Document.LoadFromString(JsonText);
+	ResetRows();
+	return bLoaded;
+}
+
+bool URapidJsonPanel::SaveToFile(const FString& FilePath)
+{
+	return Document.SaveToFile(FilePath);
+}
+
+bool URapidJsonPanel::SaveChanges()
+{
+	return Document.SaveInPlace();
+}
+
+bool URapidJsonPanel::BindStruct(const UScriptStruct* InStruct, void* InStructMemory)
+{
+	if (!InStruct || !InStructMemory)
+	{
+		return false;
+	}
+
+	BoundStruct = InStruct;
+	BoundStructMemory = InStructMemory;
+	BoundSchema = FRapidJsonStructSchema::Get(InStruct);
+	return RefreshBoundStruct();
+}
+
+void URapidJsonPanel::UnbindStruct()
+{
+	BoundStruct.Reset();
+	BoundStructMemory = nullptr;
+	BoundSchema.Reset();
+}
+
+bool URapidJsonPanel::RefreshBoundStruct()
+{
+	if (!IsStructBound())
+	{
+		return false;
+	}
+
+	// 直接从结构体内存写出Json，不经过FJsonObject
+	TArray<uint8> JsonData;
+	FRapidJsonStructWriter Writer(JsonData);
+	Writer.WriteStruct(*BoundSchema, BoundStructMemory);
+
+	const bool bLoaded = Document.LoadFromUtf8(MoveTemp(JsonData));
+	ResetRows();
+	return bLoaded;
+}
+
+bool URapidJsonPanel::IsStructBound() const
+{
+	return BoundStruct.IsValid() && BoundStructMemory && BoundSchema.IsValid();
+}
+
+void URapidJsonPanel::Clear()
+{
+	UnbindStruct();
+	Document.Reset();
+	ResetRows();
+}
+
+void URapidJsonPanel::ToggleNodeExpansion(int32 NodeIndex)
+{
+	if (IsNodeExpanded(NodeIndex))
+	{
+		CollapseNode(NodeIndex);
+	}
+	else
+	{
+		ExpandNode(NodeIndex);
+	}
+}
+
+bool URapidJsonPanel::ExpandNode(int32 NodeIndex)
+{
+	if (IsNodeExpanded(NodeIndex))
+	{
+		return true;
+	}
+
+	if (!Document.IndexChildren(NodeIndex))
+	{
+		return false;
+	}
+
+	ExpandedNodes.Add(NodeIndex);
+
+	// 根节点不显示为一行，其他节点只在自身可见时插入子行
+	const int32 Row = NodeIndex == FRapidJsonDocument::RootNode ? INDEX_NONE : FindRow(NodeIndex);
+	if (NodeIndex == FRapidJsonDocument::RootNode || Row != INDEX_NONE)
+	{
+		TArray<URapidJsonRowItem*> ChildRows;
+		AppendVisibleChildren(NodeIndex, ChildRows);
+		Rows.Insert(ChildRows, Row + 1);
+		UpdateListView();
+		RefreshNodeRow(NodeIndex);
+	}
+
+	return true;
+}
+
+void URapidJsonPanel::CollapseNode(int32 NodeIndex)
+{
+	if (NodeIndex == FRapidJsonDocument::RootNode || !ExpandedNodes.Remove(NodeIndex))
+	{
+		return;
+	}
+
+	const int32 Row = FindRow(NodeIndex);
+	if (Row == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 移除后面所有更深的行，子节点的展开状态保留
+	const int32 Depth = Document.GetNode(NodeIndex).Depth;
+	int32 EndRow = Row + 1;
+	while (EndRow < Rows.Num() && Document.GetNode(Rows[EndRow]->NodeIndex).Depth > Depth)
+	{
+		FreeRowItems.Add(Rows[EndRow]);
+		++EndRow;
+	}
+
+	Rows.RemoveAt(Row + 1, EndRow - Row - 1);
+	UpdateListView();
+	RefreshNodeRow(NodeIndex);
+}
+
+bool URapidJsonPanel::IsNodeExpanded(int32 NodeIndex) const
+{
+	return ExpandedNodes.Contains(NodeIndex);
+}
+
+bool URapidJsonPanel::SetNodeValue(int32 NodeIndex, const FString& Value)
+{
+	if (IsStructBound())
+	{
+		// 先写入结构体，再用结构体中的值更新显示，显示的内容总是规范化后的值
+		const FRapidJsonValueSchema* ValueSchema = nullptr;
+		void* ValuePtr = nullptr;
+		if (!ResolveBoundValue(NodeIndex, ValueSchema, ValuePtr) || !ImportBoundValue(*ValueSchema, ValuePtr, Value))
+		{
+			return false;
+		}
+
+		TArray<uint8> RawValue;
+		FRapidJsonStructWriter Writer(RawValue);
+		Writer.WriteValue(*ValueSchema, ValuePtr);
+
+		const FUTF8ToTCHAR RawValueText(reinterpret_cast<const ANSICHAR*>(RawValue.GetData()), RawValue.Num());
+		Document.SetRawValue(NodeIndex, FString(RawValueText.Length(), RawValueText.Get()));
+	}
+	else if (!Document.SetValue(NodeIndex, Value))
+	{
+		return false;
+	}
+
+	RefreshNodeRow(NodeIndex);
+	OnValueChanged.Broadcast(NodeIndex, Document.GetRawValue(NodeIndex));
+	return true;
+}
+
+TArray<int32> URapidJsonPanel::Query(const FString& Expression, FString& Error)
+{
+	Error.Reset();
+	if (!Document.IsValid())
+	{
+		return TArray<int32>();
+	}
+	return FRapidJsonQuery::Run(Document, Expression, &Error);
+}
+
+int32 URapidJsonPanel::SetNodeValues(const TArray<int32>& NodeIndices, const FString& Value)
+{
+	int32 NumChanged = 0;
+	for (const int32 NodeIndex : NodeIndices)
+	{
+		if (SetNodeValue(NodeIndex, Value))
+		{
+			++NumChanged;
+		}
+	}
+	return NumChanged;
+}
+
+FString URapidJsonPanel::GetNodeValue(int32 NodeIndex) const
+{
+	return Document.IsValidNode(NodeIndex) ? Document.GetRawValue(NodeIndex) : FString();
+}
+
+bool URapidJsonPanel::IsModified() const
+{
+	return Document.IsModified();
+}
+
+FString URapidJsonPanel::GetLastError() const
+{
+	return Document.GetLastError();
+}
+
+bool URapidJsonPanel::ResolveBoundValue(int32 NodeIndex, const FRapidJsonValueSchema*& OutValue, void*& OutValuePtr) const
+{
+	if (!Document.IsValidNode(NodeIndex) || NodeIndex == FRapidJsonDocument::RootNode)
+	{
+		return false;
+	}
+
+	// 从根节点到目标节点的路径
+	TArray<int32, TInlineAllocator<16>> NodePath;
+	for (int32 Index = NodeIndex; Index != FRapidJsonDocument::RootNode; Index = Document.GetNode(Index).Parent)
+	{
+		NodePath.Add(Index);
+	}
+
+	uint8* ValuePtr = static_cast<uint8*>(BoundStructMemory);
+	const FRapidJsonValueSchema* Value = nullptr;
+
+	// 静态数组字段本身，下一层按下标取元素
+	const FRapidJsonFieldSchema* StaticArrayField = nullptr;
+
+	for (int32 PathIndex = NodePath.Num() - 1; PathIndex >= 0; --PathIndex)
+	{
+		const int32 ChildIndex = NodePath[PathIndex];
+		const FRapidJsonNode& Child = Document.GetNode(ChildIndex);
+
+		if (StaticArrayField)
+		{
+			if (Child.IndexInParent >= StaticArrayField->ArrayDim)
+			{
+				return false;
+			}
+			ValuePtr += Child.IndexInParent * StaticArrayField->ElementSize;
+			Value = &StaticArrayField->Value;
+			StaticArrayField = nullptr;
+		}
+		else if (!Value || Value->Kind == ERapidJsonValueKind::Struct)
+		{
+			const FRapidJsonStructSchema& StructSchema = Value ? *Value->StructSchema : *BoundSchema;
+			const FRapidJsonFieldSchema* Field = StructSchema.FindField(Document.GetKey(ChildIndex));
+			if (!Field)
+			{
+				return false;
+			}
+
+			ValuePtr += Field->Offset;
+			if (Field->ArrayDim > 1)
+			{
+				StaticArrayField = Field;
+			}
+			else
+			{
+				Value = &Field->Value;
+			}
+		}
+		else if (Value->Kind == ERapidJsonValueKind::Array)
+		{
+			FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(Value->Property), ValuePtr);
+			if (!ArrayHelper.IsValidIndex(Child.IndexInParent))
+			{
+				return false;
+			}
+			ValuePtr = ArrayHelper.GetRawPtr(Child.IndexInParent);
+			Value = &Value->Inner[0];
+		}
+		else if (Value->Kind == ERapidJsonValueKind::Map)
+		{
+			// Json对象中的顺序与写出时的迭代顺序相同
+			FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(Value->Property), ValuePtr);
+			if (Child.IndexInParent >= MapHelper.Num())
+			{
+				return false;
+			}
+
+			int32 PairIndex = 0;
+			for (int32 Remaining = Child.IndexInParent; ; ++PairIndex)
+			{
+				if (MapHelper.IsValidIndex(PairIndex) && Remaining-- == 0)
+				{
+					break;
+				}
+			}
+			ValuePtr = MapHelper.GetValuePtr(PairIndex);
+			Value = &Value->Inner[1];
+		}
+		else
+		{
+			// 修改集合元素会破坏哈希，不支持
+			return false;
+		}
+	}
+
+	if (StaticArrayField || !Value)
+	{
+		return false;
+	}
+
+	OutValue = Value;
+	OutValuePtr = ValuePtr;
+	return true;
+}
+
+bool URapidJsonPanel::ImportBoundValue(const FRapidJsonValueSchema& InValue, void* InValuePtr, const FString& InText)
+{
+	const FString TrimmedText = InText.TrimStartAndEnd();
+
+	switch (InValue.Kind)
+	{
+	case ERapidJsonValueKind::Bool:
+		if (TrimmedText != TEXT("true") && TrimmedText != TEXT("false"))
+		{
+			return false;
+		}
+		static_cast<const FBoolProperty*>(InValue.Property)->SetPropertyValue(InValuePtr, TrimmedText == TEXT("true"));
+		return true;
+
+	case ERapidJsonValueKind::SignedInteger:
+	case ERapidJsonValueKind::UnsignedInteger:
+		if (TrimmedText.IsEmpty() || !FCString::IsNumeric(*TrimmedText) || TrimmedText.Contains(TEXT(".")))
+		{
+			return false;
+		}
+		if (InValue.Kind == ERapidJsonValueKind::SignedInteger)
+		{
+			InValue.NumericProperty->SetIntPropertyValue(InValuePtr, FCString::Atoi64(*TrimmedText));
+		}
+		else
+		{
+			InValue.NumericProperty->SetIntPropertyValue(InValuePtr, FCString::Strtoui64(*TrimmedText, nullptr, 10));
+		}
+		return true;
+
+	case ERapidJsonValueKind::Float:
+		if (TrimmedText.IsEmpty() || !FCString::IsNumeric(*TrimmedText))
+		{
+			return false;
+		}
+		InValue.NumericProperty->SetFloatingPointPropertyValue(InValuePtr, FCString::Atod(*TrimmedText));
+		return true;
+
+	case ERapidJsonValueKind::Enum:
+		{
+			int64 EnumValue = InValue.Enum->GetValueByNameString(TrimmedText);
+			if (EnumValue == INDEX_NONE)
+			{
+				if (TrimmedText.IsEmpty() || !FCString::IsNumeric(*TrimmedText) || !InValue.Enum->IsValidEnumValue(FCString::Atoi64(*TrimmedText)))
+				{
+					return false;
+				}
+				EnumValue = FCString::Atoi64(*TrimmedText);
+			}
+			InValue.NumericProperty->SetIntPropertyValue(InValuePtr, EnumValue);
+		}
+		return true;
+
+	case ERapidJsonValueKind::String:
+		*static_cast<FString*>(InValuePtr) = InText;
+		return true;
+
+	case ERapidJsonValueKind::Name:
+		*static_cast<FName*>(InValuePtr) = FName(*InText);
+		return true;
+
+	case ERapidJsonValueKind::Text:
+		*static_cast<FText*>(InValuePtr) = FText::FromString(InText);
+		return true;
+
+	case ERapidJsonValueKind::Other:
+		return InValue.Property->ImportText_Direct(*InText, InValuePtr, nullptr, PPF_None) != nullptr;
+
+	default:
+		// 容器只能修改其中的元素
+		return false;
+	}
+}
+
+void URapidJsonPanel::ResetRows()
+{
+	FreeRowItems.Append(Rows);
+	Rows.Reset();
+	ExpandedNodes.Reset();
+
+	if (Document.IsValid())
+	{
+		if (Document.GetNode(FRapidJsonDocument::RootNode).IsContainer())
+		{
+			ExpandNode(FRapidJsonDocument::RootNode);
+
+			// 按层展开，只展开已经显示出来的容器
+			for (int32 Row = 0; Row < Rows.Num(); ++Row)
+			{
+				const int32 NodeIndex = Rows[Row]->NodeIndex;
+				if (Document.GetNode(NodeIndex).Depth < InitialExpandDepth && Document.GetNode(NodeIndex).IsContainer())
+				{
+					ExpandNode(NodeIndex);
+				}
+			}
+		}
+		else
+		{
+			Rows.Add(AcquireRowItem(FRapidJsonDocument::RootNode));
+		}
+	}
+
+	UpdateListView();
+}
+
+void URapidJsonPanel::AppendVisibleChildren(int32 NodeIndex, TArray<URapidJsonRowItem*>& OutRows)
+{
+	const FRapidJsonNode& Node = Document.GetNode(NodeIndex);
+	for (int32 ChildIndex = 0; ChildIndex < Node.NumChildren; ++ChildIndex)
+	{
+		const int32 ChildNode = Node.FirstChild + ChildIndex;
+		OutRows.Add(AcquireRowItem(ChildNode));
+
+		if (ExpandedNodes.Contains(ChildNode))
+		{
+			AppendVisibleChildren(ChildNode, OutRows);
+		}
+	}
+}
+
+URapidJsonRowItem* URapidJsonPanel::AcquireRowItem(int32 NodeIndex)
+{
+	URapidJsonRowItem* RowItem = FreeRowItems.Num() > 0 ? FreeRowItems.Pop() : NewObject<URapidJsonRowItem>(this);
+	RowItem->NodeIndex = NodeIndex;
+	RowItem->Panel = this;
+	return RowItem;
+}
+
+void URapidJsonPanel::UpdateListView()
+{
+	if (RowListView)
+	{
+		RowListView->SetListItems(Rows);
+	}
+}
+
+int32 URapidJsonPanel::FindRow(int32 NodeIndex) const
+{
+	return Rows.IndexOfByPredicate([NodeIndex](const URapidJsonRowItem* RowItem)
+	{
+		return RowItem->NodeIndex == NodeIndex;
+	});
+}
+
+void URapidJsonPanel::RefreshNodeRow(int32 NodeIndex)
+{
+	const int32 Row = FindRow(NodeIndex);
+	if (!RowListView || Row == INDEX_NONE)
+	{
+		return;
+	}
+
+	// 只有屏幕上的行有控件
+	if (URapidJsonRowWidget* RowWidget = RowListView->GetEntryWidgetFromItem<URapidJsonRowWidget>(Rows[Row]))
+	{
+		RowWidget->RefreshRow();
+	}
+}
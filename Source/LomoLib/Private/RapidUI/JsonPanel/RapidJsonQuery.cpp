@@ -0,0 +1,545 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonQuery.h"
+#include "RapidUI/JsonPanel/RapidJsonDocument.h"
+
+namespace RapidJsonQueryPrivate
+{
+	/** 读取成员名，直到'.'、'['或结尾 */
+	FStringView ReadName(FStringView& InText)
+	{
+		int32 Length = 0;
+		while (Length < InText.Len() && InText[Length] != TEXT('.') && InText[Length] != TEXT('['))
+		{
+			++Length;
+		}
+
+		const FStringView Name = InText.Left(Length);
+		InText.RightChopInline(Length);
+		return Name;
+	}
+
+	/** 读取引号中的字符串，InText从引号开始，支持\\转义 */
+	bool ReadQuoted(FStringView& InText, FString& OutValue)
+	{
+		const TCHAR Quote = InText[0];
+		OutValue.Reset();
+
+		for (int32 Pos = 1; Pos < InText.Len(); ++Pos)
+		{
+			if (InText[Pos] == TEXT('\\') && Pos + 1 < InText.Len())
+			{
+				OutValue.AppendChar(InText[++Pos]);
+			}
+			else if (InText[Pos] == Quote)
+			{
+				InText.RightChopInline(Pos + 1);
+				return true;
+			}
+			else
+			{
+				OutValue.AppendChar(InText[Pos]);
+			}
+		}
+		return false;
+	}
+}
+
+bool FRapidJsonQuery::Compile(FStringView InExpression)
+{
+	using namespace RapidJsonQueryPrivate;
+
+	Steps.Reset();
+	Error.Reset();
+	bCompiled = false;
+
+	FStringView Text = InExpression.TrimStartAndEnd();
+	if (Text.StartsWith(TEXT('$')))
+	{
+		Text.RightChopInline(1);
+	}
+
+	while (!Text.IsEmpty())
+	{
+		if (Text.StartsWith(TEXT("..")))
+		{
+			Text.RightChopInline(2);
+			Steps.AddDefaulted_GetRef().Type = EStepType::Descendants;
+
+			// ..[...]直接由下一轮解析
+			if (Text.StartsWith(TEXT('[')))
+			{
+				continue;
+			}
+		}
+		else if (Text.StartsWith(TEXT('.')))
+		{
+			Text.RightChopInline(1);
+		}
+		else if (Text.StartsWith(TEXT('[')))
+		{
+			Text.RightChopInline(1);
+			if (!ParseBracket(Text))
+			{
+				return false;
+			}
+			continue;
+		}
+		else
+		{
+			return SetError(FString::Printf(TEXT("无法解析: %s"), *FString(Text)));
+		}
+
+		const FStringView Name = ReadName(Text);
+		if (Name.IsEmpty())
+		{
+			return SetError(TEXT("缺少成员名"));
+		}
+
+		FStep& Step = Steps.AddDefaulted_GetRef();
+		if (Name == TEXT("*"))
+		{
+			Step.Type = EStepType::Wildcard;
+		}
+		else
+		{
+			Step.Type = EStepType::Child;
+			Step.Key = FString(Name);
+		}
+	}
+
+	bCompiled = true;
+	return true;
+}
+
+bool FRapidJsonQuery::ParseBracket(FStringView& InText)
+{
+	using namespace RapidJsonQueryPrivate;
+
+	InText.TrimStartInline();
+	if (InText.IsEmpty())
+	{
+		return SetError(TEXT("缺少']'"));
+	}
+
+	FStep Step;
+
+	if (InText.StartsWith(TEXT('*')))
+	{
+		Step.Type = EStepType::Wildcard;
+		InText.RightChopInline(1);
+	}
+	else if (InText.StartsWith(TEXT('\'')) || InText.StartsWith(TEXT('"')))
+	{
+		Step.Type = EStepType::Child;
+		if (!ReadQuoted(InText, Step.Key))
+		{
+			return SetError(TEXT("字符串缺少结束引号"));
+		}
+	}
+	else if (InText.StartsWith(TEXT('?')))
+	{
+		// 找到与"?("匹配的')'，跳过引号中的内容
+		InText.RightChopInline(1);
+		InText.TrimStartInline();
+		if (!InText.StartsWith(TEXT('(')))
+		{
+			return SetError(TEXT("过滤表达式应以'?('开始"));
+		}
+
+		int32 Depth = 0;
+		int32 ClosePos = INDEX_NONE;
+		TCHAR Quote = 0;
+		for (int32 Pos = 0; Pos < InText.Len() && ClosePos == INDEX_NONE; ++Pos)
+		{
+			const TCHAR Char = InText[Pos];
+			if (Quote)
+			{
+				if (Char == TEXT('\\'))
+				{
+					++Pos;
+				}
+				else if (Char == Quote)
+				{
+					Quote = 0;
+				}
+			}
+			else if (Char == TEXT('\'') || Char == TEXT('"'))
+			{
+				Quote = Char;
+			}
+			else if (Char == TEXT('('))
+			{
+				++Depth;
+			}
+			else if (Char == TEXT(')') && --Depth == 0)
+			{
+				ClosePos = Pos;
+			}
+		}
+
+		if (ClosePos == INDEX_NONE)
+		{
+			return SetError(TEXT("过滤表达式缺少')'"));
+		}
+
+		Step.Type = EStepType::Filter;
+		if (!ParseFilter(InText.Mid(1, ClosePos - 1), Step.Filter))
+		{
+			return false;
+		}
+		InText.RightChopInline(ClosePos + 1);
+	}
+	else
+	{
+		// 数组下标
+		int32 Length = 0;
+		if (InText.StartsWith(TEXT('-')))
+		{
+			++Length;
+		}
+		while (Length < InText.Len() && FChar::IsDigit(InText[Length]))
+		{
+			++Length;
+		}
+
+		if (Length == 0 || (Length == 1 && InText[0] == TEXT('-')))
+		{
+			return SetError(FString::Printf(TEXT("无效的下标: %s"), *FString(InText)));
+		}
+
+		Step.Type = EStepType::Index;
+		LexFromString(Step.Index, *FString(InText.Left(Length)));
+		InText.RightChopInline(Length);
+	}
+
+	InText.TrimStartInline();
+	if (!InText.StartsWith(TEXT(']')))
+	{
+		return SetError(TEXT("缺少']'"));
+	}
+	InText.RightChopInline(1);
+
+	Steps.Add(MoveTemp(Step));
+	return true;
+}
+
+bool FRapidJsonQuery::ParseFilter(FStringView InText, FFilter& OutFilter)
+{
+	using namespace RapidJsonQueryPrivate;
+
+	InText.TrimStartAndEndInline();
+	if (!InText.StartsWith(TEXT('@')))
+	{
+		return SetError(TEXT("过滤表达式应以'@'开始"));
+	}
+	InText.RightChopInline(1);
+
+	// @之后的成员路径
+	while (InText.StartsWith(TEXT('.')))
+	{
+		InText.RightChopInline(1);
+
+		int32 Length = 0;
+		while (Length < InText.Len() && (FChar::IsAlnum(InText[Length]) || InText[Length] == TEXT('_') || InText[Length] == TEXT('-')))
+		{
+			++Length;
+		}
+
+		if (Length == 0)
+		{
+			return SetError(TEXT("过滤表达式缺少成员名"));
+		}
+
+		OutFilter.FieldPath.Add(FString(InText.Left(Length)));
+		InText.RightChopInline(Length);
+	}
+
+	InText.TrimStartInline();
+	if (InText.IsEmpty())
+	{
+		OutFilter.Operator = EFilterOperator::Exists;
+		return true;
+	}
+
+	// 运算符，先匹配两个字符的
+	static const TPair<const TCHAR*, EFilterOperator> Operators[] = {
+		{ TEXT("=="), EFilterOperator::Equal },
+		{ TEXT("!="), EFilterOperator::NotEqual },
+		{ TEXT("<="), EFilterOperator::LessEqual },
+		{ TEXT(">="), EFilterOperator::GreaterEqual },
+		{ TEXT("<"), EFilterOperator::Less },
+		{ TEXT(">"), EFilterOperator::Greater },
+	};
+
+	bool bFoundOperator = false;
+	for (const TPair<const TCHAR*, EFilterOperator>& Operator : Operators)
+	{
+		if (InText.StartsWith(Operator.Key))
+		{
+			OutFilter.Operator = Operator.Value;
+			InText.RightChopInline(FCString::Strlen(Operator.Key));
+			bFoundOperator = true;
+			break;
+		}
+	}
+
+	if (!bFoundOperator)
+	{
+		return SetError(FString::Printf(TEXT("无效的运算符: %s"), *FString(InText)));
+	}
+
+	InText.TrimStartAndEndInline();
+	if (InText.StartsWith(TEXT('\'')) || InText.StartsWith(TEXT('"')))
+	{
+		OutFilter.ValueType = EFilterValueType::String;
+		if (!ReadQuoted(InText, OutFilter.StringValue) || !InText.IsEmpty())
+		{
+			return SetError(TEXT("过滤表达式中的字符串无效"));
+		}
+	}
+	else if (InText == TEXT("true") || InText == TEXT("false"))
+	{
+		OutFilter.ValueType = EFilterValueType::Bool;
+		OutFilter.bBoolValue = InText == TEXT("true");
+	}
+	else if (InText == TEXT("null"))
+	{
+		OutFilter.ValueType = EFilterValueType::Null;
+	}
+	else
+	{
+		const FString NumberText(InText);
+		if (!FCString::IsNumeric(*NumberText))
+		{
+			return SetError(FString::Printf(TEXT("过滤表达式中的值无效: %s"), *NumberText));
+		}
+		OutFilter.ValueType = EFilterValueType::Number;
+		OutFilter.NumberValue = FCString::Atod(*NumberText);
+	}
+
+	// 只有数字和字符串可以比较大小
+	const bool bIsOrdering = OutFilter.Operator != EFilterOperator::Equal && OutFilter.Operator != EFilterOperator::NotEqual;
+	if (bIsOrdering && (OutFilter.ValueType == EFilterValueType::Bool || OutFilter.ValueType == EFilterValueType::Null))
+	{
+		return SetError(TEXT("true、false和null只能使用==或!="));
+	}
+
+	return true;
+}
+
+TArray<int32> FRapidJsonQuery::Execute(FRapidJsonDocument& InDocument) const
+{
+	TArray<int32> Current;
+	if (!bCompiled || !InDocument.IsValid())
+	{
+		return Current;
+	}
+
+	Current.Add(FRapidJsonDocument::RootNode);
+
+	TArray<int32> Next;
+	TSet<int32> Added;
+
+	for (const FStep& Step : Steps)
+	{
+		Next.Reset();
+		Added.Reset();
+
+		auto AddNode = [&Next, &Added](int32 InNodeIndex)
+		{
+			bool bAlreadyAdded = false;
+			Added.Add(InNodeIndex, &bAlreadyAdded);
+			if (!bAlreadyAdded)
+			{
+				Next.Add(InNodeIndex);
+			}
+		};
+
+		for (const int32 NodeIndex : Current)
+		{
+			switch (Step.Type)
+			{
+			case EStepType::Child:
+				{
+					const int32 Child = InDocument.FindChild(NodeIndex, Step.Key);
+					if (Child != INDEX_NONE)
+					{
+						AddNode(Child);
+					}
+					break;
+				}
+
+			case EStepType::Index:
+				if (InDocument.GetNode(NodeIndex).Type == ERapidJsonNodeType::Array && InDocument.IndexChildren(NodeIndex))
+				{
+					const int32 NumChildren = InDocument.GetNode(NodeIndex).NumChildren;
+					const int32 Child = InDocument.GetChild(NodeIndex, Step.Index < 0 ? NumChildren + Step.Index : Step.Index);
+					if (Child != INDEX_NONE)
+					{
+						AddNode(Child);
+					}
+				}
+				break;
+
+			case EStepType::Wildcard:
+			case EStepType::Filter:
+				if (InDocument.GetNode(NodeIndex).IsContainer() && InDocument.IndexChildren(NodeIndex))
+				{
+					const FRapidJsonNode& Node = InDocument.GetNode(NodeIndex);
+					const int32 FirstChild = Node.FirstChild;
+					const int32 NumChildren = Node.NumChildren;
+
+					// 过滤时会为子节点建立索引，Node引用可能失效，这里只使用拷贝的下标
+					for (int32 ChildIndex = 0; ChildIndex < NumChildren; ++ChildIndex)
+					{
+						if (Step.Type == EStepType::Wildcard || MatchFilter(InDocument, FirstChild + ChildIndex, Step.Filter))
+						{
+							AddNode(FirstChild + ChildIndex);
+						}
+					}
+				}
+				break;
+
+			case EStepType::Descendants:
+				{
+					TArray<int32> Subtree;
+					CollectSubtree(InDocument, NodeIndex, Subtree);
+					for (const int32 SubtreeNode : Subtree)
+					{
+						AddNode(SubtreeNode);
+					}
+					break;
+				}
+			}
+		}
+
+		Swap(Current, Next);
+		if (Current.Num() == 0)
+		{
+			break;
+		}
+	}
+
+	// 按文档顺序返回
+	Current.Sort([&InDocument](int32 A, int32 B)
+	{
+		return InDocument.GetNode(A).ValueOffset < InDocument.GetNode(B).ValueOffset;
+	});
+	return Current;
+}
+
+TArray<int32> FRapidJsonQuery::Run(FRapidJsonDocument& InDocument, FStringView InExpression, FString* OutError)
+{
+	FRapidJsonQuery Query;
+	if (!Query.Compile(InExpression))
+	{
+		if (OutError)
+		{
+			*OutError = Query.GetError();
+		}
+		return TArray<int32>();
+	}
+
+	return Query.Execute(InDocument);
+}
+
+bool FRapidJsonQuery::MatchFilter(FRapidJsonDocument& InDocument, int32 InNodeIndex, const FFilter& InFilter)
+{
+	int32 FieldNode = InNodeIndex;
+	for (const FString& FieldName : InFilter.FieldPath)
+	{
+		FieldNode = InDocument.FindChild(FieldNode, FieldName);
+		if (FieldNode == INDEX_NONE)
+		{
+			return false;
+		}
+	}
+
+	if (InFilter.Operator == EFilterOperator::Exists)
+	{
+		return true;
+	}
+
+	// 比较结果：<0、0、>0；类型不同时只有!=成立
+	int32 Comparison = 0;
+	const ERapidJsonNodeType FieldType = InDocument.GetNode(FieldNode).Type;
+
+	switch (InFilter.ValueType)
+	{
+	case EFilterValueType::Number:
+		{
+			if (FieldType != ERapidJsonNodeType::Number)
+			{
+				return InFilter.Operator == EFilterOperator::NotEqual;
+			}
+			const double Value = FCString::Atod(*InDocument.GetRawValue(FieldNode));
+			Comparison = Value < InFilter.NumberValue ? -1 : (Value > InFilter.NumberValue ? 1 : 0);
+			break;
+		}
+
+	case EFilterValueType::String:
+		if (FieldType != ERapidJsonNodeType::String)
+		{
+			return InFilter.Operator == EFilterOperator::NotEqual;
+		}
+		Comparison = InDocument.GetDisplayValue(FieldNode).Compare(InFilter.StringValue, ESearchCase::CaseSensitive);
+		break;
+
+	case EFilterValueType::Bool:
+		if (FieldType != ERapidJsonNodeType::Bool)
+		{
+			return InFilter.Operator == EFilterOperator::NotEqual;
+		}
+		Comparison = (InDocument.GetRawValue(FieldNode) == TEXT("true")) == InFilter.bBoolValue ? 0 : 1;
+		break;
+
+	case EFilterValueType::Null:
+		Comparison = FieldType == ERapidJsonNodeType::Null ? 0 : 1;
+		break;
+	}
+
+	switch (InFilter.Operator)
+	{
+	case EFilterOperator::Equal: return Comparison == 0;
+	case EFilterOperator::NotEqual: return Comparison != 0;
+	case EFilterOperator::Less: return Comparison < 0;
+	case EFilterOperator::LessEqual: return Comparison <= 0;
+	case EFilterOperator::Greater: return Comparison > 0;
+	case EFilterOperator::GreaterEqual: return Comparison >= 0;
+	default: return false;
+	}
+}
+
+void FRapidJsonQuery::CollectSubtree(FRapidJsonDocument& InDocument, int32 InNodeIndex, TArray<int32>& OutNodes)
+{
+	TArray<int32, TInlineAllocator<64>> Stack;
+	Stack.Add(InNodeIndex);
+
+	while (Stack.Num() > 0)
+	{
+		const int32 NodeIndex = Stack.Pop();
+		if (!InDocument.GetNode(NodeIndex).IsContainer() || !InDocument.IndexChildren(NodeIndex))
+		{
+			continue;
+		}
+
+		OutNodes.Add(NodeIndex);
+
+		// 倒序入栈，保证按文档顺序访问
+		const FRapidJsonNode& Node = InDocument.GetNode(NodeIndex);
+		for (int32 ChildIndex = Node.NumChildren - 1; ChildIndex >= 0; --ChildIndex)
+		{
+			if (InDocument.GetNode(Node.FirstChild + ChildIndex).IsContainer())
+			{
+				Stack.Add(Node.FirstChild + ChildIndex);
+			}
+		}
+	}
+}
+
+bool FRapidJsonQuery::SetError(const FString& InError)
+{
+	Error = InError;
+	return false;
+}
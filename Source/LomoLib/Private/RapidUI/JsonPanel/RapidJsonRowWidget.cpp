@@ -0,0 +1,87 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonRowWidget.h"
+#include "RapidUI/JsonPanel/RapidJsonPanel.h"
+#include "RapidUI/JsonPanel/RapidJsonDocument.h"
+#include "Components/Button.h"
+#include "Components/EditableTextBox.h"
+#include "Components/Spacer.h"
+#include "Components/TextBlock.h"
+
+void URapidJsonRowWidget::NativeOnInitialized()
+{
+	Super::NativeOnInitialized();
+
+	if (ExpandButton)
+	{
+		ExpandButton->OnClicked.AddUniqueDynamic(this, &URapidJsonRowWidget::HandleExpandClicked);
+	}
+	ValueTextBox->OnTextCommitted.AddUniqueDynamic(this, &URapidJsonRowWidget::HandleValueCommitted);
+}
+
+void URapidJsonRowWidget::NativeOnListItemObjectSet(UObject* ListItemObject)
+{
+	RowItem = Cast<URapidJsonRowItem>(ListItemObject);
+	RefreshRow();
+}
+
+void URapidJsonRowWidget::RefreshRow()
+{
+	URapidJsonPanel* Panel = RowItem ? RowItem->Panel.Get() : nullptr;
+	const FRapidJsonDocument* Document = Panel ? &Panel->GetDocument() : nullptr;
+	if (!Document || !Document->IsValidNode(RowItem->NodeIndex))
+	{
+		KeyText->SetText(FText::GetEmpty());
+		ValueTextBox->SetText(FText::GetEmpty());
+		return;
+	}
+
+	const int32 NodeIndex = RowItem->NodeIndex;
+	const FRapidJsonNode& Node = Document->GetNode(NodeIndex);
+	const bool bIsExpanded = Panel->IsNodeExpanded(NodeIndex);
+
+	// 只为可见的行解码键和值
+	KeyText->SetText(FText::FromString(Document->GetKey(NodeIndex)));
+	ValueTextBox->SetText(FText::FromString(Document->GetDisplayValue(NodeIndex)));
+	ValueTextBox->SetIsReadOnly(Node.IsContainer());
+
+	if (ExpandButton)
+	{
+		ExpandButton->SetVisibility(Node.IsContainer() ? ESlateVisibility::Visible : ESlateVisibility::Hidden);
+	}
+
+	if (ExpandText)
+	{
+		ExpandText->SetText(FText::FromString(bIsExpanded ? TEXT("-") : TEXT("+")));
+	}
+
+	if (IndentSpacer)
+	{
+		IndentSpacer->SetSize(FVector2D(Node.Depth * IndentWidth, 1.0f));
+	}
+
+	OnRowRefreshed(Node.Depth, Node.IsContainer(), bIsExpanded);
+}
+
+void URapidJsonRowWidget::HandleExpandClicked()
+{
+	if (URapidJsonPanel* Panel = RowItem ? RowItem->Panel.Get() : nullptr)
+	{
+		Panel->ToggleNodeExpansion(RowItem->NodeIndex);
+	}
+}
+
+void URapidJsonRowWidget::HandleValueCommitted(const FText& Text, ETextCommit::Type CommitMethod)
+{
+	if (CommitMethod != ETextCommit::OnEnter && CommitMethod != ETextCommit::OnUserMovedFocus)
+	{
+		return;
+	}
+
+	URapidJsonPanel* Panel = RowItem ? RowItem->Panel.Get() : nullptr;
+	if (Panel && !Panel->SetNodeValue(RowItem->NodeIndex, Text.ToString()))
+	{
+		// 值无效或没有变化时恢复显示
+		RefreshRow();
+	}
+}
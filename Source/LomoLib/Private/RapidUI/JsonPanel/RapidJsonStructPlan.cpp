@@ -0,0 +1,263 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+
+namespace RapidJsonStructPlanPrivate
+{
+	const TCHAR* GetOpName(ERapidJsonPlanOp InOp)
+	{
+		switch (InOp)
+		{
+		case ERapidJsonPlanOp::Bool: return TEXT("Bool");
+		case ERapidJsonPlanOp::Int8: return TEXT("Int8");
+		case ERapidJsonPlanOp::Int16: return TEXT("Int16");
+		case ERapidJsonPlanOp::Int32: return TEXT("Int32");
+		case ERapidJsonPlanOp::Int64: return TEXT("Int64");
+		case ERapidJsonPlanOp::UInt8: return TEXT("UInt8");
+		case ERapidJsonPlanOp::UInt16: return TEXT("UInt16");
+		case ERapidJsonPlanOp::UInt32: return TEXT("UInt32");
+		case ERapidJsonPlanOp::UInt64: return TEXT("UInt64");
+		case ERapidJsonPlanOp::Float: return TEXT("Float");
+		case ERapidJsonPlanOp::Double: return TEXT("Double");
+		case ERapidJsonPlanOp::Enum: return TEXT("Enum");
+		case ERapidJsonPlanOp::String: return TEXT("String");
+		case ERapidJsonPlanOp::Name: return TEXT("Name");
+		case ERapidJsonPlanOp::Array: return TEXT("Array");
+		default: return TEXT("Generic");
+		}
+	}
+
+	bool IsUnsignedProperty(const FProperty* InProperty)
+	{
+		return CastField<FByteProperty>(InProperty) || CastField<FUInt16Property>(InProperty)
+			|| CastField<FUInt32Property>(InProperty) || CastField<FUInt64Property>(InProperty);
+	}
+}
+
+TSharedRef<const FRapidJsonStructPlan> FRapidJsonStructPlan::Get(const UScriptStruct* InStruct)
+{
+	static TMap<TObjectKey<UScriptStruct>, TSharedRef<const FRapidJsonStructPlan>> CachedPlans;
+
+	check(IsInGameThread());
+
+	if (const TSharedRef<const FRapidJsonStructPlan>* CachedPlan = CachedPlans.Find(InStruct))
+	{
+		return *CachedPlan;
+	}
+
+	TSharedRef<FRapidJsonStructPlan> NewPlan = MakeShared<FRapidJsonStructPlan>();
+	NewPlan->Schema = FRapidJsonStructSchema::Get(InStruct);
+	NewPlan->CompileBlock(nullptr, NewPlan->Schema.Get());
+	NewPlan->ElementBlocks.Empty();
+
+	// 与结构一样，用户定义结构体的计划不缓存
+	if (InStruct->GetPackage()->HasAnyPackageFlags(PKG_CompiledIn))
+	{
+		CachedPlans.Add(InStruct, NewPlan);
+	}
+	return NewPlan;
+}
+
+int32 FRapidJsonStructPlan::NumGenericSteps() const
+{
+	int32 NumGeneric = 0;
+	for (const FRapidJsonPlanStep& Step : Steps)
+	{
+		if (Step.Op == ERapidJsonPlanOp::Generic)
+		{
+			++NumGeneric;
+		}
+	}
+	return NumGeneric;
+}
+
+FString FRapidJsonStructPlan::Describe() const
+{
+	auto LiteralToString = [this](int32 InStart, int32 InLength)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(Literals.GetData() + InStart), InLength);
+		return FString(Converter.Length(), Converter.Get());
+	};
+
+	FString Result = FString::Printf(TEXT("%s: %d 段, %d 步, 通用步骤 %d, 字面量 %d 字节\n"),
+		*Schema->GetStruct()->GetName(), Blocks.Num(), Steps.Num(), NumGenericSteps(), Literals.Num());
+
+	for (int32 BlockIndex = 0; BlockIndex < Blocks.Num(); ++BlockIndex)
+	{
+		const FRapidJsonPlanBlock& Block = Blocks[BlockIndex];
+		Result += FString::Printf(TEXT("段 %d:\n"), BlockIndex);
+
+		for (int32 StepIndex = Block.FirstStep; StepIndex < Block.FirstStep + Block.NumSteps; ++StepIndex)
+		{
+			const FRapidJsonPlanStep& Step = Steps[StepIndex];
+			Result += FString::Printf(TEXT("  %-8s +%-6d %s"), RapidJsonStructPlanPrivate::GetOpName(Step.Op), Step.Offset, *LiteralToString(Step.PrefixStart, Step.PrefixLength));
+			if (Step.Op == ERapidJsonPlanOp::Array)
+			{
+				Result += FString::Printf(TEXT(" -> 段 %d"), Step.SubBlock);
+			}
+			Result += TEXT("\n");
+		}
+
+		Result += FString::Printf(TEXT("  %s\n"), *LiteralToString(Block.SuffixStart, Block.SuffixLength));
+	}
+
+	return Result;
+}
+
+int32 FRapidJsonStructPlan::CompileBlock(const FRapidJsonValueSchema* InValue, const FRapidJsonStructSchema* InStructSchema)
+{
+	// 先占位，段内的数组元素会先编译自己的段
+	const int32 BlockIndex = Blocks.AddDefaulted();
+	if (InValue)
+	{
+		ElementBlocks.Add(InValue, BlockIndex);
+	}
+
+	TArray<FRapidJsonPlanStep> BlockSteps;
+	TArray<uint8> Prefix;
+	if (InValue)
+	{
+		CompileValue(*InValue, 0, Prefix, BlockSteps);
+	}
+	else
+	{
+		CompileStruct(*InStructSchema, 0, Prefix, BlockSteps);
+	}
+
+	FRapidJsonPlanBlock& Block = Blocks[BlockIndex];
+	Block.FirstStep = Steps.Num();
+	Block.NumSteps = BlockSteps.Num();
+	Block.SuffixStart = FlushLiteral(Prefix, Block.SuffixLength);
+	Steps.Append(MoveTemp(BlockSteps));
+
+	return BlockIndex;
+}
+
+void FRapidJsonStructPlan::CompileStruct(const FRapidJsonStructSchema& InSchema, int32 InBaseOffset, TArray<uint8>& InOutPrefix, TArray<FRapidJsonPlanStep>& OutSteps)
+{
+	const TArray<FRapidJsonFieldSchema>& Fields = InSchema.GetFields();
+
+	InOutPrefix.Add('{');
+	for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+	{
+		const FRapidJsonFieldSchema& Field = Fields[FieldIndex];
+		if (FieldIndex > 0)
+		{
+			InOutPrefix.Add(',');
+		}
+		InOutPrefix.Append(Field.EncodedKey);
+		InOutPrefix.Add(':');
+
+		if (Field.ArrayDim == 1)
+		{
+			CompileValue(Field.Value, InBaseOffset + Field.Offset, InOutPrefix, OutSteps);
+			continue;
+		}
+
+		// 静态数组展开为每个元素一步
+		InOutPrefix.Add('[');
+		for (int32 ElementIndex = 0; ElementIndex < Field.ArrayDim; ++ElementIndex)
+		{
+			if (ElementIndex > 0)
+			{
+				InOutPrefix.Add(',');
+			}
+			CompileValue(Field.Value, InBaseOffset + Field.Offset + ElementIndex * Field.ElementSize, InOutPrefix, OutSteps);
+		}
+		InOutPrefix.Add(']');
+	}
+	InOutPrefix.Add('}');
+}
+
+void FRapidJsonStructPlan::CompileValue(const FRapidJsonValueSchema& InValue, int32 InOffset, TArray<uint8>& InOutPrefix, TArray<FRapidJsonPlanStep>& OutSteps)
+{
+	using namespace RapidJsonStructPlanPrivate;
+
+	// 嵌套结构体展开到当前段
+	if (InValue.Kind == ERapidJsonValueKind::Struct)
+	{
+		CompileStruct(*InValue.StructSchema, InOffset, InOutPrefix, OutSteps);
+		return;
+	}
+
+	FRapidJsonPlanStep Step;
+	Step.Offset = InOffset;
+	Step.Value = &InValue;
+	Step.PrefixStart = FlushLiteral(InOutPrefix, Step.PrefixLength);
+
+	const FProperty* Property = InValue.Property;
+
+	switch (InValue.Kind)
+	{
+	case ERapidJsonValueKind::Bool:
+		{
+			const FBoolProperty* BoolProperty = static_cast<const FBoolProperty*>(Property);
+			Step.Op = ERapidJsonPlanOp::Bool;
+			Step.Offset += BoolProperty->GetByteOffset();
+			Step.ByteMask = BoolProperty->GetByteMask();
+			Step.FieldMask = BoolProperty->GetFieldMask();
+		}
+		break;
+
+	case ERapidJsonValueKind::SignedInteger:
+		Step.Op = CastField<FInt8Property>(Property) ? ERapidJsonPlanOp::Int8
+			: CastField<FInt16Property>(Property) ? ERapidJsonPlanOp::Int16
+			: CastField<FIntProperty>(Property) ? ERapidJsonPlanOp::Int32
+			: CastField<FInt64Property>(Property) ? ERapidJsonPlanOp::Int64
+			: ERapidJsonPlanOp::Generic;
+		break;
+
+	case ERapidJsonValueKind::UnsignedInteger:
+		Step.Op = CastField<FByteProperty>(Property) ? ERapidJsonPlanOp::UInt8
+			: CastField<FUInt16Property>(Property) ? ERapidJsonPlanOp::UInt16
+			: CastField<FUInt32Property>(Property) ? ERapidJsonPlanOp::UInt32
+			: CastField<FUInt64Property>(Property) ? ERapidJsonPlanOp::UInt64
+			: ERapidJsonPlanOp::Generic;
+		break;
+
+	case ERapidJsonValueKind::Float:
+		Step.Op = CastField<FFloatProperty>(Property) ? ERapidJsonPlanOp::Float
+			: CastField<FDoubleProperty>(Property) ? ERapidJsonPlanOp::Double
+			: ERapidJsonPlanOp::Generic;
+		break;
+
+	case ERapidJsonValueKind::Enum:
+		Step.Op = ERapidJsonPlanOp::Enum;
+		Step.Size = static_cast<uint8>(InValue.NumericProperty->GetSize());
+		Step.bSigned = !IsUnsignedProperty(InValue.NumericProperty);
+		break;
+
+	case ERapidJsonValueKind::String:
+		Step.Op = ERapidJsonPlanOp::String;
+		break;
+
+	case ERapidJsonValueKind::Name:
+		Step.Op = ERapidJsonPlanOp::Name;
+		break;
+
+	case ERapidJsonValueKind::Array:
+		{
+			const FRapidJsonValueSchema& Element = InValue.Inner[0];
+			const int32* ElementBlock = ElementBlocks.Find(&Element);
+			Step.Op = ERapidJsonPlanOp::Array;
+			Step.SubBlock = ElementBlock ? *ElementBlock : CompileBlock(&Element, nullptr);
+			Step.ElementSize = Element.Property->GetSize();
+		}
+		break;
+
+	default:
+		Step.Op = ERapidJsonPlanOp::Generic;
+		break;
+	}
+
+	OutSteps.Add(Step);
+}
+
+int32 FRapidJsonStructPlan::FlushLiteral(TArray<uint8>& InOutLiteral, int32& OutLength)
+{
+	const int32 Start = Literals.Num();
+	OutLength = InOutLiteral.Num();
+	Literals.Append(InOutLiteral);
+	InOutLiteral.Reset();
+	return Start;
+}
@@ -0,0 +1,1016 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonStructReader.h"
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+
+namespace RapidJsonStructReaderPrivate
+{
+	bool ParseHex4(TConstArrayView<uint8> InData, int32 InOffset, uint32& OutValue)
+	{
+		if (InOffset + 4 > InData.Num())
+		{
+			return false;
+		}
+
+		OutValue = 0;
+		for (int32 Index = 0; Index < 4; ++Index)
+		{
+			const uint8 Char = InData[InOffset + Index];
+			OutValue <<= 4;
+			if (Char >= '0' && Char <= '9')
+			{
+				OutValue |= Char - '0';
+			}
+			else if (Char >= 'a' && Char <= 'f')
+			{
+				OutValue |= Char - 'a' + 10;
+			}
+			else if (Char >= 'A' && Char <= 'F')
+			{
+				OutValue |= Char - 'A' + 10;
+			}
+			else
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	void AppendCodePoint(FString& OutString, uint32 InCodePoint)
+	{
+		// TCHAR为UTF-16时拆成代理对
+		if (sizeof(TCHAR) == 2 && InCodePoint >= 0x10000)
+		{
+			InCodePoint -= 0x10000;
+			OutString.AppendChar(static_cast<TCHAR>(0xD800 + (InCodePoint >> 10)));
+			OutString.AppendChar(static_cast<TCHAR>(0xDC00 + (InCodePoint & 0x3FF)));
+		}
+		else
+		{
+			OutString.AppendChar(static_cast<TCHAR>(InCodePoint));
+		}
+	}
+
+	void WriteEnumValue(const FRapidJsonPlanStep& InStep, uint8* InValuePtr, int64 InValue)
+	{
+		switch (InStep.Size)
+		{
+		case 1: *InValuePtr = static_cast<uint8>(InValue); break;
+		case 2: *reinterpret_cast<uint16*>(InValuePtr) = static_cast<uint16>(InValue); break;
+		case 4: *reinterpret_cast<uint32*>(InValuePtr) = static_cast<uint32>(InValue); break;
+		default: *reinterpret_cast<int64*>(InValuePtr) = InValue; break;
+		}
+	}
+}
+
+FRapidJsonStructReader::FRapidJsonStructReader(TConstArrayView<uint8> InData)
+	: Data(InData)
+{
+}
+
+bool FRapidJsonStructReader::Read(const UScriptStruct* InStruct, void* InStructMemory, TConstArrayView<uint8> InData, FString* OutError)
+{
+	FRapidJsonStructReader Reader(InData);
+	const bool bSucceeded = Reader.ReadStruct(*FRapidJsonStructSchema::Get(InStruct), InStructMemory);
+	if (!bSucceeded && OutError)
+	{
+		*OutError = Reader.GetError();
+	}
+	return bSucceeded;
+}
+
+bool FRapidJsonStructReader::ReadStruct(const FRapidJsonStructSchema& InSchema, void* InStructMemory)
+{
+	Pos = 0;
+	Error.Reset();
+
+	// 跳过UTF-8 BOM
+	if (Data.Num() >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+
+	SkipWhitespace();
+	if (!ReadObject(InSchema, static_cast<uint8*>(InStructMemory)))
+	{
+		return false;
+	}
+
+	SkipWhitespace();
+	if (Pos != Data.Num())
+	{
+		return SetError(TEXT("对象之后有多余的内容"));
+	}
+	return true;
+}
+
+bool FRapidJsonStructReader::ReadPlan(const FRapidJsonStructPlan& InPlan, void* InStructMemory)
+{
+	Pos = 0;
+	Error.Reset();
+
+	if (Data.Num() >= 3 && Data[0] == 0xEF && Data[1] == 0xBB && Data[2] == 0xBF)
+	{
+		Pos = 3;
+	}
+
+	if (ReadPlanBlock(InPlan, FRapidJsonStructPlan::RootBlock, static_cast<uint8*>(InStructMemory)))
+	{
+		SkipWhitespace();
+		if (Pos == Data.Num())
+		{
+			return true;
+		}
+	}
+
+	// 已经写入的字段在Json中都存在，通用路径会重新写入相同的值
+	return ReadStruct(InPlan.GetSchema(), InStructMemory);
+}
+
+bool FRapidJsonStructReader::ReadPlanBlock(const FRapidJsonStructPlan& InPlan, int32 InBlockIndex, uint8* InBaseMemory)
+{
+	using namespace RapidJsonStructReaderPrivate;
+
+	const uint8* Literals = InPlan.GetLiterals().GetData();
+	const FRapidJsonPlanBlock& Block = InPlan.GetBlocks()[InBlockIndex];
+	const FRapidJsonPlanStep* Step = InPlan.GetSteps().GetData() + Block.FirstStep;
+	const FRapidJsonPlanStep* EndStep = Step + Block.NumSteps;
+
+	int64 IntegerValue = 0;
+	uint64 UnsignedValue = 0;
+	double DoubleValue = 0.0;
+	bool bIsInteger = false;
+
+	for (; Step != EndStep; ++Step)
+	{
+		if (!MatchLiteral(Literals + Step->PrefixStart, Step->PrefixLength))
+		{
+			return false;
+		}
+
+		uint8* ValuePtr = InBaseMemory + Step->Offset;
+
+		switch (Step->Op)
+		{
+		case ERapidJsonPlanOp::Bool:
+			if (Peek() == 't' && ReadLiteral("true", 4))
+			{
+				*ValuePtr = (*ValuePtr & ~Step->FieldMask) | Step->ByteMask;
+			}
+			else if (Peek() == 'f' && ReadLiteral("false", 5))
+			{
+				*ValuePtr &= ~Step->FieldMask;
+			}
+			else
+			{
+				return false;
+			}
+			break;
+
+		case ERapidJsonPlanOp::Int8:
+		case ERapidJsonPlanOp::Int16:
+		case ERapidJsonPlanOp::Int32:
+		case ERapidJsonPlanOp::Int64:
+		case ERapidJsonPlanOp::UInt8:
+		case ERapidJsonPlanOp::UInt16:
+		case ERapidJsonPlanOp::UInt32:
+		case ERapidJsonPlanOp::UInt64:
+			if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger) || !bIsInteger)
+			{
+				return false;
+			}
+			switch (Step->Op)
+			{
+			case ERapidJsonPlanOp::Int8: *reinterpret_cast<int8*>(ValuePtr) = static_cast<int8>(IntegerValue); break;
+			case ERapidJsonPlanOp::Int16: *reinterpret_cast<int16*>(ValuePtr) = static_cast<int16>(IntegerValue); break;
+			case ERapidJsonPlanOp::Int32: *reinterpret_cast<int32*>(ValuePtr) = static_cast<int32>(IntegerValue); break;
+			case ERapidJsonPlanOp::Int64: *reinterpret_cast<int64*>(ValuePtr) = IntegerValue; break;
+			case ERapidJsonPlanOp::UInt8: *ValuePtr = static_cast<uint8>(UnsignedValue); break;
+			case ERapidJsonPlanOp::UInt16: *reinterpret_cast<uint16*>(ValuePtr) = static_cast<uint16>(UnsignedValue); break;
+			case ERapidJsonPlanOp::UInt32: *reinterpret_cast<uint32*>(ValuePtr) = static_cast<uint32>(UnsignedValue); break;
+			default: *reinterpret_cast<uint64*>(ValuePtr) = UnsignedValue; break;
+			}
+			break;
+
+		case ERapidJsonPlanOp::Float:
+			if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+			{
+				return false;
+			}
+			*reinterpret_cast<float*>(ValuePtr) = static_cast<float>(DoubleValue);
+			break;
+
+		case ERapidJsonPlanOp::Double:
+			if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+			{
+				return false;
+			}
+			*reinterpret_cast<double*>(ValuePtr) = DoubleValue;
+			break;
+
+		case ERapidJsonPlanOp::Enum:
+			if (Peek() == '"')
+			{
+				int32 Start = 0;
+				int32 End = 0;
+				if (!ScanString(Start, End))
+				{
+					return false;
+				}
+
+				const TArray<TArray<uint8>>& EncodedNames = Step->Value->EncodedEnumNames;
+				int32 EnumIndex = 0;
+				for (; EnumIndex < EncodedNames.Num(); ++EnumIndex)
+				{
+					if (EncodedNames[EnumIndex].Num() == End - Start && FMemory::Memcmp(EncodedNames[EnumIndex].GetData(), Data.GetData() + Start, End - Start) == 0)
+					{
+						break;
+					}
+				}
+
+				// 完整的枚举名等情况交给通用路径
+				if (EnumIndex == EncodedNames.Num())
+				{
+					return false;
+				}
+				WriteEnumValue(*Step, ValuePtr, Step->Value->EnumValues[EnumIndex]);
+			}
+			else
+			{
+				if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger) || !bIsInteger)
+				{
+					return false;
+				}
+				WriteEnumValue(*Step, ValuePtr, IntegerValue);
+			}
+			break;
+
+		case ERapidJsonPlanOp::String:
+			{
+				FString& Target = *reinterpret_cast<FString*>(ValuePtr);
+				Target.Reset();
+				if (!ReadString(Target))
+				{
+					return false;
+				}
+			}
+			break;
+
+		case ERapidJsonPlanOp::Name:
+			ScratchText.Reset();
+			if (!ReadString(ScratchText))
+			{
+				return false;
+			}
+			*reinterpret_cast<FName*>(ValuePtr) = FName(*ScratchText);
+			break;
+
+		case ERapidJsonPlanOp::Array:
+			{
+				if (!Consume('['))
+				{
+					return false;
+				}
+
+				FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(Step->Value->Property), ValuePtr);
+				ArrayHelper.EmptyValues();
+				if (Consume(']'))
+				{
+					break;
+				}
+
+				while (true)
+				{
+					const int32 Index = ArrayHelper.AddValue();
+					if (!ReadPlanBlock(InPlan, Step->SubBlock, ArrayHelper.GetRawPtr(Index)))
+					{
+						return false;
+					}
+					if (Consume(','))
+					{
+						continue;
+					}
+					if (Consume(']'))
+					{
+						break;
+					}
+					return false;
+				}
+			}
+			break;
+
+		case ERapidJsonPlanOp::Generic:
+		default:
+			if (!ReadValue(*Step->Value, ValuePtr))
+			{
+				return false;
+			}
+			break;
+		}
+	}
+
+	return MatchLiteral(Literals + Block.SuffixStart, Block.SuffixLength);
+}
+
+bool FRapidJsonStructReader::MatchLiteral(const uint8* InLiteral, int32 InLength)
+{
+	if (Pos + InLength > Data.Num() || FMemory::Memcmp(Data.GetData() + Pos, InLiteral, InLength) != 0)
+	{
+		return false;
+	}
+	Pos += InLength;
+	return true;
+}
+
+bool FRapidJsonStructReader::ReadObject(const FRapidJsonStructSchema& InSchema, uint8* InStructMemory)
+{
+	if (!Consume('{'))
+	{
+		return SetError(TEXT("应为'{'"));
+	}
+
+	SkipWhitespace();
+	if (Consume('}'))
+	{
+		return true;
+	}
+
+	// 键通常按字段顺序出现，先尝试下一个字段
+	int32 NextField = 0;
+
+	while (true)
+	{
+		SkipWhitespace();
+
+		int32 KeyStart = 0;
+		int32 KeyEnd = 0;
+		if (Peek() != '"' || !ScanString(KeyStart, KeyEnd))
+		{
+			return SetError(TEXT("应为键"));
+		}
+
+		SkipWhitespace();
+		if (!Consume(':'))
+		{
+			return SetError(TEXT("应为':'"));
+		}
+		SkipWhitespace();
+
+		bool bRead = false;
+		if (const FRapidJsonFieldSchema* Field = FindField(InSchema, KeyStart, KeyEnd, NextField))
+		{
+			bRead = Field->ArrayDim > 1 ? ReadStaticArray(*Field, InStructMemory) : ReadValue(Field->Value, InStructMemory + Field->Offset);
+		}
+		else
+		{
+			bRead = SkipValue();
+		}
+
+		if (!bRead)
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Consume(','))
+		{
+			continue;
+		}
+		if (Consume('}'))
+		{
+			return true;
+		}
+		return SetError(TEXT("应为','或'}'"));
+	}
+}
+
+bool FRapidJsonStructReader::ReadValue(const FRapidJsonValueSchema& InValue, void* InValuePtr)
+{
+	SkipWhitespace();
+
+	// null保持原值
+	if (Peek() == 'n')
+	{
+		return ReadLiteral("null", 4);
+	}
+
+	int64 IntegerValue = 0;
+	uint64 UnsignedValue = 0;
+	double DoubleValue = 0.0;
+	bool bIsInteger = false;
+
+	switch (InValue.Kind)
+	{
+	case ERapidJsonValueKind::Bool:
+		{
+			const bool bValue = Peek() == 't';
+			if (bValue ? !ReadLiteral("true", 4) : !ReadLiteral("false", 5))
+			{
+				return false;
+			}
+			static_cast<const FBoolProperty*>(InValue.Property)->SetPropertyValue(InValuePtr, bValue);
+		}
+		return true;
+
+	case ERapidJsonValueKind::SignedInteger:
+		if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+		{
+			return false;
+		}
+		InValue.NumericProperty->SetIntPropertyValue(InValuePtr, bIsInteger ? IntegerValue : static_cast<int64>(DoubleValue));
+		return true;
+
+	case ERapidJsonValueKind::UnsignedInteger:
+		if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+		{
+			return false;
+		}
+		InValue.NumericProperty->SetIntPropertyValue(InValuePtr, bIsInteger ? UnsignedValue : static_cast<uint64>(DoubleValue));
+		return true;
+
+	case ERapidJsonValueKind::Float:
+		if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+		{
+			return false;
+		}
+		InValue.NumericProperty->SetFloatingPointPropertyValue(InValuePtr, DoubleValue);
+		return true;
+
+	case ERapidJsonValueKind::Enum:
+		if (Peek() == '"')
+		{
+			int32 Start = 0;
+			int32 End = 0;
+			if (!ScanString(Start, End))
+			{
+				return false;
+			}
+
+			// 先按编码后的名字比较，匹配不到时再解码后按完整名查找
+			const TConstArrayView<uint8> RawName = Data.Slice(Start, End - Start);
+			int64 EnumValue = INDEX_NONE;
+			for (int32 EnumIndex = 0; EnumIndex < InValue.EncodedEnumNames.Num(); ++EnumIndex)
+			{
+				const TArray<uint8>& EncodedName = InValue.EncodedEnumNames[EnumIndex];
+				if (EncodedName.Num() == RawName.Num() && FMemory::Memcmp(EncodedName.GetData(), RawName.GetData(), RawName.Num()) == 0)
+				{
+					EnumValue = InValue.EnumValues[EnumIndex];
+					break;
+				}
+			}
+
+			if (EnumValue == INDEX_NONE)
+			{
+				ScratchText.Reset();
+				DecodeString(Start, End, ScratchText);
+				EnumValue = InValue.Enum->GetValueByNameString(ScratchText);
+				if (EnumValue == INDEX_NONE)
+				{
+					return SetError(TEXT("未知的枚举名"));
+				}
+			}
+			InValue.NumericProperty->SetIntPropertyValue(InValuePtr, EnumValue);
+			return true;
+		}
+
+		if (!ReadNumber(IntegerValue, UnsignedValue, DoubleValue, bIsInteger))
+		{
+			return false;
+		}
+		InValue.NumericProperty->SetIntPropertyValue(InValuePtr, IntegerValue);
+		return true;
+
+	case ERapidJsonValueKind::String:
+		// 直接解码到目标字符串，复用其已有的内存
+		{
+			FString& Target = *static_cast<FString*>(InValuePtr);
+			Target.Reset();
+			return ReadString(Target);
+		}
+
+	case ERapidJsonValueKind::Name:
+		ScratchText.Reset();
+		if (!ReadString(ScratchText))
+		{
+			return false;
+		}
+		*static_cast<FName*>(InValuePtr) = FName(*ScratchText);
+		return true;
+
+	case ERapidJsonValueKind::Text:
+		ScratchText.Reset();
+		if (!ReadString(ScratchText))
+		{
+			return false;
+		}
+		*static_cast<FText*>(InValuePtr) = FText::FromString(ScratchText);
+		return true;
+
+	case ERapidJsonValueKind::Struct:
+		return ReadObject(*InValue.StructSchema, static_cast<uint8*>(InValuePtr));
+
+	case ERapidJsonValueKind::Array:
+		return ReadArray(InValue, InValuePtr);
+
+	case ERapidJsonValueKind::Set:
+		return ReadSet(InValue, InValuePtr);
+
+	case ERapidJsonValueKind::Map:
+		return ReadMap(InValue, InValuePtr);
+
+	case ERapidJsonValueKind::Other:
+	default:
+		ScratchText.Reset();
+		if (!ReadString(ScratchText))
+		{
+			return false;
+		}
+		if (!InValue.Property->ImportText_Direct(*ScratchText, InValuePtr, nullptr, PPF_None))
+		{
+			return SetError(TEXT("无法导入属性值"));
+		}
+		return true;
+	}
+}
+
+bool FRapidJsonStructReader::ReadStaticArray(const FRapidJsonFieldSchema& InField, uint8* InStructMemory)
+{
+	if (!Consume('['))
+	{
+		return SetError(TEXT("应为'['"));
+	}
+
+	SkipWhitespace();
+	if (Consume(']'))
+	{
+		return true;
+	}
+
+	for (int32 ElementIndex = 0; ; ++ElementIndex)
+	{
+		// 超出长度的元素被忽略
+		const bool bRead = ElementIndex < InField.ArrayDim
+			? ReadValue(InField.Value, InStructMemory + InField.Offset + ElementIndex * InField.ElementSize)
+			: SkipValue();
+		if (!bRead)
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Consume(','))
+		{
+			continue;
+		}
+		if (Consume(']'))
+		{
+			return true;
+		}
+		return SetError(TEXT("应为','或']'"));
+	}
+}
+
+bool FRapidJsonStructReader::ReadArray(const FRapidJsonValueSchema& InValue, void* InValuePtr)
+{
+	if (!Consume('['))
+	{
+		return SetError(TEXT("应为'['"));
+	}
+
+	FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(InValue.Property), InValuePtr);
+	ArrayHelper.EmptyValues();
+
+	SkipWhitespace();
+	if (Consume(']'))
+	{
+		return true;
+	}
+
+	while (true)
+	{
+		const int32 Index = ArrayHelper.AddValue();
+		if (!ReadValue(InValue.Inner[0], ArrayHelper.GetRawPtr(Index)))
+		{
+			return false;
+		}
+
+		SkipWhitespace();
+		if (Consume(','))
+		{
+			continue;
+		}
+		if (Consume(']'))
+		{
+			return true;
+		}
+		return SetError(TEXT("应为','或']'"));
+	}
+}
+
+bool FRapidJsonStructReader::ReadSet(const FRapidJsonValueSchema& InValue, void* InValuePtr)
+{
+	if (!Consume('['))
+	{
+		return SetError(TEXT("应为'['"));
+	}
+
+	FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(InValue.Property), InValuePtr);
+	SetHelper.EmptyElements();
+
+	bool bSucceeded = true;
+	SkipWhitespace();
+	if (!Consume(']'))
+	{
+		while (true)
+		{
+			const int32 Index = SetHelper.AddDefaultValue_Invalid_NeedsRehash();
+			if (!ReadValue(InValue.Inner[0], SetHelper.GetElementPtr(Index)))
+			{
+				bSucceeded = false;
+				break;
+			}
+
+			SkipWhitespace();
+			if (Consume(','))
+			{
+				continue;
+			}
+			if (!Consume(']'))
+			{
+				bSucceeded = SetError(TEXT("应为','或']'"));
+			}
+			break;
+		}
+	}
+
+	// 失败时也要重建哈希，保证集合可用
+	SetHelper.Rehash();
+	return bSucceeded;
+}
+
+bool FRapidJsonStructReader::ReadMap(const FRapidJsonValueSchema& InValue, void* InValuePtr)
+{
+	if (!Consume('{'))
+	{
+		return SetError(TEXT("应为'{'"));
+	}
+
+	FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(InValue.Property), InValuePtr);
+	MapHelper.EmptyValues();
+
+	bool bSucceeded = true;
+	SkipWhitespace();
+	if (!Consume('}'))
+	{
+		while (true)
+		{
+			SkipWhitespace();
+
+			const int32 Index = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+			ScratchText.Reset();
+			if (Peek() != '"' || !ReadString(ScratchText) || !ImportMapKey(InValue.Inner[0], MapHelper.GetKeyPtr(Index), ScratchText))
+			{
+				bSucceeded = Error.IsEmpty() ? SetError(TEXT("无效的映射键")) : false;
+				break;
+			}
+
+			SkipWhitespace();
+			if (!Consume(':'))
+			{
+				bSucceeded = SetError(TEXT("应为':'"));
+				break;
+			}
+
+			if (!ReadValue(InValue.Inner[1], MapHelper.GetValuePtr(Index)))
+			{
+				bSucceeded = false;
+				break;
+			}
+
+			SkipWhitespace();
+			if (Consume(','))
+			{
+				continue;
+			}
+			if (!Consume('}'))
+			{
+				bSucceeded = SetError(TEXT("应为','或'}'"));
+			}
+			break;
+		}
+	}
+
+	MapHelper.Rehash();
+	return bSucceeded;
+}
+
+bool FRapidJsonStructReader::ImportMapKey(const FRapidJsonValueSchema& InKey, void* InKeyPtr, const FString& InKeyText)
+{
+	switch (InKey.Kind)
+	{
+	case ERapidJsonValueKind::String:
+		*static_cast<FString*>(InKeyPtr) = InKeyText;
+		return true;
+
+	case ERapidJsonValueKind::Name:
+		*static_cast<FName*>(InKeyPtr) = FName(*InKeyText);
+		return true;
+
+	case ERapidJsonValueKind::Text:
+		*static_cast<FText*>(InKeyPtr) = FText::FromString(InKeyText);
+		return true;
+
+	default:
+		// 与写入时的ExportText对应
+		return InKey.Property->ImportText_Direct(*InKeyText, InKeyPtr, nullptr, PPF_None) != nullptr;
+	}
+}
+
+const FRapidJsonFieldSchema* FRapidJsonStructReader::FindField(const FRapidJsonStructSchema& InSchema, int32 InKeyStart, int32 InKeyEnd, int32& InOutNextField)
+{
+	const TArray<FRapidJsonFieldSchema>& Fields = InSchema.GetFields();
+	const TConstArrayView<uint8> RawKey = Data.Slice(InKeyStart, InKeyEnd - InKeyStart);
+
+	auto MatchesRawKey = [&RawKey](const FRapidJsonFieldSchema& InField)
+	{
+		return InField.EncodedKey.Num() == RawKey.Num() && FMemory::Memcmp(InField.EncodedKey.GetData(), RawKey.GetData(), RawKey.Num()) == 0;
+	};
+
+	if (Fields.IsValidIndex(InOutNextField) && MatchesRawKey(Fields[InOutNextField]))
+	{
+		return &Fields[InOutNextField++];
+	}
+
+	for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+	{
+		if (MatchesRawKey(Fields[FieldIndex]))
+		{
+			InOutNextField = FieldIndex + 1;
+			return &Fields[FieldIndex];
+		}
+	}
+
+	// 大小写不同或者包含转义
+	ScratchText.Reset();
+	DecodeString(InKeyStart, InKeyEnd, ScratchText);
+	return InSchema.FindField(ScratchText);
+}
+
+bool FRapidJsonStructReader::ReadNumber(int64& OutInteger, uint64& OutUnsigned, double& OutDouble, bool& bOutIsInteger)
+{
+	const int32 Start = Pos;
+	bOutIsInteger = true;
+
+	while (Pos < Data.Num())
+	{
+		const uint8 Char = Data[Pos];
+		if (Char == '.' || Char == 'e' || Char == 'E')
+		{
+			bOutIsInteger = false;
+		}
+		else if (!((Char >= '0' && Char <= '9') || Char == '-' || Char == '+'))
+		{
+			break;
+		}
+		++Pos;
+	}
+
+	// 复制到栈上的缓冲中，以便使用C的转换函数
+	ANSICHAR Digits[64];
+	const int32 Length = Pos - Start;
+	if (Length == 0 || Length >= UE_ARRAY_COUNT(Digits))
+	{
+		return SetError(TEXT("应为数字"));
+	}
+	FMemory::Memcpy(Digits, Data.GetData() + Start, Length);
+	Digits[Length] = 0;
+
+	OutDouble = FCStringAnsi::Atod(Digits);
+	if (bOutIsInteger)
+	{
+		OutInteger = FCStringAnsi::Strtoi64(Digits, nullptr, 10);
+		OutUnsigned = FCStringAnsi::Strtoui64(Digits, nullptr, 10);
+	}
+	return true;
+}
+
+bool FRapidJsonStructReader::ScanString(int32& OutStart, int32& OutEnd)
+{
+	OutStart = Pos++;
+
+	while (Pos < Data.Num())
+	{
+		const uint8 Char = Data[Pos];
+		if (Char == '\\')
+		{
+			Pos += 2;
+		}
+		else if (Char == '"')
+		{
+			OutEnd = ++Pos;
+			return true;
+		}
+		else
+		{
+			++Pos;
+		}
+	}
+
+	return SetError(TEXT("字符串缺少结束引号"));
+}
+
+void FRapidJsonStructReader::DecodeString(int32 InStart, int32 InEnd, FString& OutString) const
+{
+	using namespace RapidJsonStructReaderPrivate;
+
+	// 跳过首尾的引号
+	const int32 End = InEnd - 1;
+	OutString.Reserve(OutString.Len() + End - InStart - 1);
+
+	for (int32 Offset = InStart + 1; Offset < End; )
+	{
+		const uint8 Char = Data[Offset];
+
+		if (Char == '\\' && Offset + 1 < End)
+		{
+			const uint8 Escaped = Data[Offset + 1];
+			Offset += 2;
+
+			switch (Escaped)
+			{
+			case 'n': OutString.AppendChar(TEXT('\n')); break;
+			case 't': OutString.AppendChar(TEXT('\t')); break;
+			case 'r': OutString.AppendChar(TEXT('\r')); break;
+			case 'b': OutString.AppendChar(TEXT('\b')); break;
+			case 'f': OutString.AppendChar(TEXT('\f')); break;
+			case 'u':
+				{
+					uint32 CodePoint = 0;
+					if (!ParseHex4(Data, Offset, CodePoint))
+					{
+						OutString.AppendChar(TEXT('?'));
+						break;
+					}
+					Offset += 4;
+
+					// \\uD83D\\uDE00形式的代理对
+					uint32 LowSurrogate = 0;
+					if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Offset + 6 <= End
+						&& Data[Offset] == '\\' && Data[Offset + 1] == 'u' && ParseHex4(Data, Offset + 2, LowSurrogate)
+						&& LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+					{
+						CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+						Offset += 6;
+					}
+					AppendCodePoint(OutString, CodePoint);
+				}
+				break;
+			default: OutString.AppendChar(static_cast<TCHAR>(Escaped)); break;
+			}
+			continue;
+		}
+
+		if (Char < 0x80)
+		{
+			OutString.AppendChar(static_cast<TCHAR>(Char));
+			++Offset;
+			continue;
+		}
+
+		// UTF-8多字节序列
+		int32 NumBytes = 0;
+		uint32 CodePoint = 0;
+		if ((Char & 0xE0) == 0xC0)
+		{
+			NumBytes = 2;
+			CodePoint = Char & 0x1F;
+		}
+		else if ((Char & 0xF0) == 0xE0)
+		{
+			NumBytes = 3;
+			CodePoint = Char & 0x0F;
+		}
+		else if ((Char & 0xF8) == 0xF0)
+		{
+			NumBytes = 4;
+			CodePoint = Char & 0x07;
+		}
+
+		if (NumBytes == 0 || Offset + NumBytes > End)
+		{
+			OutString.AppendChar(TEXT('?'));
+			++Offset;
+			continue;
+		}
+
+		for (int32 Index = 1; Index < NumBytes; ++Index)
+		{
+			CodePoint = (CodePoint << 6) | (Data[Offset + Index] & 0x3F);
+		}
+		AppendCodePoint(OutString, CodePoint);
+		Offset += NumBytes;
+	}
+}
+
+bool FRapidJsonStructReader::ReadString(FString& OutString)
+{
+	int32 Start = 0;
+	int32 End = 0;
+	if (Peek() != '"')
+	{
+		return SetError(TEXT("应为字符串"));
+	}
+	if (!ScanString(Start, End))
+	{
+		return false;
+	}
+
+	DecodeString(Start, End, OutString);
+	return true;
+}
+
+bool FRapidJsonStructReader::SkipValue()
+{
+	SkipWhitespace();
+
+	const uint8 Char = Peek();
+	if (Char == '"')
+	{
+		int32 Start = 0;
+		int32 End = 0;
+		return ScanString(Start, End);
+	}
+
+	if (Char == '{' || Char == '[')
+	{
+		int32 Depth = 0;
+		while (Pos < Data.Num())
+		{
+			const uint8 Current = Data[Pos];
+			if (Current == '"')
+			{
+				int32 Start = 0;
+				int32 End = 0;
+				if (!ScanString(Start, End))
+				{
+					return false;
+				}
+				continue;
+			}
+
+			++Pos;
+			if (Current == '{' || Current == '[')
+			{
+				++Depth;
+			}
+			else if ((Current == '}' || Current == ']') && --Depth == 0)
+			{
+				return true;
+			}
+		}
+		return SetError(TEXT("容器缺少结束括号"));
+	}
+
+	// 数字和字面量
+	const int32 Start = Pos;
+	while (Pos < Data.Num() && (FChar::IsAlnum(static_cast<TCHAR>(Data[Pos])) || Data[Pos] == '-' || Data[Pos] == '+' || Data[Pos] == '.'))
+	{
+		++Pos;
+	}
+	return Pos > Start ? true : SetError(TEXT("应为值"));
+}
+
+bool FRapidJsonStructReader::ReadLiteral(const ANSICHAR* InLiteral, int32 InLength)
+{
+	if (Pos + InLength > Data.Num() || FMemory::Memcmp(Data.GetData() + Pos, InLiteral, InLength) != 0)
+	{
+		return SetError(TEXT("无效的字面量"));
+	}
+	Pos += InLength;
+	return true;
+}
+
+void FRapidJsonStructReader::SkipWhitespace()
+{
+	while (Pos < Data.Num() && (Data[Pos] == ' ' || Data[Pos] == '\t' || Data[Pos] == '\n' || Data[Pos] == '\r'))
+	{
+		++Pos;
+	}
+}
+
+bool FRapidJsonStructReader::Consume(uint8 InChar)
+{
+	if (Peek() != InChar)
+	{
+		return false;
+	}
+	++Pos;
+	return true;
+}
+
+bool FRapidJsonStructReader::SetError(const TCHAR* InMessage)
+{
+	Error = FString::Printf(TEXT("%s: 位置 %d"), InMessage, Pos);
+	return false;
+}
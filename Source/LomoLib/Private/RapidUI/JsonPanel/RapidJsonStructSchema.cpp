@@ -0,0 +1,231 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonStructSchema.h"
+#include "JsonObjectConverter.h"
+
+const TArray<uint8>* FRapidJsonValueSchema::FindEncodedEnumName(int64 InValue) const
+{
+	const int32 Index = EnumValues.IndexOfByKey(InValue);
+	return Index != INDEX_NONE ? &EncodedEnumNames[Index] : nullptr;
+}
+
+TSharedRef<const FRapidJsonStructSchema> FRapidJsonStructSchema::Get(const UScriptStruct* InStruct)
+{
+	static TMap<TObjectKey<UScriptStruct>, TSharedRef<const FRapidJsonStructSchema>> CachedSchemas;
+
+	check(IsInGameThread());
+
+	if (const TSharedRef<const FRapidJsonStructSchema>* CachedSchema = CachedSchemas.Find(InStruct))
+	{
+		return *CachedSchema;
+	}
+
+	// 先加入缓存再构建，结构体通过数组引用自身时不会无限递归
+	TSharedRef<FRapidJsonStructSchema> NewSchema = MakeShared<FRapidJsonStructSchema>();
+	CachedSchemas.Add(InStruct, NewSchema);
+	NewSchema->Build(InStruct);
+
+	// 用户定义结构体编译时会原地重建属性，缓存的偏移和FProperty会失效，只缓存原生结构体
+	if (!InStruct->GetPackage()->HasAnyPackageFlags(PKG_CompiledIn))
+	{
+		CachedSchemas.Remove(InStruct);
+	}
+	return NewSchema;
+}
+
+const FRapidJsonFieldSchema* FRapidJsonStructSchema::FindField(const FString& InKey) const
+{
+	const int32* FieldIndex = KeyToField.Find(InKey);
+	return FieldIndex ? &Fields[*FieldIndex] : nullptr;
+}
+
+void FRapidJsonStructSchema::Build(const UScriptStruct* InStruct)
+{
+	Struct = InStruct;
+
+	for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+	{
+		const FProperty* Property = *It;
+
+		// 与FJsonObjectConverter的默认跳过标记相同
+		if (Property->HasAnyPropertyFlags(SkippedPropertyFlags))
+		{
+			continue;
+		}
+
+		FRapidJsonFieldSchema& Field = Fields.AddDefaulted_GetRef();
+		Field.Key = FJsonObjectConverter::StandardizeCase(Property->GetAuthoredName());
+		AppendEncodedString(Field.EncodedKey, *Field.Key, Field.Key.Len());
+		Field.Offset = Property->GetOffset_ForInternal();
+		Field.ArrayDim = Property->ArrayDim;
+		Field.ElementSize = Property->GetSize() / Property->ArrayDim;
+		BuildValue(Property, Field.Value);
+
+		KeyToField.Add(Field.Key, Fields.Num() - 1);
+	}
+}
+
+void FRapidJsonStructSchema::BuildValue(const FProperty* InProperty, FRapidJsonValueSchema& OutValue)
+{
+	OutValue.Property = InProperty;
+
+	if (CastField<FBoolProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Bool;
+	}
+	else if (const FEnumProperty* EnumProperty = CastField<FEnumProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Enum;
+		OutValue.NumericProperty = EnumProperty->GetUnderlyingProperty();
+		OutValue.Enum = EnumProperty->GetEnum();
+	}
+	else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(InProperty))
+	{
+		OutValue.NumericProperty = NumericProperty;
+		if (const UEnum* Enum = NumericProperty->GetIntPropertyEnum())
+		{
+			OutValue.Kind = ERapidJsonValueKind::Enum;
+			OutValue.Enum = Enum;
+		}
+		else if (NumericProperty->IsFloatingPoint())
+		{
+			OutValue.Kind = ERapidJsonValueKind::Float;
+		}
+		else if (CastField<FByteProperty>(InProperty) || CastField<FUInt16Property>(InProperty)
+			|| CastField<FUInt32Property>(InProperty) || CastField<FUInt64Property>(InProperty))
+		{
+			OutValue.Kind = ERapidJsonValueKind::UnsignedInteger;
+		}
+		else
+		{
+			OutValue.Kind = ERapidJsonValueKind::SignedInteger;
+		}
+	}
+	else if (CastField<FStrProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::String;
+	}
+	else if (CastField<FNameProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Name;
+	}
+	else if (CastField<FTextProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Text;
+	}
+	else if (const FStructProperty* StructProperty = CastField<FStructProperty>(InProperty))
+	{
+		// 与FJsonObjectConverter一致：有ExportTextItem的结构体（FGuid、FDateTime等）写为字符串
+		const UScriptStruct::ICppStructOps* CppStructOps = StructProperty->Struct->GetCppStructOps();
+		if (CppStructOps && CppStructOps->HasExportTextItem() && StructProperty->Struct != FJsonObjectWrapper::StaticStruct())
+		{
+			OutValue.Kind = ERapidJsonValueKind::Other;
+		}
+		else
+		{
+			OutValue.Kind = ERapidJsonValueKind::Struct;
+			OutValue.StructSchema = Get(StructProperty->Struct);
+		}
+	}
+	else if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Array;
+		BuildValue(ArrayProperty->Inner, OutValue.Inner.AddDefaulted_GetRef());
+	}
+	else if (const FSetProperty* SetProperty = CastField<FSetProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Set;
+		BuildValue(SetProperty->ElementProp, OutValue.Inner.AddDefaulted_GetRef());
+	}
+	else if (const FMapProperty* MapProperty = CastField<FMapProperty>(InProperty))
+	{
+		OutValue.Kind = ERapidJsonValueKind::Map;
+		BuildValue(MapProperty->KeyProp, OutValue.Inner.AddDefaulted_GetRef());
+		BuildValue(MapProperty->ValueProp, OutValue.Inner.AddDefaulted_GetRef());
+	}
+	else
+	{
+		OutValue.Kind = ERapidJsonValueKind::Other;
+	}
+
+	// 预先编码所有枚举名
+	if (OutValue.Enum)
+	{
+		const int32 NumEnums = OutValue.Enum->NumEnums();
+		OutValue.EnumValues.Reserve(NumEnums);
+		OutValue.EncodedEnumNames.Reserve(NumEnums);
+		for (int32 EnumIndex = 0; EnumIndex < NumEnums; ++EnumIndex)
+		{
+			const FString EnumName = OutValue.Enum->GetNameStringByIndex(EnumIndex);
+			OutValue.EnumValues.Add(OutValue.Enum->GetValueByIndex(EnumIndex));
+			AppendEncodedString(OutValue.EncodedEnumNames.AddDefaulted_GetRef(), *EnumName, EnumName.Len());
+		}
+	}
+}
+
+void FRapidJsonStructSchema::AppendEncodedString(TArray<uint8>& OutBytes, const TCHAR* InString, int32 InLength)
+{
+	static const uint8 HexDigits[] = "0123456789abcdef";
+
+	OutBytes.Add('"');
+
+	for (int32 Pos = 0; Pos < InLength; ++Pos)
+	{
+		uint32 CodePoint = static_cast<uint32>(InString[Pos]);
+
+		switch (CodePoint)
+		{
+		case '"': OutBytes.Add('\\'); OutBytes.Add('"'); continue;
+		case '\\': OutBytes.Add('\\'); OutBytes.Add('\\'); continue;
+		case '\n': OutBytes.Add('\\'); OutBytes.Add('n'); continue;
+		case '\r': OutBytes.Add('\\'); OutBytes.Add('r'); continue;
+		case '\t': OutBytes.Add('\\'); OutBytes.Add('t'); continue;
+		case '\b': OutBytes.Add('\\'); OutBytes.Add('b'); continue;
+		case '\f': OutBytes.Add('\\'); OutBytes.Add('f'); continue;
+		default: break;
+		}
+
+		if (CodePoint < 0x20)
+		{
+			const uint8 Escaped[] = { '\\', 'u', '0', '0', HexDigits[CodePoint >> 4], HexDigits[CodePoint & 0xF] };
+			OutBytes.Append(Escaped, UE_ARRAY_COUNT(Escaped));
+			continue;
+		}
+
+		// UTF-16的代理对
+		if (CodePoint >= 0xD800 && CodePoint <= 0xDBFF && Pos + 1 < InLength)
+		{
+			const uint32 LowSurrogate = static_cast<uint32>(InString[Pos + 1]);
+			if (LowSurrogate >= 0xDC00 && LowSurrogate <= 0xDFFF)
+			{
+				CodePoint = 0x10000 + ((CodePoint - 0xD800) << 10) + (LowSurrogate - 0xDC00);
+				++Pos;
+			}
+		}
+
+		if (CodePoint < 0x80)
+		{
+			OutBytes.Add(static_cast<uint8>(CodePoint));
+		}
+		else if (CodePoint < 0x800)
+		{
+			OutBytes.Add(static_cast<uint8>(0xC0 | (CodePoint >> 6)));
+			OutBytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else if (CodePoint < 0x10000)
+		{
+			OutBytes.Add(static_cast<uint8>(0xE0 | (CodePoint >> 12)));
+			OutBytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			OutBytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+		else
+		{
+			OutBytes.Add(static_cast<uint8>(0xF0 | (CodePoint >> 18)));
+			OutBytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 12) & 0x3F)));
+			OutBytes.Add(static_cast<uint8>(0x80 | ((CodePoint >> 6) & 0x3F)));
+			OutBytes.Add(static_cast<uint8>(0x80 | (CodePoint & 0x3F)));
+		}
+	}
+
+	OutBytes.Add('"');
+}
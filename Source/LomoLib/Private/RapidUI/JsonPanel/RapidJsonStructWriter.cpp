@@ -0,0 +1,417 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/JsonPanel/RapidJsonStructWriter.h"
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+
+namespace RapidJsonStructWriterPrivate
+{
+	int64 ReadEnumValue(const FRapidJsonPlanStep& InStep, const uint8* InValuePtr)
+	{
+		switch (InStep.Size)
+		{
+		case 1: return InStep.bSigned ? *reinterpret_cast<const int8*>(InValuePtr) : *InValuePtr;
+		case 2: return InStep.bSigned ? *reinterpret_cast<const int16*>(InValuePtr) : *reinterpret_cast<const uint16*>(InValuePtr);
+		case 4: return InStep.bSigned ? *reinterpret_cast<const int32*>(InValuePtr) : *reinterpret_cast<const uint32*>(InValuePtr);
+		default: return *reinterpret_cast<const int64*>(InValuePtr);
+		}
+	}
+}
+
+FRapidJsonStructWriter::FRapidJsonStructWriter(TArray<uint8>& InBuffer, bool bInPrettyPrint)
+	: Buffer(InBuffer)
+	, bPrettyPrint(bInPrettyPrint)
+{
+}
+
+void FRapidJsonStructWriter::Write(const UScriptStruct* InStruct, const void* InStructMemory, TArray<uint8>& OutBuffer, bool bPrettyPrint)
+{
+	FRapidJsonStructWriter Writer(OutBuffer, bPrettyPrint);
+	Writer.WriteStruct(*FRapidJsonStructSchema::Get(InStruct), InStructMemory);
+}
+
+void FRapidJsonStructWriter::WriteStruct(const FRapidJsonStructSchema& InSchema, const void* InStructMemory)
+{
+	const TArray<FRapidJsonFieldSchema>& Fields = InSchema.GetFields();
+	const uint8* StructMemory = static_cast<const uint8*>(InStructMemory);
+
+	BeginContainer('{');
+	for (int32 FieldIndex = 0; FieldIndex < Fields.Num(); ++FieldIndex)
+	{
+		const FRapidJsonFieldSchema& Field = Fields[FieldIndex];
+		WriteSeparator(FieldIndex == 0);
+		WriteKey(Field.EncodedKey);
+
+		if (Field.ArrayDim == 1)
+		{
+			WriteValue(Field.Value, StructMemory + Field.Offset);
+			continue;
+		}
+
+		// 静态数组写为Json数组
+		BeginContainer('[');
+		for (int32 ElementIndex = 0; ElementIndex < Field.ArrayDim; ++ElementIndex)
+		{
+			WriteSeparator(ElementIndex == 0);
+			WriteValue(Field.Value, StructMemory + Field.Offset + ElementIndex * Field.ElementSize);
+		}
+		EndContainer(']', false);
+	}
+	EndContainer('}', Fields.Num() == 0);
+}
+
+void FRapidJsonStructWriter::WriteValue(const FRapidJsonValueSchema& InValue, const void* InValuePtr)
+{
+	switch (InValue.Kind)
+	{
+	case ERapidJsonValueKind::Bool:
+		if (static_cast<const FBoolProperty*>(InValue.Property)->GetPropertyValue(InValuePtr))
+		{
+			WriteLiteral("true", 4);
+		}
+		else
+		{
+			WriteLiteral("false", 5);
+		}
+		break;
+
+	case ERapidJsonValueKind::SignedInteger:
+		AppendSignedInteger(Buffer, InValue.NumericProperty->GetSignedIntPropertyValue(InValuePtr));
+		break;
+
+	case ERapidJsonValueKind::UnsignedInteger:
+		AppendUnsignedInteger(Buffer, InValue.NumericProperty->GetUnsignedIntPropertyValue(InValuePtr));
+		break;
+
+	case ERapidJsonValueKind::Float:
+		AppendFloat(Buffer, InValue.NumericProperty->GetFloatingPointPropertyValue(InValuePtr), InValue.Property->IsA<FFloatProperty>());
+		break;
+
+	case ERapidJsonValueKind::Enum:
+		{
+			const int64 EnumValue = InValue.NumericProperty->GetSignedIntPropertyValue(InValuePtr);
+			if (const TArray<uint8>* EncodedName = InValue.FindEncodedEnumName(EnumValue))
+			{
+				Buffer.Append(*EncodedName);
+			}
+			else
+			{
+				AppendSignedInteger(Buffer, EnumValue);
+			}
+		}
+		break;
+
+	case ERapidJsonValueKind::String:
+		WriteString(*static_cast<const FString*>(InValuePtr));
+		break;
+
+	case ERapidJsonValueKind::Name:
+		{
+			TStringBuilder<FName::StringBufferSize> NameString;
+			static_cast<const FName*>(InValuePtr)->AppendString(NameString);
+			FRapidJsonStructSchema::AppendEncodedString(Buffer, NameString.GetData(), NameString.Len());
+		}
+		break;
+
+	case ERapidJsonValueKind::Text:
+		WriteString(static_cast<const FText*>(InValuePtr)->ToString());
+		break;
+
+	case ERapidJsonValueKind::Struct:
+		WriteStruct(*InValue.StructSchema, InValuePtr);
+		break;
+
+	case ERapidJsonValueKind::Array:
+		{
+			FScriptArrayHelper ArrayHelper(static_cast<const FArrayProperty*>(InValue.Property), InValuePtr);
+			const int32 Num = ArrayHelper.Num();
+
+			BeginContainer('[');
+			for (int32 Index = 0; Index < Num; ++Index)
+			{
+				WriteSeparator(Index == 0);
+				WriteValue(InValue.Inner[0], ArrayHelper.GetRawPtr(Index));
+			}
+			EndContainer(']', Num == 0);
+		}
+		break;
+
+	case ERapidJsonValueKind::Set:
+		{
+			FScriptSetHelper SetHelper(static_cast<const FSetProperty*>(InValue.Property), InValuePtr);
+			int32 Remaining = SetHelper.Num();
+			const bool bEmpty = Remaining == 0;
+
+			BeginContainer('[');
+			for (int32 Index = 0; Remaining > 0; ++Index)
+			{
+				if (SetHelper.IsValidIndex(Index))
+				{
+					WriteSeparator(Remaining == SetHelper.Num());
+					WriteValue(InValue.Inner[0], SetHelper.GetElementPtr(Index));
+					--Remaining;
+				}
+			}
+			EndContainer(']', bEmpty);
+		}
+		break;
+
+	case ERapidJsonValueKind::Map:
+		{
+			FScriptMapHelper MapHelper(static_cast<const FMapProperty*>(InValue.Property), InValuePtr);
+			int32 Remaining = MapHelper.Num();
+			const bool bEmpty = Remaining == 0;
+
+			BeginContainer('{');
+			for (int32 Index = 0; Remaining > 0; ++Index)
+			{
+				if (MapHelper.IsValidIndex(Index))
+				{
+					WriteSeparator(Remaining == MapHelper.Num());
+					WriteMapKey(InValue.Inner[0], MapHelper.GetKeyPtr(Index));
+					WriteLiteral(bPrettyPrint ? ": " : ":", bPrettyPrint ? 2 : 1);
+					WriteValue(InValue.Inner[1], MapHelper.GetValuePtr(Index));
+					--Remaining;
+				}
+			}
+			EndContainer('}', bEmpty);
+		}
+		break;
+
+	case ERapidJsonValueKind::Other:
+	default:
+		WriteExportedText(InValue.Property, InValuePtr);
+		break;
+	}
+}
+
+void FRapidJsonStructWriter::WritePlan(const FRapidJsonStructPlan& InPlan, const void* InStructMemory)
+{
+	// 计划只生成紧凑格式
+	if (bPrettyPrint)
+	{
+		WriteStruct(InPlan.GetSchema(), InStructMemory);
+		return;
+	}
+
+	WritePlanBlock(InPlan, FRapidJsonStructPlan::RootBlock, static_cast<const uint8*>(InStructMemory));
+}
+
+void FRapidJsonStructWriter::WritePlanBlock(const FRapidJsonStructPlan& InPlan, int32 InBlockIndex, const uint8* InBaseMemory)
+{
+	const uint8* Literals = InPlan.GetLiterals().GetData();
+	const FRapidJsonPlanBlock& Block = InPlan.GetBlocks()[InBlockIndex];
+	const FRapidJsonPlanStep* Step = InPlan.GetSteps().GetData() + Block.FirstStep;
+	const FRapidJsonPlanStep* EndStep = Step + Block.NumSteps;
+
+	for (; Step != EndStep; ++Step)
+	{
+		Buffer.Append(Literals + Step->PrefixStart, Step->PrefixLength);
+		const uint8* ValuePtr = InBaseMemory + Step->Offset;
+
+		switch (Step->Op)
+		{
+		case ERapidJsonPlanOp::Bool:
+			if ((*ValuePtr & Step->FieldMask) != 0)
+			{
+				WriteLiteral("true", 4);
+			}
+			else
+			{
+				WriteLiteral("false", 5);
+			}
+			break;
+
+		case ERapidJsonPlanOp::Int8: AppendSignedInteger(Buffer, *reinterpret_cast<const int8*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::Int16: AppendSignedInteger(Buffer, *reinterpret_cast<const int16*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::Int32: AppendSignedInteger(Buffer, *reinterpret_cast<const int32*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::Int64: AppendSignedInteger(Buffer, *reinterpret_cast<const int64*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::UInt8: AppendUnsignedInteger(Buffer, *ValuePtr); break;
+		case ERapidJsonPlanOp::UInt16: AppendUnsignedInteger(Buffer, *reinterpret_cast<const uint16*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::UInt32: AppendUnsignedInteger(Buffer, *reinterpret_cast<const uint32*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::UInt64: AppendUnsignedInteger(Buffer, *reinterpret_cast<const uint64*>(ValuePtr)); break;
+		case ERapidJsonPlanOp::Float: AppendFloat(Buffer, *reinterpret_cast<const float*>(ValuePtr), true); break;
+		case ERapidJsonPlanOp::Double: AppendFloat(Buffer, *reinterpret_cast<const double*>(ValuePtr), false); break;
+
+		case ERapidJsonPlanOp::Enum:
+			{
+				const int64 EnumValue = RapidJsonStructWriterPrivate::ReadEnumValue(*Step, ValuePtr);
+				if (const TArray<uint8>* EncodedName = Step->Value->FindEncodedEnumName(EnumValue))
+				{
+					Buffer.Append(*EncodedName);
+				}
+				else
+				{
+					AppendSignedInteger(Buffer, EnumValue);
+				}
+			}
+			break;
+
+		case ERapidJsonPlanOp::String:
+			WriteString(*reinterpret_cast<const FString*>(ValuePtr));
+			break;
+
+		case ERapidJsonPlanOp::Name:
+			{
+				TStringBuilder<FName::StringBufferSize> NameString;
+				reinterpret_cast<const FName*>(ValuePtr)->AppendString(NameString);
+				FRapidJsonStructSchema::AppendEncodedString(Buffer, NameString.GetData(), NameString.Len());
+			}
+			break;
+
+		case ERapidJsonPlanOp::Array:
+			{
+				const FScriptArray& Array = *reinterpret_cast<const FScriptArray*>(ValuePtr);
+				const uint8* Elements = static_cast<const uint8*>(Array.GetData());
+				const int32 Num = Array.Num();
+
+				Buffer.Add('[');
+				for (int32 Index = 0; Index < Num; ++Index)
+				{
+					if (Index > 0)
+					{
+						Buffer.Add(',');
+					}
+					WritePlanBlock(InPlan, Step->SubBlock, Elements + Index * Step->ElementSize);
+				}
+				Buffer.Add(']');
+			}
+			break;
+
+		case ERapidJsonPlanOp::Generic:
+		default:
+			WriteValue(*Step->Value, ValuePtr);
+			break;
+		}
+	}
+
+	Buffer.Append(Literals + Block.SuffixStart, Block.SuffixLength);
+}
+
+void FRapidJsonStructWriter::WriteMapKey(const FRapidJsonValueSchema& InKey, const void* InKeyPtr)
+{
+	switch (InKey.Kind)
+	{
+	case ERapidJsonValueKind::String:
+	case ERapidJsonValueKind::Name:
+	case ERapidJsonValueKind::Text:
+		WriteValue(InKey, InKeyPtr);
+		break;
+
+	default:
+		WriteExportedText(InKey.Property, InKeyPtr);
+		break;
+	}
+}
+
+void FRapidJsonStructWriter::AppendSignedInteger(TArray<uint8>& OutBuffer, int64 InValue)
+{
+	if (InValue < 0)
+	{
+		OutBuffer.Add('-');
+		// 避免对最小值取负时溢出
+		AppendUnsignedInteger(OutBuffer, static_cast<uint64>(-(InValue + 1)) + 1);
+	}
+	else
+	{
+		AppendUnsignedInteger(OutBuffer, static_cast<uint64>(InValue));
+	}
+}
+
+void FRapidJsonStructWriter::AppendUnsignedInteger(TArray<uint8>& OutBuffer, uint64 InValue)
+{
+	uint8 Digits[20];
+	int32 NumDigits = 0;
+	do
+	{
+		Digits[NumDigits++] = static_cast<uint8>('0' + InValue % 10);
+		InValue /= 10;
+	}
+	while (InValue != 0);
+
+	while (NumDigits > 0)
+	{
+		OutBuffer.Add(Digits[--NumDigits]);
+	}
+}
+
+void FRapidJsonStructWriter::AppendFloat(TArray<uint8>& OutBuffer, double InValue, bool bSinglePrecision)
+{
+	// Json不支持NaN和无穷大
+	if (!FMath::IsFinite(InValue))
+	{
+		OutBuffer.Append(reinterpret_cast<const uint8*>("null"), 4);
+		return;
+	}
+
+	// 先用较短的精度，无法还原原值时再使用完整精度
+	ANSICHAR Digits[32];
+	int32 Length = 0;
+	if (bSinglePrecision)
+	{
+		Length = FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%.7g", InValue);
+		if (static_cast<float>(FCStringAnsi::Atod(Digits)) != static_cast<float>(InValue))
+		{
+			Length = FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%.9g", InValue);
+		}
+	}
+	else
+	{
+		Length = FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%.15g", InValue);
+		if (FCStringAnsi::Atod(Digits) != InValue)
+		{
+			Length = FCStringAnsi::Snprintf(Digits, sizeof(Digits), "%.17g", InValue);
+		}
+	}
+
+	OutBuffer.Append(reinterpret_cast<const uint8*>(Digits), Length);
+}
+
+void FRapidJsonStructWriter::WriteExportedText(const FProperty* InProperty, const void* InValuePtr)
+{
+	ScratchText.Reset();
+	InProperty->ExportText_Direct(ScratchText, InValuePtr, InValuePtr, nullptr, PPF_None);
+	WriteString(ScratchText);
+}
+
+void FRapidJsonStructWriter::BeginContainer(uint8 InOpen)
+{
+	Buffer.Add(InOpen);
+	++IndentLevel;
+}
+
+void FRapidJsonStructWriter::EndContainer(uint8 InClose, bool bEmpty)
+{
+	--IndentLevel;
+	if (bPrettyPrint && !bEmpty)
+	{
+		Buffer.Add('\n');
+		for (int32 Indent = 0; Indent < IndentLevel; ++Indent)
+		{
+			Buffer.Add('\t');
+		}
+	}
+	Buffer.Add(InClose);
+}
+
+void FRapidJsonStructWriter::WriteSeparator(bool bFirst)
+{
+	if (!bFirst)
+	{
+		Buffer.Add(',');
+	}
+
+	if (bPrettyPrint)
+	{
+		Buffer.Add('\n');
+		for (int32 Indent = 0; Indent < IndentLevel; ++Indent)
+		{
+			Buffer.Add('\t');
+		}
+	}
+}
+
+void FRapidJsonStructWriter::WriteKey(const TArray<uint8>& InEncodedKey)
+{
+	Buffer.Append(InEncodedKey);
+	WriteLiteral(bPrettyPrint ? ": " : ":", bPrettyPrint ? 2 : 1);
+}
@@ -0,0 +1,192 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidEnumPropertyWidget.h"
+#include "Components/ComboBoxString.h"
+#include "Components/TextBlock.h"
+#include "UObject/EnumProperty.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+TSharedRef<const FRapidEnumOptions> FRapidEnumOptions::Get(const UEnum* InEnum)
+{
+    static TMap<TObjectKey<UEnum>, TSharedRef<const FRapidEnumOptions>> CachedOptions;
+
+    check(IsInGameThread());
+
+    if (const TSharedRef<const FRapidEnumOptions>* Options = CachedOptions.Find(InEnum))
+    {
+        return *Options;
+    }
+
+    TSharedRef<FRapidEnumOptions> NewOptions = MakeShared<FRapidEnumOptions>();
+    if (InEnum)
+    {
+        // 自动生成的_MAX不可选
+        const int32 NumEnums = InEnum->ContainsExistingMax() ? InEnum->NumEnums() - 1 : InEnum->NumEnums();
+        NewOptions->DisplayNames.Reserve(NumEnums);
+        NewOptions->Values.Reserve(NumEnums);
+
+        for (int32 Index = 0; Index < NumEnums; ++Index)
+        {
+            if (InEnum->HasMetaData(TEXT("Hidden"), Index))
+            {
+                continue;
+            }
+
+            NewOptions->DisplayNames.Add(InEnum->GetDisplayNameTextByIndex(Index).ToString());
+            NewOptions->Values.Add(InEnum->GetValueByIndex(Index));
+        }
+
+        // 用户定义枚举可以在编辑器中修改，不缓存
+        if (!InEnum->GetPackage()->HasAnyPackageFlags(PKG_CompiledIn))
+        {
+            return NewOptions;
+        }
+    }
+
+    CachedOptions.Add(InEnum, NewOptions);
+    return NewOptions;
+}
+
+URapidEnumPropertyWidget::URapidEnumPropertyWidget(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+    , CurrentValue(0)
+{
+}
+
+bool URapidEnumPropertyWidget::SupportsProperty(const FProperty* InProperty)
+{
+    if (InProperty && InProperty->IsA<FEnumProperty>())
+    {
+        return true;
+    }
+
+    const FByteProperty* ByteProperty = CastField<FByteProperty>(InProperty);
+    return ByteProperty && ByteProperty->Enum;
+}
+
+bool URapidEnumPropertyWidget::InitializePropertyWidget(UObject* InObject, FProperty* InProperty, const FName& InPropertyName)
+{
+    // 先确定底层属性和选项，父类初始化时会调用UpdateValue
+    UnderlyingProperty = nullptr;
+    EnumOptions.Reset();
+
+    if (FEnumProperty* EnumProperty = CastField<FEnumProperty>(InProperty))
+    {
+        UnderlyingProperty = EnumProperty->GetUnderlyingProperty();
+        EnumOptions = FRapidEnumOptions::Get(EnumProperty->GetEnum());
+    }
+    else if (FByteProperty* ByteProperty = CastField<FByteProperty>(InProperty))
+    {
+        if (ByteProperty->Enum)
+        {
+            UnderlyingProperty = ByteProperty;
+            EnumOptions = FRapidEnumOptions::Get(ByteProperty->Enum);
+        }
+    }
+
+    if (!UnderlyingProperty || !EnumOptions)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RapidEnumPropertyWidget初始化失败: 属性类型不是枚举"));
+        return false;
+    }
+
+    // 填充选项，名称列表来自按UEnum缓存的结果
+    ValueComboBox->ClearOptions();
+    for (const FString& DisplayName : EnumOptions->DisplayNames)
+    {
+        ValueComboBox->AddOption(DisplayName);
+    }
+
+    // 调用父类的初始化方法
+    if (!Super::InitializePropertyWidget(InObject, InProperty, InPropertyName))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RapidEnumPropertyWidget初始化失败: 父类初始化返回false"));
+        return false;
+    }
+
+    // 设置属性名称文本
+    PropertyNameText->SetText(PropertyDisplayName);
+
+    // 绑定选择事件
+    ValueComboBox->OnSelectionChanged.AddUniqueDynamic(this, &URapidEnumPropertyWidget::HandleSelectionChanged);
+
+    // 更新初始值
+    UpdateValue();
+    return true;
+}
+
+void URapidEnumPropertyWidget::UpdateValue_Implementation()
+{
+    // 获取属性值
+    void* ValuePtr = GetValuePtr();
+    if (UnderlyingProperty && EnumOptions && ValuePtr)
+    {
+        CurrentValue = UnderlyingProperty->GetSignedIntPropertyValue(ValuePtr);
+
+        // 多个对象的值不同或值不在选项中时不选中任何项
+        const int32 OptionIndex = EnumOptions->IndexOfValue(CurrentValue);
+        if (UpdateMultipleValues() || OptionIndex == INDEX_NONE)
+        {
+            ValueComboBox->ClearSelection();
+        }
+        else if (ValueComboBox->GetSelectedIndex() != OptionIndex)
+        {
+            ValueComboBox->SetSelectedIndex(OptionIndex);
+        }
+        PropertyNameText->SetText(PropertyDisplayName);
+    }
+}
+
+bool URapidEnumPropertyWidget::SetValue(int64 InValue)
+{
+    if (!IsPropertyBound() || !UnderlyingProperty)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置枚举属性值失败: 属性未绑定或对象已销毁"));
+        return false;
+    }
+
+    // 如果值没有变化，直接返回；多个对象的值不同时仍需写入以统一所有对象
+    if (!bHasMultipleValues && CurrentValue == InValue)
+    {
+        return false;
+    }
+
+    // 按属性路径解析值地址，容器元素可能已经失效
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置枚举属性值失败: 无法解析属性地址 %s"), *PropertyPath.ToString());
+        return false;
+    }
+
+    // 保存修改前的值用于撤销
+    BeginPropertyValueChange();
+
+    UnderlyingProperty->SetIntPropertyValue(ValuePtr, InValue);
+    CurrentValue = InValue;
+
+    // 通知属性值已更改
+    NotifyPropertyValueChanged();
+    return true;
+}
+
+int64 URapidEnumPropertyWidget::GetValue() const
+{
+    return CurrentValue;
+}
+
+void URapidEnumPropertyWidget::HandleSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType)
+{
+    // 代码设置的选择不需要写回属性
+    if (SelectionType == ESelectInfo::Direct || !EnumOptions)
+    {
+        return;
+    }
+
+    const int32 OptionIndex = ValueComboBox->GetSelectedIndex();
+    if (EnumOptions->Values.IsValidIndex(OptionIndex))
+    {
+        SetValue(EnumOptions->Values[OptionIndex]);
+    }
+}
@@ -59,6 +59,8 @@ bool URapidFloatPropertyWidget::InitializePropertyWidget(UObject* InObject, FPro
     
     // 绑定SpinBox事件
     ValueSpinBox->OnValueChanged.AddDynamic(this, &URapidFloatPropertyWidget::HandleValueChanged);
+    ValueSpinBox->OnBeginSliderMovement.AddUniqueDynamic(this, &URapidFloatPropertyWidget::HandleBeginSliderMovement);
+    ValueSpinBox->OnEndSliderMovement.AddUniqueDynamic(this, &URapidFloatPropertyWidget::HandleEndSliderMovement);
     
     // 设置SpinBox属性
     SetupSpinBoxFromProperty();
@@ -70,57 +72,66 @@ bool URapidFloatPropertyWidget::InitializePropertyWidget(UObject* InObject, FPro
 
 void URapidFloatPropertyWidget::UpdateValue_Implementation()
 {
-    SafeExecute([&]() {
-        // 获取属性值
-        FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property);
-        if (FloatProperty && TargetObject)
-        {
-            CurrentValue = FloatProperty->GetPropertyValue_InContainer(TargetObject);
-            ValueSpinBox->SetValue(CurrentValue);
-            PropertyNameText->SetText(PropertyDisplayName);
-        }
-    }, TEXT("更新Float属性值失败"));
+    // 获取属性值
+    FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property);
+    void* ValuePtr = GetValuePtr();
+    if (FloatProperty && ValuePtr)
+    {
+        CurrentValue = FloatProperty->GetPropertyValue(ValuePtr);
+        ValueSpinBox->SetValue(CurrentValue);
+        UpdateMultipleValues();
+        PropertyNameText->SetText(PropertyDisplayName);
+    }
 }
 
 bool URapidFloatPropertyWidget::SetValue(float InValue)
 {
-    return SafeExecuteWithRet([&]() -> bool {
-        if (!TargetObject || !Property)
-        {
-            UE_LOG(LogTemp, Error, TEXT("设置Float属性值失败: 对象或属性为空"));
-            return false;
-        }
-        
-        FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property);
-        if (!FloatProperty)
-        {
-            UE_LOG(LogTemp, Error, TEXT("设置Float属性值失败: 属性类型不是Float"));
-            return false;
-        }
-        
-        // 如果值没有变化，直接返回
-        if (FMath::IsNearlyEqual(CurrentValue, InValue))
-        {
-            return false;
-        }
-        
-        // 安全地设置属性值
-        FloatProperty->SetPropertyValue_InContainer(TargetObject, InValue);
-        CurrentValue = InValue;
-        
-        // 只更新当值不同时
-        if (!FMath::IsNearlyEqual(ValueSpinBox->GetValue(), InValue))
-        {
-            ValueSpinBox->SetValue(InValue);
-        }
-        
-        // 确保属性名称文本正确显示
-        PropertyNameText->SetText(PropertyDisplayName);
-        
-        // 通知属性值已更改
-        NotifyPropertyValueChanged();
-        return true;
-    }, TEXT("设置Float属性值失败"));
+    if (!IsPropertyBound())
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Float属性值失败: 属性未绑定或对象已销毁"));
+        return false;
+    }
+    
+    FFloatProperty* FloatProperty = CastField<FFloatProperty>(Property);
+    if (!FloatProperty)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Float属性值失败: 属性类型不是Float"));
+        return false;
+    }
+    
+    // 如果值没有变化，直接返回；多个对象的值不同时仍需写入以统一所有对象
+    if (!bHasMultipleValues && FMath::IsNearlyEqual(CurrentValue, InValue))
+    {
+        return false;
+    }
+    
+    // 按属性路径解析值地址，容器元素可能已经失效
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Float属性值失败: 无法解析属性地址 %s"), *PropertyPath.ToString());
+        return false;
+    }
+    
+    // 保存修改前的值用于撤销
+    BeginPropertyValueChange();
+
+    // 安全地设置属性值
+    FloatProperty->SetPropertyValue(ValuePtr, InValue);
+    CurrentValue = InValue;
+    
+    // 只更新当值不同时
+    if (!FMath::IsNearlyEqual(ValueSpinBox->GetValue(), InValue))
+    {
+        ValueSpinBox->SetValue(InValue);
+    }
+    
+    // 确保属性名称文本正确显示
+    PropertyNameText->SetText(PropertyDisplayName);
+    
+    // 通知属性值已更改
+    NotifyPropertyValueChanged();
+    return true;
 }
 
 float URapidFloatPropertyWidget::GetValue() const
@@ -130,10 +141,18 @@ float URapidFloatPropertyWidget::GetValue() const
 
 void URapidFloatPropertyWidget::HandleValueChanged(float NewValue)
 {
-    SafeExecute([&, NewValue]() {
-        if (!FMath::IsNearlyEqual(CurrentValue, NewValue))
-        {
-            SetValue(NewValue);
-        }
-    }, TEXT("处理数值变化失败"));
-} 
\ No newline at end of file
+    if (!FMath::IsNearlyEqual(CurrentValue, NewValue))
+    {
+        SetValue(NewValue);
+    }
+}
+
+void URapidFloatPropertyWidget::HandleBeginSliderMovement()
+{
+    BeginContinuousPropertyEdit();
+}
+
+void URapidFloatPropertyWidget::HandleEndSliderMovement(float NewValue)
+{
+    EndContinuousPropertyEdit();
+}
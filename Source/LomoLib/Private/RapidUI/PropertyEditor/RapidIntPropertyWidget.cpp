@@ -59,6 +59,8 @@ bool URapidIntPropertyWidget::InitializePropertyWidget(UObject* InObject, FPrope
     
     // 绑定SpinBox事件
     ValueSpinBox->OnValueChanged.AddDynamic(this, &URapidIntPropertyWidget::HandleValueChanged);
+    ValueSpinBox->OnBeginSliderMovement.AddUniqueDynamic(this, &URapidIntPropertyWidget::HandleBeginSliderMovement);
+    ValueSpinBox->OnEndSliderMovement.AddUniqueDynamic(this, &URapidIntPropertyWidget::HandleEndSliderMovement);
     
     // 设置SpinBox属性
     SetupSpinBoxFromProperty();
@@ -70,57 +72,66 @@ bool URapidIntPropertyWidget::InitializePropertyWidget(UObject* InObject, FPrope
 
 void URapidIntPropertyWidget::UpdateValue_Implementation()
 {
-    SafeExecute([&]() {
-        // 获取属性值
-        FIntProperty* IntProperty = CastField<FIntProperty>(Property);
-        if (IntProperty && TargetObject)
-        {
-            CurrentValue = IntProperty->GetPropertyValue_InContainer(TargetObject);
-            ValueSpinBox->SetValue(CurrentValue);
-            PropertyNameText->SetText(PropertyDisplayName);
-        }
-    }, TEXT("更新Int属性值失败"));
+    // 获取属性值
+    FIntProperty* IntProperty = CastField<FIntProperty>(Property);
+    void* ValuePtr = GetValuePtr();
+    if (IntProperty && ValuePtr)
+    {
+        CurrentValue = IntProperty->GetPropertyValue(ValuePtr);
+        ValueSpinBox->SetValue(CurrentValue);
+        UpdateMultipleValues();
+        PropertyNameText->SetText(PropertyDisplayName);
+    }
 }
 
 bool URapidIntPropertyWidget::SetValue(int32 InValue)
 {
-    return SafeExecuteWithRet([&]() -> bool {
-        if (!TargetObject || !Property)
-        {
-            UE_LOG(LogTemp, Error, TEXT("设置Int属性值失败: 对象或属性为空"));
-            return false;
-        }
-        
-        FIntProperty* IntProperty = CastField<FIntProperty>(Property);
-        if (!IntProperty)
-        {
-            UE_LOG(LogTemp, Error, TEXT("设置Int属性值失败: 属性类型不是Int"));
-            return false;
-        }
-        
-        // 如果值没有变化，直接返回
-        if (CurrentValue == InValue)
-        {
-            return false;
-        }
-        
-        // 安全地设置属性值
-        IntProperty->SetPropertyValue_InContainer(TargetObject, InValue);
-        CurrentValue = InValue;
-        
-        // 只更新当值不同时
-        if (FMath::RoundToInt(ValueSpinBox->GetValue()) != InValue)
-        {
-            ValueSpinBox->SetValue(InValue);
-        }
-        
-        // 确保属性名称文本正确显示
-        PropertyNameText->SetText(PropertyDisplayName);
-        
-        // 通知属性值已更改
-        NotifyPropertyValueChanged();
-        return true;
-    }, TEXT("设置Int属性值失败"));
+    if (!IsPropertyBound())
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Int属性值失败: 属性未绑定或对象已销毁"));
+        return false;
+    }
+    
+    FIntProperty* IntProperty = CastField<FIntProperty>(Property);
+    if (!IntProperty)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Int属性值失败: 属性类型不是Int"));
+        return false;
+    }
+    
+    // 如果值没有变化，直接返回；多个对象的值不同时仍需写入以统一所有对象
+    if (!bHasMultipleValues && CurrentValue == InValue)
+    {
+        return false;
+    }
+    
+    // 按属性路径解析值地址，容器元素可能已经失效
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置Int属性值失败: 无法解析属性地址 %s"), *PropertyPath.ToString());
+        return false;
+    }
+    
+    // 保存修改前的值用于撤销
+    BeginPropertyValueChange();
+
+    // 安全地设置属性值
+    IntProperty->SetPropertyValue(ValuePtr, InValue);
+    CurrentValue = InValue;
+    
+    // 只更新当值不同时
+    if (FMath::RoundToInt(ValueSpinBox->GetValue()) != InValue)
+    {
+        ValueSpinBox->SetValue(InValue);
+    }
+    
+    // 确保属性名称文本正确显示
+    PropertyNameText->SetText(PropertyDisplayName);
+    
+    // 通知属性值已更改
+    NotifyPropertyValueChanged();
+    return true;
 }
 
 int32 URapidIntPropertyWidget::GetValue() const
@@ -130,11 +141,19 @@ int32 URapidIntPropertyWidget::GetValue() const
 
 void URapidIntPropertyWidget::HandleValueChanged(float NewValue)
 {
-    SafeExecute([&, NewValue]() {
-        int32 NewIntValue = FMath::RoundToInt(NewValue);
-        if (CurrentValue != NewIntValue)
-        {
-            SetValue(NewIntValue);
-        }
-    }, TEXT("处理数值变化失败"));
-}
\ No newline at end of file
+    int32 NewIntValue = FMath::RoundToInt(NewValue);
+    if (CurrentValue != NewIntValue)
+    {
+        SetValue(NewIntValue);
+    }
+}
+
+void URapidIntPropertyWidget::HandleBeginSliderMovement()
+{
+    BeginContinuousPropertyEdit();
+}
+
+void URapidIntPropertyWidget::HandleEndSliderMovement(float NewValue)
+{
+    EndContinuousPropertyEdit();
+}
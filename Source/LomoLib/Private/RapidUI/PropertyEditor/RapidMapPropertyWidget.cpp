@@ -70,8 +70,23 @@ bool URapidMapPropertyWidget::InitializePropertyWidget(UObject* InObject, FPrope
         return false;
     }
 
-    // 创建元素控件
-    CreatePairWidgets();
+    // 元素控件延迟到首次展开时才创建
+    ReleaseElementWidgets();
+    if (ExpandableArea)
+    {
+        ExpandableArea->OnExpansionChanged.RemoveDynamic(this, &URapidMapPropertyWidget::HandleExpansionChanged);
+        ExpandableArea->OnExpansionChanged.AddDynamic(this, &URapidMapPropertyWidget::HandleExpansionChanged);
+        
+        if (ExpandableArea->GetIsExpanded())
+        {
+            CreatePairWidgets();
+        }
+    }
+    else
+    {
+        // 没有可展开区域时无法懒加载，直接创建
+        CreatePairWidgets();
+    }
     
     return true;
 }
@@ -85,8 +100,8 @@ void URapidMapPropertyWidget::SetElementWidgetClass(TSubclassOf<URapidMapElement
 {
     ElementWidgetClass = InElementWidgetClass;
     
-    // 如果已有数据，则重新创建元素控件
-    if (MapProperty && KeyProperty && ValueProperty && TargetObject)
+    // 如果已经创建过元素控件，则使用新的类重新创建
+    if (bChildrenCreated && MapProperty && KeyProperty && ValueProperty && TargetObject)
     {
         CreatePairWidgets();
     }
@@ -95,310 +110,468 @@ void URapidMapPropertyWidget::SetElementWidgetClass(TSubclassOf<URapidMapElement
 void URapidMapPropertyWidget::UpdateValue_Implementation()
 {
     // 刷新元素控件显示
+    UpdateEditability();
     UpdatePairWidgets();
 }
 
+bool URapidMapPropertyWidget::CanEditElements() const
+{
+    const URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>();
+    return !PropertyEditor || PropertyEditor->CanEditSparseContainers();
+}
+
+void URapidMapPropertyWidget::UpdateEditability()
+{
+    const bool bCanEdit = CanEditElements();
+    if (ContentVerticalBox)
+    {
+        ContentVerticalBox->SetIsEnabled(bCanEdit);
+    }
+    if (AddElementButton)
+    {
+        AddElementButton->SetIsEnabled(bCanEdit);
+    }
+}
+
 void URapidMapPropertyWidget::CreatePairWidgets()
 {
-    SafeExecute([&]() {
-        if (!MapProperty || !KeyProperty || !ValueProperty || !ContentVerticalBox || !TargetObject)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidgets失败: 缺少必要的属性或组件"));
-            return;
-        }
+    if (!MapProperty || !KeyProperty || !ValueProperty || !ContentVerticalBox || !TargetObject)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidgets失败: 缺少必要的属性或组件"));
+        return;
+    }
 
-        // 清除现有控件
-        ContentVerticalBox->ClearChildren();
-        ElementUWidgets.Empty();
+    // 清除现有控件
+    ContentVerticalBox->ClearChildren();
+    ElementUWidgets.Empty();
+    ElementSparseIndices.Empty();
 
-        // 获取映射地址
-        void* MapPtr = MapProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        
-        // 获取映射辅助类
-        FScriptMapHelper MapHelper(MapProperty, MapPtr);
+    // 获取映射地址
+    void* MapPtr = GetValuePtr();
+    if (!MapPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("无法解析映射地址: %s"), *PropertyPath.ToString());
+        return;
+    }
+    
+    // 获取映射辅助类
+    FScriptMapHelper MapHelper(MapProperty, MapPtr);
 
-        // 遍历映射元素创建控件
-        for (int32 Index = 0; Index < MapHelper.Num(); ++Index)
-        {
-            CreatePairWidget(Index);
-        }
-    }, TEXT("创建映射元素控件失败"));
+    // 遍历映射元素创建控件
+    for (int32 Index = 0; Index < MapHelper.Num(); ++Index)
+    {
+        CreatePairWidget(Index);
+    }
+    
+    bChildrenCreated = true;
 }
 
 void URapidMapPropertyWidget::CreatePairWidget(int32 PairIndex)
 {
-    SafeExecute([&, PairIndex]() {
-        if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject || !ContentVerticalBox)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 缺少必要的属性或组件"));
-            return;
-        }
+    if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject || !ContentVerticalBox)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 缺少必要的属性或组件"));
+        return;
+    }
 
-        // 获取映射地址
-        void* MapPtr = MapProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        
-        // 获取映射辅助类
-        FScriptMapHelper MapHelper(MapProperty, MapPtr);
+    // 获取映射地址
+    void* MapPtr = GetValuePtr();
+    if (!MapPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("无法解析映射地址: %s"), *PropertyPath.ToString());
+        return;
+    }
+    
+    // 获取映射辅助类
+    FScriptMapHelper MapHelper(MapProperty, MapPtr);
 
-        // 检查索引是否有效
-        if (PairIndex < 0 || PairIndex >= MapHelper.Num())
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 索引无效 %d"), PairIndex);
-            return;
-        }
+    // 检查索引是否有效
+    if (PairIndex < 0 || PairIndex >= MapHelper.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 索引无效 %d"), PairIndex);
+        return;
+    }
 
-        // 获取有效的对位索引
-        int32 RealIndex = 0;
-        int32 SparseIndex = -1;
-        for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+    // 获取有效的对位索引
+    int32 RealIndex = 0;
+    int32 SparseIndex = -1;
+    for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+    {
+        if (MapHelper.IsValidIndex(i))
         {
-            if (MapHelper.IsValidIndex(i))
+            if (RealIndex == PairIndex)
             {
-                if (RealIndex == PairIndex)
-                {
-                    SparseIndex = i;
-                    break;
-                }
-                RealIndex++;
+                SparseIndex = i;
+                break;
             }
+            RealIndex++;
         }
+    }
 
-        if (SparseIndex == -1)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法找到有效的稀疏索引"));
-            return;
-        }
+    if (SparseIndex == -1)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法找到有效的稀疏索引"));
+        return;
+    }
 
-        // 获取元素地址
-        uint8* PairData = MapHelper.GetPairPtr(SparseIndex);
-        uint8* KeyData = PairData;
-        uint8* ValueData = PairData + KeyProperty->GetSize();
+    // 获取元素地址
+    uint8* KeyData = MapHelper.GetKeyPtr(SparseIndex);
+    uint8* ValueData = MapHelper.GetValuePtr(SparseIndex);
 
-        // 获取属性编辑器
-        URapidPropertyEditor* PropertyEditor = Cast<URapidPropertyEditor>(GetTypedOuter<URapidPropertyEditor>());
-        if (!PropertyEditor)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 找不到父级属性编辑器"));
-            return;
-        }
+    // 获取属性编辑器
+    URapidPropertyEditor* PropertyEditor = Cast<URapidPropertyEditor>(GetTypedOuter<URapidPropertyEditor>());
+    if (!PropertyEditor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 找不到父级属性编辑器"));
+        return;
+    }
 
-        // 创建键控件
-        URapidPropertyWidget* KeyWidget = PropertyEditor->CreatePropertyWidgetForType(this, KeyProperty);
-        if (!KeyWidget)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建键属性控件"));
-            return;
-        }
+    // 创建键控件
+    URapidPropertyWidget* KeyWidget = PropertyEditor->CreatePropertyWidgetForType(this, KeyProperty);
+    if (!KeyWidget)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建键属性控件"));
+        return;
+    }
 
-        // 设置键控件属性名称
-        FName KeyPropertyName = *FString::Printf(TEXT("%s[%d].Key"), *PropertyName.ToString(), PairIndex);
-        
-        // 初始化键控件
-        if (!KeyWidget->InitializePropertyWidget(TargetObject, KeyProperty, KeyPropertyName))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法初始化键属性控件"));
-            return;
-        }
-        
-        // 设置键控件显示名称
-        KeyWidget->SetPropertyDisplayName(FText::FromString(TEXT("键")));
-        
-        // 绑定值变化事件
-        KeyWidget->OnPropertyValueChanged.AddDynamic(this, &URapidMapPropertyWidget::HandleChildPropertyValueChanged);
+    // 按稀疏下标生成键路径并初始化键控件
+    if (!KeyWidget->InitializePropertyWidgetAtPath(TargetObject, PropertyPath.GetElementPath(SparseIndex, KeyProperty)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法初始化键属性控件"));
+        return;
+    }
+    
+    // 设置键控件显示名称
+    KeyWidget->SetPropertyDisplayName(FText::FromString(TEXT("键")));
+    
+    // 绑定值变化事件
+    KeyWidget->OnPropertyPathChanged.AddUObject(this, &URapidMapPropertyWidget::HandleChildPropertyPathChanged);
 
-        // 创建值控件
-        URapidPropertyWidget* ValueWidget = PropertyEditor->CreatePropertyWidgetForType(this, ValueProperty);
-        if (!ValueWidget)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建值属性控件"));
-            return;
-        }
+    // 创建值控件
+    URapidPropertyWidget* ValueWidget = PropertyEditor->CreatePropertyWidgetForType(this, ValueProperty);
+    if (!ValueWidget)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建值属性控件"));
+        return;
+    }
 
-        // 设置值控件属性名称
-        FName ValuePropertyName = *FString::Printf(TEXT("%s[%d].Value"), *PropertyName.ToString(), PairIndex);
-        
-        // 初始化值控件
-        if (!ValueWidget->InitializePropertyWidget(TargetObject, ValueProperty, ValuePropertyName))
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法初始化值属性控件"));
-            return;
-        }
-        
-        // 设置值控件显示名称
-        ValueWidget->SetPropertyDisplayName(FText::FromString(TEXT("值")));
-        
-        // 绑定值变化事件
-        ValueWidget->OnPropertyValueChanged.AddDynamic(this, &URapidMapPropertyWidget::HandleChildPropertyValueChanged);
+    // 按稀疏下标生成值路径并初始化值控件
+    if (!ValueWidget->InitializePropertyWidgetAtPath(TargetObject, PropertyPath.GetElementPath(SparseIndex, ValueProperty)))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法初始化值属性控件"));
+        return;
+    }
+    
+    // 设置值控件显示名称
+    ValueWidget->SetPropertyDisplayName(FText::FromString(TEXT("值")));
+    
+    // 绑定值变化事件
+    ValueWidget->OnPropertyPathChanged.AddUObject(this, &URapidMapPropertyWidget::HandleChildPropertyPathChanged);
 
-        // 检查是否指定了元素小部件类
-        if (!ElementWidgetClass)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 未指定元素小部件类"));
-            return;
-        }
-        
-        // 创建自定义元素小部件
-        URapidMapElementWidget* ElementUWidget = CreateWidget<URapidMapElementWidget>(this, ElementWidgetClass);
-        if (!ElementUWidget)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建元素UI小部件"));
-            return;
-        }
-        
-        // 初始化元素小部件
-        ElementUWidget->InitializeElementWidget(TargetObject, KeyProperty, ValueProperty, KeyData, ValueData, PairIndex);
-                
-        // 设置键值属性控件
-        ElementUWidget->SetKeyPropertyWidget(KeyWidget);
-        ElementUWidget->SetValuePropertyWidget(ValueWidget);
-                
-        // 绑定删除事件
-        ElementUWidget->OnDeletePairClicked.AddDynamic(this, &URapidMapPropertyWidget::HandleElementDeleteClicked);
-                
-        // 添加到数组中
-        ElementUWidgets.Add(ElementUWidget);
+    // 检查是否指定了元素小部件类
+    if (!ElementWidgetClass)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 未指定元素小部件类"));
+        return;
+    }
+    
+    // 创建自定义元素小部件
+    URapidMapElementWidget* ElementUWidget = CreateWidget<URapidMapElementWidget>(this, ElementWidgetClass);
+    if (!ElementUWidget)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreatePairWidget失败: 无法创建元素UI小部件"));
+        return;
+    }
+    
+    // 初始化元素小部件
+    ElementUWidget->InitializeElementWidget(TargetObject, KeyProperty, ValueProperty, KeyData, ValueData, PairIndex);
             
-        // 添加到内容垂直框
-        ContentVerticalBox->AddChild(ElementUWidget);
-    }, TEXT("创建映射元素UI失败"));
+    // 设置键值属性控件
+    ElementUWidget->SetKeyPropertyWidget(KeyWidget);
+    ElementUWidget->SetValuePropertyWidget(ValueWidget);
+            
+    // 绑定删除事件
+    ElementUWidget->OnDeletePairClicked.AddDynamic(this, &URapidMapPropertyWidget::HandleElementDeleteClicked);
+            
+    // 添加到数组中
+    ElementUWidgets.Add(ElementUWidget);
+    ElementSparseIndices.Add(SparseIndex);
+        
+    // 添加到内容垂直框
+    ContentVerticalBox->AddChild(ElementUWidget);
 }
 
 void URapidMapPropertyWidget::UpdatePairWidgets()
 {
-    SafeExecute([&]() {
-        if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("UpdatePairWidgets失败: 缺少必要的属性"));
-            return;
-        }
-        
-        // 获取映射地址
-        void* MapPtr = MapProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        
-        // 检查映射元素数量是否发生变化
-        FScriptMapHelper MapHelper(MapProperty, MapPtr);
-        if (MapHelper.Num() != ElementUWidgets.Num())
-        {
-            // 映射大小改变，需要重新创建所有元素控件
-            CreatePairWidgets();
-            return;
-        }
-        
-        // 更新现有控件的值
-        for (int32 Index = 0; Index < ElementUWidgets.Num(); ++Index)
+    // 未展开过的控件没有元素控件，展开时会读取最新数据
+    if (!bChildrenCreated)
+    {
+        return;
+    }
+    
+    if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("UpdatePairWidgets失败: 缺少必要的属性"));
+        return;
+    }
+    
+    // 获取映射地址
+    void* MapPtr = GetValuePtr();
+    if (!MapPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("无法解析映射地址: %s"), *PropertyPath.ToString());
+        return;
+    }
+    
+    // 检查映射元素数量和稀疏下标是否发生变化
+    FScriptMapHelper MapHelper(MapProperty, MapPtr);
+    bool bLayoutChanged = MapHelper.Num() != ElementUWidgets.Num() || ElementSparseIndices.Num() != ElementUWidgets.Num();
+    for (int32 Index = 0; !bLayoutChanged && Index < ElementSparseIndices.Num(); ++Index)
+    {
+        bLayoutChanged = !MapHelper.IsValidIndex(ElementSparseIndices[Index]);
+    }
+    
+    if (bLayoutChanged)
+    {
+        // 映射大小或元素位置改变，需要重新创建所有元素控件
+        CreatePairWidgets();
+        return;
+    }
+    
+    // 更新现有控件的值
+    for (int32 Index = 0; Index < ElementUWidgets.Num(); ++Index)
+    {
+        if (ElementUWidgets[Index])
         {
-            if (ElementUWidgets[Index])
-            {
-                ElementUWidgets[Index]->UpdateValue();
-            }
+            ElementUWidgets[Index]->UpdateValue();
         }
-    }, TEXT("更新映射元素控件失败"));
+    }
 }
 
 void URapidMapPropertyWidget::HandleAddElementClicked()
 {
-    SafeExecute([&]() {
-        if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("添加映射元素失败: 缺少必要的属性"));
-            return;
-        }
-        
-        // 获取映射地址
-        void* MapPtr = MapProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        
-        // 获取映射辅助类
-        FScriptMapHelper MapHelper(MapProperty, MapPtr);
-        
-        // 创建一个默认键
-        void* DefaultKeyPtr = FMemory::Malloc(KeyProperty->GetSize(), KeyProperty->GetMinAlignment());
-        KeyProperty->InitializeValue(DefaultKeyPtr);
-        
-        // 创建一个默认值
-        void* DefaultValuePtr = FMemory::Malloc(ValueProperty->GetSize(), ValueProperty->GetMinAlignment());
-        ValueProperty->InitializeValue(DefaultValuePtr);
-        
-        // 添加新元素
-        int32 NewIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
-        uint8* NewPairPtr = MapHelper.GetPairPtr(NewIndex);
-        
-        // 复制键和值
-        KeyProperty->CopyCompleteValue(NewPairPtr, DefaultKeyPtr);
-        ValueProperty->CopyCompleteValue(NewPairPtr + KeyProperty->GetSize(), DefaultValuePtr);
-        
-        // 重新创建所有元素控件
-        MapHelper.Rehash();
+    if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("添加映射元素失败: 缺少必要的属性"));
+        return;
+    }
+    
+    if (!CanEditElements())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("添加映射元素失败: 多对象编辑时映射是只读的"));
+        return;
+    }
+    
+    // 获取映射地址
+    void* MapPtr = GetValuePtr();
+    if (!MapPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("无法解析映射地址: %s"), *PropertyPath.ToString());
+        return;
+    }
+    
+    // 获取映射辅助类
+    FScriptMapHelper MapHelper(MapProperty, MapPtr);
+    
+    // 创建一个默认键
+    void* DefaultKeyPtr = FMemory::Malloc(KeyProperty->GetSize(), KeyProperty->GetMinAlignment());
+    KeyProperty->InitializeValue(DefaultKeyPtr);
+    
+    // 创建一个默认值
+    void* DefaultValuePtr = FMemory::Malloc(ValueProperty->GetSize(), ValueProperty->GetMinAlignment());
+    ValueProperty->InitializeValue(DefaultValuePtr);
+    
+    // 保存修改前的映射用于撤销
+    BeginPropertyValueChange();
+
+    // 添加新元素
+    int32 NewIndex = MapHelper.AddDefaultValue_Invalid_NeedsRehash();
+    uint8* NewPairPtr = MapHelper.GetPairPtr(NewIndex);
+    
+    // 复制键和值
+    KeyProperty->CopyCompleteValue(NewPairPtr, DefaultKeyPtr);
+    ValueProperty->CopyCompleteValue(NewPairPtr + KeyProperty->GetSize(), DefaultValuePtr);
+    
+    // 重新创建所有元素控件
+    MapHelper.Rehash();
+    if (bChildrenCreated)
+    {
         CreatePairWidgets();
-        
-        // 通知修改
-        NotifyPropertyValueChanged();
-        
-        // 释放临时内存
-        KeyProperty->DestroyValue(DefaultKeyPtr);
-        ValueProperty->DestroyValue(DefaultValuePtr);
-        FMemory::Free(DefaultKeyPtr);
-        FMemory::Free(DefaultValuePtr);
-    }, TEXT("添加映射元素失败"));
+    }
+    
+    // 通知修改
+    NotifyPropertyValueChanged();
+    
+    // 释放临时内存
+    KeyProperty->DestroyValue(DefaultKeyPtr);
+    ValueProperty->DestroyValue(DefaultValuePtr);
+    FMemory::Free(DefaultKeyPtr);
+    FMemory::Free(DefaultValuePtr);
 }
 
 void URapidMapPropertyWidget::HandleElementDeleteClicked(int32 ElementIndex)
 {
-    SafeExecute([&, ElementIndex]() {
-        if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
+    if (!MapProperty || !KeyProperty || !ValueProperty || !TargetObject)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 缺少必要的属性"));
+        return;
+    }
+    
+    if (!CanEditElements())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 多对象编辑时映射是只读的"));
+        return;
+    }
+    
+    // 获取映射地址
+    void* MapPtr = GetValuePtr();
+    if (!MapPtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("无法解析映射地址: %s"), *PropertyPath.ToString());
+        return;
+    }
+    
+    // 获取映射辅助类
+    FScriptMapHelper MapHelper(MapProperty, MapPtr);
+    
+    // 检查是否有效的索引
+    if (ElementIndex < 0 || ElementIndex >= ElementUWidgets.Num())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 无效的索引 %d"), ElementIndex);
+        return;
+    }
+    
+    // 找到对应的稀疏索引
+    int32 RealIndex = 0;
+    int32 SparseIndex = -1;
+    for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+    {
+        if (MapHelper.IsValidIndex(i))
         {
-            UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 缺少必要的属性"));
-            return;
+            if (RealIndex == ElementIndex)
+            {
+                SparseIndex = i;
+                break;
+            }
+            RealIndex++;
         }
+    }
+    
+    if (SparseIndex != -1)
+    {
+        // 保存修改前的映射用于撤销
+        BeginPropertyValueChange();
+
+        // 删除元素
+        MapHelper.RemoveAt(SparseIndex);
         
-        // 获取映射地址
-        void* MapPtr = MapProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        
-        // 获取映射辅助类
-        FScriptMapHelper MapHelper(MapProperty, MapPtr);
-        
-        // 检查是否有效的索引
-        if (ElementIndex < 0 || ElementIndex >= ElementUWidgets.Num())
+        // 重新创建所有元素控件
+        if (bChildrenCreated)
         {
-            UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 无效的索引 %d"), ElementIndex);
-            return;
+            CreatePairWidgets();
         }
         
-        // 找到对应的稀疏索引
-        int32 RealIndex = 0;
-        int32 SparseIndex = -1;
-        for (int32 i = 0; i < MapHelper.GetMaxIndex(); ++i)
+        // 通知修改
+        NotifyPropertyValueChanged();
+    }
+    else
+    {
+        UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 无法找到元素的稀疏索引"));
+    }
+}
+
+int32 URapidMapPropertyWidget::GetEditedKeySparseIndex(const FRapidPropertyPath& InChildPropertyPath) const
+{
+    // 子路径的形式为 映射[稀疏下标].Key[.字段...]
+    const int32 MapSegment = PropertyPath.Num() - 1;
+    if (!MapProperty || MapSegment < 0 || InChildPropertyPath.Num() <= PropertyPath.Num() || !InChildPropertyPath.StartsWith(PropertyPath))
+    {
+        return INDEX_NONE;
+    }
+    
+    return InChildPropertyPath[MapSegment + 1].Property == KeyProperty ? InChildPropertyPath[MapSegment].Index : INDEX_NONE;
+}
+
+void URapidMapPropertyWidget::PreCommitChildPropertyValue(const FRapidPropertyPath& InChildPropertyPath, const FRapidPropertyValueBuffer& InBeforeValue)
+{
+    // 键控件直接写入了映射中的键，哈希已经过期，必须在记录撤销和通知之前修正
+    const int32 SparseIndex = GetEditedKeySparseIndex(InChildPropertyPath);
+    void* MapPtr = SparseIndex != INDEX_NONE ? GetValuePtr() : nullptr;
+    if (MapPtr)
+    {
+        FScriptMapHelper MapHelper(MapProperty, MapPtr);
+        if (MapHelper.IsValidIndex(SparseIndex))
         {
-            if (MapHelper.IsValidIndex(i))
+            const uint8* EditedKeyPtr = MapHelper.GetKeyPtr(SparseIndex);
+            bool bDuplicateKey = false;
+            for (int32 Index = 0; Index < MapHelper.GetMaxIndex() && !bDuplicateKey; ++Index)
             {
-                if (RealIndex == ElementIndex)
-                {
-                    SparseIndex = i;
-                    break;
-                }
-                RealIndex++;
+                bDuplicateKey = Index != SparseIndex && MapHelper.IsValidIndex(Index) && KeyProperty->Identical(EditedKeyPtr, MapHelper.GetKeyPtr(Index), PPF_None);
             }
-        }
-        
-        if (SparseIndex != -1)
-        {
-            // 删除元素
-            MapHelper.RemoveAt(SparseIndex);
             
-            // 重新创建所有元素控件
-            CreatePairWidgets();
-            
-            // 通知修改
-            NotifyPropertyValueChanged();
-        }
-        else
-        {
-            UE_LOG(LogTemp, Warning, TEXT("删除映射元素失败: 无法找到元素的稀疏索引"));
+            if (!bDuplicateKey)
+            {
+                MapHelper.Rehash();
+            }
+            else if (InBeforeValue.GetProperty() == MapProperty)
+            {
+                // 还原整个映射，复制映射时会重建哈希
+                UE_LOG(LogTemp, Warning, TEXT("映射 %s 中已经存在相同的键，修改被还原"), *PropertyPath.ToString());
+                InBeforeValue.CopyTo(MapPtr);
+            }
+            else
+            {
+                // 没有修改前的映射时无法还原，删除重复的元素，保证映射中的键唯一
+                UE_LOG(LogTemp, Warning, TEXT("映射 %s 中已经存在相同的键，删除重复的元素"), *PropertyPath.ToString());
+                MapHelper.Rehash();
+                MapHelper.RemoveAt(SparseIndex);
+            }
         }
-    }, TEXT("删除映射元素失败"));
+    }
+    
+    Super::PreCommitChildPropertyValue(InChildPropertyPath, InBeforeValue);
 }
 
-void URapidMapPropertyWidget::HandleChildPropertyValueChanged(UObject* Object, FName InPropertyName, URapidPropertyWidget* PropertyWidget)
+void URapidMapPropertyWidget::HandleChildPropertyPathChanged(UObject* Object, const FRapidPropertyPath& InChildPropertyPath)
 {
+    // 键被还原或删除时元素控件需要重新读取
+    if (GetEditedKeySparseIndex(InChildPropertyPath) != INDEX_NONE)
+    {
+        UpdatePairWidgets();
+    }
+    
     // 传递子属性变化事件
-    NotifyPropertyValueChanged();
+    NotifyChildPropertyValueChanged(InChildPropertyPath);
+}
+
+void URapidMapPropertyWidget::ReleaseElementWidgets()
+{
+    ElementUWidgets.Empty();
+    ElementSparseIndices.Empty();
+    if (ContentVerticalBox)
+    {
+        ContentVerticalBox->ClearChildren();
+    }
+    
+    bChildrenCreated = false;
+}
+
+void URapidMapPropertyWidget::HandleExpansionChanged(UExpandableArea* Area, bool bIsExpanded)
+{
+    if (bIsExpanded)
+    {
+        // 首次展开时创建元素控件，已创建过则只刷新数值
+        if (bChildrenCreated)
+        {
+            UpdatePairWidgets();
+        }
+        else
+        {
+            CreatePairWidgets();
+        }
+    }
+    else if (bReleaseChildrenOnCollapse)
+    {
+        ReleaseElementWidgets();
+    }
 }
\ No newline at end of file
@@ -0,0 +1,245 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidNumericPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidNumericPropertyAccessor.h"
+#include "Components/SpinBox.h"
+#include "Components/EditableTextBox.h"
+#include "Components/TextBlock.h"
+#include "UObject/UnrealType.h"
+
+URapidNumericPropertyWidget::URapidNumericPropertyWidget(const FObjectInitializer& ObjectInitializer)
+    : Super(ObjectInitializer)
+    , CurrentValue(0.0)
+{
+}
+
+bool URapidNumericPropertyWidget::SupportsProperty(const FProperty* InProperty)
+{
+    // 带枚举的字节属性按枚举处理
+    if (const FByteProperty* ByteProperty = CastField<FByteProperty>(InProperty))
+    {
+        if (ByteProperty->Enum)
+        {
+            return false;
+        }
+    }
+
+    return FRapidNumericPropertyDispatch::Find(InProperty) != nullptr;
+}
+
+// 添加辅助方法用于设置SpinBox属性
+void URapidNumericPropertyWidget::SetupSpinBoxFromProperty()
+{
+    // 只有float能精确表示的类型使用SpinBox，这些类型的范围都在float范围内
+    const double Lowest = FMath::Max(Accessor->GetLowest(), static_cast<double>(TNumericLimits<float>::Lowest()));
+    const double Max = FMath::Min(Accessor->GetMax(), static_cast<double>(TNumericLimits<float>::Max()));
+    ValueSpinBox->SetMinValue(static_cast<float>(Lowest));
+    ValueSpinBox->SetMaxValue(static_cast<float>(Max));
+
+    // 整数类型不显示小数
+    if (Accessor->IsInteger())
+    {
+        ValueSpinBox->SetDelta(1.0f);
+        ValueSpinBox->SetMinFractionalDigits(0);
+        ValueSpinBox->SetMaxFractionalDigits(0);
+    }
+    else
+    {
+        ValueSpinBox->SetDelta(0.1f);
+    }
+
+    // 从元数据中读取最小最大值
+    if (Property->HasMetaData(TEXT("ClampMin")))
+    {
+        ValueSpinBox->SetMinValue(static_cast<float>(FCString::Atod(*Property->GetMetaData(TEXT("ClampMin")))));
+    }
+
+    if (Property->HasMetaData(TEXT("ClampMax")))
+    {
+        ValueSpinBox->SetMaxValue(static_cast<float>(FCString::Atod(*Property->GetMetaData(TEXT("ClampMax")))));
+    }
+}
+
+bool URapidNumericPropertyWidget::InitializePropertyWidget(UObject* InObject, FProperty* InProperty, const FName& InPropertyName)
+{
+    // 先确定访问实现，父类初始化时会调用UpdateValue
+    Accessor = SupportsProperty(InProperty) ? FRapidNumericPropertyDispatch::Find(InProperty) : nullptr;
+    if (!Accessor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RapidNumericPropertyWidget初始化失败: 不支持的属性类型 %s"), InProperty ? *InProperty->GetClass()->GetName() : TEXT("null"));
+        return false;
+    }
+    bUseTextBox = !Accessor->IsExactInFloat();
+
+    // 调用父类的初始化方法
+    if (!Super::InitializePropertyWidget(InObject, InProperty, InPropertyName))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("RapidNumericPropertyWidget初始化失败: 父类初始化返回false"));
+        return false;
+    }
+
+    // 设置属性名称文本
+    PropertyNameText->SetText(PropertyDisplayName);
+
+    // 只显示与类型对应的编辑框
+    ValueSpinBox->SetVisibility(bUseTextBox ? ESlateVisibility::Collapsed : ESlateVisibility::Visible);
+    ValueTextBox->SetVisibility(bUseTextBox ? ESlateVisibility::Visible : ESlateVisibility::Collapsed);
+
+    if (bUseTextBox)
+    {
+        ValueTextBox->OnTextCommitted.AddUniqueDynamic(this, &URapidNumericPropertyWidget::HandleTextCommitted);
+    }
+    else
+    {
+        // 绑定SpinBox事件
+        ValueSpinBox->OnValueChanged.AddUniqueDynamic(this, &URapidNumericPropertyWidget::HandleValueChanged);
+        ValueSpinBox->OnBeginSliderMovement.AddUniqueDynamic(this, &URapidNumericPropertyWidget::HandleBeginSliderMovement);
+        ValueSpinBox->OnEndSliderMovement.AddUniqueDynamic(this, &URapidNumericPropertyWidget::HandleEndSliderMovement);
+
+        // 设置SpinBox属性
+        SetupSpinBoxFromProperty();
+    }
+
+    // 更新初始值
+    UpdateValue();
+    return true;
+}
+
+void URapidNumericPropertyWidget::UpdateValue_Implementation()
+{
+    // 获取属性值
+    void* ValuePtr = GetValuePtr();
+    if (Accessor && ValuePtr)
+    {
+        CurrentValue = Accessor->GetValue(ValuePtr);
+        DisplayValue(ValuePtr);
+        UpdateMultipleValues();
+        PropertyNameText->SetText(PropertyDisplayName);
+    }
+}
+
+void URapidNumericPropertyWidget::DisplayValue(const void* InValuePtr)
+{
+    if (bUseTextBox)
+    {
+        ValueTextBox->SetText(FText::FromString(Accessor->GetValueText(InValuePtr)));
+    }
+    else if (!FMath::IsNearlyEqual(static_cast<double>(ValueSpinBox->GetValue()), CurrentValue))
+    {
+        // 只更新当值不同时
+        ValueSpinBox->SetValue(static_cast<float>(CurrentValue));
+    }
+}
+
+void URapidNumericPropertyWidget::ClampToMetaData(void* InOutValuePtr) const
+{
+    // 元数据的范围按double比较，只在超出范围时写入边界值
+    const double Value = Accessor->GetValue(InOutValuePtr);
+    if (Property->HasMetaData(TEXT("ClampMin")))
+    {
+        const double ClampMin = FCString::Atod(*Property->GetMetaData(TEXT("ClampMin")));
+        if (Value < ClampMin)
+        {
+            Accessor->SetValue(InOutValuePtr, ClampMin);
+            return;
+        }
+    }
+
+    if (Property->HasMetaData(TEXT("ClampMax")))
+    {
+        const double ClampMax = FCString::Atod(*Property->GetMetaData(TEXT("ClampMax")));
+        if (Value > ClampMax)
+        {
+            Accessor->SetValue(InOutValuePtr, ClampMax);
+        }
+    }
+}
+
+bool URapidNumericPropertyWidget::ApplyValue(TFunctionRef<bool(void*)> InWriteValue)
+{
+    if (!IsPropertyBound() || !Accessor)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置数值属性值失败: 属性未绑定或对象已销毁"));
+        return false;
+    }
+
+    // 按属性路径解析值地址，容器元素可能已经失效
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置数值属性值失败: 无法解析属性地址 %s"), *PropertyPath.ToString());
+        return false;
+    }
+
+    // 先写入临时值，得到取整和限制范围之后的实际值；数值属性最大8字节
+    alignas(8) uint8 NewValue[8];
+    check(Property->GetElementSize() <= sizeof(NewValue));
+    Property->CopySingleValue(NewValue, ValuePtr);
+    if (!InWriteValue(NewValue))
+    {
+        DisplayValue(ValuePtr);
+        return false;
+    }
+    ClampToMetaData(NewValue);
+
+    // 如果值没有变化，直接返回；多个对象的值不同时仍需写入以统一所有对象
+    if (!bHasMultipleValues && Property->Identical(NewValue, ValuePtr, PPF_None))
+    {
+        DisplayValue(ValuePtr);
+        return false;
+    }
+
+    // 保存修改前的值用于撤销
+    BeginPropertyValueChange();
+
+    Property->CopySingleValue(ValuePtr, NewValue);
+    CurrentValue = Accessor->GetValue(ValuePtr);
+    DisplayValue(ValuePtr);
+
+    // 通知属性值已更改
+    NotifyPropertyValueChanged();
+    return true;
+}
+
+bool URapidNumericPropertyWidget::SetValue(double InValue)
+{
+    return ApplyValue([this, InValue](void* OutValuePtr)
+    {
+        Accessor->SetValue(OutValuePtr, InValue);
+        return true;
+    });
+}
+
+double URapidNumericPropertyWidget::GetValue() const
+{
+    return CurrentValue;
+}
+
+void URapidNumericPropertyWidget::HandleValueChanged(float NewValue)
+{
+    SetValue(NewValue);
+}
+
+void URapidNumericPropertyWidget::HandleTextCommitted(const FText& InText, ETextCommit::Type InCommitMethod)
+{
+    const FString Text = InText.ToString();
+    ApplyValue([this, &Text](void* OutValuePtr)
+    {
+        if (!Accessor->SetValueFromText(OutValuePtr, Text))
+        {
+            UE_LOG(LogTemp, Warning, TEXT("%s 不是有效的数值: %s"), *PropertyPath.ToString(), *Text);
+            return false;
+        }
+        return true;
+    });
+}
+
+void URapidNumericPropertyWidget::HandleBeginSliderMovement()
+{
+    BeginContinuousPropertyEdit();
+}
+
+void URapidNumericPropertyWidget::HandleEndSliderMovement(float NewValue)
+{
+    EndContinuousPropertyEdit();
+}
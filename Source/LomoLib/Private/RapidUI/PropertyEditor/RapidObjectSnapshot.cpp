@@ -0,0 +1,381 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidObjectSnapshot.h"
+#include "Memory/MemoryView.h"
+#include "Misc/FileHelper.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "Serialization/StructuredArchive.h"
+#include "UObject/ObjectKey.h"
+#include "UObject/UnrealType.h"
+
+namespace RapidObjectSnapshotPrivate
+{
+    constexpr uint32 Magic = 0x4E535052; // "RPSN"
+    constexpr uint32 Version = 1;
+
+    /**
+     * 类的快照布局：可保存的顶层属性及其类型标签，每个原生类只构建一次
+     */
+    struct FSnapshotLayout
+    {
+        struct FEntry
+        {
+            FProperty* Property = nullptr;
+            uint32 TypeTag = 0;
+        };
+
+        TArray<FEntry> Entries;
+        TMap<FName, int32> NameToEntry;
+
+        static TSharedRef<const FSnapshotLayout> Get(const UClass* InClass)
+        {
+            static TMap<TObjectKey<UClass>, TSharedRef<const FSnapshotLayout>> CachedLayouts;
+
+            check(IsInGameThread());
+
+            if (const TSharedRef<const FSnapshotLayout>* CachedLayout = CachedLayouts.Find(InClass))
+            {
+                return *CachedLayout;
+            }
+
+            TSharedRef<FSnapshotLayout> Layout = MakeShared<FSnapshotLayout>();
+            for (TFieldIterator<FProperty> It(InClass); It; ++It)
+            {
+                FProperty* Property = *It;
+
+                // 与属性编辑器保持一致，只保存可编辑的属性
+                if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_EditorOnly | CPF_Transient))
+                {
+                    continue;
+                }
+
+                // 对象引用和委托在另一次运行中没有意义
+                if (Property->IsA<FObjectPropertyBase>() || Property->IsA<FInterfaceProperty>()
+                    || Property->IsA<FDelegateProperty>() || Property->IsA<FMulticastDelegateProperty>())
+                {
+                    continue;
+                }
+
+                // 类型标签：属性类型和C++类型都一致时才恢复
+                const FString TypeString = FString::Printf(TEXT("%s %s %d"), *Property->GetClass()->GetName(), *Property->GetCPPType(), Property->ArrayDim);
+                Layout->NameToEntry.Add(Property->GetFName(), Layout->Entries.Num());
+                Layout->Entries.Add({ Property, FCrc::StrCrc32(*TypeString) });
+            }
+
+            // 蓝图类重新编译后FProperty会被替换，只缓存原生类
+            if (InClass->HasAnyClassFlags(CLASS_Native))
+            {
+                CachedLayouts.Add(InClass, Layout);
+            }
+            return Layout;
+        }
+    };
+
+    /** 序列化属性的所有静态数组元素，对象和名称以字符串形式保存 */
+    void SerializeProperty(FArchive& InAr, const FProperty* InProperty, void* InContainer)
+    {
+        FObjectAndNameAsStringProxyArchive ProxyAr(InAr, false);
+        for (int32 ArrayIndex = 0; ArrayIndex < InProperty->ArrayDim; ++ArrayIndex)
+        {
+            FStructuredArchiveFromArchive StructuredArchive(ProxyAr);
+            InProperty->SerializeItem(StructuredArchive.GetSlot(), InProperty->ContainerPtrToValuePtr<void>(InContainer, ArrayIndex), nullptr);
+        }
+    }
+}
+
+FRapidObjectSnapshot FRapidObjectSnapshot::Capture(TConstArrayView<UObject*> InObjects)
+{
+    using namespace RapidObjectSnapshotPrivate;
+
+    // 先写对象数据，同时收集名称表
+    TArray<uint8> Body;
+    FMemoryWriter BodyWriter(Body);
+    TArray<FName> Names;
+    TMap<FName, int32> NameToIndex;
+    TArray<uint8> Payload;
+
+    int32 ObjectCount = InObjects.Num();
+    BodyWriter << ObjectCount;
+
+    for (UObject* Object : InObjects)
+    {
+        if (!Object)
+        {
+            // 空对象写入空记录，保持序号对应
+            FString EmptyClassPath;
+            int32 EmptyRecordCount = 0;
+            BodyWriter << EmptyClassPath << EmptyRecordCount;
+            continue;
+        }
+
+        const TSharedRef<const FSnapshotLayout> Layout = FSnapshotLayout::Get(Object->GetClass());
+        FString ClassPath = Object->GetClass()->GetPathName();
+        int32 RecordCount = Layout->Entries.Num();
+        BodyWriter << ClassPath << RecordCount;
+
+        for (const FSnapshotLayout::FEntry& Entry : Layout->Entries)
+        {
+            const FName PropertyName = Entry.Property->GetFName();
+            int32* ExistingNameIndex = NameToIndex.Find(PropertyName);
+            uint32 NameIndex = ExistingNameIndex ? *ExistingNameIndex : NameToIndex.Add(PropertyName, Names.Add(PropertyName));
+            uint32 TypeTag = Entry.TypeTag;
+
+            Payload.Reset();
+            FMemoryWriter PayloadWriter(Payload);
+            SerializeProperty(PayloadWriter, Entry.Property, Object);
+            uint32 PayloadSize = Payload.Num();
+
+            BodyWriter.SerializeIntPacked(NameIndex);
+            BodyWriter << TypeTag;
+            BodyWriter.SerializeIntPacked(PayloadSize);
+            BodyWriter.Serialize(Payload.GetData(), Payload.Num());
+        }
+    }
+
+    // 头部 + 名称表 + 对象数据
+    FRapidObjectSnapshot Snapshot;
+    FMemoryWriter Writer(Snapshot.Data);
+
+    uint32 FileMagic = Magic;
+    uint32 FileVersion = Version;
+    Writer << FileMagic << FileVersion;
+
+    int32 NameCount = Names.Num();
+    Writer << NameCount;
+    for (const FName& Name : Names)
+    {
+        FString NameString = Name.ToString();
+        Writer << NameString;
+    }
+
+    Writer.Serialize(Body.GetData(), Body.Num());
+
+    Snapshot.Parse();
+    return Snapshot;
+}
+
+int32 FRapidObjectSnapshot::Restore(TConstArrayView<UObject*> InObjects, TArray<TArray<FProperty*>>* OutRestoredProperties) const
+{
+    using namespace RapidObjectSnapshotPrivate;
+
+    if (OutRestoredProperties)
+    {
+        OutRestoredProperties->Reset();
+        OutRestoredProperties->SetNum(InObjects.Num());
+    }
+
+    int32 RestoredCount = 0;
+    const int32 ObjectCount = FMath::Min(InObjects.Num(), Objects.Num());
+
+    for (int32 ObjectIndex = 0; ObjectIndex < ObjectCount; ++ObjectIndex)
+    {
+        UObject* Object = InObjects[ObjectIndex];
+        if (!Object)
+        {
+            continue;
+        }
+
+        const TSharedRef<const FSnapshotLayout> Layout = FSnapshotLayout::Get(Object->GetClass());
+        for (const FRecord& Record : Objects[ObjectIndex].Records)
+        {
+            // 属性已被删除或类型已改变时跳过
+            const int32* EntryIndex = Layout->NameToEntry.Find(Names[Record.NameIndex]);
+            if (!EntryIndex || Layout->Entries[*EntryIndex].TypeTag != Record.TypeTag)
+            {
+                UE_LOG(LogTemp, Verbose, TEXT("快照恢复跳过属性 %s: 属性不存在或类型不一致"), *Names[Record.NameIndex].ToString());
+                continue;
+            }
+
+            FProperty* Property = Layout->Entries[*EntryIndex].Property;
+            const TConstArrayView<uint8> Payload = GetPayload(Record);
+            FMemoryReaderView PayloadReader(MakeMemoryView(Payload.GetData(), Payload.Num()));
+            SerializeProperty(PayloadReader, Property, Object);
+
+            if (PayloadReader.IsError())
+            {
+                UE_LOG(LogTemp, Warning, TEXT("快照恢复属性失败: %s.%s"), *Object->GetName(), *Property->GetName());
+                continue;
+            }
+
+            ++RestoredCount;
+            if (OutRestoredProperties)
+            {
+                (*OutRestoredProperties)[ObjectIndex].Add(Property);
+            }
+        }
+    }
+
+    return RestoredCount;
+}
+
+TArray<FRapidSnapshotDifference> FRapidObjectSnapshot::Diff(const FRapidObjectSnapshot& InA, const FRapidObjectSnapshot& InB)
+{
+    TArray<FRapidSnapshotDifference> Differences;
+
+    const int32 ObjectCount = FMath::Max(InA.Objects.Num(), InB.Objects.Num());
+    for (int32 ObjectIndex = 0; ObjectIndex < ObjectCount; ++ObjectIndex)
+    {
+        // 两个快照的名称表不同，按属性名建立B的查找表
+        TMap<FName, const FRecord*> RecordsInB;
+        if (InB.Objects.IsValidIndex(ObjectIndex))
+        {
+            for (const FRecord& Record : InB.Objects[ObjectIndex].Records)
+            {
+                RecordsInB.Add(InB.Names[Record.NameIndex], &Record);
+            }
+        }
+
+        if (InA.Objects.IsValidIndex(ObjectIndex))
+        {
+            for (const FRecord& RecordA : InA.Objects[ObjectIndex].Records)
+            {
+                const FName PropertyName = InA.Names[RecordA.NameIndex];
+
+                const FRecord* RecordB = nullptr;
+                RecordsInB.RemoveAndCopyValue(PropertyName, RecordB);
+
+                if (!RecordB)
+                {
+                    Differences.Add({ ObjectIndex, PropertyName, FRapidSnapshotDifference::EType::OnlyInA });
+                }
+                else if (RecordA.TypeTag != RecordB->TypeTag || RecordA.Size != RecordB->Size
+                    || FMemory::Memcmp(InA.GetPayload(RecordA).GetData(), InB.GetPayload(*RecordB).GetData(), RecordA.Size) != 0)
+                {
+                    Differences.Add({ ObjectIndex, PropertyName, FRapidSnapshotDifference::EType::Changed });
+                }
+            }
+        }
+
+        for (const TPair<FName, const FRecord*>& Pair : RecordsInB)
+        {
+            Differences.Add({ ObjectIndex, Pair.Key, FRapidSnapshotDifference::EType::OnlyInB });
+        }
+    }
+
+    return Differences;
+}
+
+bool FRapidObjectSnapshot::SetData(TArray<uint8>&& InData)
+{
+    Data = MoveTemp(InData);
+    return Parse();
+}
+
+bool FRapidObjectSnapshot::SaveToFile(const FString& InFilePath) const
+{
+    return IsValid() && FFileHelper::SaveArrayToFile(Data, *InFilePath);
+}
+
+bool FRapidObjectSnapshot::LoadFromFile(const FString& InFilePath)
+{
+    TArray<uint8> FileData;
+    if (!FFileHelper::LoadFileToArray(FileData, *InFilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("读取快照文件失败: %s"), *InFilePath);
+        return false;
+    }
+
+    return SetData(MoveTemp(FileData));
+}
+
+bool FRapidObjectSnapshot::Parse()
+{
+    using namespace RapidObjectSnapshotPrivate;
+
+    Names.Reset();
+    Objects.Reset();
+
+    FMemoryReader Reader(Data);
+
+    uint32 FileMagic = 0;
+    uint32 FileVersion = 0;
+    Reader << FileMagic << FileVersion;
+    if (Reader.IsError() || FileMagic != Magic || FileVersion != Version)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("快照格式无效或版本不支持"));
+        Data.Reset();
+        return false;
+    }
+
+    int32 NameCount = 0;
+    Reader << NameCount;
+    if (NameCount < 0 || NameCount > Data.Num())
+    {
+        Data.Reset();
+        return false;
+    }
+
+    Names.Reserve(NameCount);
+    for (int32 Index = 0; Index < NameCount && !Reader.IsError(); ++Index)
+    {
+        FString NameString;
+        Reader << NameString;
+        Names.Add(FName(*NameString));
+    }
+
+    int32 ObjectCount = 0;
+    Reader << ObjectCount;
+    if (ObjectCount < 0 || ObjectCount > Data.Num())
+    {
+        Data.Reset();
+        Names.Reset();
+        return false;
+    }
+
+    Objects.SetNum(ObjectCount);
+    for (FObjectRecord& ObjectRecord : Objects)
+    {
+        int32 RecordCount = 0;
+        Reader << ObjectRecord.ClassPath << RecordCount;
+        if (Reader.IsError() || RecordCount < 0 || RecordCount > Data.Num())
+        {
+            Reader.SetError();
+            break;
+        }
+
+        ObjectRecord.Records.SetNum(RecordCount);
+        for (FRecord& Record : ObjectRecord.Records)
+        {
+            uint32 NameIndex = 0;
+            uint32 PayloadSize = 0;
+            Reader.SerializeIntPacked(NameIndex);
+            Reader << Record.TypeTag;
+            Reader.SerializeIntPacked(PayloadSize);
+
+            // 校验名称下标和数据长度，跳过数据本身
+            if (Reader.IsError() || !Names.IsValidIndex(NameIndex) || Reader.Tell() + PayloadSize > Data.Num())
+            {
+                Reader.SetError();
+                break;
+            }
+
+            Record.NameIndex = NameIndex;
+            Record.Offset = Reader.Tell();
+            Record.Size = PayloadSize;
+            Reader.Seek(Reader.Tell() + PayloadSize);
+        }
+
+        if (Reader.IsError())
+        {
+            break;
+        }
+    }
+
+    if (Reader.IsError())
+    {
+        UE_LOG(LogTemp, Warning, TEXT("快照数据已损坏"));
+        Data.Reset();
+        Names.Reset();
+        Objects.Reset();
+        return false;
+    }
+
+    return true;
+}
+
+TConstArrayView<uint8> FRapidObjectSnapshot::GetPayload(const FRecord& InRecord) const
+{
+    return TConstArrayView<uint8>(Data.GetData() + InRecord.Offset, InRecord.Size);
+}
@@ -3,14 +3,27 @@
 #include "RapidUI/PropertyEditor/RapidPropertyEditor.h"
 #include "Components/ScrollBox.h"
 #include "Components/VerticalBox.h"
+#include "Components/EditableTextBox.h"
 #include "RapidUI/PropertyEditor/LomoLibPropertyEditorTestObject.h"
 #include "UObject/UnrealType.h"
 #include "UObject/PropertyPortFlags.h"
 #include "RapidUI/PropertyEditor/RapidPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidNumericPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidEnumPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidObjectSnapshot.h"
 
 void URapidPropertyEditor::NativeConstruct()
 {
     Super::NativeConstruct();
+
+    TransactionBuffer.SetLimits(static_cast<SIZE_T>(MaxUndoMemoryKB) * 1024, MaxUndoCount);
+    TransactionBuffer.SetCoalesceWindow(UndoCoalesceWindow);
+
+    if (SearchTextBox)
+    {
+        SearchTextBox->OnTextChanged.RemoveDynamic(this, &URapidPropertyEditor::HandleSearchTextChanged);
+        SearchTextBox->OnTextChanged.AddDynamic(this, &URapidPropertyEditor::HandleSearchTextChanged);
+    }
 }
 
 void URapidPropertyEditor::NativeDestruct()
@@ -20,6 +33,16 @@ void URapidPropertyEditor::NativeDestruct()
 }
 
 bool URapidPropertyEditor::SetObject(UObject* InObject)
+{
+    TArray<UObject*> Objects;
+    if (InObject)
+    {
+        Objects.Add(InObject);
+    }
+    return SetObjects(Objects);
+}
+
+bool URapidPropertyEditor::SetObjects(const TArray<UObject*>& InObjects)
 {
     // 清空现有的内容
     if (ContentScrollBox)
@@ -30,15 +53,34 @@ bool URapidPropertyEditor::SetObject(UObject* InObject)
     // 清空已创建的属性控件
     PropertyWidgets.Empty();
     
-    // 如果传入的对象为空，则清除当前对象并返回
-    if (!InObject)
+    // 过滤空对象和重复对象
+    TArray<UObject*> NewObjects;
+    NewObjects.Reserve(InObjects.Num());
+    for (UObject* Object : InObjects)
+    {
+        if (IsValid(Object))
+        {
+            NewObjects.AddUnique(Object);
+        }
+    }
+    
+    // 切换对象时旧对象的撤销记录不再有意义
+    if (NewObjects != TargetObjects)
+    {
+        TransactionBuffer.Reset();
+    }
+    
+    // 如果没有有效对象，则清除当前对象并返回
+    if (NewObjects.Num() == 0)
     {
         TargetObject = nullptr;
+        TargetObjects.Empty();
         return false;
     }
     
     // 设置新对象并渲染属性
-    TargetObject = InObject;
+    TargetObjects = MoveTemp(NewObjects);
+    TargetObject = TargetObjects[0];
     RenderProperties();
     return true;
 }
@@ -48,6 +90,11 @@ UObject* URapidPropertyEditor::GetObject() const
     return TargetObject;
 }
 
+const TArray<UObject*>& URapidPropertyEditor::GetObjects() const
+{
+    return TargetObjects;
+}
+
 void URapidPropertyEditor::Refresh()
 {
     if (TargetObject)
@@ -68,8 +115,10 @@ void URapidPropertyEditor::ClearObject()
     
     // 清空已创建的属性控件
     PropertyWidgets.Empty();
+    TransactionBuffer.Reset();
     
     TargetObject = nullptr;
+    TargetObjects.Empty();
 }
 
 TObjectPtr<URapidPropertyWidget> URapidPropertyEditor::CreatePropertyWidgetForType(UUserWidget* InOuter, const FProperty* InProperty)
@@ -79,15 +128,24 @@ TObjectPtr<URapidPropertyWidget> URapidPropertyEditor::CreatePropertyWidgetForTy
         return nullptr;
     }
 
-    // 支持int、float、bool和string三种类型的属性
-    if (InProperty->IsA<FIntProperty>())
+    // 支持数值、枚举、bool、string以及结构体、数组和映射类型的属性
+    // 枚举必须在数值之前判断，带枚举的字节属性也是数值属性
+    if (EnumPropertyWidgetClass && URapidEnumPropertyWidget::SupportsProperty(InProperty))
+    {
+        return CreateWidget<URapidPropertyWidget>(InOuter, EnumPropertyWidgetClass);
+    }
+    else if (InProperty->IsA<FIntProperty>() && IntPropertyWidgetClass)
     {
         return CreateWidget<URapidPropertyWidget>(InOuter, IntPropertyWidgetClass);
     }
-    else if (InProperty->IsA<FFloatProperty>())
+    else if (InProperty->IsA<FFloatProperty>() && FloatPropertyWidgetClass)
     {
         return CreateWidget<URapidPropertyWidget>(InOuter, FloatPropertyWidgetClass);
     }
+    else if (NumericPropertyWidgetClass && URapidNumericPropertyWidget::SupportsProperty(InProperty))
+    {
+        return CreateWidget<URapidPropertyWidget>(InOuter, NumericPropertyWidgetClass);
+    }
     else if (InProperty->IsA<FBoolProperty>())
     {
         return CreateWidget<URapidPropertyWidget>(InOuter, BoolPropertyWidgetClass);
@@ -96,6 +154,18 @@ TObjectPtr<URapidPropertyWidget> URapidPropertyEditor::CreatePropertyWidgetForTy
     {
         return CreateWidget<URapidPropertyWidget>(InOuter, StringPropertyWidgetClass);
     }
+    else if (InProperty->IsA<FStructProperty>() && StructPropertyWidgetClass)
+    {
+        return CreateWidget<URapidPropertyWidget>(InOuter, StructPropertyWidgetClass);
+    }
+    else if (InProperty->IsA<FArrayProperty>() && ArrayPropertyWidgetClass)
+    {
+        return CreateWidget<URapidPropertyWidget>(InOuter, ArrayPropertyWidgetClass);
+    }
+    else if (InProperty->IsA<FMapProperty>() && MapPropertyWidgetClass)
+    {
+        return CreateWidget<URapidPropertyWidget>(InOuter, MapPropertyWidgetClass);
+    }
 
     // 其他类型返回nullptr
     return nullptr;
@@ -111,8 +181,12 @@ void URapidPropertyEditor::RenderProperties()
     // 清空现有内容
     ContentScrollBox->ClearChildren();
     
-    // 获取对象的类
-    UClass* ObjectClass = TargetObject->GetClass();
+    // 获取对象的类，多对象编辑时只显示共同基类上的属性
+    UClass* ObjectClass = GetCommonClass();
+    
+    // 搜索索引按类型缓存，需要在创建控件之前准备好
+    SearchIndex = FRapidPropertySearchIndex::Get(ObjectClass);
+    SearchFilter.SetIndex(SearchIndex);
     
     // 创建垂直容器
     UVerticalBox* MainVerticalBox = NewObject<UVerticalBox>(this);
@@ -135,9 +209,6 @@ void URapidPropertyEditor::RenderProperties()
             continue;
         }
         
-        // 获取属性地址
-        void* PropertyValuePtr = Property->ContainerPtrToValuePtr<void>(TargetObject);
-        
         // 创建属性控件
         auto PropertyWidget = CreatePropertyWidgetForType(this, Property);
         
@@ -148,7 +219,7 @@ void URapidPropertyEditor::RenderProperties()
             if (PropertyWidget->InitializePropertyWidget(TargetObject, Property, Property->GetFName()))
             {
                 // 绑定属性值变化事件
-                PropertyWidget->OnPropertyValueChanged.AddDynamic(this, &URapidPropertyEditor::HandlePropertyValueChanged);
+                PropertyWidget->OnPropertyPathChanged.AddUObject(this, &URapidPropertyEditor::HandlePropertyPathChanged);
                     
                 // 添加到主容器
                 MainVerticalBox->AddChild(PropertyWidget);
@@ -160,30 +231,44 @@ void URapidPropertyEditor::RenderProperties()
     }
 }
 
-void URapidPropertyEditor::HandlePropertyValueChanged(UObject* Object, FName PropertyName, URapidPropertyWidget* PropertyWidget)
+void URapidPropertyEditor::HandlePropertyPathChanged(UObject* Object, const FRapidPropertyPath& PropertyPath)
 {
     // 触发属性改变事件
     if (Object == TargetObject)
     {
+        // 多对象编辑时把主对象的新值一次性写入其他对象
+        const FRapidPropertyPath SharedPath = GetSharedEditPath(PropertyPath);
+        if (TargetObjects.Num() > 1)
+        {
+            PropagateToOtherObjects(SharedPath);
+        }
+
         if (auto TestObj = Cast<ULomoLibPropertyEditorTestObject>(TargetObject))
         {
             TestObj->PrintAllProperties();
         }
 
-        
-        FProperty* Property = TargetObject->GetClass()->FindPropertyByName(PropertyName);
+        // 按路径解析被修改的值，结构体字段和容器元素也能直接定位
+        FProperty* Property = PropertyPath.GetLeafProperty();
+        const void* ValuePtr = PropertyPath.Resolve(TargetObject);
 
         // 打印当前数值
-        if (Property)
+        if (Property && ValuePtr)
         {
             FString PropertyValue;
-            Property->ExportText_Direct(PropertyValue, Property->ContainerPtrToValuePtr<void>(TargetObject), nullptr, TargetObject, 0);
-            UE_LOG(LogTemp, Log, TEXT("Property %s changed to: %s"), *PropertyName.ToString(), *PropertyValue);
+            Property->ExportText_Direct(PropertyValue, ValuePtr, nullptr, TargetObject, 0);
+            UE_LOG(LogTemp, Log, TEXT("Property %s changed to: %s"), *PropertyPath.ToString(), *PropertyValue);
         }
 
         if (Property)
         {
-            NotifyPropertyChanged(PropertyName, Property);
+            NotifyPropertyChanged(TargetObjects.Num() > 1 ? SharedPath : PropertyPath);
+        }
+
+        // 写入后所有对象的值相同，刷新"多个值"标记
+        if (TargetObjects.Num() > 1)
+        {
+            RefreshPropertyWidgets(SharedPath);
         }
     }
 }
@@ -205,8 +290,329 @@ FString URapidPropertyEditor::GetPropertyDisplayName(FProperty* Property) const
     return Property->GetName();
 }
 
-void URapidPropertyEditor::NotifyPropertyChanged(FName PropertyName, FProperty* Property)
+void URapidPropertyEditor::NotifyPropertyChanged(const FRapidPropertyPath& PropertyPath)
+{
+    // 广播属性改变事件，每个对象一次
+    for (UObject* Object : TargetObjects)
+    {
+        if (Object)
+        {
+            OnPropertyPathChanged.Broadcast(Object, PropertyPath);
+        }
+    }
+}
+
+FRapidPropertyPath URapidPropertyEditor::GetSharedEditPath(const FRapidPropertyPath& InPropertyPath) const
+{
+    if (TargetObjects.Num() <= 1)
+    {
+        // 修改映射的键会改变元素的哈希，撤销时需要恢复整个映射才能重建哈希
+        const int32 MapKeySegment = InPropertyPath.FindMapKeySegment();
+        if (MapKeySegment == INDEX_NONE)
+        {
+            return InPropertyPath;
+        }
+
+        FRapidPropertyPath MapPath;
+        for (int32 Index = 0; Index < MapKeySegment; ++Index)
+        {
+            MapPath.Push(InPropertyPath[Index].Property, InPropertyPath[Index].Index);
+        }
+        MapPath.Push(InPropertyPath[MapKeySegment].Property);
+        return MapPath;
+    }
+
+    FRapidPropertyPath SharedPath;
+    for (int32 Index = 0; Index < InPropertyPath.Num(); ++Index)
+    {
+        const FRapidPropertyPathSegment& Segment = InPropertyPath[Index];
+
+        // 映射和集合的稀疏下标在各对象间不对应，截断到整个容器
+        const bool bSparseContainer = Segment.Index != INDEX_NONE
+            && (Segment.Property->IsA<FMapProperty>() || Segment.Property->IsA<FSetProperty>());
+        if (bSparseContainer)
+        {
+            SharedPath.Push(Segment.Property);
+            break;
+        }
+
+        SharedPath.Push(Segment.Property, Segment.Index);
+    }
+
+    return SharedPath;
+}
+
+bool URapidPropertyEditor::CanEditSparseContainers() const
+{
+    return TargetObjects.Num() <= 1;
+}
+
+bool URapidPropertyEditor::HasMultipleValues(const FRapidPropertyPath& InPropertyPath) const
+{
+    if (TargetObjects.Num() <= 1 || !TargetObject)
+    {
+        return false;
+    }
+
+    const FRapidPropertyPath SharedPath = GetSharedEditPath(InPropertyPath);
+    const FProperty* Property = SharedPath.GetLeafProperty();
+    const void* PrimaryValuePtr = SharedPath.Resolve(TargetObject);
+    if (!Property || !PrimaryValuePtr)
+    {
+        return false;
+    }
+
+    for (int32 Index = 1; Index < TargetObjects.Num(); ++Index)
+    {
+        const void* ValuePtr = TargetObjects[Index] ? SharedPath.Resolve(TargetObjects[Index]) : nullptr;
+        if (!ValuePtr || !Property->Identical(PrimaryValuePtr, ValuePtr, PPF_None))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void URapidPropertyEditor::PropagateToOtherObjects(const FRapidPropertyPath& InPropertyPath)
+{
+    const FProperty* Property = InPropertyPath.GetLeafProperty();
+    const void* SourceValuePtr = TargetObject ? InPropertyPath.Resolve(TargetObject) : nullptr;
+    if (!Property || !SourceValuePtr)
+    {
+        return;
+    }
+
+    // 映射和集合的元素在各对象间不对应，复制整个容器会丢掉其他对象自己的元素
+    for (int32 Index = 0; Index < InPropertyPath.Num(); ++Index)
+    {
+        if (InPropertyPath[Index].Property->IsA<FMapProperty>() || InPropertyPath[Index].Property->IsA<FSetProperty>())
+        {
+            UE_LOG(LogTemp, Warning, TEXT("多对象编辑时不能修改映射或集合，%s 只写入了主对象"), *InPropertyPath.ToString());
+            return;
+        }
+    }
+
+    // 路径在某个对象上无法解析（如数组长度不同）时跳过该对象
+    for (int32 Index = 1; Index < TargetObjects.Num(); ++Index)
+    {
+        if (void* ValuePtr = TargetObjects[Index] ? InPropertyPath.Resolve(TargetObjects[Index]) : nullptr)
+        {
+            Property->CopyCompleteValue(ValuePtr, SourceValuePtr);
+        }
+    }
+}
+
+void URapidPropertyEditor::RefreshPropertyWidgets(const FRapidPropertyPath& InPropertyPath)
+{
+    // 只刷新受影响的顶层属性控件，容器控件会在UpdateValue中处理元素数量的变化
+    const FProperty* RootProperty = InPropertyPath.GetRootProperty();
+    for (URapidPropertyWidget* PropertyWidget : PropertyWidgets)
+    {
+        if (PropertyWidget && PropertyWidget->GetPropertyPath().GetRootProperty() == RootProperty)
+        {
+            PropertyWidget->UpdateValue();
+        }
+    }
+}
+
+UClass* URapidPropertyEditor::GetCommonClass() const
+{
+    UClass* CommonClass = TargetObject ? TargetObject->GetClass() : nullptr;
+    for (const UObject* Object : TargetObjects)
+    {
+        while (CommonClass && Object && !Object->IsA(CommonClass))
+        {
+            CommonClass = CommonClass->GetSuperClass();
+        }
+    }
+    return CommonClass;
+}
+
+void URapidPropertyEditor::SetSearchText(const FString& InSearchText)
 {
-    // 广播属性改变事件
-    // OnPropertyChanged.Broadcast(TargetObject, PropertyName, Property);
-}
\ No newline at end of file
+    SearchFilter.SetSearchText(InSearchText);
+
+    for (URapidPropertyWidget* PropertyWidget : PropertyWidgets)
+    {
+        if (PropertyWidget)
+        {
+            PropertyWidget->ApplySearchFilter(SearchFilter);
+        }
+    }
+}
+
+const FRapidPropertySearchFilter& URapidPropertyEditor::GetSearchFilter() const
+{
+    return SearchFilter;
+}
+
+int32 URapidPropertyEditor::FindSearchEntry(const FRapidPropertyPath& InPropertyPath) const
+{
+    return SearchIndex ? SearchIndex->FindEntry(InPropertyPath) : INDEX_NONE;
+}
+
+void URapidPropertyEditor::HandleSearchTextChanged(const FText& InText)
+{
+    SetSearchText(InText.ToString());
+}
+
+bool URapidPropertyEditor::SaveSnapshot(const FString& FilePath)
+{
+    if (TargetObjects.Num() == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("保存快照失败: 没有正在编辑的对象"));
+        return false;
+    }
+
+    const FRapidObjectSnapshot Snapshot = FRapidObjectSnapshot::Capture(TargetObjects);
+    if (!Snapshot.SaveToFile(FilePath))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("保存快照失败: %s"), *FilePath);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("已保存快照: %s (%d 字节)"), *FilePath, Snapshot.GetData().Num());
+    return true;
+}
+
+bool URapidPropertyEditor::LoadSnapshot(const FString& FilePath)
+{
+    FRapidObjectSnapshot Snapshot;
+    if (TargetObjects.Num() == 0 || !Snapshot.LoadFromFile(FilePath))
+    {
+        return false;
+    }
+
+    TArray<TArray<FProperty*>> RestoredProperties;
+    const int32 RestoredCount = Snapshot.Restore(TargetObjects, &RestoredProperties);
+    if (RestoredCount == 0)
+    {
+        return false;
+    }
+
+    // 快照直接改写了属性，已有的撤销记录不再可靠
+    TransactionBuffer.Reset();
+
+    for (URapidPropertyWidget* PropertyWidget : PropertyWidgets)
+    {
+        if (PropertyWidget)
+        {
+            PropertyWidget->UpdateValue();
+        }
+    }
+
+    for (int32 ObjectIndex = 0; ObjectIndex < RestoredProperties.Num(); ++ObjectIndex)
+    {
+        for (FProperty* Property : RestoredProperties[ObjectIndex])
+        {
+            OnPropertyPathChanged.Broadcast(TargetObjects[ObjectIndex], FRapidPropertyPath(Property));
+        }
+    }
+
+    return true;
+}
+
+TArray<FName> URapidPropertyEditor::DiffSnapshotFiles(const FString& FilePathA, const FString& FilePathB)
+{
+    TArray<FName> ChangedProperties;
+
+    FRapidObjectSnapshot SnapshotA;
+    FRapidObjectSnapshot SnapshotB;
+    if (!SnapshotA.LoadFromFile(FilePathA) || !SnapshotB.LoadFromFile(FilePathB))
+    {
+        return ChangedProperties;
+    }
+
+    for (const FRapidSnapshotDifference& Difference : FRapidObjectSnapshot::Diff(SnapshotA, SnapshotB))
+    {
+        ChangedProperties.AddUnique(Difference.PropertyName);
+    }
+
+    return ChangedProperties;
+}
+
+bool URapidPropertyEditor::Undo()
+{
+    const FRapidPropertyTransaction* Transaction = TransactionBuffer.Undo();
+    if (!Transaction)
+    {
+        return false;
+    }
+
+    HandleTransactionApplied(*Transaction);
+    return true;
+}
+
+bool URapidPropertyEditor::Redo()
+{
+    const FRapidPropertyTransaction* Transaction = TransactionBuffer.Redo();
+    if (!Transaction)
+    {
+        return false;
+    }
+
+    HandleTransactionApplied(*Transaction);
+    return true;
+}
+
+bool URapidPropertyEditor::CanUndo() const
+{
+    return TransactionBuffer.CanUndo();
+}
+
+bool URapidPropertyEditor::CanRedo() const
+{
+    return TransactionBuffer.CanRedo();
+}
+
+void URapidPropertyEditor::ClearUndoHistory()
+{
+    TransactionBuffer.Reset();
+}
+
+void URapidPropertyEditor::RecordPropertyEdit(UObject* InObject, const FRapidPropertyPath& InPropertyPath, FRapidPropertyValueBuffer&& InBefore)
+{
+    TArray<FRapidPropertyValueBuffer> BeforeValues;
+    BeforeValues.Add(MoveTemp(InBefore));
+
+    if (InObject != TargetObject || TargetObjects.Num() <= 1)
+    {
+        TransactionBuffer.RecordEdit(MakeArrayView(&InObject, 1), InPropertyPath, MoveTemp(BeforeValues));
+        return;
+    }
+
+    // 此时新值还没有写入其他对象，直接保存它们当前的值
+    BeforeValues.Reserve(TargetObjects.Num());
+    for (int32 Index = 1; Index < TargetObjects.Num(); ++Index)
+    {
+        UObject* Object = TargetObjects[Index];
+        BeforeValues.Emplace(InPropertyPath.GetLeafProperty(), Object ? InPropertyPath.Resolve(Object) : nullptr);
+    }
+
+    TransactionBuffer.RecordEdit(TargetObjects, InPropertyPath, MoveTemp(BeforeValues));
+}
+
+void URapidPropertyEditor::BeginContinuousEdit()
+{
+    TransactionBuffer.BeginContinuousEdit();
+}
+
+void URapidPropertyEditor::EndContinuousEdit()
+{
+    TransactionBuffer.EndContinuousEdit();
+}
+
+void URapidPropertyEditor::HandleTransactionApplied(const FRapidPropertyTransaction& Transaction)
+{
+    RefreshPropertyWidgets(Transaction.PropertyPath);
+
+    // 记录中的每个对象通知一次
+    for (const TWeakObjectPtr<UObject>& Object : Transaction.Objects)
+    {
+        if (Object.IsValid())
+        {
+            OnPropertyPathChanged.Broadcast(Object.Get(), Transaction.PropertyPath);
+        }
+    }
+}
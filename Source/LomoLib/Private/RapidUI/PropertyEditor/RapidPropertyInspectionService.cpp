@@ -0,0 +1,461 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionService.h"
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionTransport.h"
+#include "RapidUI/PropertyEditor/RapidPropertySearchIndex.h"
+#include "Dom/JsonObject.h"
+#include "Policies/CondensedJsonPrintPolicy.h"
+#include "Serialization/JsonReader.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+#include "UObject/UObjectHash.h"
+
+namespace RapidPropertyInspectionServicePrivate
+{
+    /**
+     * 检查路径是否可以写入，规则与属性编辑器的控件相同
+     * 对象和结构体上的属性需要CPF_Edit且不能是CPF_EditConst或CPF_EditorOnly，容器元素跟随所在的容器
+     * 映射的键和集合的元素参与哈希，原地写入后哈希会失效，不能修改
+     * @return 不可写入时返回原因
+     */
+    FString CheckWritable(const FRapidPropertyPath& InPropertyPath)
+    {
+        const FProperty* ParentContainer = nullptr;
+        for (int32 Index = 0; Index < InPropertyPath.Num(); ++Index)
+        {
+            const FRapidPropertyPathSegment& Segment = InPropertyPath[Index];
+
+            // 映射的键直接修改后哈希会失效
+            const FMapProperty* ParentMap = CastField<FMapProperty>(ParentContainer);
+            if (ParentMap && Segment.Property == ParentMap->KeyProp)
+            {
+                return FString::Printf(TEXT("映射的键不能修改: %s"), *InPropertyPath.ToString());
+            }
+            if (CastField<FSetProperty>(ParentContainer))
+            {
+                return FString::Printf(TEXT("集合的元素不能修改: %s"), *InPropertyPath.ToString());
+            }
+
+            if (!ParentContainer)
+            {
+                if (!Segment.Property->HasAnyPropertyFlags(CPF_Edit) || Segment.Property->HasAnyPropertyFlags(CPF_EditorOnly))
+                {
+                    return FString::Printf(TEXT("属性不可编辑: %s"), *Segment.Property->GetName());
+                }
+                if (Segment.Property->HasAnyPropertyFlags(CPF_EditConst))
+                {
+                    return FString::Printf(TEXT("属性是只读的: %s"), *Segment.Property->GetName());
+                }
+            }
+
+            const bool bEntersContainer = Segment.Index != INDEX_NONE
+                && (Segment.Property->IsA<FArrayProperty>() || Segment.Property->IsA<FMapProperty>() || Segment.Property->IsA<FSetProperty>());
+            ParentContainer = bEntersContainer ? Segment.Property : nullptr;
+        }
+        return FString();
+    }
+}
+
+FRapidPropertyInspectionService::FRapidPropertyInspectionService(TUniquePtr<IRapidPropertyInspectionTransport>&& InTransport)
+    : Transport(MoveTemp(InTransport))
+{
+}
+
+FRapidPropertyInspectionService::~FRapidPropertyInspectionService()
+{
+    Stop();
+}
+
+bool FRapidPropertyInspectionService::Start()
+{
+    return Transport && Transport->Start();
+}
+
+void FRapidPropertyInspectionService::Stop()
+{
+    if (Transport)
+    {
+        Transport->Stop();
+    }
+    Watches.Empty();
+    WatchCursor = 0;
+}
+
+void FRapidPropertyInspectionService::Tick()
+{
+    check(IsInGameThread());
+
+    if (!Transport)
+    {
+        return;
+    }
+
+    PendingMessages.Reset();
+    DisconnectedClients.Reset();
+    Transport->Poll(PendingMessages, DisconnectedClients);
+
+    // 断开的客户端不再需要订阅
+    if (DisconnectedClients.Num() > 0)
+    {
+        Watches.RemoveAll([this](const FWatch& Watch)
+        {
+            return DisconnectedClients.Contains(Watch.ClientId);
+        });
+    }
+
+    for (const TPair<int32, FString>& Message : PendingMessages)
+    {
+        HandleMessage(Message.Key, Message.Value);
+    }
+
+    SendWatchDeltas();
+}
+
+void FRapidPropertyInspectionService::RegisterObject(const FString& InAlias, UObject* InObject)
+{
+    Aliases.Add(InAlias, InObject);
+}
+
+void FRapidPropertyInspectionService::UnregisterObject(const FString& InAlias)
+{
+    Aliases.Remove(InAlias);
+}
+
+void FRapidPropertyInspectionService::SetMaxWatchChecksPerTick(int32 InMaxWatchChecksPerTick)
+{
+    MaxWatchChecksPerTick = FMath::Max(1, InMaxWatchChecksPerTick);
+}
+
+void FRapidPropertyInspectionService::HandleMessage(int32 InClientId, const FString& InMessage)
+{
+    TSharedPtr<FJsonObject> Request;
+    const TSharedRef<TJsonReader<>> Reader = TJsonReaderFactory<>::Create(InMessage);
+
+    const TSharedRef<FJsonObject> Response = MakeShared<FJsonObject>();
+    FString Error;
+
+    if (!FJsonSerializer::Deserialize(Reader, Request) || !Request.IsValid())
+    {
+        Error = TEXT("无效的JSON");
+    }
+    else
+    {
+        double RequestId = 0.0;
+        if (Request->TryGetNumberField(TEXT("id"), RequestId))
+        {
+            Response->SetNumberField(TEXT("id"), RequestId);
+        }
+
+        const FString Operation = Request->GetStringField(TEXT("op"));
+        if (Operation == TEXT("find"))
+        {
+            Error = HandleFind(*Request, *Response);
+        }
+        else if (Operation == TEXT("layout"))
+        {
+            Error = HandleLayout(*Request, *Response);
+        }
+        else if (Operation == TEXT("get"))
+        {
+            Error = HandleGet(*Request, *Response);
+        }
+        else if (Operation == TEXT("set"))
+        {
+            Error = HandleSet(*Request, *Response);
+        }
+        else if (Operation == TEXT("watch"))
+        {
+            Error = HandleWatch(InClientId, *Request, *Response);
+        }
+        else if (Operation == TEXT("unwatch"))
+        {
+            Error = HandleUnwatch(InClientId, *Request, *Response);
+        }
+        else
+        {
+            Error = FString::Printf(TEXT("未知的操作: %s"), *Operation);
+        }
+    }
+
+    Response->SetBoolField(TEXT("ok"), Error.IsEmpty());
+    if (!Error.IsEmpty())
+    {
+        Response->SetStringField(TEXT("error"), Error);
+    }
+
+    Send(InClientId, Response);
+}
+
+FString FRapidPropertyInspectionService::HandleFind(const FJsonObject& InRequest, FJsonObject& OutResponse) const
+{
+    const FString ClassName = InRequest.GetStringField(TEXT("class"));
+    UClass* Class = FindObject<UClass>(nullptr, *ClassName);
+    if (!Class)
+    {
+        Class = FindFirstObject<UClass>(*ClassName, EFindFirstObjectOptions::NativeFirst);
+    }
+
+    if (!Class)
+    {
+        return FString::Printf(TEXT("找不到类: %s"), *ClassName);
+    }
+
+    int32 Limit = 100;
+    InRequest.TryGetNumberField(TEXT("limit"), Limit);
+    Limit = FMath::Clamp(Limit, 1, MaxFindResults);
+
+    TArray<UObject*> Objects;
+    GetObjectsOfClass(Class, Objects, true, RF_ClassDefaultObject | RF_ArchetypeObject, EInternalObjectFlags::Garbage);
+
+    TArray<TSharedPtr<FJsonValue>> ObjectPaths;
+    ObjectPaths.Reserve(FMath::Min(Limit, Objects.Num()));
+    for (int32 Index = 0; Index < Objects.Num() && ObjectPaths.Num() < Limit; ++Index)
+    {
+        ObjectPaths.Add(MakeShared<FJsonValueString>(Objects[Index]->GetPathName()));
+    }
+
+    OutResponse.SetArrayField(TEXT("objects"), ObjectPaths);
+    OutResponse.SetNumberField(TEXT("total"), Objects.Num());
+    return FString();
+}
+
+FString FRapidPropertyInspectionService::HandleLayout(const FJsonObject& InRequest, FJsonObject& OutResponse) const
+{
+    const FString ObjectName = InRequest.GetStringField(TEXT("object"));
+    UObject* Object = ResolveObject(ObjectName);
+    if (!Object)
+    {
+        return FString::Printf(TEXT("找不到对象: %s"), *ObjectName);
+    }
+
+    // 与属性编辑器使用同一份按类缓存的属性索引
+    const TSharedRef<const FRapidPropertySearchIndex> SearchIndex = FRapidPropertySearchIndex::Get(Object->GetClass());
+
+    TArray<TSharedPtr<FJsonValue>> Properties;
+    Properties.Reserve(SearchIndex->GetEntries().Num());
+    for (const FRapidPropertySearchEntry& Entry : SearchIndex->GetEntries())
+    {
+        const FProperty* LeafProperty = Entry.PropertyPath.GetLeafProperty();
+
+        TSharedRef<FJsonObject> PropertyObject = MakeShared<FJsonObject>();
+        PropertyObject->SetStringField(TEXT("path"), Entry.PropertyPath.ToString());
+        PropertyObject->SetStringField(TEXT("type"), LeafProperty->GetCPPType());
+        PropertyObject->SetNumberField(TEXT("parent"), Entry.ParentIndex);
+        Properties.Add(MakeShared<FJsonValueObject>(PropertyObject));
+    }
+
+    OutResponse.SetStringField(TEXT("class"), Object->GetClass()->GetPathName());
+    OutResponse.SetArrayField(TEXT("properties"), Properties);
+    return FString();
+}
+
+FString FRapidPropertyInspectionService::HandleGet(const FJsonObject& InRequest, FJsonObject& OutResponse) const
+{
+    UObject* Object = nullptr;
+    FRapidPropertyPath PropertyPath;
+    void* ValuePtr = nullptr;
+    const FString Error = ResolveRequestValue(InRequest, Object, PropertyPath, ValuePtr);
+    if (!Error.IsEmpty())
+    {
+        return Error;
+    }
+
+    FString ValueText;
+    PropertyPath.GetLeafProperty()->ExportText_Direct(ValueText, ValuePtr, ValuePtr, Object, PPF_None);
+    OutResponse.SetStringField(TEXT("value"), ValueText);
+    return FString();
+}
+
+FString FRapidPropertyInspectionService::HandleSet(const FJsonObject& InRequest, FJsonObject& OutResponse)
+{
+    UObject* Object = nullptr;
+    FRapidPropertyPath PropertyPath;
+    void* ValuePtr = nullptr;
+    const FString Error = ResolveRequestValue(InRequest, Object, PropertyPath, ValuePtr);
+    if (!Error.IsEmpty())
+    {
+        return Error;
+    }
+
+    // 属性编辑器中隐藏或只读的属性同样不能远程修改
+    const FString WritableError = RapidPropertyInspectionServicePrivate::CheckWritable(PropertyPath);
+    if (!WritableError.IsEmpty())
+    {
+        return WritableError;
+    }
+
+    FString ValueText;
+    if (!InRequest.TryGetStringField(TEXT("value"), ValueText))
+    {
+        return TEXT("缺少value");
+    }
+
+    // 先导入到临时值，失败时不修改对象
+    const FProperty* LeafProperty = PropertyPath.GetLeafProperty();
+    void* TempValue = FMemory::Malloc(LeafProperty->GetSize(), LeafProperty->GetMinAlignment());
+    LeafProperty->InitializeValue(TempValue);
+
+    const bool bImported = LeafProperty->ImportText_Direct(*ValueText, TempValue, Object, PPF_None, GLog) != nullptr;
+    if (bImported)
+    {
+        LeafProperty->CopyCompleteValue(ValuePtr, TempValue);
+    }
+
+    LeafProperty->DestroyValue(TempValue);
+    FMemory::Free(TempValue);
+
+    if (!bImported)
+    {
+        return FString::Printf(TEXT("无法解析值: %s"), *ValueText);
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("远程属性查看: %s.%s = %s"), *Object->GetName(), *PropertyPath.ToString(), *ValueText);
+    OnRemotePropertyChanged.Broadcast(Object, PropertyPath);
+    return FString();
+}
+
+FString FRapidPropertyInspectionService::HandleWatch(int32 InClientId, const FJsonObject& InRequest, FJsonObject& OutResponse)
+{
+    UObject* Object = nullptr;
+    FRapidPropertyPath PropertyPath;
+    void* ValuePtr = nullptr;
+    const FString Error = ResolveRequestValue(InRequest, Object, PropertyPath, ValuePtr);
+    if (!Error.IsEmpty())
+    {
+        return Error;
+    }
+
+    FWatch& Watch = Watches.AddDefaulted_GetRef();
+    Watch.WatchId = NextWatchId++;
+    Watch.ClientId = InClientId;
+    Watch.Object = Object;
+    Watch.PropertyPath = PropertyPath;
+    Watch.LastValue = FRapidPropertyValueBuffer(PropertyPath.GetLeafProperty(), ValuePtr);
+
+    FString ValueText;
+    PropertyPath.GetLeafProperty()->ExportText_Direct(ValueText, ValuePtr, ValuePtr, Object, PPF_None);
+    OutResponse.SetNumberField(TEXT("watch"), Watch.WatchId);
+    OutResponse.SetStringField(TEXT("value"), ValueText);
+    return FString();
+}
+
+FString FRapidPropertyInspectionService::HandleUnwatch(int32 InClientId, const FJsonObject& InRequest, FJsonObject& OutResponse)
+{
+    int32 WatchId = INDEX_NONE;
+    if (!InRequest.TryGetNumberField(TEXT("watch"), WatchId))
+    {
+        return TEXT("缺少watch");
+    }
+
+    const int32 NumRemoved = Watches.RemoveAll([InClientId, WatchId](const FWatch& Watch)
+    {
+        return Watch.ClientId == InClientId && Watch.WatchId == WatchId;
+    });
+
+    return NumRemoved > 0 ? FString() : FString::Printf(TEXT("找不到订阅: %d"), WatchId);
+}
+
+UObject* FRapidPropertyInspectionService::ResolveObject(const FString& InObjectName) const
+{
+    if (const TWeakObjectPtr<UObject>* AliasObject = Aliases.Find(InObjectName))
+    {
+        return AliasObject->Get();
+    }
+
+    UObject* Object = FindObject<UObject>(nullptr, *InObjectName);
+    return IsValid(Object) ? Object : nullptr;
+}
+
+FString FRapidPropertyInspectionService::ResolveRequestValue(const FJsonObject& InRequest, UObject*& OutObject, FRapidPropertyPath& OutPropertyPath, void*& OutValuePtr) const
+{
+    const FString ObjectName = InRequest.GetStringField(TEXT("object"));
+    OutObject = ResolveObject(ObjectName);
+    if (!OutObject)
+    {
+        return FString::Printf(TEXT("找不到对象: %s"), *ObjectName);
+    }
+
+    const FString PathText = InRequest.GetStringField(TEXT("path"));
+    if (!FRapidPropertyPath::Parse(OutObject->GetClass(), PathText, OutPropertyPath))
+    {
+        return FString::Printf(TEXT("无效的属性路径: %s"), *PathText);
+    }
+
+    OutValuePtr = OutPropertyPath.Resolve(OutObject);
+    if (!OutValuePtr)
+    {
+        return FString::Printf(TEXT("无法解析属性地址: %s"), *PathText);
+    }
+
+    return FString();
+}
+
+void FRapidPropertyInspectionService::SendWatchDeltas()
+{
+    if (Watches.Num() == 0)
+    {
+        return;
+    }
+
+    TMap<int32, TArray<TSharedPtr<FJsonValue>>> ChangesByClient;
+
+    // 每帧只检查一部分订阅，从上一帧停下的位置继续
+    int32 NumChecks = FMath::Min(Watches.Num(), MaxWatchChecksPerTick);
+    while (NumChecks-- > 0 && Watches.Num() > 0)
+    {
+        if (WatchCursor >= Watches.Num())
+        {
+            WatchCursor = 0;
+        }
+
+        FWatch& Watch = Watches[WatchCursor];
+        UObject* Object = Watch.Object.Get();
+        const void* ValuePtr = Object ? Watch.PropertyPath.Resolve(Object) : nullptr;
+
+        TSharedRef<FJsonObject> Change = MakeShared<FJsonObject>();
+        Change->SetNumberField(TEXT("watch"), Watch.WatchId);
+
+        if (!ValuePtr)
+        {
+            // 对象已销毁或容器元素已失效，通知客户端后移除订阅
+            Change->SetBoolField(TEXT("removed"), true);
+            ChangesByClient.FindOrAdd(Watch.ClientId).Add(MakeShared<FJsonValueObject>(Change));
+            Watches.RemoveAtSwap(WatchCursor);
+            continue;
+        }
+
+        ++WatchCursor;
+        if (Watch.LastValue.Identical(ValuePtr))
+        {
+            continue;
+        }
+
+        const FProperty* LeafProperty = Watch.PropertyPath.GetLeafProperty();
+        Watch.LastValue = FRapidPropertyValueBuffer(LeafProperty, ValuePtr);
+
+        FString ValueText;
+        LeafProperty->ExportText_Direct(ValueText, ValuePtr, ValuePtr, Object, PPF_None);
+        Change->SetStringField(TEXT("value"), ValueText);
+        ChangesByClient.FindOrAdd(Watch.ClientId).Add(MakeShared<FJsonValueObject>(Change));
+    }
+
+    // 每个客户端每帧只发送一条消息
+    for (TPair<int32, TArray<TSharedPtr<FJsonValue>>>& Pair : ChangesByClient)
+    {
+        const TSharedRef<FJsonObject> Delta = MakeShared<FJsonObject>();
+        Delta->SetStringField(TEXT("op"), TEXT("delta"));
+        Delta->SetNumberField(TEXT("frame"), static_cast<double>(GFrameCounter));
+        Delta->SetArrayField(TEXT("changes"), Pair.Value);
+        Send(Pair.Key, Delta);
+    }
+}
+
+void FRapidPropertyInspectionService::Send(int32 InClientId, const TSharedRef<FJsonObject>& InMessage) const
+{
+    // 每条消息占一行，使用紧凑格式
+    FString MessageText;
+    const TSharedRef<TJsonWriter<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>> Writer = TJsonWriterFactory<TCHAR, TCondensedJsonPrintPolicy<TCHAR>>::Create(&MessageText);
+    FJsonSerializer::Serialize(InMessage, Writer);
+
+    Transport->Send(InClientId, MessageText);
+}
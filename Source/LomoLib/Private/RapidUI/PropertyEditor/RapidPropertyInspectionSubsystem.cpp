@@ -0,0 +1,76 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionSubsystem.h"
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionService.h"
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionTransport.h"
+#include "Misc/CommandLine.h"
+#include "Misc/Parse.h"
+
+bool URapidPropertyInspectionSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+#if UE_BUILD_SHIPPING
+    return false;
+#else
+    int32 Port = 0;
+    return GetPortFromCommandLine(Port) && Super::ShouldCreateSubsystem(Outer);
+#endif
+}
+
+void URapidPropertyInspectionSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+    Super::Initialize(Collection);
+
+    int32 Port = 0;
+    if (!GetPortFromCommandLine(Port))
+    {
+        return;
+    }
+
+    Service = MakeUnique<FRapidPropertyInspectionService>(MakeUnique<FRapidPropertyInspectionTcpTransport>(Port));
+    if (!Service->Start())
+    {
+        Service.Reset();
+    }
+}
+
+void URapidPropertyInspectionSubsystem::Deinitialize()
+{
+    Service.Reset();
+    Super::Deinitialize();
+}
+
+void URapidPropertyInspectionSubsystem::Tick(float DeltaTime)
+{
+    Service->Tick();
+}
+
+bool URapidPropertyInspectionSubsystem::IsTickable() const
+{
+    return Service.IsValid() && !IsTemplate();
+}
+
+TStatId URapidPropertyInspectionSubsystem::GetStatId() const
+{
+    RETURN_QUICK_DECLARE_CYCLE_STAT(URapidPropertyInspectionSubsystem, STATGROUP_Tickables);
+}
+
+void URapidPropertyInspectionSubsystem::RegisterInspectedObject(const FString& Alias, UObject* Object)
+{
+    if (Service)
+    {
+        Service->RegisterObject(Alias, Object);
+    }
+}
+
+void URapidPropertyInspectionSubsystem::UnregisterInspectedObject(const FString& Alias)
+{
+    if (Service)
+    {
+        Service->UnregisterObject(Alias);
+    }
+}
+
+bool URapidPropertyInspectionSubsystem::GetPortFromCommandLine(int32& OutPort)
+{
+    return FParse::Value(FCommandLine::Get(), TEXT("RapidInspectPort="), OutPort) && OutPort > 0 && OutPort < 65536;
+}
@@ -0,0 +1,203 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertyInspectionTransport.h"
+#include "Common/TcpSocketBuilder.h"
+#include "Interfaces/IPv4/IPv4Address.h"
+#include "Interfaces/IPv4/IPv4Endpoint.h"
+#include "Sockets.h"
+#include "SocketSubsystem.h"
+
+FRapidPropertyInspectionTcpTransport::FRapidPropertyInspectionTcpTransport(int32 InPort)
+    : Port(InPort)
+{
+}
+
+FRapidPropertyInspectionTcpTransport::~FRapidPropertyInspectionTcpTransport()
+{
+    Stop();
+}
+
+bool FRapidPropertyInspectionTcpTransport::Start()
+{
+    if (ListenSocket)
+    {
+        return true;
+    }
+
+    // 只绑定本机地址，不对外网开放
+    ListenSocket = FTcpSocketBuilder(TEXT("RapidPropertyInspection"))
+        .AsNonBlocking()
+        .AsReusable()
+        .BoundToEndpoint(FIPv4Endpoint(FIPv4Address(127, 0, 0, 1), Port))
+        .Listening(8)
+        .Build();
+
+    if (!ListenSocket)
+    {
+        UE_LOG(LogTemp, Error, TEXT("远程属性查看: 无法监听端口 %d"), Port);
+        return false;
+    }
+
+    UE_LOG(LogTemp, Log, TEXT("远程属性查看: 正在监听 127.0.0.1:%d"), Port);
+    return true;
+}
+
+void FRapidPropertyInspectionTcpTransport::Stop()
+{
+    for (TPair<int32, FClient>& Pair : Clients)
+    {
+        DestroyClient(Pair.Value);
+    }
+    Clients.Empty();
+
+    if (ListenSocket)
+    {
+        ListenSocket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(ListenSocket);
+        ListenSocket = nullptr;
+    }
+}
+
+void FRapidPropertyInspectionTcpTransport::Poll(TArray<TPair<int32, FString>>& OutMessages, TArray<int32>& OutDisconnectedClients)
+{
+    if (!ListenSocket)
+    {
+        return;
+    }
+
+    // 接受新连接
+    bool bHasPendingConnection = false;
+    while (ListenSocket->HasPendingConnection(bHasPendingConnection) && bHasPendingConnection)
+    {
+        FSocket* ClientSocket = ListenSocket->Accept(TEXT("RapidPropertyInspectionClient"));
+        if (!ClientSocket)
+        {
+            break;
+        }
+
+        ClientSocket->SetNonBlocking(true);
+        FClient& Client = Clients.Add(NextClientId++);
+        Client.Socket = ClientSocket;
+    }
+
+    // 发送缓存的数据并读取消息
+    for (auto It = Clients.CreateIterator(); It; ++It)
+    {
+        FClient& Client = It.Value();
+        const bool bConnected = Client.SendBuffer.Num() <= MaxPendingSendBytes
+            && FlushClient(Client)
+            && ReceiveClient(It.Key(), Client, OutMessages);
+
+        if (!bConnected)
+        {
+            OutDisconnectedClients.Add(It.Key());
+            DestroyClient(Client);
+            It.RemoveCurrent();
+        }
+    }
+}
+
+void FRapidPropertyInspectionTcpTransport::Send(int32 InClientId, const FString& InMessage)
+{
+    FClient* Client = Clients.Find(InClientId);
+    if (!Client || Client->SendBuffer.Num() > MaxPendingSendBytes)
+    {
+        return;
+    }
+
+    const FTCHARToUTF8 Converter(*InMessage, InMessage.Len());
+    Client->SendBuffer.Append(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length());
+    Client->SendBuffer.Add('\n');
+
+    // 立即尝试发送，发不完的部分在下一次Poll时继续；出错时由下一次Poll断开
+    FlushClient(*Client);
+}
+
+bool FRapidPropertyInspectionTcpTransport::FlushClient(FClient& InClient)
+{
+    if (InClient.SendBuffer.Num() == 0)
+    {
+        return true;
+    }
+
+    int32 BytesSent = 0;
+    if (!InClient.Socket->Send(InClient.SendBuffer.GetData(), InClient.SendBuffer.Num(), BytesSent))
+    {
+        // 非阻塞套接字的发送缓冲区已满，等待下一次发送
+        return ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->GetLastErrorCode() == SE_EWOULDBLOCK;
+    }
+
+    if (BytesSent > 0)
+    {
+        InClient.SendBuffer.RemoveAt(0, BytesSent);
+    }
+    return true;
+}
+
+bool FRapidPropertyInspectionTcpTransport::ReceiveClient(int32 InClientId, FClient& InClient, TArray<TPair<int32, FString>>& OutMessages)
+{
+    if (InClient.Socket->GetConnectionState() != SCS_Connected)
+    {
+        return false;
+    }
+
+    uint32 PendingSize = 0;
+    while (InClient.Socket->HasPendingData(PendingSize) && PendingSize > 0)
+    {
+        const int32 Offset = InClient.ReceiveBuffer.Num();
+        const int32 ReadSize = static_cast<int32>(FMath::Min<uint32>(PendingSize, 64 * 1024));
+        InClient.ReceiveBuffer.AddUninitialized(ReadSize);
+
+        int32 BytesRead = 0;
+        if (!InClient.Socket->Recv(InClient.ReceiveBuffer.GetData() + Offset, ReadSize, BytesRead))
+        {
+            return false;
+        }
+
+        InClient.ReceiveBuffer.SetNumUninitialized(Offset + BytesRead);
+        if (BytesRead == 0)
+        {
+            break;
+        }
+    }
+
+    // 按换行拆分消息，最后不完整的一行留到下次
+    int32 LineStart = 0;
+    for (int32 Index = 0; Index < InClient.ReceiveBuffer.Num(); ++Index)
+    {
+        if (InClient.ReceiveBuffer[Index] != '\n')
+        {
+            continue;
+        }
+
+        int32 LineLength = Index - LineStart;
+        if (LineLength > 0 && InClient.ReceiveBuffer[Index - 1] == '\r')
+        {
+            --LineLength;
+        }
+
+        if (LineLength > 0)
+        {
+            const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(InClient.ReceiveBuffer.GetData() + LineStart), LineLength);
+            OutMessages.Emplace(InClientId, FString(Converter.Length(), Converter.Get()));
+        }
+        LineStart = Index + 1;
+    }
+
+    if (LineStart > 0)
+    {
+        InClient.ReceiveBuffer.RemoveAt(0, LineStart);
+    }
+
+    return InClient.ReceiveBuffer.Num() <= MaxMessageBytes;
+}
+
+void FRapidPropertyInspectionTcpTransport::DestroyClient(FClient& InClient)
+{
+    if (InClient.Socket)
+    {
+        InClient.Socket->Close();
+        ISocketSubsystem::Get(PLATFORM_SOCKETSUBSYSTEM)->DestroySocket(InClient.Socket);
+        InClient.Socket = nullptr;
+    }
+}
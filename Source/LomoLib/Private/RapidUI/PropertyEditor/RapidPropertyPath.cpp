@@ -0,0 +1,367 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+
+FRapidPropertyPath::FRapidPropertyPath(FProperty* InRootProperty)
+{
+    Segments.Emplace(InRootProperty);
+}
+
+FRapidPropertyPath FRapidPropertyPath::GetChildPath(FProperty* InChildProperty) const
+{
+    FRapidPropertyPath ChildPath(*this);
+    ChildPath.Push(InChildProperty);
+    return ChildPath;
+}
+
+FRapidPropertyPath FRapidPropertyPath::GetElementPath(int32 InIndex, FProperty* InElementProperty) const
+{
+    FRapidPropertyPath ElementPath(*this);
+    if (ElementPath.Segments.Num() > 0)
+    {
+        ElementPath.Segments.Last().Index = InIndex;
+    }
+    ElementPath.Push(InElementProperty);
+    return ElementPath;
+}
+
+void FRapidPropertyPath::Push(FProperty* InProperty, int32 InIndex)
+{
+    Segments.Emplace(InProperty, InIndex);
+}
+
+void FRapidPropertyPath::Pop()
+{
+    if (Segments.Num() > 0)
+    {
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 4
+        Segments.Pop(EAllowShrinking::No);
+#else
+        Segments.Pop(false);
+#endif
+    }
+}
+
+int32 FRapidPropertyPath::FindMapKeySegment() const
+{
+    for (int32 Index = 0; Index + 1 < Segments.Num(); ++Index)
+    {
+        const FMapProperty* MapProperty = CastField<FMapProperty>(Segments[Index].Property);
+        if (MapProperty && Segments[Index].Index != INDEX_NONE && Segments[Index + 1].Property == MapProperty->KeyProp)
+        {
+            return Index;
+        }
+    }
+    return INDEX_NONE;
+}
+
+FProperty* FRapidPropertyPath::GetRootProperty() const
+{
+    return Segments.Num() > 0 ? Segments[0].Property : nullptr;
+}
+
+FProperty* FRapidPropertyPath::GetLeafProperty() const
+{
+    return Segments.Num() > 0 ? Segments.Last().Property : nullptr;
+}
+
+void* FRapidPropertyPath::Resolve(void* InContainer) const
+{
+    uint8* ValuePtr = static_cast<uint8*>(InContainer);
+
+    for (const FRapidPropertyPathSegment& Segment : Segments)
+    {
+        if (!ValuePtr || !Segment.Property)
+        {
+            return nullptr;
+        }
+
+        if (Segment.Index == INDEX_NONE)
+        {
+            ValuePtr = Segment.Property->ContainerPtrToValuePtr<uint8>(ValuePtr);
+            continue;
+        }
+
+        // 进入容器元素
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Segment.Property))
+        {
+            FScriptArrayHelper ArrayHelper(ArrayProperty, ArrayProperty->ContainerPtrToValuePtr<void>(ValuePtr));
+            ValuePtr = ArrayHelper.IsValidIndex(Segment.Index) ? ArrayHelper.GetRawPtr(Segment.Index) : nullptr;
+        }
+        else if (const FMapProperty* MapProperty = CastField<FMapProperty>(Segment.Property))
+        {
+            FScriptMapHelper MapHelper(MapProperty, MapProperty->ContainerPtrToValuePtr<void>(ValuePtr));
+            ValuePtr = MapHelper.IsValidIndex(Segment.Index) ? MapHelper.GetPairPtr(Segment.Index) : nullptr;
+        }
+        else if (const FSetProperty* SetProperty = CastField<FSetProperty>(Segment.Property))
+        {
+            FScriptSetHelper SetHelper(SetProperty, SetProperty->ContainerPtrToValuePtr<void>(ValuePtr));
+            ValuePtr = SetHelper.IsValidIndex(Segment.Index) ? SetHelper.GetElementPtr(Segment.Index) : nullptr;
+        }
+        else
+        {
+            // 静态数组
+            ValuePtr = Segment.Index < Segment.Property->ArrayDim
+                ? Segment.Property->ContainerPtrToValuePtr<uint8>(ValuePtr, Segment.Index)
+                : nullptr;
+        }
+    }
+
+    return ValuePtr;
+}
+
+const void* FRapidPropertyPath::Resolve(const void* InContainer) const
+{
+    return Resolve(const_cast<void*>(InContainer));
+}
+
+bool FRapidPropertyPath::IsCompatibleWith(const UStruct* InRootStruct) const
+{
+    const UStruct* OwnerStruct = InRootStruct;
+    const FProperty* ParentContainer = nullptr;
+
+    for (const FRapidPropertyPathSegment& Segment : Segments)
+    {
+        if (!Segment.Property)
+        {
+            return false;
+        }
+
+        // 上一段进入了容器元素，当前属性必须是该容器的元素属性
+        if (ParentContainer)
+        {
+            bool bIsElement = false;
+            if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(ParentContainer))
+            {
+                bIsElement = Segment.Property == ArrayProperty->Inner;
+            }
+            else if (const FMapProperty* MapProperty = CastField<FMapProperty>(ParentContainer))
+            {
+                bIsElement = Segment.Property == MapProperty->KeyProp || Segment.Property == MapProperty->ValueProp;
+            }
+            else if (const FSetProperty* SetProperty = CastField<FSetProperty>(ParentContainer))
+            {
+                bIsElement = Segment.Property == SetProperty->ElementProp;
+            }
+
+            if (!bIsElement)
+            {
+                return false;
+            }
+        }
+        else
+        {
+            const UStruct* PropertyOwner = Segment.Property->GetOwnerStruct();
+            if (!OwnerStruct || !PropertyOwner || !OwnerStruct->IsChildOf(PropertyOwner))
+            {
+                return false;
+            }
+        }
+
+        const bool bEntersDynamicContainer = Segment.Index != INDEX_NONE
+            && (Segment.Property->IsA<FArrayProperty>() || Segment.Property->IsA<FMapProperty>() || Segment.Property->IsA<FSetProperty>());
+        if (Segment.Index != INDEX_NONE && !bEntersDynamicContainer && Segment.Index >= Segment.Property->ArrayDim)
+        {
+            return false;
+        }
+
+        ParentContainer = bEntersDynamicContainer ? Segment.Property : nullptr;
+        const FStructProperty* StructProperty = CastField<FStructProperty>(Segment.Property);
+        OwnerStruct = StructProperty ? StructProperty->Struct : nullptr;
+    }
+
+    return Segments.Num() > 0;
+}
+
+int32 FRapidPropertyPath::GetFixedOffset() const
+{
+    int32 Offset = 0;
+
+    for (const FRapidPropertyPathSegment& Segment : Segments)
+    {
+        if (!Segment.Property)
+        {
+            return INDEX_NONE;
+        }
+
+        if (Segment.Index != INDEX_NONE
+            && (Segment.Property->IsA<FArrayProperty>() || Segment.Property->IsA<FMapProperty>() || Segment.Property->IsA<FSetProperty>()))
+        {
+            return INDEX_NONE;
+        }
+
+        // 静态数组元素的偏移也是固定的
+        Offset += Segment.Property->GetOffset_ForInternal() + (Segment.Index == INDEX_NONE ? 0 : Segment.Index * (Segment.Property->GetSize() / Segment.Property->ArrayDim));
+    }
+
+    return Segments.Num() > 0 ? Offset : INDEX_NONE;
+}
+
+bool FRapidPropertyPath::StartsWith(const FRapidPropertyPath& InPrefix) const
+{
+    if (InPrefix.Segments.Num() > Segments.Num())
+    {
+        return false;
+    }
+
+    for (int32 Index = 0; Index < InPrefix.Segments.Num(); ++Index)
+    {
+        const FRapidPropertyPathSegment& PrefixSegment = InPrefix.Segments[Index];
+        const FRapidPropertyPathSegment& Segment = Segments[Index];
+
+        // 前缀的最后一段没有进入容器时，匹配该容器下的所有元素
+        const bool bIsLastPrefixSegment = Index == InPrefix.Segments.Num() - 1;
+        if (PrefixSegment.Property != Segment.Property
+            || (PrefixSegment.Index != Segment.Index && !(bIsLastPrefixSegment && PrefixSegment.Index == INDEX_NONE)))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+FString FRapidPropertyPath::ToString() const
+{
+    TStringBuilder<256> Builder;
+    const FProperty* ParentContainer = nullptr;
+
+    for (const FRapidPropertyPathSegment& Segment : Segments)
+    {
+        if (!Segment.Property)
+        {
+            Builder << TEXT("<null>");
+            break;
+        }
+
+        if (const FMapProperty* ParentMap = CastField<FMapProperty>(ParentContainer))
+        {
+            Builder << (Segment.Property == ParentMap->ValueProp ? TEXT(".Value") : TEXT(".Key"));
+        }
+        else if (!ParentContainer)
+        {
+            // 数组和集合的元素属性没有独立的名字，只显示下标
+            if (Builder.Len() > 0)
+            {
+                Builder << TEXT('.');
+            }
+            Builder << Segment.Property->GetFName();
+        }
+
+        if (Segment.Index != INDEX_NONE)
+        {
+            Builder << TEXT('[') << Segment.Index << TEXT(']');
+        }
+
+        const bool bEntersContainer = Segment.Index != INDEX_NONE
+            && (Segment.Property->IsA<FArrayProperty>() || Segment.Property->IsA<FMapProperty>() || Segment.Property->IsA<FSetProperty>());
+        ParentContainer = bEntersContainer ? Segment.Property : nullptr;
+    }
+
+    return FString(Builder.ToString());
+}
+
+bool FRapidPropertyPath::Parse(const UStruct* InRootStruct, FStringView InText, FRapidPropertyPath& OutPath)
+{
+    OutPath = FRapidPropertyPath();
+
+    const UStruct* CurrentStruct = InRootStruct;
+    const FMapProperty* ParentMap = nullptr;
+
+    while (!InText.IsEmpty())
+    {
+        // 取出一段名称
+        int32 NameLength = 0;
+        while (NameLength < InText.Len() && InText[NameLength] != TEXT('.') && InText[NameLength] != TEXT('['))
+        {
+            ++NameLength;
+        }
+        const FStringView Name = InText.Left(NameLength);
+        InText.RightChopInline(NameLength);
+
+        // 可选的下标
+        int32 Index = INDEX_NONE;
+        if (InText.StartsWith(TEXT('[')))
+        {
+            int32 Position = 1;
+            int64 Value = 0;
+            while (Position < InText.Len() && FChar::IsDigit(InText[Position]) && Value <= MAX_int32)
+            {
+                Value = Value * 10 + (InText[Position] - TEXT('0'));
+                ++Position;
+            }
+
+            if (Position == 1 || Position >= InText.Len() || InText[Position] != TEXT(']') || Value > MAX_int32)
+            {
+                return false;
+            }
+
+            Index = static_cast<int32>(Value);
+            InText.RightChopInline(Position + 1);
+        }
+
+        // 映射元素之后是Key或Value，其他情况在当前结构体中查找属性
+        FProperty* Property = nullptr;
+        if (ParentMap)
+        {
+            Property = Name == TEXT("Key") ? ParentMap->KeyProp : (Name == TEXT("Value") ? ParentMap->ValueProp : nullptr);
+            ParentMap = nullptr;
+        }
+        else if (CurrentStruct && !Name.IsEmpty())
+        {
+            const FName PropertyName(Name.Len(), Name.GetData(), FNAME_Find);
+            Property = PropertyName.IsNone() ? nullptr : CurrentStruct->FindPropertyByName(PropertyName);
+        }
+
+        if (!Property)
+        {
+            return false;
+        }
+
+        OutPath.Push(Property, Index);
+
+        // 数组和集合的元素属性没有名字，直接追加
+        FProperty* ValueProperty = Property;
+        if (Index != INDEX_NONE)
+        {
+            if (FArrayProperty* ArrayProperty = CastField<FArrayProperty>(Property))
+            {
+                ValueProperty = ArrayProperty->Inner;
+                OutPath.Push(ValueProperty);
+            }
+            else if (FSetProperty* SetProperty = CastField<FSetProperty>(Property))
+            {
+                ValueProperty = SetProperty->ElementProp;
+                OutPath.Push(ValueProperty);
+            }
+            else if (FMapProperty* MapProperty = CastField<FMapProperty>(Property))
+            {
+                ParentMap = MapProperty;
+                ValueProperty = nullptr;
+            }
+            else if (Index >= Property->ArrayDim)
+            {
+                return false;
+            }
+        }
+
+        const FStructProperty* StructProperty = CastField<FStructProperty>(ValueProperty);
+        CurrentStruct = StructProperty ? StructProperty->Struct : nullptr;
+
+        if (InText.StartsWith(TEXT('.')))
+        {
+            InText.RightChopInline(1);
+            if (InText.IsEmpty())
+            {
+                return false;
+            }
+        }
+        else if (!InText.IsEmpty())
+        {
+            return false;
+        }
+    }
+
+    // 映射元素必须指明Key或Value
+    return OutPath.IsValid() && !ParentMap;
+}
@@ -0,0 +1,189 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertySearchIndex.h"
+#include "UObject/ObjectKey.h"
+
+TSharedRef<const FRapidPropertySearchIndex> FRapidPropertySearchIndex::Get(const UStruct* InStruct)
+{
+    static TMap<TObjectKey<UStruct>, TSharedRef<const FRapidPropertySearchIndex>> CachedIndices;
+
+    check(IsInGameThread());
+
+    if (const TSharedRef<const FRapidPropertySearchIndex>* CachedIndex = CachedIndices.Find(InStruct))
+    {
+        return *CachedIndex;
+    }
+
+    TSharedRef<FRapidPropertySearchIndex> NewIndex = MakeShared<FRapidPropertySearchIndex>();
+    if (InStruct)
+    {
+        NewIndex->Build(InStruct, nullptr, INDEX_NONE);
+
+        // 蓝图类和用户定义结构体重新编译后属性会被替换，不缓存
+        if (!InStruct->GetPackage()->HasAnyPackageFlags(PKG_CompiledIn))
+        {
+            return NewIndex;
+        }
+    }
+
+    CachedIndices.Add(InStruct, NewIndex);
+    return NewIndex;
+}
+
+int32 FRapidPropertySearchIndex::FindEntry(const FRapidPropertyPath& InPropertyPath) const
+{
+    const int32* EntryIndex = PathToEntry.Find(InPropertyPath);
+    return EntryIndex ? *EntryIndex : INDEX_NONE;
+}
+
+void FRapidPropertySearchIndex::Build(const UStruct* InStruct, const FRapidPropertyPath* InParentPath, int32 InParentIndex)
+{
+    for (TFieldIterator<FProperty> It(InStruct); It; ++It)
+    {
+        FProperty* Property = *It;
+
+        // 与属性编辑器保持一致，跳过不可编辑和仅编辑器可见的属性
+        if (!Property->HasAnyPropertyFlags(CPF_Edit) || Property->HasAnyPropertyFlags(CPF_EditorOnly))
+        {
+            continue;
+        }
+
+        const FRapidPropertyPath PropertyPath = InParentPath ? InParentPath->GetChildPath(Property) : FRapidPropertyPath(Property);
+
+        const int32 EntryIndex = Entries.AddDefaulted();
+        {
+            FRapidPropertySearchEntry& Entry = Entries[EntryIndex];
+            Entry.PropertyPath = PropertyPath;
+            Entry.ParentIndex = InParentIndex;
+
+            Entry.SearchText = Property->GetName();
+            if (Property->HasMetaData(TEXT("DisplayName")))
+            {
+                Entry.SearchText += TEXT('\n');
+                Entry.SearchText += Property->GetMetaData(TEXT("DisplayName"));
+            }
+            if (Property->HasMetaData(TEXT("Category")))
+            {
+                Entry.SearchText += TEXT('\n');
+                Entry.SearchText += Property->GetMetaData(TEXT("Category"));
+            }
+            Entry.SearchText.ToLowerInline();
+        }
+
+        PathToEntry.Add(PropertyPath, EntryIndex);
+
+        // 展开嵌套结构体的字段
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(Property))
+        {
+            Build(StructProperty->Struct, &PropertyPath, EntryIndex);
+        }
+
+        Entries[EntryIndex].SubtreeEnd = Entries.Num();
+    }
+}
+
+void FRapidPropertySearchFilter::SetIndex(const TSharedPtr<const FRapidPropertySearchIndex>& InIndex)
+{
+    if (Index == InIndex)
+    {
+        return;
+    }
+
+    Index = InIndex;
+
+    // 新索引上重新完整计算
+    const FString CurrentSearchText = MoveTemp(SearchText);
+    SearchText.Reset();
+    Matched.Empty();
+    Visible.Empty();
+    SetSearchText(CurrentSearchText);
+}
+
+void FRapidPropertySearchFilter::SetSearchText(const FString& InSearchText)
+{
+    FString NewSearchText = InSearchText.TrimStartAndEnd().ToLower();
+    if (NewSearchText == SearchText && Matched.Num() == (Index ? Index->GetEntries().Num() : 0))
+    {
+        return;
+    }
+
+    if (NewSearchText.IsEmpty() || !Index)
+    {
+        SearchText = MoveTemp(NewSearchText);
+        Matched.Empty();
+        Visible.Empty();
+        return;
+    }
+
+    const TArray<FRapidPropertySearchEntry>& Entries = Index->GetEntries();
+    const bool bHasPreviousResult = !SearchText.IsEmpty() && Matched.Num() == Entries.Num();
+
+    if (bHasPreviousResult && NewSearchText.StartsWith(SearchText, ESearchCase::CaseSensitive))
+    {
+        // 追加字符：匹配集只会缩小，只测试之前匹配的项
+        for (TConstSetBitIterator<> It(Matched); It; ++It)
+        {
+            if (!Entries[It.GetIndex()].SearchText.Contains(NewSearchText, ESearchCase::CaseSensitive))
+            {
+                Matched[It.GetIndex()] = false;
+            }
+        }
+    }
+    else if (bHasPreviousResult && SearchText.StartsWith(NewSearchText, ESearchCase::CaseSensitive))
+    {
+        // 删除字符：匹配集只会扩大，只测试之前不匹配的项
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+        {
+            if (!Matched[EntryIndex] && Entries[EntryIndex].SearchText.Contains(NewSearchText, ESearchCase::CaseSensitive))
+            {
+                Matched[EntryIndex] = true;
+            }
+        }
+    }
+    else
+    {
+        Matched.Init(false, Entries.Num());
+        for (int32 EntryIndex = 0; EntryIndex < Entries.Num(); ++EntryIndex)
+        {
+            if (Entries[EntryIndex].SearchText.Contains(NewSearchText, ESearchCase::CaseSensitive))
+            {
+                Matched[EntryIndex] = true;
+            }
+        }
+    }
+
+    SearchText = MoveTemp(NewSearchText);
+    UpdateVisibility();
+}
+
+bool FRapidPropertySearchFilter::IsEntryVisible(int32 InEntryIndex) const
+{
+    if (!IsActive() || !Visible.IsValidIndex(InEntryIndex))
+    {
+        return true;
+    }
+
+    return Visible[InEntryIndex];
+}
+
+void FRapidPropertySearchFilter::UpdateVisibility()
+{
+    const TArray<FRapidPropertySearchEntry>& Entries = Index->GetEntries();
+    Visible.Init(false, Entries.Num());
+
+    // 按下标升序处理，祖先项一定先于子孙项
+    for (TConstSetBitIterator<> It(Matched); It; ++It)
+    {
+        const int32 EntryIndex = It.GetIndex();
+        const FRapidPropertySearchEntry& Entry = Entries[EntryIndex];
+
+        // 匹配项的整个子树可见
+        Visible.SetRange(EntryIndex, Entry.SubtreeEnd - EntryIndex, true);
+
+        // 祖先可见，遇到已可见的祖先时其上层也一定已经可见
+        for (int32 ParentIndex = Entry.ParentIndex; ParentIndex != INDEX_NONE && !Visible[ParentIndex]; ParentIndex = Entries[ParentIndex].ParentIndex)
+        {
+            Visible[ParentIndex] = true;
+        }
+    }
+}
@@ -0,0 +1,367 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "RapidUI/PropertyEditor/RapidPropertyTransactionBuffer.h"
+#include "Algo/AllOf.h"
+
+namespace RapidPropertyTransactionPrivate
+{
+    /** 估算属性值在堆上占用的内存，只统计常见的字符串和容器 */
+    SIZE_T GetHeapSize(const FProperty* InProperty, const void* InValuePtr)
+    {
+        if (const FStrProperty* StrProperty = CastField<FStrProperty>(InProperty))
+        {
+            return StrProperty->GetPropertyValue(InValuePtr).GetAllocatedSize();
+        }
+
+        if (const FArrayProperty* ArrayProperty = CastField<FArrayProperty>(InProperty))
+        {
+            FScriptArrayHelper ArrayHelper(ArrayProperty, InValuePtr);
+            SIZE_T Size = static_cast<SIZE_T>(ArrayHelper.Num()) * ArrayProperty->Inner->GetSize();
+            if (!(ArrayProperty->Inner->PropertyFlags & CPF_IsPlainOldData))
+            {
+                for (int32 Index = 0; Index < ArrayHelper.Num(); ++Index)
+                {
+                    Size += GetHeapSize(ArrayProperty->Inner, ArrayHelper.GetRawPtr(Index));
+                }
+            }
+            return Size;
+        }
+
+        if (const FMapProperty* MapProperty = CastField<FMapProperty>(InProperty))
+        {
+            FScriptMapHelper MapHelper(MapProperty, InValuePtr);
+            return static_cast<SIZE_T>(MapHelper.GetMaxIndex()) * MapProperty->MapLayout.SetLayout.Size;
+        }
+
+        if (const FSetProperty* SetProperty = CastField<FSetProperty>(InProperty))
+        {
+            FScriptSetHelper SetHelper(SetProperty, InValuePtr);
+            return static_cast<SIZE_T>(SetHelper.GetMaxIndex()) * SetProperty->SetLayout.Size;
+        }
+
+        if (const FStructProperty* StructProperty = CastField<FStructProperty>(InProperty))
+        {
+            if (StructProperty->PropertyFlags & CPF_IsPlainOldData)
+            {
+                return 0;
+            }
+
+            SIZE_T Size = 0;
+            for (TFieldIterator<FProperty> It(StructProperty->Struct); It; ++It)
+            {
+                Size += GetHeapSize(*It, It->ContainerPtrToValuePtr<void>(InValuePtr));
+            }
+            return Size;
+        }
+
+        return 0;
+    }
+}
+
+FRapidPropertyValueBuffer::FRapidPropertyValueBuffer(const FProperty* InProperty, const void* InValuePtr)
+{
+    if (!InProperty || !InValuePtr)
+    {
+        return;
+    }
+
+    Property = InProperty;
+    Data.SetNumUninitialized(Property->GetSize());
+    Property->InitializeValue(Data.GetData());
+    Property->CopyCompleteValue(Data.GetData(), InValuePtr);
+}
+
+FRapidPropertyValueBuffer::~FRapidPropertyValueBuffer()
+{
+    Reset();
+}
+
+FRapidPropertyValueBuffer::FRapidPropertyValueBuffer(FRapidPropertyValueBuffer&& Other)
+    : Property(Other.Property)
+    , Data(MoveTemp(Other.Data))
+{
+    Other.Property = nullptr;
+}
+
+FRapidPropertyValueBuffer& FRapidPropertyValueBuffer::operator=(FRapidPropertyValueBuffer&& Other)
+{
+    if (this != &Other)
+    {
+        Reset();
+        Property = Other.Property;
+        Data = MoveTemp(Other.Data);
+        Other.Property = nullptr;
+    }
+    return *this;
+}
+
+void FRapidPropertyValueBuffer::CopyTo(void* OutValuePtr) const
+{
+    if (Property && OutValuePtr)
+    {
+        Property->CopyCompleteValue(OutValuePtr, Data.GetData());
+    }
+}
+
+bool FRapidPropertyValueBuffer::Identical(const void* InValuePtr) const
+{
+    return Property && InValuePtr && Property->Identical(Data.GetData(), InValuePtr, PPF_None);
+}
+
+SIZE_T FRapidPropertyValueBuffer::GetAllocatedSize() const
+{
+    if (!Property)
+    {
+        return 0;
+    }
+
+    return Data.GetAllocatedSize() + RapidPropertyTransactionPrivate::GetHeapSize(Property, Data.GetData());
+}
+
+void FRapidPropertyValueBuffer::Reset()
+{
+    if (Property)
+    {
+        Property->DestroyValue(Data.GetData());
+        Property = nullptr;
+    }
+    Data.Empty();
+}
+
+FRapidPropertyTransactionBuffer::FRapidPropertyTransactionBuffer(SIZE_T InMaxMemoryBytes, int32 InMaxTransactions)
+    : MaxMemoryBytes(InMaxMemoryBytes)
+    , MaxTransactions(InMaxTransactions)
+{
+}
+
+void FRapidPropertyTransactionBuffer::SetLimits(SIZE_T InMaxMemoryBytes, int32 InMaxTransactions)
+{
+    MaxMemoryBytes = InMaxMemoryBytes;
+    MaxTransactions = FMath::Max(1, InMaxTransactions);
+    TrimToBudget();
+}
+
+void FRapidPropertyTransactionBuffer::RecordEdit(TConstArrayView<UObject*> InObjects, const FRapidPropertyPath& InPropertyPath, TArray<FRapidPropertyValueBuffer>&& InBefore)
+{
+    if (InObjects.Num() == 0 || !InObjects[0] || InObjects.Num() != InBefore.Num() || !InPropertyPath.IsValid())
+    {
+        return;
+    }
+
+    // 修改后的值以主对象为准，其他对象会被写入相同的值
+    const void* ValuePtr = InPropertyPath.Resolve(static_cast<const void*>(InObjects[0]));
+    if (!ValuePtr)
+    {
+        return;
+    }
+
+    // 新的修改会使所有可重做记录失效
+    DiscardRedo();
+
+    const double Now = FPlatformTime::Seconds();
+
+    // 与上一条记录是同一组对象的同一属性时尝试合并，只更新After
+    if (UndoCount > 0)
+    {
+        FRapidPropertyTransaction& LastTransaction = Transactions[UndoCount - 1];
+
+        bool bSameTarget = LastTransaction.PropertyPath == InPropertyPath && LastTransaction.Objects.Num() == InObjects.Num();
+        for (int32 Index = 0; bSameTarget && Index < InObjects.Num(); ++Index)
+        {
+            bSameTarget = LastTransaction.Objects[Index].Get() == InObjects[Index];
+        }
+
+        const bool bSameContinuousEdit = ActiveContinuousEditId != INDEX_NONE && LastTransaction.ContinuousEditId == ActiveContinuousEditId;
+        const bool bWithinWindow = Now - LastTransaction.LastEditTime <= CoalesceWindowSeconds;
+
+        if (bSameTarget && (bSameContinuousEdit || bWithinWindow))
+        {
+            MemoryUsage -= LastTransaction.GetAllocatedSize();
+
+            // 合并后没有净变化时直接丢弃这条记录
+            const bool bNoNetChange = Algo::AllOf(LastTransaction.Before, [ValuePtr](const FRapidPropertyValueBuffer& BeforeValue)
+            {
+                return BeforeValue.Identical(ValuePtr);
+            });
+            if (bNoNetChange)
+            {
+                Transactions.RemoveAt(UndoCount - 1);
+                --UndoCount;
+                return;
+            }
+
+            LastTransaction.After = FRapidPropertyValueBuffer(InPropertyPath.GetLeafProperty(), ValuePtr);
+            LastTransaction.LastEditTime = Now;
+            LastTransaction.ContinuousEditId = ActiveContinuousEditId;
+            MemoryUsage += LastTransaction.GetAllocatedSize();
+            TrimToBudget();
+            return;
+        }
+    }
+
+    // 值没有变化时不产生记录
+    const bool bUnchanged = Algo::AllOf(InBefore, [ValuePtr](const FRapidPropertyValueBuffer& BeforeValue)
+    {
+        return BeforeValue.Identical(ValuePtr);
+    });
+    if (bUnchanged)
+    {
+        return;
+    }
+
+    FRapidPropertyTransaction& Transaction = Transactions.AddDefaulted_GetRef();
+    Transaction.Objects.Reserve(InObjects.Num());
+    for (UObject* Object : InObjects)
+    {
+        Transaction.Objects.Add(Object);
+    }
+    Transaction.PropertyPath = InPropertyPath;
+    Transaction.Before = MoveTemp(InBefore);
+    Transaction.After = FRapidPropertyValueBuffer(InPropertyPath.GetLeafProperty(), ValuePtr);
+    Transaction.LastEditTime = Now;
+    Transaction.ContinuousEditId = ActiveContinuousEditId;
+    UndoCount = Transactions.Num();
+
+    MemoryUsage += Transaction.GetAllocatedSize();
+    TrimToBudget();
+}
+
+void FRapidPropertyTransactionBuffer::BeginContinuousEdit()
+{
+    ActiveContinuousEditId = NextContinuousEditId++;
+}
+
+void FRapidPropertyTransactionBuffer::EndContinuousEdit()
+{
+    ActiveContinuousEditId = INDEX_NONE;
+
+    // 连续编辑结束后不再与之后的修改合并
+    if (UndoCount > 0)
+    {
+        Transactions[UndoCount - 1].LastEditTime = -DBL_MAX;
+    }
+}
+
+const FRapidPropertyTransaction* FRapidPropertyTransactionBuffer::Undo()
+{
+    if (!CanUndo())
+    {
+        return nullptr;
+    }
+
+    const int32 TransactionIndex = UndoCount - 1;
+    FRapidPropertyTransaction& Transaction = Transactions[TransactionIndex];
+
+    // 跳过已销毁的对象，其余对象照常撤销
+    int32 AppliedCount = 0;
+    for (int32 ObjectIndex = 0; ObjectIndex < Transaction.Objects.Num(); ++ObjectIndex)
+    {
+        if (void* ValuePtr = ResolveTransaction(Transaction, ObjectIndex))
+        {
+            Transaction.Before[ObjectIndex].CopyTo(ValuePtr);
+            ++AppliedCount;
+        }
+    }
+
+    if (AppliedCount == 0)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("撤销失败，对象已销毁或属性路径已失效: %s"), *Transaction.PropertyPath.ToString());
+        MemoryUsage -= Transaction.GetAllocatedSize();
+        Transactions.RemoveAt(TransactionIndex);
+        --UndoCount;
+        return nullptr;
+    }
+
+    // 撤销后的记录不再参与合并
+    Transaction.LastEditTime = -DBL_MAX;
+    Transaction.ContinuousEditId = INDEX_NONE;
+    --UndoCount;
+    return &Transaction;
+}
+
+const FRapidPropertyTransaction* FRapidPropertyTransactionBuffer::Redo()
+{
+    if (!CanRedo())
+    {
+        return nullptr;
+    }
+
+    FRapidPropertyTransaction& Transaction = Transactions[UndoCount];
+
+    int32 AppliedCount = 0;
+    for (int32 ObjectIndex = 0; ObjectIndex < Transaction.Objects.Num(); ++ObjectIndex)
+    {
+        if (void* ValuePtr = ResolveTransaction(Transaction, ObjectIndex))
+        {
+            Transaction.After.CopyTo(ValuePtr);
+            ++AppliedCount;
+        }
+    }
+
+    if (AppliedCount == 0)
+    {
+        // 之后的记录依赖这条记录的结果，一并丢弃
+        UE_LOG(LogTemp, Warning, TEXT("重做失败，对象已销毁或属性路径已失效: %s"), *Transaction.PropertyPath.ToString());
+        DiscardRedo();
+        return nullptr;
+    }
+
+    ++UndoCount;
+    return &Transaction;
+}
+
+void FRapidPropertyTransactionBuffer::Reset()
+{
+    Transactions.Empty();
+    UndoCount = 0;
+    MemoryUsage = 0;
+    ActiveContinuousEditId = INDEX_NONE;
+}
+
+void FRapidPropertyTransactionBuffer::DiscardRedo()
+{
+    for (int32 Index = UndoCount; Index < Transactions.Num(); ++Index)
+    {
+        MemoryUsage -= Transactions[Index].GetAllocatedSize();
+    }
+    Transactions.SetNum(UndoCount);
+}
+
+void FRapidPropertyTransactionBuffer::TrimToBudget()
+{
+    int32 RemoveCount = 0;
+    SIZE_T RemainingMemory = MemoryUsage;
+    int32 RemainingCount = Transactions.Num();
+
+    // 只丢弃可撤销的记录，并且至少保留最新的一条
+    while (RemoveCount < UndoCount - 1 && (RemainingCount > MaxTransactions || RemainingMemory > MaxMemoryBytes))
+    {
+        RemainingMemory -= Transactions[RemoveCount].GetAllocatedSize();
+        --RemainingCount;
+        ++RemoveCount;
+    }
+
+    if (RemoveCount > 0)
+    {
+        Transactions.RemoveAt(0, RemoveCount);
+        MemoryUsage = RemainingMemory;
+        UndoCount -= RemoveCount;
+    }
+}
+
+void* FRapidPropertyTransactionBuffer::ResolveTransaction(const FRapidPropertyTransaction& InTransaction, int32 InObjectIndex)
+{
+    UObject* Object = InTransaction.Objects[InObjectIndex].Get();
+    if (!Object)
+    {
+        return nullptr;
+    }
+
+    // 路径解析成功但类型已变化（如热重载）时也视为失效
+    if (InTransaction.PropertyPath.GetLeafProperty() != InTransaction.After.GetProperty())
+    {
+        return nullptr;
+    }
+
+    return InTransaction.PropertyPath.Resolve(static_cast<void*>(Object));
+}
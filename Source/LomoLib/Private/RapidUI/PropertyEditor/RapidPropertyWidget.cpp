@@ -1,6 +1,7 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "RapidUI/PropertyEditor/RapidPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidPropertyEditor.h"
 #include "UObject/UnrealType.h"
 
 URapidPropertyWidget::URapidPropertyWidget(const FObjectInitializer& ObjectInitializer)
@@ -37,8 +38,29 @@ bool URapidPropertyWidget::InitializePropertyWidget(UObject* InObject, FProperty
         return false;
     }
 
+    // 直接初始化时属性位于对象顶层
+    if (!bHasPendingPropertyPath || PropertyPath.GetLeafProperty() != InProperty)
+    {
+        PropertyPath = FRapidPropertyPath(InProperty);
+    }
+    bHasPendingPropertyPath = false;
+
+    // 绑定时一次性验证属性路径和对象类型，之后每次访问只检查对象是否还有效
+    if (!PropertyPath.IsCompatibleWith(InObject->GetClass()))
+    {
+        UE_LOG(LogTemp, Warning, TEXT("属性控件初始化失败: 属性路径 %s 与对象 %s 的类型不匹配"), *PropertyPath.ToString(), *InObject->GetName());
+        TargetObject = nullptr;
+        Property = nullptr;
+        BoundObject.Reset();
+        BoundValueOffset = INDEX_NONE;
+        return false;
+    }
+
     TargetObject = InObject;
     Property = InProperty;
+    BoundObject = InObject;
+    BoundValueOffset = PropertyPath.GetFixedOffset();
+    
     PropertyName = InPropertyName.IsNone() ? Property->GetFName() : InPropertyName;
     
     // 设置显示名称
@@ -51,10 +73,51 @@ bool URapidPropertyWidget::InitializePropertyWidget(UObject* InObject, FProperty
         PropertyDisplayName = FText::FromName(PropertyName);
     }
     
+    // 查找搜索索引项，并应用属性编辑器当前的搜索结果（懒加载的子控件创建时也会经过这里）
+    if (const URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>())
+    {
+        SearchEntryIndex = PropertyEditor->FindSearchEntry(PropertyPath);
+        ApplySearchFilter(PropertyEditor->GetSearchFilter());
+    }
+    
     UpdateValue();
     return true;
 }
 
+bool URapidPropertyWidget::InitializePropertyWidgetAtPath(UObject* InObject, const FRapidPropertyPath& InPropertyPath)
+{
+    FProperty* LeafProperty = InPropertyPath.GetLeafProperty();
+    if (!InObject || !LeafProperty)
+    {
+        return false;
+    }
+
+    PropertyPath = InPropertyPath;
+    bHasPendingPropertyPath = true;
+    return InitializePropertyWidget(InObject, LeafProperty, LeafProperty->GetFName());
+}
+
+const FRapidPropertyPath& URapidPropertyWidget::GetPropertyPath() const
+{
+    return PropertyPath;
+}
+
+void URapidPropertyWidget::ApplySearchFilter(const FRapidPropertySearchFilter& InFilter)
+{
+    const bool bVisible = InFilter.IsEntryVisible(SearchEntryIndex);
+    if (!bVisible && !bHiddenBySearch)
+    {
+        VisibilityBeforeSearch = GetVisibility();
+        SetVisibility(ESlateVisibility::Collapsed);
+        bHiddenBySearch = true;
+    }
+    else if (bVisible && bHiddenBySearch)
+    {
+        SetVisibility(VisibilityBeforeSearch);
+        bHiddenBySearch = false;
+    }
+}
+
 void URapidPropertyWidget::UpdateValue_Implementation()
 {
     // 子类中实现实际更新逻辑
@@ -70,10 +133,100 @@ FString URapidPropertyWidget::GetPropertyMetaData(const FName& MetaDataKey) cons
     return FString();
 }
 
+void URapidPropertyWidget::BeginPropertyValueChange()
+{
+    // 多对象编辑时由属性编辑器决定实际写入和记录的路径
+    const URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>();
+    PendingEditPath = PropertyEditor ? PropertyEditor->GetSharedEditPath(PropertyPath) : PropertyPath;
+    UObject* Object = BoundObject.Get();
+    PendingBeforeValue = FRapidPropertyValueBuffer(PendingEditPath.GetLeafProperty(), Object ? PendingEditPath.Resolve(Object) : nullptr);
+}
+
 void URapidPropertyWidget::NotifyPropertyValueChanged()
+{
+    // 先让上层的容器控件检查这次修改，撤销记录保存的是检查之后的值
+    if (URapidPropertyWidget* ParentWidget = GetTypedOuter<URapidPropertyWidget>())
+    {
+        ParentWidget->PreCommitChildPropertyValue(PropertyPath, PendingBeforeValue);
+    }
+
+    // 记录撤销信息，控件不在属性编辑器中时直接丢弃
+    if (PendingBeforeValue.IsValid())
+    {
+        if (URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>())
+        {
+            PropertyEditor->RecordPropertyEdit(TargetObject, PendingEditPath, MoveTemp(PendingBeforeValue));
+        }
+        PendingBeforeValue.Reset();
+    }
+
+    NotifyChildPropertyValueChanged(PropertyPath);
+}
+
+void URapidPropertyWidget::BeginContinuousPropertyEdit()
+{
+    if (URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>())
+    {
+        PropertyEditor->BeginContinuousEdit();
+    }
+}
+
+void URapidPropertyWidget::EndContinuousPropertyEdit()
+{
+    if (URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>())
+    {
+        PropertyEditor->EndContinuousEdit();
+    }
+}
+
+void URapidPropertyWidget::PreCommitChildPropertyValue(const FRapidPropertyPath& InChildPropertyPath, const FRapidPropertyValueBuffer& InBeforeValue)
+{
+    if (URapidPropertyWidget* ParentWidget = GetTypedOuter<URapidPropertyWidget>())
+    {
+        ParentWidget->PreCommitChildPropertyValue(InChildPropertyPath, InBeforeValue);
+    }
+}
+
+void URapidPropertyWidget::NotifyChildPropertyValueChanged(const FRapidPropertyPath& InChildPropertyPath)
 {
     if (TargetObject && !PropertyName.IsNone())
     {
+        OnPropertyPathChanged.Broadcast(TargetObject, InChildPropertyPath);
         OnPropertyValueChanged.Broadcast(TargetObject, PropertyName, this);
     }
-}
\ No newline at end of file
+}
+
+void* URapidPropertyWidget::GetValuePtr() const
+{
+    UObject* Object = BoundObject.Get();
+    if (!Object)
+    {
+        return nullptr;
+    }
+
+    if (BoundValueOffset != INDEX_NONE)
+    {
+        return reinterpret_cast<uint8*>(Object) + BoundValueOffset;
+    }
+
+    return PropertyPath.Resolve(Object);
+}
+
+bool URapidPropertyWidget::IsPropertyBound() const
+{
+    return Property && BoundObject.IsValid();
+}
+
+bool URapidPropertyWidget::UpdateMultipleValues()
+{
+    const URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>();
+    const bool bNewHasMultipleValues = PropertyEditor && PropertyEditor->HasMultipleValues(PropertyPath);
+
+    if (bNewHasMultipleValues != bHasMultipleValues)
+    {
+        bHasMultipleValues = bNewHasMultipleValues;
+        OnMultipleValuesChanged(bHasMultipleValues);
+    }
+
+    return bHasMultipleValues;
+}
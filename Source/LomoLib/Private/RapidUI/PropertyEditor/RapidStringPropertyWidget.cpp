@@ -65,119 +65,137 @@ bool URapidStringPropertyWidget::InitializePropertyWidget(UObject* InObject, FPr
 
 void URapidStringPropertyWidget::UpdateValue_Implementation()
 {
-    SafeExecute([&]()
+    // 初始化当前值
+    CurrentValue = FString();
+    
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
     {
-        // 初始化当前值
-        CurrentValue = FString();
+        return;
+    }
 
-        // 获取属性值
-        if (PropertyType == EPropertyType::String)
-        {
-            FStrProperty* StrProperty = CastField<FStrProperty>(Property);
-            if (StrProperty && TargetObject)
-            {
-                CurrentValue = StrProperty->GetPropertyValue_InContainer(TargetObject);
-                UE_LOG(LogTemp, Verbose, TEXT("获取FString属性值: %s"), *CurrentValue);
-            }
-        }
-        else if (PropertyType == EPropertyType::Name)
+    // 获取属性值
+    if (PropertyType == EPropertyType::String)
+    {
+        FStrProperty* StrProperty = CastField<FStrProperty>(Property);
+        if (StrProperty)
         {
-            FNameProperty* NameProperty = CastField<FNameProperty>(Property);
-            if (NameProperty && TargetObject)
-            {
-                FName NameValue = NameProperty->GetPropertyValue_InContainer(TargetObject);
-                CurrentValue = NameValue.ToString();
-                UE_LOG(LogTemp, Verbose, TEXT("获取FName属性值: %s"), *CurrentValue);
-            }
+            CurrentValue = StrProperty->GetPropertyValue(ValuePtr);
+            UE_LOG(LogTemp, Verbose, TEXT("获取FString属性值: %s"), *CurrentValue);
         }
-        else if (PropertyType == EPropertyType::Text)
+    }
+    else if (PropertyType == EPropertyType::Name)
+    {
+        FNameProperty* NameProperty = CastField<FNameProperty>(Property);
+        if (NameProperty)
         {
-            FTextProperty* TextProperty = CastField<FTextProperty>(Property);
-            if (TextProperty && TargetObject)
-            {
-                FText TextValue = TextProperty->GetPropertyValue_InContainer(TargetObject);
-                CurrentValue = TextValue.ToString();
-                UE_LOG(LogTemp, Verbose, TEXT("获取FText属性值: %s"), *CurrentValue);
-            }
+            FName NameValue = NameProperty->GetPropertyValue(ValuePtr);
+            CurrentValue = NameValue.ToString();
+            UE_LOG(LogTemp, Verbose, TEXT("获取FName属性值: %s"), *CurrentValue);
         }
-        else
+    }
+    else if (PropertyType == EPropertyType::Text)
+    {
+        FTextProperty* TextProperty = CastField<FTextProperty>(Property);
+        if (TextProperty)
         {
-            UE_LOG(LogTemp, Error, TEXT("无法更新值: 未知的属性类型"));
-            return;
+            FText TextValue = TextProperty->GetPropertyValue(ValuePtr);
+            CurrentValue = TextValue.ToString();
+            UE_LOG(LogTemp, Verbose, TEXT("获取FText属性值: %s"), *CurrentValue);
         }
+    }
+    else
+    {
+        UE_LOG(LogTemp, Error, TEXT("无法更新值: 未知的属性类型"));
+        return;
+    }
 
-        // 更新界面
+    // 更新界面，多个对象的值不同时清空文本并显示提示
+    if (UpdateMultipleValues())
+    {
+        ValueTextBox->SetText(FText::GetEmpty());
+        ValueTextBox->SetHintText(FText::FromString(TEXT("多个值")));
+    }
+    else
+    {
         ValueTextBox->SetText(FText::FromString(CurrentValue));
-        PropertyNameText->SetText(PropertyDisplayName);
-    },
-    TEXT("更新String属性值失败"));
+        ValueTextBox->SetHintText(FText::GetEmpty());
+    }
+    PropertyNameText->SetText(PropertyDisplayName);
 }
 
 bool URapidStringPropertyWidget::SetValue(const FString& InValue)
 {
-    return SafeExecuteWithRet([&]() -> bool
+    if (!IsPropertyBound())
     {
-        if (!TargetObject || !Property)
-        {
-            UE_LOG(LogTemp, Error, TEXT("设置String属性值失败: 对象或属性为空"));
-            return false;
-        }
+        UE_LOG(LogTemp, Error, TEXT("设置String属性值失败: 属性未绑定或对象已销毁"));
+        return false;
+    }
 
-        // 如果值没有变化，直接返回
-        if (CurrentValue.Equals(InValue))
-        {
-            return false;
-        }
+    // 如果值没有变化，直接返回；多个对象的值不同时仍需写入以统一所有对象
+    if (!bHasMultipleValues && CurrentValue.Equals(InValue))
+    {
+        return false;
+    }
+
+    // 按属性路径解析值地址，容器元素可能已经失效
+    void* ValuePtr = GetValuePtr();
+    if (!ValuePtr)
+    {
+        UE_LOG(LogTemp, Error, TEXT("设置String属性值失败: 无法解析属性地址 %s"), *PropertyPath.ToString());
+        return false;
+    }
 
-        bool bValueSet = false;
+    // 保存修改前的值用于撤销
+    BeginPropertyValueChange();
 
-        // 根据属性类型设置值
-        if (PropertyType == EPropertyType::String)
+    bool bValueSet = false;
+
+    // 根据属性类型设置值
+    if (PropertyType == EPropertyType::String)
+    {
+        FStrProperty* StrProperty = CastField<FStrProperty>(Property);
+        if (StrProperty)
         {
-            FStrProperty* StrProperty = CastField<FStrProperty>(Property);
-            if (StrProperty)
-            {
-                StrProperty->SetPropertyValue_InContainer(TargetObject, InValue);
-                bValueSet = true;
-            }
+            StrProperty->SetPropertyValue(ValuePtr, InValue);
+            bValueSet = true;
         }
-        else if (PropertyType == EPropertyType::Name)
+    }
+    else if (PropertyType == EPropertyType::Name)
+    {
+        FNameProperty* NameProperty = CastField<FNameProperty>(Property);
+        if (NameProperty)
         {
-            FNameProperty* NameProperty = CastField<FNameProperty>(Property);
-            if (NameProperty)
-            {
-                NameProperty->SetPropertyValue_InContainer(TargetObject, FName(*InValue));
-                bValueSet = true;
-            }
+            NameProperty->SetPropertyValue(ValuePtr, FName(*InValue));
+            bValueSet = true;
         }
-        else if (PropertyType == EPropertyType::Text)
+    }
+    else if (PropertyType == EPropertyType::Text)
+    {
+        FTextProperty* TextProperty = CastField<FTextProperty>(Property);
+        if (TextProperty)
         {
-            FTextProperty* TextProperty = CastField<FTextProperty>(Property);
-            if (TextProperty)
-            {
-                TextProperty->SetPropertyValue_InContainer(TargetObject, FText::FromString(InValue));
-                bValueSet = true;
-            }
+            TextProperty->SetPropertyValue(ValuePtr, FText::FromString(InValue));
+            bValueSet = true;
         }
+    }
 
-        if (bValueSet)
-        {
-            // 更新缓存的当前值
-            CurrentValue = InValue;
-            
-            // 更新UI
-            ValueTextBox->SetText(FText::FromString(CurrentValue));
-            PropertyNameText->SetText(PropertyDisplayName);
-
-            // 通知值变化
-            NotifyPropertyValueChanged();
-            return true;
-        }
+    if (bValueSet)
+    {
+        // 更新缓存的当前值
+        CurrentValue = InValue;
+        
+        // 更新UI
+        ValueTextBox->SetText(FText::FromString(CurrentValue));
+        PropertyNameText->SetText(PropertyDisplayName);
 
-        UE_LOG(LogTemp, Error, TEXT("设置属性值失败"));
-        return false;
-    },
-    TEXT("设置String属性值失败"));
+        // 通知值变化
+        NotifyPropertyValueChanged();
+        return true;
+    }
+
+    UE_LOG(LogTemp, Error, TEXT("设置属性值失败"));
+    return false;
 }
 
 FString URapidStringPropertyWidget::GetValue() const
@@ -187,15 +205,11 @@ FString URapidStringPropertyWidget::GetValue() const
 
 void URapidStringPropertyWidget::HandleTextCommitted(const FText& Text, ETextCommit::Type CommitMethod)
 {
-    SafeExecute([&]()
+    // 只在按下回车键或失去焦点时更新值
+    if (CommitMethod == ETextCommit::OnEnter || CommitMethod == ETextCommit::OnUserMovedFocus)
     {
-        // 只在按下回车键或失去焦点时更新值
-        if (CommitMethod == ETextCommit::OnEnter || CommitMethod == ETextCommit::OnUserMovedFocus)
-        {
-            SetValue(Text.ToString());
-        }
-    },
-    TEXT("处理文本提交失败"));
+        SetValue(Text.ToString());
+    }
 }
 
 void URapidStringPropertyWidget::HandleTextChanged(const FText& Text)
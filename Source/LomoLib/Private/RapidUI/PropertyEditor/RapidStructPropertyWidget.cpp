@@ -5,10 +5,7 @@
 #include "Components/ExpandableArea.h"
 #include "Components/VerticalBox.h"
 #include "UObject/UnrealType.h"
-#include "RapidUI/PropertyEditor/RapidFloatPropertyWidget.h"
-#include "RapidUI/PropertyEditor/RapidIntPropertyWidget.h"
-#include "RapidUI/PropertyEditor/RapidBoolPropertyWidget.h"
-#include "RapidUI/PropertyEditor/RapidStringPropertyWidget.h"
+#include "RapidUI/PropertyEditor/RapidPropertyEditor.h"
 #include "Blueprint/WidgetTree.h"
 
 URapidStructPropertyWidget::URapidStructPropertyWidget(const FObjectInitializer& ObjectInitializer)
@@ -46,25 +43,32 @@ bool URapidStructPropertyWidget::InitializePropertyWidget(UObject* InObject, FPr
     }
     
     // 清除现有的子属性控件
-    ChildPropertyWidgets.Empty();
-    if (ContentVerticalBox)
-    {
-        ContentVerticalBox->ClearChildren();
-    }
-    
-    // 创建所有子属性控件
-    CreateChildProperties();
+    ReleaseChildProperties();
     
-    // 默认展开
+    // 子属性控件延迟到首次展开时才创建，折叠状态下只占用一行标题
     if (ExpandableArea)
     {
         // 可通过元数据控制是否默认展开
-        bool bDefaultExpanded = true;
+        bool bDefaultExpanded = false;
         if (Property && Property->HasMetaData(TEXT("DefaultExpanded")))
         {
-            bDefaultExpanded = Property->GetMetaDataText(TEXT("DefaultExpanded")).ToString().ToBool();
+            bDefaultExpanded = Property->GetMetaData(TEXT("DefaultExpanded")).ToBool();
         }
         ExpandableArea->SetIsExpanded(bDefaultExpanded);
+        
+        ExpandableArea->OnExpansionChanged.RemoveDynamic(this, &URapidStructPropertyWidget::HandleExpansionChanged);
+        ExpandableArea->OnExpansionChanged.AddDynamic(this, &URapidStructPropertyWidget::HandleExpansionChanged);
+        
+        // SetIsExpanded不会触发OnExpansionChanged，默认展开时需要手动创建
+        if (bDefaultExpanded)
+        {
+            CreateChildProperties();
+        }
+    }
+    else
+    {
+        // 没有可展开区域时无法懒加载，直接创建
+        CreateChildProperties();
     }
     
     return true;
@@ -72,7 +76,7 @@ bool URapidStructPropertyWidget::InitializePropertyWidget(UObject* InObject, FPr
 
 void URapidStructPropertyWidget::UpdateValue_Implementation()
 {
-    // 更新所有子属性控件
+    // 更新已创建的子属性控件，未展开过的结构体没有子控件
     for (URapidPropertyWidget* ChildWidget : ChildPropertyWidgets)
     {
         if (ChildWidget)
@@ -82,111 +86,149 @@ void URapidStructPropertyWidget::UpdateValue_Implementation()
     }
 }
 
-void URapidStructPropertyWidget::CreateChildProperties()
+void URapidStructPropertyWidget::ApplySearchFilter(const FRapidPropertySearchFilter& InFilter)
 {
-    SafeExecute([&]() {
-        if (!Property || !TargetObject || !ContentVerticalBox)
+    Super::ApplySearchFilter(InFilter);
+    
+    // 未展开过的结构体没有子控件，展开时子控件初始化会自行应用搜索结果
+    for (URapidPropertyWidget* ChildWidget : ChildPropertyWidgets)
+    {
+        if (ChildWidget)
         {
-            UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 属性、对象或内容框为空"));
-            return;
+            ChildWidget->ApplySearchFilter(InFilter);
         }
+    }
+}
+
+void URapidStructPropertyWidget::CreateChildProperties()
+{
+    if (bChildrenCreated)
+    {
+        return;
+    }
+    
+    if (!Property || !TargetObject || !ContentVerticalBox)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 属性、对象或内容框为空"));
+        return;
+    }
+    
+    // 获取结构体属性
+    FStructProperty* StructProperty = CastField<FStructProperty>(Property);
+    if (!StructProperty)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 无法转换为结构体属性"));
+        return;
+    }
+    
+    // 获取结构体信息
+    UScriptStruct* ScriptStruct = StructProperty->Struct;
+    if (!ScriptStruct)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 结构体描述为空"));
+        return;
+    }
+    
+    // 获取结构体值的指针
+    void* StructValuePtr = GetValuePtr();
+    if (!StructValuePtr)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 结构体值指针为空"));
+        return;
+    }
+    
+    // 子属性控件统一由属性编辑器按类型创建，保证使用蓝图中配置的控件类
+    URapidPropertyEditor* PropertyEditor = GetTypedOuter<URapidPropertyEditor>();
+    if (!PropertyEditor)
+    {
+        UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 找不到父级属性编辑器"));
+        return;
+    }
+    
+    // 获取结构体中的所有属性
+    for (TFieldIterator<FProperty> It(ScriptStruct); It; ++It)
+    {
+        FProperty* StructField = *It;
         
-        // 获取结构体属性
-        FStructProperty* StructProperty = CastField<FStructProperty>(Property);
-        if (!StructProperty)
+        // 跳过不可编辑的属性
+        if (!StructField->HasAnyPropertyFlags(CPF_Edit))
         {
-            UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 无法转换为结构体属性"));
-            return;
+            continue;
         }
         
-        // 获取结构体信息
-        UScriptStruct* ScriptStruct = StructProperty->Struct;
-        if (!ScriptStruct)
+        // 跳过仅编辑器可见的属性
+        if (StructField->HasAnyPropertyFlags(CPF_EditorOnly))
         {
-            UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 结构体描述为空"));
-            return;
+            continue;
         }
         
-        // 获取结构体值的指针
-        void* StructValuePtr = StructProperty->ContainerPtrToValuePtr<void>(TargetObject);
-        if (!StructValuePtr)
-        {
-            UE_LOG(LogTemp, Warning, TEXT("CreateChildProperties失败: 结构体值指针为空"));
-            return;
-        }
+        // 根据字段类型创建控件
+        URapidPropertyWidget* FieldWidget = PropertyEditor->CreatePropertyWidgetForType(this, StructField);
         
-        // 获取结构体中的所有属性
-        for (TFieldIterator<FProperty> It(ScriptStruct); It; ++It)
+        // 初始化字段控件
+        if (FieldWidget)
         {
-            FProperty* StructField = *It;
-            
-            // 跳过不可编辑的属性
-            if (!StructField->HasAnyPropertyFlags(CPF_Edit))
+            // 字段路径 = 结构体路径 + 字段属性，不需要拼接名称
+            if (FieldWidget->InitializePropertyWidgetAtPath(TargetObject, PropertyPath.GetChildPath(StructField)))
             {
-                continue;
-            }
-            
-            // 跳过仅编辑器可见的属性
-            if (StructField->HasAnyPropertyFlags(CPF_EditorOnly))
-            {
-                continue;
-            }
-            
-            // 获取字段地址
-            void* FieldValuePtr = StructField->ContainerPtrToValuePtr<void>(StructValuePtr);
-            
-            // 创建字段控件
-            URapidPropertyWidget* FieldWidget = nullptr;
-            
-            // 根据字段类型创建不同的控件
-            if (StructField->IsA<FFloatProperty>())
-            {
-                FieldWidget = CreateWidget<URapidFloatPropertyWidget>(this, URapidFloatPropertyWidget::StaticClass());
-            }
-            else if (StructField->IsA<FIntProperty>())
-            {
-                FieldWidget = CreateWidget<URapidIntPropertyWidget>(this, URapidIntPropertyWidget::StaticClass());
-            }
-            else if (StructField->IsA<FBoolProperty>())
-            {
-                FieldWidget = CreateWidget<URapidBoolPropertyWidget>(this, URapidBoolPropertyWidget::StaticClass());
-            }
-            else if (StructField->IsA<FStrProperty>() || StructField->IsA<FNameProperty>() || StructField->IsA<FTextProperty>())
-            {
-                FieldWidget = CreateWidget<URapidStringPropertyWidget>(this, URapidStringPropertyWidget::StaticClass());
-            }
-            else if (StructField->IsA<FStructProperty>())
-            {
-                FieldWidget = CreateWidget<URapidStructPropertyWidget>(this, URapidStructPropertyWidget::StaticClass());
+                // 绑定值变化事件
+                FieldWidget->OnPropertyPathChanged.AddUObject(this, &URapidStructPropertyWidget::HandleChildPropertyPathChanged);
+                
+                // 添加到容器
+                ContentVerticalBox->AddChild(FieldWidget);
+                ChildPropertyWidgets.Add(FieldWidget);
             }
-            
-            // 初始化字段控件
-            if (FieldWidget)
+            else
             {
-                // 设置特殊属性名格式以便识别结构体字段
-                FName FieldPropertyName = *FString::Printf(TEXT("%s.%s"), *PropertyName.ToString(), *StructField->GetName());
-                
-                // 初始化控件
-                if (FieldWidget->InitializePropertyWidget(TargetObject, StructField, FieldPropertyName))
-                {
-                    // 绑定值变化事件
-                    FieldWidget->OnPropertyValueChanged.AddDynamic(this, &URapidStructPropertyWidget::HandleChildPropertyValueChanged);
-                    
-                    // 添加到容器
-                    ContentVerticalBox->AddChild(FieldWidget);
-                    ChildPropertyWidgets.Add(FieldWidget);
-                }
-                else
-                {
-                    UE_LOG(LogTemp, Warning, TEXT("无法初始化字段控件: %s"), *FieldPropertyName.ToString());
-                }
+                UE_LOG(LogTemp, Warning, TEXT("无法初始化字段控件: %s"), *StructField->GetName());
             }
         }
-    }, TEXT("创建结构体子属性控件失败"));
+    }
+    
+    bChildrenCreated = true;
+}
+
+void URapidStructPropertyWidget::ReleaseChildProperties()
+{
+    for (URapidPropertyWidget* ChildWidget : ChildPropertyWidgets)
+    {
+        if (ChildWidget)
+        {
+            ChildWidget->OnPropertyPathChanged.RemoveAll(this);
+        }
+    }
+    
+    ChildPropertyWidgets.Empty();
+    if (ContentVerticalBox)
+    {
+        ContentVerticalBox->ClearChildren();
+    }
+    
+    bChildrenCreated = false;
+}
+
+void URapidStructPropertyWidget::HandleExpansionChanged(UExpandableArea* Area, bool bIsExpanded)
+{
+    if (bIsExpanded)
+    {
+        // 首次展开时创建子属性控件，已创建过则只刷新数值
+        if (bChildrenCreated)
+        {
+            UpdateValue();
+        }
+        else
+        {
+            CreateChildProperties();
+        }
+    }
+    else if (bReleaseChildrenOnCollapse)
+    {
+        ReleaseChildProperties();
+    }
 }
 
-void URapidStructPropertyWidget::HandleChildPropertyValueChanged(UObject* Object, FName InPropertyName, URapidPropertyWidget* PropertyWidget)
+void URapidStructPropertyWidget::HandleChildPropertyPathChanged(UObject* Object, const FRapidPropertyPath& InChildPropertyPath)
 {
     // 传递子属性变化事件
-    NotifyPropertyValueChanged();
+    NotifyChildPropertyValueChanged(InChildPropertyPath);
 }
\ No newline at end of file
@@ -3,7 +3,9 @@
 #pragma once
 
 #include "CoreMinimal.h"
-#include "JsonObjectConverter.h"
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+#include "RapidUI/JsonPanel/RapidJsonStructReader.h"
+#include "RapidUI/JsonPanel/RapidJsonStructWriter.h"
 #include "Kismet/BlueprintFunctionLibrary.h"
 #include "LomoLibBlueprintFunctionLibrary.generated.h"
 
@@ -15,11 +17,50 @@ class LOMOLIB_API ULomoLibBlueprintFunctionLibrary : public UBlueprintFunctionLi
 {
 	GENERATED_BODY()
 
-	// 结构体转JSON字符串
+public:
+	// 结构体转JSON字符串，按反射结构直接写出，不构建FJsonObject，格式与FJsonObjectConverter相同
 	template<typename T>
 	static bool ToJson(const T& InStruct, FString& OutJsonString)
 	{
-		return FJsonObjectConverter::UStructToJsonObjectString(T::StaticStruct(), &InStruct, OutJsonString, 0, 0);
+		TArray<uint8> JsonData;
+		FRapidJsonStructWriter::Write(T::StaticStruct(), &InStruct, JsonData, true);
+
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(JsonData.GetData()), JsonData.Num());
+		OutJsonString = FString(Converter.Length(), Converter.Get());
+		return true;
+	}
+
+	// 结构体转UTF-8 JSON，追加到OutJsonData末尾，大量写入时复用同一个缓冲
+	// 紧凑格式按结构体编译好的计划写出
+	template<typename T>
+	static void ToJsonUtf8(const T& InStruct, TArray<uint8>& OutJsonData, bool bPrettyPrint = false)
+	{
+		FRapidJsonStructWriter Writer(OutJsonData, bPrettyPrint);
+		Writer.WritePlan(*FRapidJsonStructPlan::Get(T::StaticStruct()), &InStruct);
+	}
+
+	// JSON字符串转结构体，缺少的字段保持原值
+	template<typename T>
+	static bool FromJson(const FString& InJsonString, T& OutStruct, FString* OutError = nullptr)
+	{
+		const FTCHARToUTF8 Converter(*InJsonString, InJsonString.Len());
+		return FromJsonUtf8(TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length()), OutStruct, OutError);
+	}
+
+	// UTF-8 JSON转结构体，缺少的字段保持原值
+	template<typename T>
+	static bool FromJsonUtf8(TConstArrayView<uint8> InJsonData, T& OutStruct, FString* OutError = nullptr)
+	{
+		FRapidJsonStructReader Reader(InJsonData);
+		if (Reader.ReadPlan(*FRapidJsonStructPlan::Get(T::StaticStruct()), &OutStruct))
+		{
+			return true;
+		}
+		if (OutError)
+		{
+			*OutError = Reader.GetError();
+		}
+		return false;
 	}
 
 	// For UI
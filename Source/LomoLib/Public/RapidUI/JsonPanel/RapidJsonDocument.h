@@ -0,0 +1,208 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+
+enum class ERapidJsonNodeType : uint8
+{
+	Null,
+	Bool,
+	Number,
+	String,
+	Array,
+	Object,
+};
+
+/**
+ * Json文档中的一个节点，只记录在原始数据中的位置，不保存解析后的值
+ */
+struct FRapidJsonNode
+{
+	/** 父节点，根节点为INDEX_NONE */
+	int32 Parent = INDEX_NONE;
+
+	/** 对象成员的键在数据中的位置（包含引号），数组元素和根节点为INDEX_NONE */
+	int32 KeyOffset = INDEX_NONE;
+	int32 KeyLength = 0;
+
+	/** 值在数据中的位置，容器包含括号，字符串包含引号 */
+	int32 ValueOffset = 0;
+	int32 ValueLength = 0;
+
+	/** 在父节点中的序号 */
+	int32 IndexInParent = 0;
+
+	/** 深度，根节点为0 */
+	int32 Depth = 0;
+
+	/** 子节点在节点数组中连续存放，未展开时FirstChild为INDEX_NONE */
+	int32 FirstChild = INDEX_NONE;
+	int32 NumChildren = 0;
+
+	ERapidJsonNodeType Type = ERapidJsonNodeType::Null;
+
+	/** 子节点是否已经建立索引 */
+	bool bIndexed = false;
+
+	bool IsContainer() const { return Type == ERapidJsonNodeType::Array || Type == ERapidJsonNodeType::Object; }
+};
+
+/**
+ * 按偏移索引的Json文档，不构建FJsonObject树：
+ * 1. 数据保持为原始UTF-8，大文件优先使用内存映射
+ * 2. 加载时只扫描根节点，容器的子节点在展开时才建立索引，内存与展开的节点数成正比
+ * 3. 修改以覆盖的形式记录，不改动原始数据，保存时拼接未修改的数据和修改的内容
+ * 只能在游戏线程使用
+ */
+class LOMOLIB_API FRapidJsonDocument
+{
+public:
+	FRapidJsonDocument();
+	~FRapidJsonDocument();
+
+	FRapidJsonDocument(const FRapidJsonDocument&) = delete;
+	FRapidJsonDocument& operator=(const FRapidJsonDocument&) = delete;
+
+	/** 加载文件，能映射时使用内存映射 */
+	bool LoadFromFile(const FString& InFilePath);
+
+	/** 从字符串加载 */
+	bool LoadFromString(const FString& InJsonText);
+
+	/** 从UTF-8数据加载，数据被移动到文档中 */
+	bool LoadFromUtf8(TArray<uint8>&& InData);
+
+	/** 清空文档 */
+	void Reset();
+
+	bool IsValid() const { return Nodes.Num() > 0; }
+
+	/** 最近一次解析错误 */
+	const FString& GetLastError() const { return LastError; }
+
+	/** 根节点的下标 */
+	static constexpr int32 RootNode = 0;
+
+	int32 NumNodes() const { return Nodes.Num(); }
+	const FRapidJsonNode& GetNode(int32 InNodeIndex) const { return Nodes[InNodeIndex]; }
+	bool IsValidNode(int32 InNodeIndex) const { return Nodes.IsValidIndex(InNodeIndex); }
+
+	/**
+	 * 为容器节点的直接子节点建立索引，已建立时直接返回
+	 * @return 节点不是容器或数据格式错误时返回false
+	 */
+	bool IndexChildren(int32 InNodeIndex);
+
+	/** 子节点的下标，需要先调用IndexChildren */
+	int32 GetChild(int32 InNodeIndex, int32 InChildIndex) const;
+
+	/** 按键查找对象的直接子节点，会为对象建立索引 */
+	int32 FindChild(int32 InNodeIndex, FStringView InKey);
+
+	/** 对象成员的键（已解码），数组元素返回下标 */
+	FString GetKey(int32 InNodeIndex) const;
+
+	/** 值的原始Json文本，已修改的节点返回修改后的文本 */
+	FString GetRawValue(int32 InNodeIndex) const;
+
+	/** 用于显示的值：字符串为解码后的内容，容器为元素数量的摘要 */
+	FString GetDisplayValue(int32 InNodeIndex) const;
+
+	/**
+	 * 修改标量节点的值
+	 * @param InValue 字符串节点为新的字符串内容；其他节点为Json字面量（数字、true、false、null）
+	 * @return 节点是容器或字面量无效时返回false
+	 */
+	bool SetValue(int32 InNodeIndex, const FString& InValue);
+
+	/**
+	 * 用Json文本修改标量节点的值，节点类型随新值改变
+	 * @param InRawValue 编码后的Json字符串（包含引号）或字面量
+	 * @return 节点是容器、文本不是标量或值没有变化时返回false
+	 */
+	bool SetRawValue(int32 InNodeIndex, const FString& InRawValue);
+
+	/**
+	 * 把多个节点修改为同一个值，通常与FRapidJsonQuery的结果一起使用
+	 * @return 实际修改的节点数
+	 */
+	int32 SetValues(TConstArrayView<int32> InNodeIndices, const FString& InValue);
+
+	/** 是否有未保存的修改 */
+	bool IsModified() const { return bModified; }
+
+	/**
+	 * 把文档（包括修改）写入文件，未修改的部分直接拷贝原始数据
+	 * 覆盖内存映射的源文件时会先把数据复制到内存中
+	 * 覆盖源文件后文档改为基于新的文件内容，节点下标不变，偏移随之平移
+	 */
+	bool SaveToFile(const FString& InFilePath);
+
+	/**
+	 * 把修改直接写回源文件的对应位置，不重写整个文件
+	 * 新值比原值短时用空格补齐；有任何新值比原值长，或源文件在加载后被外部修改过时退回到SaveToFile
+	 */
+	bool SaveInPlace();
+
+	/** 数据来源的文件，从字符串加载时为空 */
+	const FString& GetSourceFilePath() const { return SourceFilePath; }
+
+	/** 原始数据 */
+	TConstArrayView<uint8> GetData() const { return Data; }
+
+protected:
+	/** 扫描一个值，返回值之后的位置，格式错误时返回INDEX_NONE */
+	int32 ScanValue(int32 InOffset, ERapidJsonNodeType& OutType) const;
+
+	/** 扫描字符串，InOffset指向开头的引号，返回结束引号之后的位置 */
+	int32 ScanString(int32 InOffset) const;
+
+	int32 SkipWhitespace(int32 InOffset) const;
+
+	/** 释放内存映射，把数据复制到OwnedData */
+	void DetachMappedData();
+
+	/**
+	 * 覆盖源文件后改为使用保存的数据，平移所有节点的偏移并清空修改
+	 * @param InModifiedEnds 按位置排序的每个修改在原数据中结束的位置
+	 * @param InShiftsAfter 长度比InModifiedEnds多1，第i项为前i个修改累计的长度变化
+	 */
+	void RebaseOnSavedData(TArray<uint8>&& InSavedData, TConstArrayView<int32> InModifiedEnds, TConstArrayView<int32> InShiftsAfter);
+
+	/** 使用新的数据重建根节点 */
+	bool InitializeRoot();
+
+	/** 把一段原始Json字符串（包含引号）解码 */
+	static FString DecodeString(TConstArrayView<uint8> InRawString);
+
+	/** 把字符串编码为Json字符串（包含引号） */
+	static FString EncodeString(const FString& InValue);
+
+	bool SetError(const FString& InError);
+
+	/** 当前数据，指向OwnedData或内存映射区域 */
+	TConstArrayView<uint8> Data;
+
+	TArray<uint8> OwnedData;
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+
+	TArray<FRapidJsonNode> Nodes;
+
+	/** 节点下标到修改后的原始Json文本 */
+	TMap<int32, FString> Overrides;
+
+	/** 数据来源的文件，从字符串加载时为空 */
+	FString SourceFilePath;
+
+	/** 源文件在加载或上次由文档写入后的修改时间，用于发现外部修改 */
+	FDateTime SourceTimeStamp = FDateTime::MinValue();
+
+	bool bModified = false;
+
+	FString LastError;
+};
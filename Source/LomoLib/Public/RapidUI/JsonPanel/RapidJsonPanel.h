@@ -4,10 +4,21 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "RapidUI/JsonPanel/RapidJsonDocument.h"
 #include "RapidJsonPanel.generated.h"
 
+class UListView;
+class URapidJsonRowItem;
+class FRapidJsonStructSchema;
+struct FRapidJsonValueSchema;
+
+DECLARE_DYNAMIC_MULTICAST_DELEGATE_TwoParams(FOnRapidJsonValueChanged, int32, NodeIndex, const FString&, NewValue);
+
 /**
  * RapidJsonPanel 用于展示和编辑 任意Json 数据
+ * 数据保存在按偏移索引的FRapidJsonDocument中，不构建FJsonObject树：
+ * 节点展开时才为子节点建立索引，行由ListView虚拟化，只为屏幕上的行创建控件
+ * 也可以绑定结构体内存，按缓存的反射结构显示，修改直接写入结构体
  */
 UCLASS()
 class LOMOLIB_API URapidJsonPanel : public UUserWidget
@@ -15,5 +26,156 @@ class LOMOLIB_API URapidJsonPanel : public UUserWidget
 	GENERATED_BODY()
 
 public:
-	
+	/** 加载Json文件 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool LoadFromFile(const FString& FilePath);
+
+	/** 加载Json字符串 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool LoadFromString(const FString& JsonText);
+
+	/** 保存到文件，未修改的部分直接拷贝原始数据 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool SaveToFile(const FString& FilePath);
+
+	/**
+	 * 绑定结构体内存，面板显示结构体的Json表示，修改直接写入结构体
+	 * 调用者需要保证内存在绑定期间有效，加载其他数据或Clear时解除绑定
+	 */
+	bool BindStruct(const UScriptStruct* InStruct, void* InStructMemory);
+
+	template<typename T>
+	bool BindStruct(T& InStruct)
+	{
+		return BindStruct(T::StaticStruct(), &InStruct);
+	}
+
+	/** 解除结构体绑定，已显示的数据保持不变 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	void UnbindStruct();
+
+	/** 结构体在外部被修改后重新生成显示的数据 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool RefreshBoundStruct();
+
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool IsStructBound() const;
+
+	/** 把修改直接写回源文件，新值比原值长时退回到重写整个文件 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool SaveChanges();
+
+	/** 清空面板 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	void Clear();
+
+	/** 展开或折叠节点 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	void ToggleNodeExpansion(int32 NodeIndex);
+
+	/** 展开节点，会为子节点建立索引 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool ExpandNode(int32 NodeIndex);
+
+	/** 折叠节点 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	void CollapseNode(int32 NodeIndex);
+
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool IsNodeExpanded(int32 NodeIndex) const;
+
+	/**
+	 * 修改标量节点的值
+	 * @param Value 字符串节点为字符串内容；其他节点为Json字面量
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool SetNodeValue(int32 NodeIndex, const FString& Value);
+
+	/**
+	 * 执行JSONPath子集查询，语法见FRapidJsonQuery
+	 * @return 匹配节点的下标，按文档顺序；表达式错误时返回空数组并设置Error
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	TArray<int32> Query(const FString& Expression, FString& Error);
+
+	/**
+	 * 把多个标量节点修改为同一个值，容器节点会被跳过
+	 * @return 实际修改的节点数
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	int32 SetNodeValues(const TArray<int32>& NodeIndices, const FString& Value);
+
+	/** 节点的原始Json文本 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	FString GetNodeValue(int32 NodeIndex) const;
+
+	/** 是否有未保存的修改 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	bool IsModified() const;
+
+	/** 最近一次错误 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	FString GetLastError() const;
+
+	/** 节点的值被修改时触发 */
+	UPROPERTY(BlueprintAssignable, Category = "Json Panel")
+	FOnRapidJsonValueChanged OnValueChanged;
+
+	FRapidJsonDocument& GetDocument() { return Document; }
+	const FRapidJsonDocument& GetDocument() const { return Document; }
+
+protected:
+	// 行列表，条目控件需要继承URapidJsonRowWidget
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+	UListView* RowListView;
+
+	/** 加载后自动展开的层数 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Json Panel")
+	int32 InitialExpandDepth = 1;
+
+private:
+	/** 加载后重建行列表 */
+	void ResetRows();
+
+	/** 把节点已展开的子树按显示顺序追加到OutRows */
+	void AppendVisibleChildren(int32 NodeIndex, TArray<URapidJsonRowItem*>& OutRows);
+
+	/** 获取复用的行对象 */
+	URapidJsonRowItem* AcquireRowItem(int32 NodeIndex);
+
+	/** 行列表改变后刷新ListView */
+	void UpdateListView();
+
+	/** 节点所在的行，节点不可见时返回INDEX_NONE */
+	int32 FindRow(int32 NodeIndex) const;
+
+	/** 刷新显示某个节点的行 */
+	void RefreshNodeRow(int32 NodeIndex);
+
+	/**
+	 * 节点在绑定结构体中对应的值
+	 * @return 节点是结构体本身、集合元素、映射的键或者结构体已经改变时返回false
+	 */
+	bool ResolveBoundValue(int32 NodeIndex, const FRapidJsonValueSchema*& OutValue, void*& OutValuePtr) const;
+
+	/** 把输入的值写入结构体中的标量 */
+	static bool ImportBoundValue(const FRapidJsonValueSchema& InValue, void* InValuePtr, const FString& InText);
+
+	FRapidJsonDocument Document;
+
+	/** 绑定的结构体 */
+	TWeakObjectPtr<const UScriptStruct> BoundStruct;
+	void* BoundStructMemory = nullptr;
+	TSharedPtr<const FRapidJsonStructSchema> BoundSchema;
+
+	/** 已展开的节点 */
+	TSet<int32> ExpandedNodes;
+
+	/** 当前显示的行，按显示顺序 */
+	UPROPERTY()
+	TArray<URapidJsonRowItem*> Rows;
+
+	/** 被折叠后移出列表的行对象，下次展开时复用 */
+	UPROPERTY()
+	TArray<URapidJsonRowItem*> FreeRowItems;
 };
@@ -0,0 +1,103 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRapidJsonDocument;
+
+/**
+ * 在FRapidJsonDocument的偏移索引上执行的JSONPath子集查询
+ * 支持的语法：
+ * - $                      根节点
+ * - .key 或 ['key']        对象成员
+ * - [n]                    数组元素，负数从末尾计数
+ * - .* 或 [*]              所有子节点
+ * - ..key 或 ..*           递归查找
+ * - [?(@.a.b > 100)]       过滤子节点，运算符为 == != < <= > >=，值为数字、字符串、true、false、null
+ * - [?(@.a)]               过滤存在某个成员的子节点
+ * 查询只为经过的容器建立索引，不会构建DOM
+ */
+class LOMOLIB_API FRapidJsonQuery
+{
+public:
+	/**
+	 * 编译查询表达式
+	 * @return 语法错误时返回false，错误信息见GetError
+	 */
+	bool Compile(FStringView InExpression);
+
+	/** 执行查询，返回匹配节点的下标，按文档顺序 */
+	TArray<int32> Execute(FRapidJsonDocument& InDocument) const;
+
+	bool IsValid() const { return bCompiled; }
+	const FString& GetError() const { return Error; }
+
+	/** 编译并执行，表达式错误时返回空数组 */
+	static TArray<int32> Run(FRapidJsonDocument& InDocument, FStringView InExpression, FString* OutError = nullptr);
+
+private:
+	enum class EStepType : uint8
+	{
+		Child,
+		Index,
+		Wildcard,
+		/** 节点自身及所有子孙容器，用于实现".." */
+		Descendants,
+		Filter,
+	};
+
+	enum class EFilterOperator : uint8
+	{
+		Exists,
+		Equal,
+		NotEqual,
+		Less,
+		LessEqual,
+		Greater,
+		GreaterEqual,
+	};
+
+	enum class EFilterValueType : uint8
+	{
+		Number,
+		String,
+		Bool,
+		Null,
+	};
+
+	struct FFilter
+	{
+		/** @之后的成员路径 */
+		TArray<FString> FieldPath;
+		EFilterOperator Operator = EFilterOperator::Exists;
+		EFilterValueType ValueType = EFilterValueType::Null;
+		double NumberValue = 0.0;
+		FString StringValue;
+		bool bBoolValue = false;
+	};
+
+	struct FStep
+	{
+		EStepType Type = EStepType::Child;
+		FString Key;
+		int32 Index = 0;
+		FFilter Filter;
+	};
+
+	bool SetError(const FString& InError);
+
+	/** 解析[]中的内容，InText从'['之后开始，结束后指向']'之后 */
+	bool ParseBracket(FStringView& InText);
+	bool ParseFilter(FStringView InText, FFilter& OutFilter);
+
+	/** 节点是否满足过滤条件 */
+	static bool MatchFilter(FRapidJsonDocument& InDocument, int32 InNodeIndex, const FFilter& InFilter);
+
+	/** 把节点自身及所有子孙容器加入OutNodes（深度优先，文档顺序） */
+	static void CollectSubtree(FRapidJsonDocument& InDocument, int32 InNodeIndex, TArray<int32>& OutNodes);
+
+	TArray<FStep> Steps;
+	FString Error;
+	bool bCompiled = false;
+};
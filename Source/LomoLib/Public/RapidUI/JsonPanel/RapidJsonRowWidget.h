@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Blueprint/IUserObjectListEntry.h"
+#include "Blueprint/UserWidget.h"
+#include "Types/SlateEnums.h"
+#include "RapidJsonRowWidget.generated.h"
+
+class UButton;
+class UEditableTextBox;
+class USpacer;
+class UTextBlock;
+class URapidJsonPanel;
+
+/**
+ * RapidJsonPanel列表中的一行，只保存节点下标
+ */
+UCLASS(BlueprintType)
+class LOMOLIB_API URapidJsonRowItem : public UObject
+{
+	GENERATED_BODY()
+
+public:
+	/** 节点在文档中的下标 */
+	UPROPERTY(BlueprintReadOnly, Category = "Json Panel")
+	int32 NodeIndex = INDEX_NONE;
+
+	/** 所属的面板 */
+	UPROPERTY(BlueprintReadOnly, Category = "Json Panel")
+	TWeakObjectPtr<URapidJsonPanel> Panel;
+};
+
+/**
+ * RapidJsonPanel列表的行控件，由ListView按可见行复用
+ */
+UCLASS(Blueprintable)
+class LOMOLIB_API URapidJsonRowWidget : public UUserWidget, public IUserObjectListEntry
+{
+	GENERATED_BODY()
+
+public:
+	/** 用当前行的数据刷新显示 */
+	UFUNCTION(BlueprintCallable, Category = "Json Panel")
+	void RefreshRow();
+
+protected:
+	virtual void NativeOnInitialized() override;
+	virtual void NativeOnListItemObjectSet(UObject* ListItemObject) override;
+
+	/** 行刷新后调用，用于在蓝图中调整样式 */
+	UFUNCTION(BlueprintImplementableEvent, Category = "Json Panel")
+	void OnRowRefreshed(int32 Depth, bool bIsContainer, bool bIsExpanded);
+
+	// 键
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+	UTextBlock* KeyText;
+
+	// 值，容器为只读
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+	UEditableTextBox* ValueTextBox;
+
+	// 展开按钮
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UButton* ExpandButton;
+
+	// 展开按钮上的文本
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UTextBlock* ExpandText;
+
+	// 缩进
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	USpacer* IndentSpacer;
+
+	// 每层缩进的宽度
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Json Panel")
+	float IndentWidth = 16.0f;
+
+	UFUNCTION()
+	void HandleExpandClicked();
+
+	UFUNCTION()
+	void HandleValueCommitted(const FText& Text, ETextCommit::Type CommitMethod);
+
+private:
+	UPROPERTY()
+	URapidJsonRowItem* RowItem = nullptr;
+};
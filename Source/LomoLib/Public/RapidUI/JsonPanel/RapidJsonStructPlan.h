@@ -0,0 +1,120 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/JsonPanel/RapidJsonStructSchema.h"
+
+/** 计划中的操作，按内存中的具体类型区分，执行时不需要虚函数 */
+enum class ERapidJsonPlanOp : uint8
+{
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	/** 按Size读取底层整数，写为枚举名 */
+	Enum,
+	String,
+	Name,
+	/** 动态数组，元素按SubBlock执行 */
+	Array,
+	/** 其他类型（文本、集合、映射、对象引用等），交给FRapidJsonStructWriter/Reader的通用路径 */
+	Generic,
+};
+
+/** 计划中的一步：先输出前缀字面量（分隔符和键），再在偏移处读写一个值 */
+struct FRapidJsonPlanStep
+{
+	ERapidJsonPlanOp Op = ERapidJsonPlanOp::Generic;
+
+	/** 布尔值的掩码，见FBoolProperty */
+	uint8 ByteMask = 0;
+	uint8 FieldMask = 0;
+
+	/** 枚举底层整数的大小和符号 */
+	uint8 Size = 0;
+	bool bSigned = false;
+
+	/** 相对所在段基址的偏移，嵌套结构体已经展开为累加后的偏移 */
+	int32 Offset = 0;
+
+	/** 前缀在Literals中的位置 */
+	int32 PrefixStart = 0;
+	int32 PrefixLength = 0;
+
+	/** 数组元素对应的段和元素大小 */
+	int32 SubBlock = INDEX_NONE;
+	int32 ElementSize = 0;
+
+	/** 枚举、数组和通用步骤使用的值结构 */
+	const FRapidJsonValueSchema* Value = nullptr;
+};
+
+/** 连续的一段步骤，对应一个结构体或数组元素 */
+struct FRapidJsonPlanBlock
+{
+	int32 FirstStep = 0;
+	int32 NumSteps = 0;
+
+	/** 最后一步之后的字面量（结束括号） */
+	int32 SuffixStart = 0;
+	int32 SuffixLength = 0;
+};
+
+/**
+ * 由FRapidJsonStructSchema编译的扁平序列化计划
+ * - 嵌套结构体和静态数组展开为连续的步骤，偏移在编译时累加
+ * - 键、逗号和括号合并为每步一段预先编码的前缀
+ * - 标量按具体类型直接读写内存
+ * 用于大量写入和读取热点结构体，输出与FRapidJsonStructWriter的紧凑格式相同
+ * 每个原生结构体只编译一次并缓存，用户定义结构体每次获取时重新编译，只能在游戏线程获取
+ */
+class LOMOLIB_API FRapidJsonStructPlan
+{
+public:
+	/** 获取结构体的计划，首次调用时编译 */
+	static TSharedRef<const FRapidJsonStructPlan> Get(const UScriptStruct* InStruct);
+
+	/** 结构体本身对应的段 */
+	static constexpr int32 RootBlock = 0;
+
+	const TArray<FRapidJsonPlanStep>& GetSteps() const { return Steps; }
+	const TArray<FRapidJsonPlanBlock>& GetBlocks() const { return Blocks; }
+	const TArray<uint8>& GetLiterals() const { return Literals; }
+	const FRapidJsonStructSchema& GetSchema() const { return *Schema; }
+
+	/** 通用步骤的数量，为0时整个结构体都由专用步骤处理 */
+	int32 NumGenericSteps() const;
+
+	/** 可读的计划内容，每步一行，用于工具中查看 */
+	FString Describe() const;
+
+private:
+	/** 编译值的结构为一段，返回段的下标 */
+	int32 CompileBlock(const FRapidJsonValueSchema* InValue, const FRapidJsonStructSchema* InStructSchema);
+
+	/** 把结构体的字段追加到当前段 */
+	void CompileStruct(const FRapidJsonStructSchema& InSchema, int32 InBaseOffset, TArray<uint8>& InOutPrefix, TArray<FRapidJsonPlanStep>& OutSteps);
+
+	/** 把一个值追加到当前段，结构体展开 */
+	void CompileValue(const FRapidJsonValueSchema& InValue, int32 InOffset, TArray<uint8>& InOutPrefix, TArray<FRapidJsonPlanStep>& OutSteps);
+
+	/** 把前缀移动到Literals，返回位置 */
+	int32 FlushLiteral(TArray<uint8>& InOutLiteral, int32& OutLength);
+
+	TSharedPtr<const FRapidJsonStructSchema> Schema;
+
+	TArray<FRapidJsonPlanStep> Steps;
+	TArray<FRapidJsonPlanBlock> Blocks;
+	TArray<uint8> Literals;
+
+	/** 编译时数组元素的值结构到段的映射，结构体通过数组引用自身时复用同一段 */
+	TMap<const FRapidJsonValueSchema*, int32> ElementBlocks;
+};
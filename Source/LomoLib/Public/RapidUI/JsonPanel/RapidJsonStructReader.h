@@ -0,0 +1,89 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/JsonPanel/RapidJsonStructSchema.h"
+
+class FRapidJsonStructPlan;
+
+/**
+ * 按FRapidJsonStructSchema把UTF-8 Json直接读入结构体内存，不构建FJsonObject
+ * 与FRapidJsonStructWriter的输出对应，行为与FJsonObjectConverter相同：
+ * 未知的键被忽略，缺少的字段保持原值，键不区分大小写，枚举可以是名字或数值
+ * 结构体内存需要已经初始化
+ */
+class LOMOLIB_API FRapidJsonStructReader
+{
+public:
+	explicit FRapidJsonStructReader(TConstArrayView<uint8> InData);
+
+	/** 读取一个Json对象到结构体，之后只能有空白 */
+	bool ReadStruct(const FRapidJsonStructSchema& InSchema, void* InStructMemory);
+
+	/**
+	 * 按编译好的计划读取，输入为计划的紧凑格式时逐段匹配前缀，不需要查找键
+	 * 输入格式不同（有空白、键的顺序不同、缺少字段等）时退回到ReadStruct
+	 */
+	bool ReadPlan(const FRapidJsonStructPlan& InPlan, void* InStructMemory);
+
+	/** 获取结构体的结构并读取 */
+	static bool Read(const UScriptStruct* InStruct, void* InStructMemory, TConstArrayView<uint8> InData, FString* OutError = nullptr);
+
+	/** 错误信息，包含出错的位置 */
+	const FString& GetError() const { return Error; }
+
+private:
+	/** 执行计划中的一段，与计划不符时返回false */
+	bool ReadPlanBlock(const FRapidJsonStructPlan& InPlan, int32 InBlockIndex, uint8* InBaseMemory);
+
+	/** 匹配并跳过一段字面量 */
+	bool MatchLiteral(const uint8* InLiteral, int32 InLength);
+
+	bool ReadObject(const FRapidJsonStructSchema& InSchema, uint8* InStructMemory);
+	bool ReadValue(const FRapidJsonValueSchema& InValue, void* InValuePtr);
+	bool ReadStaticArray(const FRapidJsonFieldSchema& InField, uint8* InStructMemory);
+	bool ReadArray(const FRapidJsonValueSchema& InValue, void* InValuePtr);
+	bool ReadSet(const FRapidJsonValueSchema& InValue, void* InValuePtr);
+	bool ReadMap(const FRapidJsonValueSchema& InValue, void* InValuePtr);
+
+	/** 映射的键是字符串，按键的类型转换 */
+	bool ImportMapKey(const FRapidJsonValueSchema& InKey, void* InKeyPtr, const FString& InKeyText);
+
+	/** 按原始字节匹配键，匹配不到时按解码后的键不区分大小写查找 */
+	const FRapidJsonFieldSchema* FindField(const FRapidJsonStructSchema& InSchema, int32 InKeyStart, int32 InKeyEnd, int32& InOutNextField);
+
+	/** 读取数字，bIsInteger表示没有小数部分和指数 */
+	bool ReadNumber(int64& OutInteger, uint64& OutUnsigned, double& OutDouble, bool& bOutIsInteger);
+
+	/** 扫描字符串，Pos指向开头的引号，返回包含引号的范围 */
+	bool ScanString(int32& OutStart, int32& OutEnd);
+
+	/** 把扫描到的字符串解码追加到OutString */
+	void DecodeString(int32 InStart, int32 InEnd, FString& OutString) const;
+
+	/** 读取字符串并解码 */
+	bool ReadString(FString& OutString);
+
+	/** 跳过一个任意的值 */
+	bool SkipValue();
+
+	bool ReadLiteral(const ANSICHAR* InLiteral, int32 InLength);
+
+	void SkipWhitespace();
+
+	uint8 Peek() const { return Pos < Data.Num() ? Data[Pos] : 0; }
+
+	bool Consume(uint8 InChar);
+
+	bool SetError(const TCHAR* InMessage);
+
+	TConstArrayView<uint8> Data;
+
+	int32 Pos = 0;
+
+	/** 名字、文本和ExportText的临时字符串，多次读取时复用 */
+	FString ScratchText;
+
+	FString Error;
+};
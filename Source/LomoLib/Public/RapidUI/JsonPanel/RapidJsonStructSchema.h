@@ -0,0 +1,119 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FRapidJsonStructSchema;
+
+/** 属性在Json中的表示方式 */
+enum class ERapidJsonValueKind : uint8
+{
+	Bool,
+	SignedInteger,
+	UnsignedInteger,
+	Float,
+	/** 带UEnum的枚举或字节属性，写为枚举名 */
+	Enum,
+	String,
+	Name,
+	Text,
+	/** 嵌套结构体，写为对象 */
+	Struct,
+	Array,
+	/** 集合，写为数组 */
+	Set,
+	/** 映射，写为对象，键转换为字符串 */
+	Map,
+	/** 其他属性（对象引用等），写为ExportText的字符串 */
+	Other,
+};
+
+/**
+ * 一个值的Json表示，由属性类型决定
+ * 容器的元素和映射的键、值也用这个结构描述
+ */
+struct LOMOLIB_API FRapidJsonValueSchema
+{
+	const FProperty* Property = nullptr;
+
+	ERapidJsonValueKind Kind = ERapidJsonValueKind::Other;
+
+	/** 整数、浮点数和枚举的底层数值属性 */
+	const FNumericProperty* NumericProperty = nullptr;
+
+	/** 枚举的UEnum */
+	const UEnum* Enum = nullptr;
+
+	/** 枚举值和编码后的Json字符串（包含引号），写入时不需要查找名字 */
+	TArray<int64> EnumValues;
+	TArray<TArray<uint8>> EncodedEnumNames;
+
+	/** 嵌套结构体的结构 */
+	TSharedPtr<const FRapidJsonStructSchema> StructSchema;
+
+	/** 数组和集合为[元素]，映射为[键, 值] */
+	TArray<FRapidJsonValueSchema> Inner;
+
+	/** 编码后的枚举名，找不到时返回nullptr */
+	const TArray<uint8>* FindEncodedEnumName(int64 InValue) const;
+};
+
+/** 结构体的一个字段 */
+struct LOMOLIB_API FRapidJsonFieldSchema
+{
+	/** Json中的键，与FJsonObjectConverter相同（首字母小写） */
+	FString Key;
+
+	/** 编码后的键（包含引号），写入时直接拷贝 */
+	TArray<uint8> EncodedKey;
+
+	/** 相对结构体的偏移 */
+	int32 Offset = 0;
+
+	/** 静态数组的长度，大于1时写为数组 */
+	int32 ArrayDim = 1;
+
+	/** 静态数组中每个元素的大小 */
+	int32 ElementSize = 0;
+
+	FRapidJsonValueSchema Value;
+};
+
+/**
+ * 由反射生成的结构体Json结构，每个原生结构体只构建一次并缓存，用户定义结构体每次获取时重新构建
+ * 写入和编辑时按字段表直接访问内存，不需要遍历TFieldIterator或按名字查找属性
+ * 与FJsonObjectConverter一样跳过Transient和Deprecated属性，读取时忽略它们的键
+ * 只能在游戏线程获取
+ */
+class LOMOLIB_API FRapidJsonStructSchema
+{
+public:
+	/** 获取结构体对应的结构，首次调用时构建 */
+	static TSharedRef<const FRapidJsonStructSchema> Get(const UScriptStruct* InStruct);
+
+	const UScriptStruct* GetStruct() const { return Struct; }
+
+	const TArray<FRapidJsonFieldSchema>& GetFields() const { return Fields; }
+
+	/** 按Json键查找字段，找不到时返回nullptr */
+	const FRapidJsonFieldSchema* FindField(const FString& InKey) const;
+
+	/** 不写入也不读取的属性标记，对应FJsonObjectConverter未指定SkipFlags时的默认值 */
+	static constexpr EPropertyFlags SkippedPropertyFlags = CPF_Transient | CPF_Deprecated;
+
+	/** 把字符串编码为Json字符串（UTF-8，包含引号），追加到OutBytes */
+	static void AppendEncodedString(TArray<uint8>& OutBytes, const TCHAR* InString, int32 InLength);
+
+private:
+	void Build(const UScriptStruct* InStruct);
+
+	static void BuildValue(const FProperty* InProperty, FRapidJsonValueSchema& OutValue);
+
+	const UScriptStruct* Struct = nullptr;
+
+	TArray<FRapidJsonFieldSchema> Fields;
+
+	/** Json键到字段的下标，与FJsonObjectConverter一样不区分大小写 */
+	TMap<FString, int32> KeyToField;
+};
@@ -0,0 +1,74 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/JsonPanel/RapidJsonStructSchema.h"
+
+class FRapidJsonStructPlan;
+
+/**
+ * 按FRapidJsonStructSchema把结构体内存直接写为UTF-8 Json，不构建FJsonObject
+ * 输出追加到调用者提供的缓冲，缓冲可以在多次写入之间复用
+ * 输出格式与FJsonObjectConverter相同：键首字母小写，枚举写为名字，映射的键用ExportText转换为字符串
+ */
+class LOMOLIB_API FRapidJsonStructWriter
+{
+public:
+	FRapidJsonStructWriter(TArray<uint8>& InBuffer, bool bInPrettyPrint = false);
+
+	/** 把结构体写为Json对象，追加到缓冲末尾 */
+	void WriteStruct(const FRapidJsonStructSchema& InSchema, const void* InStructMemory);
+
+	/** 获取结构体的结构并写入OutBuffer末尾 */
+	static void Write(const UScriptStruct* InStruct, const void* InStructMemory, TArray<uint8>& OutBuffer, bool bPrettyPrint = false);
+
+	/** 写入单个值 */
+	void WriteValue(const FRapidJsonValueSchema& InValue, const void* InValuePtr);
+
+	/** 按编译好的计划写入结构体，格式化输出时使用WriteStruct */
+	void WritePlan(const FRapidJsonStructPlan& InPlan, const void* InStructMemory);
+
+	/** 数字的Json文本，浮点数使用能还原原值的最短精度 */
+	static void AppendSignedInteger(TArray<uint8>& OutBuffer, int64 InValue);
+	static void AppendUnsignedInteger(TArray<uint8>& OutBuffer, uint64 InValue);
+	static void AppendFloat(TArray<uint8>& OutBuffer, double InValue, bool bSinglePrecision);
+
+private:
+	/** 执行计划中的一段 */
+	void WritePlanBlock(const FRapidJsonStructPlan& InPlan, int32 InBlockIndex, const uint8* InBaseMemory);
+
+	/** 映射的键总是字符串 */
+	void WriteMapKey(const FRapidJsonValueSchema& InKey, const void* InKeyPtr);
+
+	/** 写入ExportText的结果作为字符串 */
+	void WriteExportedText(const FProperty* InProperty, const void* InValuePtr);
+
+	void WriteString(const FString& InValue)
+	{
+		FRapidJsonStructSchema::AppendEncodedString(Buffer, *InValue, InValue.Len());
+	}
+
+	void WriteLiteral(const ANSICHAR* InLiteral, int32 InLength)
+	{
+		Buffer.Append(reinterpret_cast<const uint8*>(InLiteral), InLength);
+	}
+
+	/** 容器的开始和结束，格式化输出时处理换行和缩进 */
+	void BeginContainer(uint8 InOpen);
+	void EndContainer(uint8 InClose, bool bEmpty);
+
+	/** 容器中下一个元素之前的分隔符 */
+	void WriteSeparator(bool bFirst);
+
+	void WriteKey(const TArray<uint8>& InEncodedKey);
+
+	TArray<uint8>& Buffer;
+
+	bool bPrettyPrint = false;
+
+	int32 IndentLevel = 0;
+
+	/** ExportText的临时字符串，多次写入时复用 */
+	FString ScratchText;
+};
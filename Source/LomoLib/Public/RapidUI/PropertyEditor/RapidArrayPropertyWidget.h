@@ -65,9 +65,16 @@ protected:
     UFUNCTION()
     void HandleElementDeleteClicked(int32 ElementIndex);
     
+    // 折叠时是否释放元素控件，释放后再次展开会重新创建
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Property Widget")
+    bool bReleaseChildrenOnCollapse = false;
+    
     // 处理子属性值改变
+    void HandleChildPropertyPathChanged(UObject* Object, const FRapidPropertyPath& InChildPropertyPath);
+    
+    // 处理展开状态改变，首次展开时才创建元素控件
     UFUNCTION()
-    void HandleChildPropertyValueChanged(UObject* Object, FName InPropertyName, URapidPropertyWidget* PropertyWidget);
+    void HandleExpansionChanged(UExpandableArea* Area, bool bIsExpanded);
     
 private:
     // 创建数组中的所有元素控件
@@ -79,6 +86,12 @@ private:
     // 更新所有元素的显示
     void UpdateElementWidgets();
     
+    // 释放已创建的元素控件
+    void ReleaseElementWidgets();
+    
+    // 元素控件是否已经创建
+    bool bChildrenCreated = false;
+    
     // 内部保存的数组属性
     FArrayProperty* ArrayProperty;
     
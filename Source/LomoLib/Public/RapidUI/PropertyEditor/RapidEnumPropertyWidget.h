@@ -0,0 +1,85 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Types/SlateEnums.h"
+#include "RapidUI/PropertyEditor/RapidPropertyWidget.h"
+#include "RapidEnumPropertyWidget.generated.h"
+
+class UComboBoxString;
+class UTextBlock;
+class FNumericProperty;
+
+/**
+ * 某个UEnum可供选择的项，每个UEnum只构建一次
+ */
+struct FRapidEnumOptions
+{
+    /** 下拉框中显示的名称 */
+    TArray<FString> DisplayNames;
+
+    /** 与DisplayNames一一对应的枚举值 */
+    TArray<int64> Values;
+
+    /** 获取UEnum对应的选项，跳过隐藏项和自动生成的_MAX；只缓存原生枚举 */
+    static TSharedRef<const FRapidEnumOptions> Get(const UEnum* InEnum);
+
+    /** 枚举值在选项中的位置，找不到时返回INDEX_NONE */
+    int32 IndexOfValue(int64 InValue) const
+    {
+        return Values.IndexOfByKey(InValue);
+    }
+};
+
+/**
+ * 枚举类型的属性控件，支持FEnumProperty和带枚举的FByteProperty
+ */
+UCLASS(BlueprintType, Blueprintable)
+class LOMOLIB_API URapidEnumPropertyWidget : public URapidPropertyWidget
+{
+    GENERATED_BODY()
+
+public:
+    URapidEnumPropertyWidget(const FObjectInitializer& ObjectInitializer);
+
+    // 重写初始化方法
+    virtual bool InitializePropertyWidget(UObject* InObject, FProperty* InProperty, const FName& InPropertyName) override;
+
+    // 重写更新值方法
+    virtual void UpdateValue_Implementation() override;
+
+    /** 属性是否为枚举类型 */
+    static bool SupportsProperty(const FProperty* InProperty);
+
+    // 设置枚举值
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    bool SetValue(int64 InValue);
+
+    // 获取枚举值
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    int64 GetValue() const;
+
+protected:
+    // 属性名称显示
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+    UTextBlock* PropertyNameText;
+
+    // 枚举选择框
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+    UComboBoxString* ValueComboBox;
+
+    // 选择变化时的处理函数
+    UFUNCTION()
+    void HandleSelectionChanged(FString SelectedItem, ESelectInfo::Type SelectionType);
+
+private:
+    // 当前值
+    int64 CurrentValue;
+
+    // 存储枚举值的整数属性，FEnumProperty为其底层属性
+    FNumericProperty* UnderlyingProperty = nullptr;
+
+    // 枚举选项
+    TSharedPtr<const FRapidEnumOptions> EnumOptions;
+};
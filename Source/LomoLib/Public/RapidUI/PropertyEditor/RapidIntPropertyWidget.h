@@ -46,6 +46,14 @@ protected:
     // 数值变化时的处理函数
     UFUNCTION()
     void HandleValueChanged(float NewValue);
+
+    // 开始拖动SpinBox时的处理函数，拖动期间的修改合并为一条撤销记录
+    UFUNCTION()
+    void HandleBeginSliderMovement();
+
+    // 结束拖动SpinBox时的处理函数
+    UFUNCTION()
+    void HandleEndSliderMovement(float NewValue);
     
 private:
     // 当前值
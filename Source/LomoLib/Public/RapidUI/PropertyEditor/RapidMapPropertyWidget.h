@@ -28,6 +28,9 @@ public:
     // 重写更新值方法
     virtual void UpdateValue_Implementation() override;
     
+    // 键被修改后重建哈希，与其他元素的键重复时还原修改
+    virtual void PreCommitChildPropertyValue(const FRapidPropertyPath& InChildPropertyPath, const FRapidPropertyValueBuffer& InBeforeValue) override;
+    
     /** 获取元素小部件类 */
     UFUNCTION(BlueprintCallable, Category = "Property Widget")
     TSubclassOf<URapidMapElementWidget> GetElementWidgetClass() const;
@@ -65,9 +68,16 @@ protected:
     UFUNCTION()
     void HandleElementDeleteClicked(int32 ElementIndex);
     
+    // 折叠时是否释放键值对控件，释放后再次展开会重新创建
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Property Widget")
+    bool bReleaseChildrenOnCollapse = false;
+    
     // 处理子属性值改变
+    void HandleChildPropertyPathChanged(UObject* Object, const FRapidPropertyPath& InChildPropertyPath);
+    
+    // 处理展开状态改变，首次展开时才创建键值对控件
     UFUNCTION()
-    void HandleChildPropertyValueChanged(UObject* Object, FName InPropertyName, URapidPropertyWidget* PropertyWidget);
+    void HandleExpansionChanged(UExpandableArea* Area, bool bIsExpanded);
     
 private:
     // 创建映射中的所有元素控件
@@ -79,6 +89,24 @@ private:
     // 更新所有元素的显示
     void UpdatePairWidgets();
     
+    // 释放已创建的键值对控件
+    void ReleaseElementWidgets();
+    
+    // 是否可以增删和修改元素，多对象编辑时映射是只读的
+    bool CanEditElements() const;
+    
+    // 按CanEditElements启用或禁用元素控件和添加按钮
+    void UpdateEditability();
+    
+    // 子属性路径是否是本映射某个元素的键，是时返回该元素的稀疏下标
+    int32 GetEditedKeySparseIndex(const FRapidPropertyPath& InChildPropertyPath) const;
+    
+    // 键值对控件是否已经创建
+    bool bChildrenCreated = false;
+    
+    // 每个元素控件对应的稀疏下标，整个映射被替换（如撤销）后下标可能改变
+    TArray<int32> ElementSparseIndices;
+    
     // 内部保存的映射属性
     FMapProperty* MapProperty;
     
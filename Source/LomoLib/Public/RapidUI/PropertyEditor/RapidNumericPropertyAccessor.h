@@ -0,0 +1,197 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * 数值属性的读写接口，控件统一用double与之交互
+ * double无法精确表示的大整数通过文本读写，不经过浮点转换
+ * 具体实现按FProperty类型在编译期特化，读写直接调用该类型的静态访问函数
+ */
+class IRapidNumericPropertyAccessor
+{
+public:
+    virtual ~IRapidNumericPropertyAccessor() = default;
+
+    virtual double GetValue(const void* InValuePtr) const = 0;
+
+    /** 写入值，整数类型会四舍五入并限制在类型范围内 */
+    virtual void SetValue(void* OutValuePtr, double InValue) const = 0;
+
+    virtual bool IsInteger() const = 0;
+
+    /** 类型的所有值是否都能用float精确表示，是时可以使用SpinBox编辑 */
+    virtual bool IsExactInFloat() const = 0;
+
+    /** 值的文本，整数为十进制，浮点数为能还原原值的最短表示 */
+    virtual FString GetValueText(const void* InValuePtr) const = 0;
+
+    /**
+     * 从文本写入值，不经过double转换
+     * @return 文本不是有效的数值时返回false，不写入
+     */
+    virtual bool SetValueFromText(void* OutValuePtr, const FString& InText) const = 0;
+
+    /** 类型本身能表示的范围 */
+    virtual double GetLowest() const = 0;
+    virtual double GetMax() const = 0;
+};
+
+/** 某个具体数值属性类型的访问实现 */
+template<typename TProperty>
+class TRapidNumericPropertyAccessor final : public IRapidNumericPropertyAccessor
+{
+public:
+    using TCppType = typename TProperty::TCppType;
+
+    virtual double GetValue(const void* InValuePtr) const override
+    {
+        return static_cast<double>(TProperty::GetPropertyValue(InValuePtr));
+    }
+
+    virtual void SetValue(void* OutValuePtr, double InValue) const override
+    {
+        if constexpr (TIsIntegral<TCppType>::Value)
+        {
+            // 64位整数的上限无法用double精确表示，越界时直接使用类型的极值
+            const double RoundedValue = FMath::RoundToDouble(InValue);
+            const TCppType Value = RoundedValue <= GetLowest() ? TNumericLimits<TCppType>::Lowest()
+                : RoundedValue >= GetMax() ? TNumericLimits<TCppType>::Max()
+                : static_cast<TCppType>(RoundedValue);
+            TProperty::SetPropertyValue(OutValuePtr, Value);
+        }
+        else
+        {
+            TProperty::SetPropertyValue(OutValuePtr, static_cast<TCppType>(FMath::Clamp(InValue, GetLowest(), GetMax())));
+        }
+    }
+
+    virtual bool IsInteger() const override
+    {
+        return TIsIntegral<TCppType>::Value;
+    }
+
+    virtual bool IsExactInFloat() const override
+    {
+        // float的尾数有24位，16位以内的整数都可以精确表示
+        return std::is_same_v<TCppType, float> || (TIsIntegral<TCppType>::Value && sizeof(TCppType) <= 2);
+    }
+
+    virtual FString GetValueText(const void* InValuePtr) const override
+    {
+        const TCppType Value = TProperty::GetPropertyValue(InValuePtr);
+        if constexpr (TIsIntegral<TCppType>::Value)
+        {
+            return LexToString(Value);
+        }
+        else
+        {
+            // 从15位有效数字开始尝试，得到能还原原值的最短文本
+            FString Text;
+            for (int32 Precision = 15; Precision <= 17; ++Precision)
+            {
+                Text = FString::Printf(TEXT("%.*g"), Precision, static_cast<double>(Value));
+                if (static_cast<TCppType>(FCString::Atod(*Text)) == Value)
+                {
+                    break;
+                }
+            }
+            return Text;
+        }
+    }
+
+    virtual bool SetValueFromText(void* OutValuePtr, const FString& InText) const override
+    {
+        const FString Text = InText.TrimStartAndEnd();
+        if constexpr (TIsIntegral<TCppType>::Value)
+        {
+            // 只接受十进制整数，超出类型范围时拒绝，避免静默截断
+            if (Text.IsEmpty() || !Text.IsNumeric() || Text.Contains(TEXT(".")))
+            {
+                return false;
+            }
+
+            // 解析后转回文本比较，可以发现超出范围被截断的值
+            FString Digits = Text;
+            const bool bNegative = Digits.RemoveFromStart(TEXT("-"));
+            if (!bNegative)
+            {
+                Digits.RemoveFromStart(TEXT("+"));
+            }
+            while (Digits.Len() > 1 && Digits[0] == TEXT('0'))
+            {
+                Digits.RightChopInline(1);
+            }
+            const FString Normalized = bNegative && Digits != TEXT("0") ? TEXT("-") + Digits : Digits;
+
+            TCppType Value = 0;
+            if (!LexTryParseString(Value, *Text) || LexToString(Value) != Normalized)
+            {
+                return false;
+            }
+            TProperty::SetPropertyValue(OutValuePtr, Value);
+            return true;
+        }
+        else
+        {
+            TCppType Value = 0;
+            if (Text.IsEmpty() || !LexTryParseString(Value, *Text))
+            {
+                return false;
+            }
+            TProperty::SetPropertyValue(OutValuePtr, Value);
+            return true;
+        }
+    }
+
+    virtual double GetLowest() const override
+    {
+        return static_cast<double>(TNumericLimits<TCppType>::Lowest());
+    }
+
+    virtual double GetMax() const override
+    {
+        return static_cast<double>(TNumericLimits<TCppType>::Max());
+    }
+};
+
+/**
+ * 编译期数值属性类型列表，初始化控件时匹配一次，之后的读写不再判断类型
+ */
+template<typename... TProperties>
+struct TRapidNumericPropertyDispatch
+{
+    static const IRapidNumericPropertyAccessor* Find(const FProperty* InProperty)
+    {
+        const IRapidNumericPropertyAccessor* Accessor = nullptr;
+        if (InProperty)
+        {
+            // 按列表顺序匹配第一个类型，找到后短路
+            ((Accessor == nullptr && InProperty->IsA<TProperties>() ? (Accessor = &GetAccessor<TProperties>(), true) : false), ...);
+        }
+        return Accessor;
+    }
+
+private:
+    template<typename TProperty>
+    static const IRapidNumericPropertyAccessor& GetAccessor()
+    {
+        static const TRapidNumericPropertyAccessor<TProperty> Accessor;
+        return Accessor;
+    }
+};
+
+/** 属性编辑器支持的所有数值属性类型 */
+using FRapidNumericPropertyDispatch = TRapidNumericPropertyDispatch<
+    FFloatProperty,
+    FDoubleProperty,
+    FInt8Property,
+    FInt16Property,
+    FIntProperty,
+    FInt64Property,
+    FByteProperty,
+    FUInt16Property,
+    FUInt32Property,
+    FUInt64Property>;
@@ -0,0 +1,95 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/PropertyEditor/RapidPropertyWidget.h"
+#include "RapidNumericPropertyWidget.generated.h"
+
+class USpinBox;
+class UTextBlock;
+class UEditableTextBox;
+class IRapidNumericPropertyAccessor;
+
+/**
+ * 通用数值类型的属性控件
+ * 支持float、double、int8/16/32/64、uint8/16/32/64，初始化时按属性类型选定访问实现
+ * USpinBox内部是float，只用于float能精确表示的类型；double和32/64位整数使用文本框，按文本精确读写
+ * 带枚举的字节属性由URapidEnumPropertyWidget处理
+ */
+UCLASS(BlueprintType, Blueprintable)
+class LOMOLIB_API URapidNumericPropertyWidget : public URapidPropertyWidget
+{
+    GENERATED_BODY()
+
+public:
+    URapidNumericPropertyWidget(const FObjectInitializer& ObjectInitializer);
+
+    // 重写初始化方法
+    virtual bool InitializePropertyWidget(UObject* InObject, FProperty* InProperty, const FName& InPropertyName) override;
+
+    // 重写更新值方法
+    virtual void UpdateValue_Implementation() override;
+
+    /** 属性是否为该控件支持的数值类型 */
+    static bool SupportsProperty(const FProperty* InProperty);
+
+    // 设置数值，整数类型会四舍五入
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    bool SetValue(double InValue);
+
+    // 获取数值
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    double GetValue() const;
+
+protected:
+    // 属性名称显示
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+    UTextBlock* PropertyNameText;
+
+    // 数值编辑框，用于float能精确表示的类型
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+    USpinBox* ValueSpinBox;
+
+    // 文本编辑框，用于double和32/64位整数
+    UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
+    UEditableTextBox* ValueTextBox;
+
+    // 数值变化时的处理函数
+    UFUNCTION()
+    void HandleValueChanged(float NewValue);
+
+    // 文本提交时的处理函数，文本不是有效数值时恢复显示当前值
+    UFUNCTION()
+    void HandleTextCommitted(const FText& InText, ETextCommit::Type InCommitMethod);
+
+    // 开始拖动SpinBox时的处理函数，拖动期间的修改合并为一条撤销记录
+    UFUNCTION()
+    void HandleBeginSliderMovement();
+
+    // 结束拖动SpinBox时的处理函数
+    UFUNCTION()
+    void HandleEndSliderMovement(float NewValue);
+
+private:
+    // 当前值
+    double CurrentValue;
+
+    // 按属性类型选定的访问实现
+    const IRapidNumericPropertyAccessor* Accessor = nullptr;
+
+    // 是否使用文本框编辑
+    bool bUseTextBox = false;
+
+    // 设置SpinBox属性的辅助方法
+    void SetupSpinBoxFromProperty();
+
+    // 把值写入属性并通知修改，值没有变化时不写入
+    bool ApplyValue(TFunctionRef<bool(void*)> InWriteValue);
+
+    // 按元数据的ClampMin和ClampMax限制值
+    void ClampToMetaData(void* InOutValuePtr) const;
+
+    // 显示属性的当前值
+    void DisplayValue(const void* InValuePtr);
+};
@@ -0,0 +1,92 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 两个快照之间的一处差异
+ */
+struct FRapidSnapshotDifference
+{
+    enum class EType : uint8
+    {
+        /** 两个快照中都有该属性，但值不同 */
+        Changed,
+        /** 只有第一个快照中有该属性 */
+        OnlyInA,
+        /** 只有第二个快照中有该属性 */
+        OnlyInB,
+    };
+
+    /** 对象在快照中的序号 */
+    int32 ObjectIndex = INDEX_NONE;
+    FName PropertyName;
+    EType Type = EType::Changed;
+};
+
+/**
+ * 一个或多个对象可编辑属性的二进制快照，用于在运行时保存和切换调参方案
+ *
+ * 格式：
+ * 1. 头部：魔数、版本号
+ * 2. 名称表：所有属性名只保存一次，记录中按下标引用
+ * 3. 每个对象：类路径、记录数，以及每个属性的名称下标、类型标签、数据长度和数据
+ *
+ * 属性数据通过FProperty::SerializeItem以二进制写入，不经过ExportText；
+ * 恢复时按属性名匹配，类型标签不一致的属性会被跳过，因此类布局变化后旧快照仍可部分恢复
+ * 顶层的对象引用、委托等属性不会保存
+ */
+class LOMOLIB_API FRapidObjectSnapshot
+{
+public:
+    /** 保存对象的可编辑属性，对象按顺序编号 */
+    static FRapidObjectSnapshot Capture(TConstArrayView<UObject*> InObjects);
+
+    /**
+     * 按序号把快照恢复到对象上，只遍历一遍数据
+     * @param InObjects 目标对象，第i个对象使用快照中第i个对象的数据
+     * @param OutRestoredProperties 可选，输出每个对象被恢复的属性
+     * @return 恢复的属性总数
+     */
+    int32 Restore(TConstArrayView<UObject*> InObjects, TArray<TArray<FProperty*>>* OutRestoredProperties = nullptr) const;
+
+    /** 比较两个快照，直接比较属性的二进制数据，不需要反序列化 */
+    static TArray<FRapidSnapshotDifference> Diff(const FRapidObjectSnapshot& InA, const FRapidObjectSnapshot& InB);
+
+    /** 使用已有的二进制数据，格式无效时返回false并清空快照 */
+    bool SetData(TArray<uint8>&& InData);
+    const TArray<uint8>& GetData() const { return Data; }
+
+    bool SaveToFile(const FString& InFilePath) const;
+    bool LoadFromFile(const FString& InFilePath);
+
+    bool IsValid() const { return Objects.Num() > 0; }
+    int32 NumObjects() const { return Objects.Num(); }
+
+private:
+    /** 一条属性记录在Data中的位置 */
+    struct FRecord
+    {
+        int32 NameIndex = INDEX_NONE;
+        uint32 TypeTag = 0;
+        int32 Offset = 0;
+        int32 Size = 0;
+    };
+
+    struct FObjectRecord
+    {
+        FString ClassPath;
+        TArray<FRecord> Records;
+    };
+
+    /** 解析Data，建立记录索引 */
+    bool Parse();
+
+    /** 记录的属性数据 */
+    TConstArrayView<uint8> GetPayload(const FRecord& InRecord) const;
+
+    TArray<uint8> Data;
+    TArray<FName> Names;
+    TArray<FObjectRecord> Objects;
+};
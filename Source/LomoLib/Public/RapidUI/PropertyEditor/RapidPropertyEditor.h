@@ -11,6 +11,8 @@
  * 2. 具体类型的属性控件:
  *    - URapidFloatPropertyWidget - 浮点数属性控件
  *    - URapidIntPropertyWidget - 整数属性控件
+ *    - URapidNumericPropertyWidget - 通用数值属性控件 (double, int64, uint8等)
+ *    - URapidEnumPropertyWidget - 枚举属性控件
  *    - URapidBoolPropertyWidget - 布尔属性控件
  *    - URapidStringPropertyWidget - 字符串属性控件 (支持FString, FName, FText)
  *    - URapidStructPropertyWidget - 结构体属性控件
@@ -73,12 +75,16 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+#include "RapidUI/PropertyEditor/RapidPropertyTransactionBuffer.h"
+#include "RapidUI/PropertyEditor/RapidPropertySearchIndex.h"
 #include "RapidPropertyEditor.generated.h"
 
 class USpinBox;
 class UScrollBox;
 class UVerticalBox;
 class UButton;
+class UEditableTextBox;
 class URapidPropertyWidget;
 
 /**
@@ -102,13 +108,43 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Property Editor")
 	bool SetObject(UObject* InObject);
 
+	/**
+	 * 同时编辑多个对象，只显示所有对象共同基类上的属性
+	 * 各对象值不同的属性会标记为"多个值"，一次修改会写入所有对象
+	 * 映射和集合的元素在各对象间不对应，多对象编辑时只读
+	 * @param InObjects 要编辑的对象，第一个有效对象作为主对象
+	 * @return 是否成功设置对象
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor")
+	bool SetObjects(const TArray<UObject*>& InObjects);
+
 	/**
 	 * 获取当前正在编辑的对象
-	 * @return 当前编辑的对象
+	 * @return 当前编辑的对象，多对象编辑时为主对象
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Property Editor")
 	UObject* GetObject() const;
 
+	/** 获取当前正在编辑的所有对象 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor")
+	const TArray<UObject*>& GetObjects() const;
+
+	/**
+	 * 多对象编辑时实际写入和记录撤销的路径
+	 * 映射和集合元素的稀疏下标在各对象间不对应，此时返回整个容器的路径
+	 * 修改映射的键时也返回整个映射的路径，撤销后映射的哈希才是正确的
+	 */
+	FRapidPropertyPath GetSharedEditPath(const FRapidPropertyPath& InPropertyPath) const;
+
+	/**
+	 * 映射和集合的元素是否可以编辑
+	 * 稀疏下标在各对象间不对应，多对象编辑时只显示主对象的元素，不能修改
+	 */
+	bool CanEditSparseContainers() const;
+
+	/** 多对象编辑时各对象在该路径上的值是否不同 */
+	bool HasMultipleValues(const FRapidPropertyPath& InPropertyPath) const;
+
 	/**
 	 * 刷新属性编辑器
 	 */
@@ -122,6 +158,82 @@ public:
 	void ClearObject();
 
 	TObjectPtr<URapidPropertyWidget> CreatePropertyWidgetForType(UUserWidget* InOuter, const FProperty* InProperty);
+
+	/**
+	 * 设置搜索文本，按属性名、显示名称和分类过滤（忽略大小写）
+	 * 只切换控件可见性，不会创建或销毁控件；空文本显示全部属性
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Search")
+	void SetSearchText(const FString& InSearchText);
+
+	/** 当前的搜索过滤状态 */
+	const FRapidPropertySearchFilter& GetSearchFilter() const;
+
+	/** 按属性路径查找搜索索引项，不在索引中时返回INDEX_NONE */
+	int32 FindSearchEntry(const FRapidPropertyPath& InPropertyPath) const;
+
+	/**
+	 * 把当前编辑对象的可编辑属性保存为二进制快照文件
+	 * @param FilePath 快照文件路径
+	 * @return 是否保存成功
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Snapshot")
+	bool SaveSnapshot(const FString& FilePath);
+
+	/**
+	 * 从快照文件恢复当前编辑对象的属性，多对象编辑时按对象顺序对应
+	 * 恢复后撤销记录会被清空
+	 * @param FilePath 快照文件路径
+	 * @return 是否恢复了至少一个属性
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Snapshot")
+	bool LoadSnapshot(const FString& FilePath);
+
+	/**
+	 * 比较两个快照文件
+	 * @return 值不同或只存在于其中一个快照的属性名
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Snapshot")
+	static TArray<FName> DiffSnapshotFiles(const FString& FilePathA, const FString& FilePathB);
+
+	/**
+	 * 撤销最近一次属性修改
+	 * @return 是否成功撤销
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Undo")
+	bool Undo();
+
+	/**
+	 * 重做最近一次被撤销的属性修改
+	 * @return 是否成功重做
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Undo")
+	bool Redo();
+
+	UFUNCTION(BlueprintPure, Category = "Property Editor|Undo")
+	bool CanUndo() const;
+
+	UFUNCTION(BlueprintPure, Category = "Property Editor|Undo")
+	bool CanRedo() const;
+
+	/** 清空撤销记录 */
+	UFUNCTION(BlueprintCallable, Category = "Property Editor|Undo")
+	void ClearUndoHistory();
+
+	/** 记录一次属性修改，由属性控件在写入值后调用 */
+	void RecordPropertyEdit(UObject* InObject, const FRapidPropertyPath& InPropertyPath, FRapidPropertyValueBuffer&& InBefore);
+
+	/** 开始连续编辑，期间对同一属性的修改合并为一条撤销记录 */
+	void BeginContinuousEdit();
+
+	/** 结束连续编辑 */
+	void EndContinuousEdit();
+
+	/**
+	 * 任何属性（包括结构体字段和容器元素）改变时触发，携带被修改值的完整路径
+	 */
+	FOnRapidPropertyPathChanged OnPropertyPathChanged;
+
 	/**
 	 * 属性改变时触发的委托
 	 */
@@ -138,6 +250,10 @@ protected:
 	UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
 	UScrollBox* ContentScrollBox;
 
+	/** 搜索框，可选 */
+	UPROPERTY(BlueprintReadOnly, meta = (BindWidgetOptional))
+	UEditableTextBox* SearchTextBox;
+
 	// -------- 属性控件类引用 Start ----------
 	/** 浮点数属性控件类 */
 	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Widget Classes")
@@ -147,6 +263,14 @@ protected:
 	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Widget Classes")
 	TSubclassOf<URapidPropertyWidget> IntPropertyWidgetClass;
 	
+	/** 通用数值属性控件类，用于double、int64、uint8等类型；未设置浮点数或整数控件类时也用于float和int32 */
+	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Widget Classes")
+	TSubclassOf<URapidPropertyWidget> NumericPropertyWidgetClass;
+	
+	/** 枚举属性控件类 */
+	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Widget Classes")
+	TSubclassOf<URapidPropertyWidget> EnumPropertyWidgetClass;
+	
 	/** 布尔属性控件类 */
 	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Widget Classes")
 	TSubclassOf<URapidPropertyWidget> BoolPropertyWidgetClass;
@@ -168,18 +292,37 @@ protected:
 	TSubclassOf<URapidPropertyWidget> MapPropertyWidgetClass;
 	// -------- 属性控件类引用 End -------------
 
+	/** 撤销记录的最大条数 */
+	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Undo", meta = (ClampMin = "1"))
+	int32 MaxUndoCount = 256;
+
+	/** 撤销记录占用内存上限（KB），超出时丢弃最早的记录 */
+	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Undo", meta = (ClampMin = "1"))
+	int32 MaxUndoMemoryKB = 4096;
+
+	/** 同一属性两次修改间隔小于该值（秒）时合并为一条撤销记录 */
+	UPROPERTY(EditDefaultsOnly, Category = "Property Editor|Undo", meta = (ClampMin = "0"))
+	float UndoCoalesceWindow = 0.5f;
+
 	/** 创建并渲染属性面板内容 */
 	void RenderProperties();
 
 	/** 处理属性值改变 */
+	void HandlePropertyPathChanged(UObject* Object, const FRapidPropertyPath& PropertyPath);
+
+	/** 处理搜索框文本改变 */
 	UFUNCTION()
-	void HandlePropertyValueChanged(UObject* Object, FName PropertyName, URapidPropertyWidget* PropertyWidget);
+	void HandleSearchTextChanged(const FText& InText);
 
 private:
-	/** 当前编辑的对象 */
+	/** 当前编辑的对象，多对象编辑时为主对象，属性控件都绑定在主对象上 */
 	UPROPERTY(Transient)
 	UObject* TargetObject;
 
+	/** 当前编辑的所有对象，第一个为主对象 */
+	UPROPERTY(Transient)
+	TArray<UObject*> TargetObjects;
+
 	/** 已创建的属性控件 */
 	UPROPERTY()
 	TArray<URapidPropertyWidget*> PropertyWidgets;
@@ -187,6 +330,27 @@ private:
 	/** 获取属性显示名称 */
 	FString GetPropertyDisplayName(FProperty* Property) const;
 
-	/** 通知属性改变 */
-	void NotifyPropertyChanged(FName PropertyName, FProperty* Property = nullptr);
+	/** 通知属性改变，多对象编辑时每个对象只通知一次 */
+	void NotifyPropertyChanged(const FRapidPropertyPath& PropertyPath);
+
+	/** 把主对象上该路径的值写入其他对象，经过映射或集合的路径不写入，避免覆盖其他对象的整个容器 */
+	void PropagateToOtherObjects(const FRapidPropertyPath& InPropertyPath);
+
+	/** 刷新该路径所属顶层属性的控件 */
+	void RefreshPropertyWidgets(const FRapidPropertyPath& InPropertyPath);
+
+	/** 所有对象的共同基类 */
+	UClass* GetCommonClass() const;
+
+	/** 撤销或重做之后刷新所有控件的显示值并发出通知 */
+	void HandleTransactionApplied(const FRapidPropertyTransaction& Transaction);
+
+	/** 撤销/重做缓冲区，只保存被修改属性的前后值 */
+	FRapidPropertyTransactionBuffer TransactionBuffer;
+
+	/** 当前对象类型的搜索索引，按类型缓存共享 */
+	TSharedPtr<const FRapidPropertySearchIndex> SearchIndex;
+
+	/** 当前的搜索过滤状态 */
+	FRapidPropertySearchFilter SearchFilter;
 };
\ No newline at end of file
@@ -0,0 +1,99 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Templates/UniquePtr.h"
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+#include "RapidUI/PropertyEditor/RapidPropertyTransactionBuffer.h"
+
+class IRapidPropertyInspectionTransport;
+class FJsonObject;
+
+/**
+ * 远程属性查看服务，用于没有UI的专用服务器
+ * 运行在游戏进程内，通过传输层接收每行一个的JSON请求：
+ * - {"id":1,"op":"find","class":"/Script/Engine.Actor","limit":100}    查找对象
+ * - {"id":2,"op":"layout","object":"Player"}                          类布局，与属性编辑器的搜索索引相同
+ * - {"id":3,"op":"get","object":"Player","path":"Stats.Health"}       读取值（ExportText格式）
+ * - {"id":4,"op":"set","object":"Player","path":"Stats.Health","value":"100"}   写入值，只能写入可编辑且不是只读的属性，不能写入映射的键和集合的元素
+ * - {"id":5,"op":"watch","object":"Player","path":"Stats.Health"}     订阅值变化
+ * - {"id":6,"op":"unwatch","watch":1}
+ * 回复为{"id":...,"ok":true,...}或{"id":...,"ok":false,"error":"..."}
+ * 订阅的值变化每帧合并为一条{"op":"delta","frame":...,"changes":[{"watch":1,"value":"..."}]}
+ * 每帧检查的订阅数有上限，订阅很多时分多帧轮流检查，查看繁忙的服务器不会占用过多帧时间
+ * 只能在游戏线程使用
+ */
+class LOMOLIB_API FRapidPropertyInspectionService
+{
+public:
+    explicit FRapidPropertyInspectionService(TUniquePtr<IRapidPropertyInspectionTransport>&& InTransport);
+    ~FRapidPropertyInspectionService();
+
+    bool Start();
+    void Stop();
+
+    /** 处理请求并发送订阅的变化，每帧调用一次 */
+    void Tick();
+
+    /** 为对象注册一个别名，请求中可以用别名代替对象路径 */
+    void RegisterObject(const FString& InAlias, UObject* InObject);
+    void UnregisterObject(const FString& InAlias);
+
+    /** 每帧最多检查的订阅数 */
+    void SetMaxWatchChecksPerTick(int32 InMaxWatchChecksPerTick);
+
+    /** 单次find请求最多返回的对象数 */
+    static constexpr int32 MaxFindResults = 1000;
+
+    /** 远程客户端修改属性后触发 */
+    FOnRapidPropertyPathChanged OnRemotePropertyChanged;
+
+private:
+    struct FWatch
+    {
+        int32 WatchId = INDEX_NONE;
+        int32 ClientId = INDEX_NONE;
+        TWeakObjectPtr<UObject> Object;
+        FRapidPropertyPath PropertyPath;
+
+        /** 上一次发送给客户端的值 */
+        FRapidPropertyValueBuffer LastValue;
+    };
+
+    void HandleMessage(int32 InClientId, const FString& InMessage);
+
+    /** 各请求的处理函数，失败时返回错误信息 */
+    FString HandleFind(const FJsonObject& InRequest, FJsonObject& OutResponse) const;
+    FString HandleLayout(const FJsonObject& InRequest, FJsonObject& OutResponse) const;
+    FString HandleGet(const FJsonObject& InRequest, FJsonObject& OutResponse) const;
+    FString HandleSet(const FJsonObject& InRequest, FJsonObject& OutResponse);
+    FString HandleWatch(int32 InClientId, const FJsonObject& InRequest, FJsonObject& OutResponse);
+    FString HandleUnwatch(int32 InClientId, const FJsonObject& InRequest, FJsonObject& OutResponse);
+
+    /** 按别名或对象路径查找对象 */
+    UObject* ResolveObject(const FString& InObjectName) const;
+
+    /** 解析请求中的object和path字段 */
+    FString ResolveRequestValue(const FJsonObject& InRequest, UObject*& OutObject, FRapidPropertyPath& OutPropertyPath, void*& OutValuePtr) const;
+
+    /** 检查一部分订阅，把变化按客户端合并发送 */
+    void SendWatchDeltas();
+
+    void Send(int32 InClientId, const TSharedRef<FJsonObject>& InMessage) const;
+
+    TUniquePtr<IRapidPropertyInspectionTransport> Transport;
+
+    TMap<FString, TWeakObjectPtr<UObject>> Aliases;
+
+    TArray<FWatch> Watches;
+    int32 NextWatchId = 1;
+
+    /** 下一帧开始检查的订阅位置 */
+    int32 WatchCursor = 0;
+    int32 MaxWatchChecksPerTick = 256;
+
+    /** 复用的消息缓冲 */
+    TArray<TPair<int32, FString>> PendingMessages;
+    TArray<int32> DisconnectedClients;
+};
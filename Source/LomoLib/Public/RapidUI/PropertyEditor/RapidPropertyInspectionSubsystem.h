@@ -0,0 +1,48 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Subsystems/GameInstanceSubsystem.h"
+#include "Tickable.h"
+#include "RapidPropertyInspectionSubsystem.generated.h"
+
+class FRapidPropertyInspectionService;
+
+/**
+ * 在游戏进程内运行远程属性查看服务
+ * 启动参数带有-RapidInspectPort=端口时创建，只监听本机地址，Shipping版本不会创建
+ */
+UCLASS()
+class LOMOLIB_API URapidPropertyInspectionSubsystem : public UGameInstanceSubsystem, public FTickableGameObject
+{
+    GENERATED_BODY()
+
+public:
+    virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+    virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+    virtual void Deinitialize() override;
+
+    // FTickableGameObject
+    virtual void Tick(float DeltaTime) override;
+    virtual bool IsTickable() const override;
+    virtual bool IsTickableWhenPaused() const override { return true; }
+    virtual TStatId GetStatId() const override;
+
+    /** 为对象注册一个别名，远程客户端可以用别名代替对象路径 */
+    UFUNCTION(BlueprintCallable, Category = "Property Inspection")
+    void RegisterInspectedObject(const FString& Alias, UObject* Object);
+
+    /** 移除别名 */
+    UFUNCTION(BlueprintCallable, Category = "Property Inspection")
+    void UnregisterInspectedObject(const FString& Alias);
+
+    /** 获取服务，未启动时返回nullptr */
+    FRapidPropertyInspectionService* GetService() const { return Service.Get(); }
+
+private:
+    /** 从命令行读取端口，没有指定时返回false */
+    static bool GetPortFromCommandLine(int32& OutPort);
+
+    TUniquePtr<FRapidPropertyInspectionService> Service;
+};
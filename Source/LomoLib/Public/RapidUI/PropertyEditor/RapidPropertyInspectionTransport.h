@@ -0,0 +1,80 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class FSocket;
+
+/**
+ * 远程查看服务的传输层接口
+ * 消息以行为单位（UTF-8，以'\n'结尾），传输层只负责收发，不解析内容
+ * 所有方法只在游戏线程调用，实现不应阻塞
+ */
+class LOMOLIB_API IRapidPropertyInspectionTransport
+{
+public:
+    virtual ~IRapidPropertyInspectionTransport() = default;
+
+    /** 开始监听 */
+    virtual bool Start() = 0;
+
+    /** 断开所有客户端并停止监听 */
+    virtual void Stop() = 0;
+
+    /**
+     * 接受新连接、发送缓存的数据并读取完整的消息行
+     * @param OutMessages 收到的消息，Key为客户端ID
+     * @param OutDisconnectedClients 本次断开的客户端
+     */
+    virtual void Poll(TArray<TPair<int32, FString>>& OutMessages, TArray<int32>& OutDisconnectedClients) = 0;
+
+    /** 向客户端发送一条消息，不需要包含换行 */
+    virtual void Send(int32 InClientId, const FString& InMessage) = 0;
+};
+
+/**
+ * 基于本机TCP的传输层，只绑定127.0.0.1，使用非阻塞套接字在游戏线程轮询
+ */
+class LOMOLIB_API FRapidPropertyInspectionTcpTransport : public IRapidPropertyInspectionTransport
+{
+public:
+    explicit FRapidPropertyInspectionTcpTransport(int32 InPort);
+    virtual ~FRapidPropertyInspectionTcpTransport() override;
+
+    virtual bool Start() override;
+    virtual void Stop() override;
+    virtual void Poll(TArray<TPair<int32, FString>>& OutMessages, TArray<int32>& OutDisconnectedClients) override;
+    virtual void Send(int32 InClientId, const FString& InMessage) override;
+
+    /** 单个客户端未发送数据的上限，超过时断开该客户端，避免读取过慢的客户端占用内存 */
+    static constexpr int32 MaxPendingSendBytes = 8 * 1024 * 1024;
+
+    /** 单条消息的长度上限 */
+    static constexpr int32 MaxMessageBytes = 1024 * 1024;
+
+private:
+    struct FClient
+    {
+        FSocket* Socket = nullptr;
+
+        /** 已收到但还没有遇到换行的数据 */
+        TArray<uint8> ReceiveBuffer;
+
+        /** 还没有发送出去的数据 */
+        TArray<uint8> SendBuffer;
+    };
+
+    /** 尽量发送缓存的数据，连接出错时返回false */
+    bool FlushClient(FClient& InClient);
+
+    /** 读取数据并拆分为消息行，连接断开时返回false */
+    bool ReceiveClient(int32 InClientId, FClient& InClient, TArray<TPair<int32, FString>>& OutMessages);
+
+    void DestroyClient(FClient& InClient);
+
+    int32 Port = 0;
+    FSocket* ListenSocket = nullptr;
+    TMap<int32, FClient> Clients;
+    int32 NextClientId = 1;
+};
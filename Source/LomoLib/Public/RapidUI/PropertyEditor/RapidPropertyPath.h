@@ -0,0 +1,130 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "UObject/UnrealType.h"
+
+/**
+ * 属性路径中的一段
+ * Index为INDEX_NONE时表示属性值本身；否则表示进入该属性的第Index个元素：
+ * 数组为元素下标，映射和集合为稀疏下标，普通属性为静态数组下标
+ */
+struct FRapidPropertyPathSegment
+{
+    FProperty* Property = nullptr;
+    int32 Index = INDEX_NONE;
+
+    FRapidPropertyPathSegment() = default;
+    FRapidPropertyPathSegment(FProperty* InProperty, int32 InIndex = INDEX_NONE)
+        : Property(InProperty)
+        , Index(InIndex)
+    {
+    }
+
+    bool operator==(const FRapidPropertyPathSegment& Other) const
+    {
+        return Property == Other.Property && Index == Other.Index;
+    }
+
+    bool operator!=(const FRapidPropertyPathSegment& Other) const
+    {
+        return !(*this == Other);
+    }
+};
+
+/**
+ * 属性路径，由FProperty*链和容器索引组成
+ * 用于替代"Struct.Field"、"Array[0]"形式的字符串FName：
+ * 不会向全局名称表添加条目，从根对象解析到值地址的开销为O(深度)
+ */
+class LOMOLIB_API FRapidPropertyPath
+{
+public:
+    FRapidPropertyPath() = default;
+    explicit FRapidPropertyPath(FProperty* InRootProperty);
+
+    /** 获取结构体字段的路径 */
+    FRapidPropertyPath GetChildPath(FProperty* InChildProperty) const;
+
+    /**
+     * 获取容器元素的路径
+     * @param InIndex 数组为元素下标，映射和集合为稀疏下标
+     * @param InElementProperty 数组的Inner，映射的KeyProp或ValueProp，集合的ElementProp
+     */
+    FRapidPropertyPath GetElementPath(int32 InIndex, FProperty* InElementProperty) const;
+
+    /** 追加一段 */
+    void Push(FProperty* InProperty, int32 InIndex = INDEX_NONE);
+
+    /** 移除最后一段 */
+    void Pop();
+
+    bool IsValid() const { return Segments.Num() > 0; }
+    int32 Num() const { return Segments.Num(); }
+    const FRapidPropertyPathSegment& operator[](int32 InIndex) const { return Segments[InIndex]; }
+
+    /**
+     * 路径经过映射的键时，返回进入该映射元素的段的下标
+     * @return 不经过映射的键时返回INDEX_NONE
+     */
+    int32 FindMapKeySegment() const;
+
+    /** 路径第一段的属性，即对象上的顶层属性 */
+    FProperty* GetRootProperty() const;
+
+    /** 路径最后一段的属性，即值地址对应的属性 */
+    FProperty* GetLeafProperty() const;
+
+    /**
+     * 从容器（对象或结构体内存）解析出值地址
+     * @return 路径中任意容器索引失效时返回nullptr
+     */
+    void* Resolve(void* InContainer) const;
+    const void* Resolve(const void* InContainer) const;
+
+    /**
+     * 检查路径结构是否与InRootStruct匹配：根属性属于该结构体，后续每一段属于上一段的结构体或容器
+     * 只检查类型关系，不检查容器索引，用于在绑定时一次性验证路径
+     */
+    bool IsCompatibleWith(const UStruct* InRootStruct) const;
+
+    /**
+     * 路径不经过动态容器（数组、映射、集合）时，值地址相对于根容器的固定偏移
+     * @return 经过动态容器时返回INDEX_NONE
+     */
+    int32 GetFixedOffset() const;
+
+    /** 当前路径是否以InPrefix开头（包含相等的情况） */
+    bool StartsWith(const FRapidPropertyPath& InPrefix) const;
+
+    /** 生成可读字符串，用于日志、调试和远程查看 */
+    FString ToString() const;
+
+    /**
+     * 解析ToString生成的字符串，如"Stats.Levels[2]"、"Items[3].Value.Count"
+     * 属性名只查找已有的FName，不会向名称表添加条目
+     * @param InRootStruct 路径根属性所在的类或结构体
+     * @return 格式错误或属性不存在时返回false
+     */
+    static bool Parse(const UStruct* InRootStruct, FStringView InText, FRapidPropertyPath& OutPath);
+
+    bool operator==(const FRapidPropertyPath& Other) const { return Segments == Other.Segments; }
+    bool operator!=(const FRapidPropertyPath& Other) const { return !(*this == Other); }
+
+    friend uint32 GetTypeHash(const FRapidPropertyPath& InPath)
+    {
+        uint32 Hash = 0;
+        for (const FRapidPropertyPathSegment& Segment : InPath.Segments)
+        {
+            Hash = HashCombine(Hash, HashCombine(GetTypeHash(Segment.Property), GetTypeHash(Segment.Index)));
+        }
+        return Hash;
+    }
+
+private:
+    TArray<FRapidPropertyPathSegment, TInlineAllocator<4>> Segments;
+};
+
+/** 属性路径对应的值被修改时触发 */
+DECLARE_MULTICAST_DELEGATE_TwoParams(FOnRapidPropertyPathChanged, UObject* /*Object*/, const FRapidPropertyPath& /*PropertyPath*/);
@@ -0,0 +1,84 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+
+/**
+ * 搜索索引中的一项，对应一个可编辑属性（包括嵌套结构体的字段）
+ * 容器元素是运行时数据，不在索引中
+ */
+struct FRapidPropertySearchEntry
+{
+    FRapidPropertyPath PropertyPath;
+
+    /** 小写的属性名、显示名称和分类，以换行分隔，避免跨字段误匹配 */
+    FString SearchText;
+
+    /** 父结构体对应的项，顶层属性为INDEX_NONE */
+    int32 ParentIndex = INDEX_NONE;
+
+    /** 子树结束位置（不含），子孙项的下标位于(自身, SubtreeEnd)之间 */
+    int32 SubtreeEnd = 0;
+};
+
+/**
+ * 某个类或结构体布局的属性搜索索引
+ * 按深度优先顺序展开所有可编辑属性，每个原生类型只构建一次并缓存，蓝图类型每次获取时重新构建，只能在游戏线程使用
+ */
+class LOMOLIB_API FRapidPropertySearchIndex
+{
+public:
+    /** 获取类型对应的索引，首次调用时构建 */
+    static TSharedRef<const FRapidPropertySearchIndex> Get(const UStruct* InStruct);
+
+    /** 按属性路径查找索引项，找不到时返回INDEX_NONE */
+    int32 FindEntry(const FRapidPropertyPath& InPropertyPath) const;
+
+    const TArray<FRapidPropertySearchEntry>& GetEntries() const { return Entries; }
+
+private:
+    void Build(const UStruct* InStruct, const FRapidPropertyPath* InParentPath, int32 InParentIndex);
+
+    TArray<FRapidPropertySearchEntry> Entries;
+    TMap<FRapidPropertyPath, int32> PathToEntry;
+};
+
+/**
+ * 基于搜索索引的过滤状态
+ * 搜索文本在上一次的基础上追加或删除字符时只重新测试必要的项
+ */
+class LOMOLIB_API FRapidPropertySearchFilter
+{
+public:
+    /** 切换索引，已有的搜索文本会在新索引上重新计算 */
+    void SetIndex(const TSharedPtr<const FRapidPropertySearchIndex>& InIndex);
+
+    /** 设置搜索文本，忽略大小写 */
+    void SetSearchText(const FString& InSearchText);
+
+    /** 是否正在过滤 */
+    bool IsActive() const { return !SearchText.IsEmpty(); }
+
+    /**
+     * 索引项是否可见：自身匹配、祖先匹配或有子孙匹配时可见
+     * 不在索引中的项（INDEX_NONE）总是可见，由父控件决定是否显示
+     */
+    bool IsEntryVisible(int32 InEntryIndex) const;
+
+private:
+    /** 重新计算Visible */
+    void UpdateVisibility();
+
+    TSharedPtr<const FRapidPropertySearchIndex> Index;
+
+    /** 小写的搜索文本 */
+    FString SearchText;
+
+    /** 自身匹配搜索文本的项 */
+    TBitArray<> Matched;
+
+    /** 最终可见的项 */
+    TBitArray<> Visible;
+};
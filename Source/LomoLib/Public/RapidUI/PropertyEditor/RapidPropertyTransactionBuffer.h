@@ -0,0 +1,156 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+
+/**
+ * 单个属性值的副本，只保存被修改属性本身的数据
+ * POD属性就是ElementSize个字节；FString、TArray等属性通过属性自身的拷贝语义保存
+ */
+class LOMOLIB_API FRapidPropertyValueBuffer
+{
+public:
+    FRapidPropertyValueBuffer() = default;
+    FRapidPropertyValueBuffer(const FProperty* InProperty, const void* InValuePtr);
+    ~FRapidPropertyValueBuffer();
+
+    FRapidPropertyValueBuffer(FRapidPropertyValueBuffer&& Other);
+    FRapidPropertyValueBuffer& operator=(FRapidPropertyValueBuffer&& Other);
+    FRapidPropertyValueBuffer(const FRapidPropertyValueBuffer&) = delete;
+    FRapidPropertyValueBuffer& operator=(const FRapidPropertyValueBuffer&) = delete;
+
+    bool IsValid() const { return Property != nullptr; }
+
+    const FProperty* GetProperty() const { return Property; }
+
+    /** 将保存的值写回目标地址 */
+    void CopyTo(void* OutValuePtr) const;
+
+    /** 保存的值是否与目标地址的值相同 */
+    bool Identical(const void* InValuePtr) const;
+
+    /** 估算占用的内存，包括字符串和数组的堆内存 */
+    SIZE_T GetAllocatedSize() const;
+
+    /** 释放保存的值 */
+    void Reset();
+
+private:
+    const FProperty* Property = nullptr;
+    TArray<uint8, TAlignedHeapAllocator<16>> Data;
+};
+
+/**
+ * 一条撤销记录：一个或多个对象上同一属性路径修改前后的值
+ * 多对象编辑时所有对象写入的是同一个值，因此只保存一份After
+ */
+struct FRapidPropertyTransaction
+{
+    /** 被修改的对象，第一个为属性编辑器的主对象 */
+    TArray<TWeakObjectPtr<UObject>> Objects;
+    FRapidPropertyPath PropertyPath;
+
+    /** 每个对象修改前的值，与Objects一一对应 */
+    TArray<FRapidPropertyValueBuffer> Before;
+    FRapidPropertyValueBuffer After;
+
+    /** 最后一次合并修改的时间，用于合并窗口判断 */
+    double LastEditTime = 0.0;
+
+    /** 记录时所在的连续编辑序号，INDEX_NONE表示不在连续编辑中 */
+    int32 ContinuousEditId = INDEX_NONE;
+
+    SIZE_T GetAllocatedSize() const
+    {
+        SIZE_T Size = sizeof(FRapidPropertyTransaction) + Objects.GetAllocatedSize() + Before.GetAllocatedSize() + After.GetAllocatedSize();
+        for (const FRapidPropertyValueBuffer& BeforeValue : Before)
+        {
+            Size += BeforeValue.GetAllocatedSize();
+        }
+        return Size;
+    }
+};
+
+/**
+ * 运行时属性修改的撤销/重做缓冲区
+ * 不依赖编辑器的FTransaction，只保存被修改属性的前后值：
+ * 1. 连续编辑（拖动SpinBox）期间对同一属性的修改合并为一条记录
+ * 2. 合并窗口内对同一属性的连续修改（如按住方向键）也会合并
+ * 3. 超出记录数或内存上限时丢弃最早的记录
+ */
+class LOMOLIB_API FRapidPropertyTransactionBuffer
+{
+public:
+    explicit FRapidPropertyTransactionBuffer(SIZE_T InMaxMemoryBytes = 4 * 1024 * 1024, int32 InMaxTransactions = 256);
+
+    /** 设置内存和记录数上限 */
+    void SetLimits(SIZE_T InMaxMemoryBytes, int32 InMaxTransactions);
+
+    /** 设置合并窗口（秒），同一属性两次修改间隔小于该值时合并 */
+    void SetCoalesceWindow(double InSeconds) { CoalesceWindowSeconds = InSeconds; }
+
+    /**
+     * 记录一次修改，修改后的值从第一个对象的当前内存读取
+     * @param InObjects 被修改的对象，多对象编辑时包含所有对象
+     * @param InPropertyPath 被修改值的路径
+     * @param InBefore 每个对象修改前的值，与InObjects一一对应
+     */
+    void RecordEdit(TConstArrayView<UObject*> InObjects, const FRapidPropertyPath& InPropertyPath, TArray<FRapidPropertyValueBuffer>&& InBefore);
+
+    /** 开始一次连续编辑，结束前对同一属性的所有修改合并为一条记录 */
+    void BeginContinuousEdit();
+
+    /** 结束连续编辑 */
+    void EndContinuousEdit();
+
+    bool CanUndo() const { return UndoCount > 0; }
+    bool CanRedo() const { return UndoCount < Transactions.Num(); }
+
+    /**
+     * 撤销最近一次修改
+     * 已销毁的对象会被跳过
+     * @return 被撤销的记录，所有对象都已销毁或路径已失效时返回nullptr并丢弃该记录
+     */
+    const FRapidPropertyTransaction* Undo();
+
+    /**
+     * 重做最近一次被撤销的修改
+     * 已销毁的对象会被跳过
+     * @return 被重做的记录，所有对象都已销毁或路径已失效时返回nullptr并丢弃之后的重做记录
+     */
+    const FRapidPropertyTransaction* Redo();
+
+    /** 清空所有记录 */
+    void Reset();
+
+    /** 当前所有记录占用的内存 */
+    SIZE_T GetMemoryUsage() const { return MemoryUsage; }
+
+    int32 Num() const { return Transactions.Num(); }
+
+private:
+    /** 丢弃所有可重做的记录 */
+    void DiscardRedo();
+
+    /** 丢弃最早的记录直到满足上限 */
+    void TrimToBudget();
+
+    /** 解析记录中第InObjectIndex个对象的值地址 */
+    static void* ResolveTransaction(const FRapidPropertyTransaction& InTransaction, int32 InObjectIndex);
+
+    /** [0, UndoCount)为可撤销记录，[UndoCount, Num)为可重做记录 */
+    TArray<FRapidPropertyTransaction> Transactions;
+    int32 UndoCount = 0;
+
+    SIZE_T MemoryUsage = 0;
+    SIZE_T MaxMemoryBytes;
+    int32 MaxTransactions;
+
+    double CoalesceWindowSeconds = 0.5;
+
+    /** 当前连续编辑序号，INDEX_NONE表示不在连续编辑中 */
+    int32 ActiveContinuousEditId = INDEX_NONE;
+    int32 NextContinuousEditId = 0;
+};
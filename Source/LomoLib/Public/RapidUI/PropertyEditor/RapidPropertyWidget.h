@@ -4,6 +4,9 @@
 
 #include "CoreMinimal.h"
 #include "Blueprint/UserWidget.h"
+#include "RapidUI/PropertyEditor/RapidPropertyPath.h"
+#include "RapidUI/PropertyEditor/RapidPropertyTransactionBuffer.h"
+#include "RapidUI/PropertyEditor/RapidPropertySearchIndex.h"
 #include "RapidPropertyWidget.generated.h"
 
 /**
@@ -36,6 +39,21 @@ public:
     /** 初始化属性控件 */
     virtual bool InitializePropertyWidget(UObject* InObject, FProperty* InProperty, const FName& InPropertyName);
 
+    /**
+     * 按属性路径初始化属性控件，用于结构体字段和容器元素
+     * 属性名使用路径最后一段属性的FName，不会拼接字符串
+     */
+    bool InitializePropertyWidgetAtPath(UObject* InObject, const FRapidPropertyPath& InPropertyPath);
+
+    /** 获取从目标对象到当前属性值的路径 */
+    const FRapidPropertyPath& GetPropertyPath() const;
+
+    /**
+     * 按搜索结果显示或隐藏控件，不会创建或销毁控件
+     * 结构体控件会继续应用到已创建的子控件
+     */
+    virtual void ApplySearchFilter(const FRapidPropertySearchFilter& InFilter);
+
     /** 更新属性值（当值改变时） */
     UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Property Widget")
     void UpdateValue();
@@ -47,6 +65,9 @@ public:
     UPROPERTY(BlueprintAssignable, Category = "Property Widget")
     FOnPropertyValueChangedDelegate OnPropertyValueChanged;
 
+    /** 当控件中的值被用户改变时触发，携带被修改值的完整路径（子属性的修改也会向上传递） */
+    FOnRapidPropertyPathChanged OnPropertyPathChanged;
+
 protected:
     /** 当前编辑的对象 */
     UPROPERTY(BlueprintReadOnly, Category = "Property Widget")
@@ -55,6 +76,9 @@ protected:
     /** 属性指针 */
     FProperty* Property;
 
+    /** 从目标对象到当前属性值的路径 */
+    FRapidPropertyPath PropertyPath;
+
     /** 属性名称 */
     UPROPERTY(BlueprintReadOnly, Category = "Property Widget")
     FName PropertyName;
@@ -63,49 +87,83 @@ protected:
     UPROPERTY(BlueprintReadOnly, Category = "Property Widget")
     FText PropertyDisplayName;
 
+    /** 多对象编辑时各对象的值是否不同 */
+    UPROPERTY(BlueprintReadOnly, Category = "Property Widget")
+    bool bHasMultipleValues = false;
+
+    /** 多对象编辑时"多个值"状态改变时调用，用于在蓝图中调整显示 */
+    UFUNCTION(BlueprintImplementableEvent, Category = "Property Widget")
+    void OnMultipleValuesChanged(bool bInHasMultipleValues);
+
+    /**
+     * 重新检查各对象的值是否相同，由具体控件在UpdateValue中调用
+     * @return 是否存在多个不同的值
+     */
+    bool UpdateMultipleValues();
+
     /** 获取属性的元数据值 */
     UFUNCTION(BlueprintCallable, Category = "Property Widget")
     FString GetPropertyMetaData(const FName& MetaDataKey) const;
 
+    /**
+     * 在写入属性值之前调用，保存修改前的值用于撤销
+     * 之后的NotifyPropertyValueChanged会把这次修改记录到属性编辑器的撤销缓冲区
+     */
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    void BeginPropertyValueChange();
+
     /** 通知属性值已经改变 */
     UFUNCTION(BlueprintCallable, Category = "Property Widget")
     void NotifyPropertyValueChanged();
+
+    /** 开始连续编辑（如拖动SpinBox），期间的修改合并为一条撤销记录 */
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    void BeginContinuousPropertyEdit();
+
+    /** 结束连续编辑 */
+    UFUNCTION(BlueprintCallable, Category = "Property Widget")
+    void EndContinuousPropertyEdit();
+
+    /**
+     * 子控件写入值之后、记录撤销之前调用，沿控件层级向上传递
+     * 容器控件可以在这里修正或拒绝子控件的修改，如映射的键改变后重建哈希
+     * @param InChildPropertyPath 被修改值的路径
+     * @param InBeforeValue 修改前的值，对应属性编辑器GetSharedEditPath返回的路径，可能无效
+     */
+    virtual void PreCommitChildPropertyValue(const FRapidPropertyPath& InChildPropertyPath, const FRapidPropertyValueBuffer& InBeforeValue);
+
+    /** 通知子属性值已经改变，用于结构体和容器控件向上传递子控件的修改 */
+    void NotifyChildPropertyValueChanged(const FRapidPropertyPath& InChildPropertyPath);
+
+    /**
+     * 按属性路径解析出当前属性值的地址，对象已销毁或容器元素失效时返回nullptr
+     * 路径已在初始化时验证过，这里只检查对象弱指针；不经过动态容器的路径直接使用固定偏移
+     */
+    void* GetValuePtr() const;
+
+    /** 属性是否已成功绑定到目标对象 */
+    bool IsPropertyBound() const;
     
-    /** 安全执行方法的辅助函数，统一处理异常 */
-    template<typename F>
-    void SafeExecute(F&& Operation, const TCHAR* ErrorMessage)
-    {
-        try
-        {
-            Operation();
-        }
-        catch (const std::exception& Ex)
-        {
-            UE_LOG(LogTemp, Error, TEXT("%s - 异常: %s"), ErrorMessage, UTF8_TO_TCHAR(Ex.what()));
-        }
-        catch (...)
-        {
-            UE_LOG(LogTemp, Error, TEXT("%s - 未知异常"), ErrorMessage);
-        }
-    }
-    
-    /** 安全执行方法的辅助函数，带返回值，统一处理异常 */
-    template<typename F, typename RetType = decltype(std::declval<F>()())>
-    RetType SafeExecuteWithRet(F&& Operation, const TCHAR* ErrorMessage)
-    {
-        try
-        {
-            return Operation();
-        }
-        catch (const std::exception& Ex)
-        {
-            UE_LOG(LogTemp, Error, TEXT("%s - 异常: %s"), ErrorMessage, UTF8_TO_TCHAR(Ex.what()));
-            return RetType();
-        }
-        catch (...)
-        {
-            UE_LOG(LogTemp, Error, TEXT("%s - 未知异常"), ErrorMessage);
-            return RetType();
-        }
-    }
-};
\ No newline at end of file
+private:
+    /** 初始化时验证过的目标对象，弱指针的序号检查可以发现对象已被销毁 */
+    TWeakObjectPtr<UObject> BoundObject;
+
+    /** 路径不经过动态容器时值地址相对于对象的固定偏移，否则为INDEX_NONE */
+    int32 BoundValueOffset = INDEX_NONE;
+
+    /** 下一次InitializePropertyWidget是否使用InitializePropertyWidgetAtPath设置的路径 */
+    bool bHasPendingPropertyPath = false;
+
+    /** BeginPropertyValueChange保存的修改前的值 */
+    FRapidPropertyValueBuffer PendingBeforeValue;
+
+    /** PendingBeforeValue对应的路径，多对象编辑映射元素时为整个映射的路径 */
+    FRapidPropertyPath PendingEditPath;
+
+    /** 在属性编辑器搜索索引中的位置，容器元素等不在索引中的控件为INDEX_NONE */
+    int32 SearchEntryIndex = INDEX_NONE;
+
+    /** 是否因为搜索被隐藏，以及隐藏前的可见性 */
+    bool bHiddenBySearch = false;
+    ESlateVisibility VisibilityBeforeSearch = ESlateVisibility::Visible;
+};
@@ -28,6 +28,9 @@ public:
     // 重写更新值方法
     virtual void UpdateValue_Implementation() override;
     
+    // 重写搜索过滤方法，同时过滤已创建的子属性控件
+    virtual void ApplySearchFilter(const FRapidPropertySearchFilter& InFilter) override;
+    
 protected:
     // 标题文本
     UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
@@ -41,14 +44,27 @@ protected:
     UPROPERTY(BlueprintReadOnly, meta = (BindWidget))
     UVerticalBox* ContentVerticalBox;
     
+    // 折叠时是否释放子属性控件，释放后再次展开会重新创建
+    UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Property Widget")
+    bool bReleaseChildrenOnCollapse = false;
+    
     // 处理子属性值改变
+    void HandleChildPropertyPathChanged(UObject* Object, const FRapidPropertyPath& InChildPropertyPath);
+    
+    // 处理展开状态改变，首次展开时才创建子属性控件
     UFUNCTION()
-    void HandleChildPropertyValueChanged(UObject* Object, FName InPropertyName, URapidPropertyWidget* PropertyWidget);
+    void HandleExpansionChanged(UExpandableArea* Area, bool bIsExpanded);
     
 private:
     // 创建结构体中的所有子属性控件
     void CreateChildProperties();
     
+    // 释放已创建的子属性控件
+    void ReleaseChildProperties();
+    
+    // 子属性控件是否已经创建
+    bool bChildrenCreated = false;
+    
     // 生成的属性控件
     UPROPERTY()
     TArray<URapidPropertyWidget*> ChildPropertyWidgets;
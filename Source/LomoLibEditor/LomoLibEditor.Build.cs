@@ -38,8 +38,12 @@ public class LomoLibEditor : ModuleRules
                 "EditorWidgets",
                 "Blutility",
                 "DeveloperSettings",
+                "DirectoryWatcher",
                 "UMG"
             }
         );
+
+        // XLSX的ZIP压缩
+        AddEngineThirdPartyPrivateStaticDependencies(Target, "zlib");
     }
 }
\ No newline at end of file
@@ -0,0 +1,108 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/CsvParser.h"
+#include "Misc/FileHelper.h"
+
+FCsvParser::FCsvParser(FString&& InText)
+	: Text(MoveTemp(InText))
+{
+}
+
+bool FCsvParser::LoadFile(const FString& InFilePath)
+{
+	Text.Reset();
+	Position = 0;
+	LineNumber = 1;
+	RowLineNumber = 0;
+
+	// LoadFileToString会识别UTF-8和UTF-16的BOM并去掉
+	return FFileHelper::LoadFileToString(Text, *InFilePath);
+}
+
+bool FCsvParser::ReadRow(TArray<FStringView>& OutCells)
+{
+	const int32 Len = Text.Len();
+	if (Position >= Len)
+	{
+		return false;
+	}
+
+	OutCells.Reset();
+	RowLineNumber = LineNumber;
+
+	// 文本末尾有'\0'，所以Data[Len]总是可以读写
+	TCHAR* Data = Text.GetCharArray().GetData();
+	int32 Read = Position;
+
+	while (true)
+	{
+		const int32 Start = Read;
+		int32 End;
+
+		if (Data[Read] == TEXT('"'))
+		{
+			// 引号字段，去除转义后的内容向前移动一位，写入位置总是不超过读取位置
+			int32 Write = Start;
+			++Read;
+			while (Read < Len)
+			{
+				const TCHAR Char = Data[Read];
+				if (Char == TEXT('"'))
+				{
+					if (Data[Read + 1] != TEXT('"'))
+					{
+						++Read;
+						break;
+					}
+					++Read;
+				}
+				else if (Char == TEXT('\n') || (Char == TEXT('\r') && Data[Read + 1] != TEXT('\n')))
+				{
+					++LineNumber;
+				}
+				Data[Write++] = Char;
+				++Read;
+			}
+
+			// 闭合引号之后到分隔符之前的内容按原样追加，与Excel一致
+			while (Read < Len && Data[Read] != TEXT(',') && Data[Read] != TEXT('\n') && Data[Read] != TEXT('\r'))
+			{
+				Data[Write++] = Data[Read++];
+			}
+			End = Write;
+		}
+		else
+		{
+			while (Read < Len && Data[Read] != TEXT(',') && Data[Read] != TEXT('\n') && Data[Read] != TEXT('\r'))
+			{
+				++Read;
+			}
+			End = Read;
+		}
+
+		// 先取出分隔符，再在单元格末尾写入'\0'，End可能就是分隔符的位置
+		const TCHAR Delimiter = Read < Len ? Data[Read] : TEXT('\0');
+		Data[End] = TEXT('\0');
+		OutCells.Emplace(Data + Start, End - Start);
+
+		if (Delimiter == TEXT(','))
+		{
+			++Read;
+			continue;
+		}
+
+		if (Delimiter == TEXT('\r') && Data[Read + 1] == TEXT('\n'))
+		{
+			++Read;
+		}
+		if (Delimiter != TEXT('\0'))
+		{
+			++Read;
+			++LineNumber;
+		}
+		break;
+	}
+
+	Position = Read;
+	return true;
+}
@@ -0,0 +1,288 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/ExcelColumnPlan.h"
+#include "UObject/PropertyPortFlags.h"
+#include "UObject/UnrealType.h"
+
+namespace ExcelColumnPlanPrivate
+{
+	/** 与RowStruct中数字属性的具体类型对应的操作 */
+	EExcelColumnOp GetNumericOp(const FNumericProperty* InProperty)
+	{
+		if (InProperty->IsA<FInt8Property>()) return EExcelColumnOp::Int8;
+		if (InProperty->IsA<FInt16Property>()) return EExcelColumnOp::Int16;
+		if (InProperty->IsA<FIntProperty>()) return EExcelColumnOp::Int32;
+		if (InProperty->IsA<FInt64Property>()) return EExcelColumnOp::Int64;
+		if (InProperty->IsA<FByteProperty>()) return EExcelColumnOp::UInt8;
+		if (InProperty->IsA<FUInt16Property>()) return EExcelColumnOp::UInt16;
+		if (InProperty->IsA<FUInt32Property>()) return EExcelColumnOp::UInt32;
+		if (InProperty->IsA<FUInt64Property>()) return EExcelColumnOp::UInt64;
+		if (InProperty->IsA<FFloatProperty>()) return EExcelColumnOp::Float;
+		if (InProperty->IsA<FDoubleProperty>()) return EExcelColumnOp::Double;
+		return EExcelColumnOp::Generic;
+	}
+
+	/** 只接受[+-]十进制数字，最多18位不会溢出；十六进制、空白和小数交给ImportText */
+	bool ParseInteger(FStringView InText, int64& OutValue)
+	{
+		const TCHAR* Char = InText.GetData();
+		const TCHAR* End = Char + InText.Len();
+		const bool bNegative = Char < End && *Char == TEXT('-');
+		if (Char < End && (*Char == TEXT('-') || *Char == TEXT('+')))
+		{
+			++Char;
+		}
+
+		if (Char == End || End - Char > 18)
+		{
+			return false;
+		}
+
+		int64 Value = 0;
+		for (; Char < End; ++Char)
+		{
+			if (*Char < TEXT('0') || *Char > TEXT('9'))
+			{
+				return false;
+			}
+			Value = Value * 10 + (*Char - TEXT('0'));
+		}
+
+		OutValue = bNegative ? -Value : Value;
+		return true;
+	}
+
+	/** 按属性的实际类型解析整数，超出范围时返回false，交给ImportText按原来的方式处理 */
+	template <typename T>
+	bool ParseIntegerAs(FStringView InText, T& OutValue)
+	{
+		int64 Value = 0;
+		if (!ParseInteger(InText, Value))
+		{
+			return false;
+		}
+
+		if constexpr (sizeof(T) < sizeof(int64))
+		{
+			if (Value < TNumericLimits<T>::Min() || Value > TNumericLimits<T>::Max())
+			{
+				return false;
+			}
+		}
+		else if constexpr (!std::is_signed_v<T>)
+		{
+			if (Value < 0)
+			{
+				return false;
+			}
+		}
+
+		OutValue = static_cast<T>(Value);
+		return true;
+	}
+
+	/** 检查是否为[+-]数字[.数字][e[+-]数字]，数值与ImportText一样由Atod计算 */
+	bool ParseFloat(FStringView InText, double& OutValue)
+	{
+		const TCHAR* Char = InText.GetData();
+		const TCHAR* End = Char + InText.Len();
+		if (Char < End && (*Char == TEXT('-') || *Char == TEXT('+')))
+		{
+			++Char;
+		}
+
+		int32 NumDigits = 0;
+		for (; Char < End && *Char >= TEXT('0') && *Char <= TEXT('9'); ++Char)
+		{
+			++NumDigits;
+		}
+		if (Char < End && *Char == TEXT('.'))
+		{
+			for (++Char; Char < End && *Char >= TEXT('0') && *Char <= TEXT('9'); ++Char)
+			{
+				++NumDigits;
+			}
+		}
+		if (NumDigits == 0)
+		{
+			return false;
+		}
+
+		if (Char < End && (*Char == TEXT('e') || *Char == TEXT('E')))
+		{
+			++Char;
+			if (Char < End && (*Char == TEXT('-') || *Char == TEXT('+')))
+			{
+				++Char;
+			}
+			if (Char == End)
+			{
+				return false;
+			}
+			for (; Char < End && *Char >= TEXT('0') && *Char <= TEXT('9'); ++Char)
+			{
+			}
+		}
+
+		if (Char != End)
+		{
+			return false;
+		}
+
+		// 单元格以'\0'结尾，可以直接传给Atod
+		OutValue = FCString::Atod(InText.GetData());
+		return true;
+	}
+
+	/** 导出的写法True/False和1/0，不区分大小写；Yes/No和本地化的文本交给ImportText */
+	bool ParseBool(FStringView InText, bool& OutValue)
+	{
+		if (InText.Equals(TEXT("True"), ESearchCase::IgnoreCase) || InText == TEXT("1"))
+		{
+			OutValue = true;
+			return true;
+		}
+		if (InText.Equals(TEXT("False"), ESearchCase::IgnoreCase) || InText == TEXT("0"))
+		{
+			OutValue = false;
+			return true;
+		}
+		return false;
+	}
+}
+
+FExcelColumnPlan::FExcelColumnPlan(const UScriptStruct* InRowStruct, TConstArrayView<FString> InHeaders)
+{
+	using namespace ExcelColumnPlanPrivate;
+
+	Columns.SetNum(InHeaders.Num());
+
+	// 第一列是行名
+	for (int32 Index = 1; Index < InHeaders.Num(); ++Index)
+	{
+		FProperty* Property = InRowStruct->FindPropertyByName(*InHeaders[Index]);
+		if (!Property)
+		{
+			continue;
+		}
+
+		FExcelColumn& Column = Columns[Index];
+		Column.Property = Property;
+		Column.Offset = Property->GetOffset_ForInternal();
+		Column.Op = EExcelColumnOp::Generic;
+
+		// 固定大小的数组和枚举需要ImportText
+		if (Property->ArrayDim != 1)
+		{
+			continue;
+		}
+
+		if (Property->IsA<FBoolProperty>())
+		{
+			Column.Op = EExcelColumnOp::Bool;
+		}
+		else if (const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property))
+		{
+			if (!NumericProperty->IsEnum())
+			{
+				Column.Op = GetNumericOp(NumericProperty);
+			}
+		}
+		else if (Property->IsA<FNameProperty>())
+		{
+			Column.Op = EExcelColumnOp::Name;
+		}
+		else if (Property->IsA<FStrProperty>())
+		{
+			Column.Op = EExcelColumnOp::String;
+		}
+	}
+}
+
+bool FExcelColumnPlan::ImportRow(TConstArrayView<FStringView> InCells, uint8* InRowData, int32& OutFailedColumn) const
+{
+	using namespace ExcelColumnPlanPrivate;
+
+	const int32 NumCells = FMath::Min(InCells.Num(), Columns.Num());
+	for (int32 Index = 1; Index < NumCells; ++Index)
+	{
+		const FExcelColumn& Column = Columns[Index];
+		const FStringView Cell = InCells[Index];
+		uint8* Value = InRowData + Column.Offset;
+
+		double FloatValue = 0.0;
+		bool bBoolValue = false;
+
+		// 快速解析成功时直接写入并处理下一列，否则落到下面的ImportText
+		switch (Column.Op)
+		{
+		case EExcelColumnOp::Skip:
+			continue;
+		case EExcelColumnOp::Bool:
+			if (ParseBool(Cell, bBoolValue))
+			{
+				static_cast<const FBoolProperty*>(Column.Property)->SetPropertyValue(Value, bBoolValue);
+				continue;
+			}
+			break;
+		case EExcelColumnOp::Int8:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<int8*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::Int16:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<int16*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::Int32:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<int32*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::Int64:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<int64*>(Value))) { continue; }
+			break;
+		// 无符号类型的负数和超出范围的值交给ImportText
+		case EExcelColumnOp::UInt8:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<uint8*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::UInt16:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<uint16*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::UInt32:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<uint32*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::UInt64:
+			if (ParseIntegerAs(Cell, *reinterpret_cast<uint64*>(Value))) { continue; }
+			break;
+		case EExcelColumnOp::Float:
+			if (ParseFloat(Cell, FloatValue)) { *reinterpret_cast<float*>(Value) = static_cast<float>(FloatValue); continue; }
+			break;
+		case EExcelColumnOp::Double:
+			if (ParseFloat(Cell, FloatValue)) { *reinterpret_cast<double*>(Value) = FloatValue; continue; }
+			break;
+		case EExcelColumnOp::Name:
+			*reinterpret_cast<FName*>(Value) = FName(Cell);
+			continue;
+		case EExcelColumnOp::String:
+			*reinterpret_cast<FString*>(Value) = FString(Cell);
+			continue;
+		case EExcelColumnOp::Generic:
+			break;
+		}
+
+		// 成功时返回解析结束的位置，失败时返回nullptr
+		if (Column.Property->ImportText_Direct(Cell.GetData(), Value, nullptr, PPF_None, nullptr) == nullptr)
+		{
+			OutFailedColumn = Index;
+			return false;
+		}
+	}
+
+	return true;
+}
+
+int32 FExcelColumnPlan::NumGenericColumns() const
+{
+	int32 Num = 0;
+	for (const FExcelColumn& Column : Columns)
+	{
+		Num += Column.Op == EExcelColumnOp::Generic ? 1 : 0;
+	}
+	return Num;
+}
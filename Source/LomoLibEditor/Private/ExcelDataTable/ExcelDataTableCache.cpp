@@ -0,0 +1,244 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/ExcelDataTableCache.h"
+#include "ExcelDataTable/ExcelDataTableSettings.h"
+#include "Async/MappedFileHandle.h"
+#include "Engine/DataTable.h"
+#include "HAL/FileManager.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/MemoryReader.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+
+namespace ExcelDataTableCachePrivate
+{
+	/** 缓存文件的标识和版本，格式变化时增加版本，旧缓存直接忽略 */
+	constexpr uint32 CacheMagic = 0x43544445; // "EDTC"
+	constexpr int32 CacheVersion = 1;
+
+	/** 文件头，ReadSourceHash只读取这一部分 */
+	struct FCacheHeader
+	{
+		uint32 Magic = 0;
+		int32 Version = 0;
+		uint64 SourceHash = 0;
+		uint64 SchemaHash = 0;
+
+		friend FArchive& operator<<(FArchive& Ar, FCacheHeader& Header)
+		{
+			return Ar << Header.Magic << Header.Version << Header.SourceHash << Header.SchemaHash;
+		}
+
+		bool IsValid() const
+		{
+			return Magic == CacheMagic && Version == CacheVersion;
+		}
+	};
+}
+
+FExcelDataTableCache::FExcelDataTableCache() = default;
+
+FExcelDataTableCache::~FExcelDataTableCache()
+{
+	Close();
+}
+
+uint64 FExcelDataTableCache::ReadSourceHash(const FString& InDataTablePath)
+{
+	using namespace ExcelDataTableCachePrivate;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetCachePath(InDataTablePath)));
+	if (!Reader)
+	{
+		return 0;
+	}
+
+	FCacheHeader Header;
+	*Reader << Header;
+	return !Reader->IsError() && Header.IsValid() ? Header.SourceHash : 0;
+}
+
+bool FExcelDataTableCache::Write(const FString& InDataTablePath, const UDataTable* InDataTable, TConstArrayView<FString> InHeaders, const FExcelDataTableImportHashes& InHashes)
+{
+	using namespace ExcelDataTableCachePrivate;
+
+	const UScriptStruct* RowStruct = InDataTable->RowStruct;
+	if (!RowStruct)
+	{
+		return false;
+	}
+
+	// 行先序列化到数据区，索引中记录每行的位置和大小
+	TArray<uint8> RowBytes;
+	FMemoryWriter RowWriter(RowBytes, true);
+	FObjectAndNameAsStringProxyArchive RowArchive(RowWriter, false);
+
+	TArray<FString> RowNames;
+	TArray<uint64> RowHashes;
+	TArray<int64> RowOffsets;
+	const TMap<FName, uint8*>& RowMap = InDataTable->GetRowMap();
+	RowNames.Reserve(RowMap.Num());
+	RowHashes.Reserve(RowMap.Num());
+	RowOffsets.Reserve(RowMap.Num() + 1);
+
+	for (const TPair<FName, uint8*>& RowPair : RowMap)
+	{
+		const uint64* Hash = InHashes.RowHashes.Find(RowPair.Key);
+		if (!Hash)
+		{
+			// 行不是这次导入的结果，缓存不完整时不写入
+			return false;
+		}
+
+		RowNames.Add(RowPair.Key.ToString());
+		RowHashes.Add(*Hash);
+		RowOffsets.Add(RowBytes.Num());
+		const_cast<UScriptStruct*>(RowStruct)->SerializeItem(RowArchive, RowPair.Value, nullptr);
+	}
+	RowOffsets.Add(RowBytes.Num());
+
+	TArray<uint8> FileBytes;
+	FMemoryWriter Writer(FileBytes, true);
+
+	FCacheHeader Header;
+	Header.Magic = CacheMagic;
+	Header.Version = CacheVersion;
+	Header.SourceHash = InHashes.SourceHash;
+	Header.SchemaHash = InHashes.SchemaHash;
+	Writer << Header;
+
+	TArray<FString> Headers(InHeaders.GetData(), InHeaders.Num());
+	Writer << Headers;
+	Writer << RowNames;
+	Writer << RowHashes;
+	Writer << RowOffsets;
+	Writer.Serialize(RowBytes.GetData(), RowBytes.Num());
+
+	// 先写入临时文件，避免写入中断后留下损坏的缓存
+	const FString CachePath = GetCachePath(InDataTablePath);
+	const FString TempPath = CachePath + TEXT(".tmp");
+	if (!FFileHelper::SaveArrayToFile(FileBytes, *TempPath) || !IFileManager::Get().Move(*CachePath, *TempPath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("无法写入DataTable缓存: %s"), *CachePath);
+		IFileManager::Get().Delete(*TempPath);
+		return false;
+	}
+
+	return true;
+}
+
+bool FExcelDataTableCache::Open(const FString& InDataTablePath, uint64 InSourceHash, uint64 InSchemaHash)
+{
+	if (!Open(InDataTablePath, InSchemaHash))
+	{
+		return false;
+	}
+
+	if (SourceHash != InSourceHash)
+	{
+		Close();
+		return false;
+	}
+	return true;
+}
+
+bool FExcelDataTableCache::Open(const FString& InDataTablePath, uint64 InSchemaHash)
+{
+	using namespace ExcelDataTableCachePrivate;
+
+	Close();
+
+	// 优先映射文件，行按需读取，不需要把整个文件复制到内存
+	const FString CachePath = GetCachePath(InDataTablePath);
+	TConstArrayView<uint8> Data;
+	MappedFile.Reset(FPlatformFileManager::Get().GetPlatformFile().OpenMapped(*CachePath));
+	if (MappedFile)
+	{
+		MappedRegion.Reset(MappedFile->MapRegion());
+	}
+	if (MappedRegion)
+	{
+		Data = TConstArrayView<uint8>(MappedRegion->GetMappedPtr(), static_cast<int32>(MappedRegion->GetMappedSize()));
+	}
+	else
+	{
+		MappedFile.Reset();
+		if (!FFileHelper::LoadFileToArray(FileData, *CachePath, FILEREAD_Silent))
+		{
+			return false;
+		}
+		Data = FileData;
+	}
+
+	FMemoryReaderView Reader(Data, true);
+	FCacheHeader Header;
+	Reader << Header;
+	if (Reader.IsError() || !Header.IsValid() || Header.SchemaHash != InSchemaHash)
+	{
+		Close();
+		return false;
+	}
+
+	TArray<FString> RowNames;
+	TArray<uint64> RowHashes;
+	TArray<int64> RowOffsets;
+	Reader << Headers;
+	Reader << RowNames;
+	Reader << RowHashes;
+	Reader << RowOffsets;
+
+	const int32 RowDataStart = static_cast<int32>(Reader.Tell());
+	if (Reader.IsError() || RowHashes.Num() != RowNames.Num() || RowOffsets.Num() != RowNames.Num() + 1 || RowOffsets.Last() > Data.Num() - RowDataStart)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("DataTable缓存已损坏: %s"), *CachePath);
+		Close();
+		return false;
+	}
+
+	SourceHash = Header.SourceHash;
+	RowData = Data.Slice(RowDataStart, Data.Num() - RowDataStart);
+	Rows.SetNum(RowNames.Num());
+	for (int32 Index = 0; Index < RowNames.Num(); ++Index)
+	{
+		FRowEntry& Row = Rows[Index];
+		Row.Name = FName(*RowNames[Index]);
+		Row.Hash = RowHashes[Index];
+		Row.Offset = RowOffsets[Index];
+		Row.Size = RowOffsets[Index + 1] - RowOffsets[Index];
+	}
+
+	return true;
+}
+
+void FExcelDataTableCache::Close()
+{
+	// 先释放映射的区域再关闭文件
+	RowData = TConstArrayView<uint8>();
+	MappedRegion.Reset();
+	MappedFile.Reset();
+	FileData.Reset();
+	Headers.Reset();
+	Rows.Reset();
+	SourceHash = 0;
+}
+
+bool FExcelDataTableCache::ReadRow(int32 InIndex, const UScriptStruct* InRowStruct, uint8* OutRowData) const
+{
+	const FRowEntry& Row = Rows[InIndex];
+	if (Row.Offset < 0 || Row.Size < 0 || Row.Offset + Row.Size > RowData.Num())
+	{
+		return false;
+	}
+
+	FMemoryReaderView RowReader(RowData.Slice(static_cast<int32>(Row.Offset), static_cast<int32>(Row.Size)), true);
+	FObjectAndNameAsStringProxyArchive RowArchive(RowReader, true);
+	const_cast<UScriptStruct*>(InRowStruct)->SerializeItem(RowArchive, OutRowData, nullptr);
+	return !RowReader.IsError();
+}
+
+FString FExcelDataTableCache::GetCachePath(const FString& InDataTablePath)
+{
+	return FPaths::ProjectSavedDir() / TEXT("ExcelDataTable") / TEXT("Cache") / FPaths::MakeValidFileName(InDataTablePath.Replace(TEXT("/"), TEXT("_")), TEXT('_')) + TEXT(".bin");
+}
@@ -0,0 +1,167 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/ExcelDataTableCommandlet.h"
+#include "ExcelDataTable/ExcelDataTableConverter.h"
+#include "Editor.h"
+#include "Engine/DataTable.h"
+#include "FileHelpers.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/QueuedThreadPool.h"
+#include "Serialization/JsonSerializer.h"
+#include "Serialization/JsonWriter.h"
+
+namespace ExcelDataTableCommandletPrivate
+{
+	/** 工作线程的栈大小 */
+	constexpr uint32 WorkerStackSize = 256 * 1024;
+
+	/** 有出错的行时即使其余行导入成功也算失败，构建机才能发现数据错误 */
+	bool IsSucceeded(const FExcelOperationResult& InResult)
+	{
+		return InResult.bSuccess && InResult.ErrorRows.Num() == 0;
+	}
+
+	TSharedRef<FJsonObject> MakeResultJson(const FExcelOperationResult& InResult, bool bInSaved)
+	{
+		TSharedRef<FJsonObject> Json = MakeShared<FJsonObject>();
+		Json->SetStringField(TEXT("DataTable"), InResult.DataTablePath);
+		Json->SetBoolField(TEXT("Success"), IsSucceeded(InResult));
+		Json->SetStringField(TEXT("Message"), InResult.Message);
+		Json->SetNumberField(TEXT("ProcessedRows"), InResult.ProcessedRows);
+		Json->SetNumberField(TEXT("UnchangedRows"), InResult.UnchangedRows);
+
+		TArray<TSharedPtr<FJsonValue>> ErrorRows;
+		for (int32 Row : InResult.ErrorRows)
+		{
+			ErrorRows.Add(MakeShared<FJsonValueNumber>(Row));
+		}
+		Json->SetArrayField(TEXT("ErrorRows"), ErrorRows);
+
+		Json->SetNumberField(TEXT("ReadSeconds"), InResult.ReadSeconds);
+		Json->SetNumberField(TEXT("WriteSeconds"), InResult.WriteSeconds);
+		Json->SetBoolField(TEXT("Saved"), bInSaved);
+		return Json;
+	}
+}
+
+UExcelDataTableCommandlet::UExcelDataTableCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+int32 UExcelDataTableCommandlet::Main(const FString& Params)
+{
+	using namespace ExcelDataTableCommandletPrivate;
+
+	const bool bImport = !FParse::Param(*Params, TEXT("Export"));
+	const bool bSave = bImport && !FParse::Param(*Params, TEXT("NoSave"));
+
+	FString ReportPath = FPaths::ProjectSavedDir() / TEXT("ExcelDataTable") / TEXT("BatchReport.json");
+	FParse::Value(*Params, TEXT("Report="), ReportPath);
+	ReportPath = FPaths::ConvertRelativePathToFull(ReportPath);
+
+	UExcelDataTableConverter* Converter = GEditor ? GEditor->GetEditorSubsystem<UExcelDataTableConverter>() : nullptr;
+	if (!Converter)
+	{
+		UE_LOG(LogTemp, Error, TEXT("无法获取UExcelDataTableConverter，需要在编辑器命令行中运行"));
+		return 1;
+	}
+
+	// 指定工作线程数时使用单独的线程池，否则使用全局线程池
+	int32 NumWorkers = 0;
+	FParse::Value(*Params, TEXT("Workers="), NumWorkers);
+	TUniquePtr<FQueuedThreadPool> ThreadPool;
+	if (bImport && NumWorkers > 0)
+	{
+		ThreadPool.Reset(FQueuedThreadPool::Allocate());
+		if (!ThreadPool->Create(NumWorkers, WorkerStackSize, TPri_Normal, TEXT("ExcelDataTableWorker")))
+		{
+			UE_LOG(LogTemp, Error, TEXT("无法创建 %d 个工作线程"), NumWorkers);
+			return 1;
+		}
+	}
+
+	const double StartTime = FPlatformTime::Seconds();
+	const TArray<FExcelOperationResult> Results = Converter->BatchProcessOnPool(bImport, ThreadPool.Get());
+	const double ProcessSeconds = FPlatformTime::Seconds() - StartTime;
+
+	if (Results.Num() == 0)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("未定义任何映射关系，请先在设置中配置DataTable与Excel的映射"));
+	}
+
+	if (ThreadPool)
+	{
+		ThreadPool->Destroy();
+		ThreadPool.Reset();
+	}
+
+	// 只保存导入时被修改的DataTable
+	// 被修改的DataTable的导入哈希在包保存时才写入哈希文件，-NoSave或保存失败时不写入
+	TSet<FString> SavedTables;
+	if (bSave)
+	{
+		TArray<UPackage*> DirtyPackages;
+		for (const FExcelOperationResult& Result : Results)
+		{
+			// 导入时已经加载，这里只是按路径取回
+			UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *Result.DataTablePath, nullptr, LOAD_NoWarn);
+			if (DataTable && DataTable->GetOutermost()->IsDirty())
+			{
+				DirtyPackages.AddUnique(DataTable->GetOutermost());
+				SavedTables.Add(Result.DataTablePath);
+			}
+		}
+
+		if (DirtyPackages.Num() > 0 && !UEditorLoadingAndSavingUtils::SavePackages(DirtyPackages, true))
+		{
+			UE_LOG(LogTemp, Error, TEXT("保存DataTable失败"));
+			SavedTables.Reset();
+		}
+	}
+	const double TotalSeconds = FPlatformTime::Seconds() - StartTime;
+
+	int32 SuccessCount = 0;
+	TArray<TSharedPtr<FJsonValue>> TableValues;
+	for (const FExcelOperationResult& Result : Results)
+	{
+		const bool bSucceeded = IsSucceeded(Result);
+		if (bSucceeded)
+		{
+			SuccessCount++;
+		}
+
+		UE_LOG(LogTemp, Display, TEXT("%s %s: 读取 %.3f 秒, 写入 %.3f 秒, %s"),
+			bSucceeded ? TEXT("[成功]") : Result.bSuccess ? TEXT("[行错误]") : TEXT("[失败]"), *Result.DataTablePath, Result.ReadSeconds, Result.WriteSeconds, *Result.Message);
+
+		TableValues.Add(MakeShared<FJsonValueObject>(MakeResultJson(Result, SavedTables.Contains(Result.DataTablePath))));
+	}
+
+	UE_LOG(LogTemp, Display, TEXT("批量%s完成: %d 成功, %d 失败, 处理 %.3f 秒, 共 %.3f 秒"),
+		bImport ? TEXT("导入") : TEXT("导出"), SuccessCount, Results.Num() - SuccessCount, ProcessSeconds, TotalSeconds);
+
+	TSharedRef<FJsonObject> Report = MakeShared<FJsonObject>();
+	Report->SetStringField(TEXT("Mode"), bImport ? TEXT("Import") : TEXT("Export"));
+	Report->SetNumberField(TEXT("Workers"), bImport && NumWorkers > 0 ? NumWorkers : GThreadPool->GetNumThreads());
+	Report->SetNumberField(TEXT("SuccessCount"), SuccessCount);
+	Report->SetNumberField(TEXT("FailureCount"), Results.Num() - SuccessCount);
+	Report->SetNumberField(TEXT("ProcessSeconds"), ProcessSeconds);
+	Report->SetNumberField(TEXT("TotalSeconds"), TotalSeconds);
+	Report->SetArrayField(TEXT("Tables"), TableValues);
+
+	FString ReportText;
+	const TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&ReportText);
+	FJsonSerializer::Serialize(Report, Writer);
+	if (!FFileHelper::SaveStringToFile(ReportText, *ReportPath, FFileHelper::EEncodingOptions::ForceUTF8WithoutBOM))
+	{
+		UE_LOG(LogTemp, Error, TEXT("无法写入报告: %s"), *ReportPath);
+		return 1;
+	}
+	UE_LOG(LogTemp, Display, TEXT("报告已写入: %s"), *ReportPath);
+
+	return SuccessCount == Results.Num() ? 0 : 1;
+}
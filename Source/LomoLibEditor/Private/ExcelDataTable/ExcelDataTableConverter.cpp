@@ -12,30 +12,582 @@
 #include "PropertyEditorModule.h"
 #include "UObject/PropertyPortFlags.h"
 #include "UObject/TextProperty.h"
-#include "PythonBridge.h"
+#include "ExcelDataTable/ExcelColumnPlan.h"
+#include "ExcelDataTable/ExcelDataTableCache.h"
+#include "ExcelDataTable/ExcelTableRows.h"
+#include "ExcelDataTable/XlsxReader.h"
+#include "Async/Async.h"
+#include "Misc/QueuedThreadPool.h"
+#include "DataTableEditorUtils.h"
+#include "DirectoryWatcherModule.h"
+#include "Framework/Notifications/NotificationManager.h"
+#include "IDirectoryWatcher.h"
+#include "Widgets/Notifications/SNotificationList.h"
+#include "Hash/CityHash.h"
+#include "Misc/PackageName.h"
+#include "Misc/ScopedSlowTask.h"
+#include "UObject/StructOnScope.h"
+#include "ExcelDataTable/XlsxWriter.h"
+#include "Serialization/MemoryWriter.h"
+#include "Serialization/ObjectAndNameAsStringProxyArchive.h"
+#include "UObject/ObjectSaveContext.h"
+#include "UObject/Package.h"
+
+namespace ExcelDataTableConverterPrivate
+{
+	/** float的最短十进制表示对应的double，避免0.1f写为0.100000001490116 */
+	double GetShortestFloatValue(float InValue)
+	{
+		const FString Candidates[] = {
+			FString::Printf(TEXT("%.6g"), InValue),
+			FString::Printf(TEXT("%.7g"), InValue),
+			FString::Printf(TEXT("%.8g"), InValue),
+		};
+		for (const FString& Text : Candidates)
+		{
+			const double Value = FCString::Atod(*Text);
+			if (static_cast<float>(Value) == InValue)
+			{
+				return Value;
+			}
+		}
+		return FCString::Atod(*FString::Printf(TEXT("%.9g"), InValue));
+	}
+	
+	/** 自动同步检查的间隔，以及文件最后一次变化后等待的时间，保存后一秒内完成同步 */
+	constexpr float AutoSyncTickInterval = 0.1f;
+	constexpr double AutoSyncDebounceSeconds = 0.3;
+	constexpr int32 AutoSyncMaxRetries = 5;
+	
+	FString GetFullPath(const FString& InFilePath)
+	{
+		FString FullPath = FPaths::ConvertRelativePathToFull(InFilePath);
+		FPaths::NormalizeFilename(FullPath);
+		return FullPath;
+	}
+	
+	void ShowAutoSyncNotification(const FString& InMessage, bool bInSuccess)
+	{
+		FNotificationInfo Info(FText::FromString(InMessage));
+		Info.ExpireDuration = 3.0f;
+		if (TSharedPtr<SNotificationItem> Notification = FSlateNotificationManager::Get().AddNotification(Info))
+		{
+			Notification->SetCompletionState(bInSuccess ? SNotificationItem::CS_Success : SNotificationItem::CS_Fail);
+		}
+	}
+	
+	/** 单元格文本的哈希，单元格的长度也计入，避免"ab","c"与"a","bc"相同 */
+	uint64 HashCells(TConstArrayView<FStringView> InCells, uint64 InSeed)
+	{
+		uint64 Hash = InSeed;
+		for (const FStringView& Cell : InCells)
+		{
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(Cell.GetData()), static_cast<uint32>(Cell.Len() * sizeof(TCHAR)), Hash + Cell.Len());
+		}
+		return Hash;
+	}
+	
+	/** 行结构的哈希，包括每个属性的名称、类型和偏移 */
+	uint64 GetSchemaHash(const UScriptStruct* InRowStruct)
+	{
+		const FString StructPath = InRowStruct->GetPathName();
+		uint64 Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*StructPath), static_cast<uint32>(StructPath.Len() * sizeof(TCHAR)), InRowStruct->GetStructureSize());
+		for (TFieldIterator<FProperty> PropIt(InRowStruct); PropIt; ++PropIt)
+		{
+			const FString PropertyText = FString::Printf(TEXT("%s %s %d"), *PropIt->GetCPPType(), *PropIt->GetName(), PropIt->GetOffset_ForInternal());
+			Hash = CityHash64WithSeed(reinterpret_cast<const char*>(*PropertyText), static_cast<uint32>(PropertyText.Len() * sizeof(TCHAR)), Hash);
+		}
+		return Hash;
+	}
+	
+	/**
+	 * DataTable当前内容的哈希，包括行名、行的顺序和每行的属性
+	 * 行与缓存一样使用带标签的序列化，对象和名称写为字符串，不同的编辑器进程中结果相同
+	 */
+	uint64 GetContentHash(const UDataTable* InDataTable)
+	{
+		TArray<uint8> Bytes;
+		FMemoryWriter Writer(Bytes, true);
+		FObjectAndNameAsStringProxyArchive Archive(Writer, false);
+		
+		const UScriptStruct* RowStruct = InDataTable->RowStruct;
+		for (const TPair<FName, uint8*>& RowPair : InDataTable->GetRowMap())
+		{
+			FString RowName = RowPair.Key.ToString();
+			Archive << RowName;
+			const_cast<UScriptStruct*>(RowStruct)->SerializeItem(Archive, RowPair.Value, nullptr);
+		}
+		return CityHash64(reinterpret_cast<const char*>(Bytes.GetData()), static_cast<uint32>(Bytes.Num()));
+	}
+	
+	/** DataTable所在的包是否与磁盘上的资源一致，没有未保存的修改 */
+	bool IsPackageSaved(const UDataTable* InDataTable)
+	{
+		const UPackage* Package = InDataTable->GetOutermost();
+		return !Package->IsDirty() && FPackageName::DoesPackageExist(Package->GetName());
+	}
+	
+	/**
+	 * 写入一行：已有的行先填充复用的临时行，内容不同时才复制，内容相同时不算修改
+	 * 新的行由DataTable分配，直接在表格的内存中填充，不需要临时行和再次复制
+	 * @return FillRow是否成功，失败时新的行被删除，已有的行保持不变
+	 */
+	bool UpsertRow(UDataTable* InDataTable, FName InRowName, const uint8* InDefaultRowData, uint8* InScratchRowData, bool& bOutChanged, TFunctionRef<bool(uint8*)> FillRow)
+	{
+		const UScriptStruct* RowStruct = InDataTable->RowStruct;
+		if (uint8* ExistingRowData = InDataTable->FindRowUnchecked(InRowName))
+		{
+			RowStruct->CopyScriptStruct(InScratchRowData, InDefaultRowData);
+			if (!FillRow(InScratchRowData))
+			{
+				return false;
+			}
+			
+			if (!RowStruct->CompareScriptStruct(ExistingRowData, InScratchRowData, PPF_None))
+			{
+				RowStruct->CopyScriptStruct(ExistingRowData, InScratchRowData);
+				bOutChanged = true;
+			}
+			return true;
+		}
+		
+		InDataTable->AddRow(InRowName, *(const FTableRowBase*)InDefaultRowData);
+		if (!FillRow(InDataTable->FindRowUnchecked(InRowName)))
+		{
+			InDataTable->RemoveRow(InRowName);
+			return false;
+		}
+		
+		bOutChanged = true;
+		return true;
+	}
+	
+	/** 删除不在InRowHashes中的行，返回删除的行数 */
+	int32 RemoveRowsNotIn(UDataTable* InDataTable, const TMap<FName, uint64>& InRowHashes)
+	{
+		TArray<FName> RemovedRows;
+		for (const TPair<FName, uint8*>& RowPair : InDataTable->GetRowMap())
+		{
+			if (!InRowHashes.Contains(RowPair.Key))
+			{
+				RemovedRows.Add(RowPair.Key);
+			}
+		}
+		for (const FName& RowName : RemovedRows)
+		{
+			InDataTable->RemoveRow(RowName);
+		}
+		return RemovedRows.Num();
+	}
+	
+	/** 从缓存恢复DataTable，行按缓存中的哈希记录到OutHashes，之后可以继续增量导入 */
+	FExcelOperationResult RestoreFromCache(UDataTable* InDataTable, const FExcelDataTableCache& InCache, uint64 InSourceHash, uint64 InSchemaHash, FExcelDataTableImportHashes& OutHashes)
+	{
+		FExcelOperationResult Result;
+		const UScriptStruct* RowStruct = InDataTable->RowStruct;
+		
+		FStructOnScope DefaultRow(RowStruct);
+		FStructOnScope ScratchRow(RowStruct);
+		
+		FExcelDataTableImportHashes& NewHashes = OutHashes;
+		NewHashes.SourceHash = InSourceHash;
+		NewHashes.SchemaHash = InSchemaHash;
+		NewHashes.RowHashes.Reserve(InCache.Num());
+		
+		bool bChanged = false;
+		for (int32 Index = 0; Index < InCache.Num(); ++Index)
+		{
+			const FName RowName = InCache.GetRowName(Index);
+			if (UpsertRow(InDataTable, RowName, DefaultRow.GetStructMemory(), ScratchRow.GetStructMemory(), bChanged, [&](uint8* OutRowData)
+			{
+				return InCache.ReadRow(Index, RowStruct, OutRowData);
+			}))
+			{
+				NewHashes.RowHashes.Add(RowName, InCache.GetRowHash(Index));
+				Result.ProcessedRows++;
+			}
+			else
+			{
+				Result.ErrorRows.Add(Index + 2);
+			}
+		}
+		
+		bChanged |= RemoveRowsNotIn(InDataTable, NewHashes.RowHashes) > 0;
+		if (bChanged)
+		{
+			InDataTable->MarkPackageDirty();
+			FDataTableEditorUtils::BroadcastPostChange(InDataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+		}
+		
+		Result.bSuccess = Result.ProcessedRows > 0;
+		Result.Message = FString::Printf(TEXT("文件未变化，从缓存恢复 %d 行数据%s"), Result.ProcessedRows, bChanged ? TEXT("") : TEXT("，DataTable没有变化"));
+		return Result;
+	}
+}
 
 void UExcelDataTableConverter::Initialize(FSubsystemCollectionBase& Collection)
 {
 	Super::Initialize(Collection);
+	
+	// 导入的哈希在DataTable保存后才写入哈希文件，命令行中保存时也需要
+	PackageSavedHandle = UPackage::PackageSavedWithContextEvent.AddUObject(this, &UExcelDataTableConverter::OnPackageSaved);
+	
+	// 命令行中不需要自动同步
+	if (!IsRunningCommandlet())
+	{
+		RefreshAutoSyncWatchers();
+		SettingsChangedHandle = GetMutableDefault<UExcelDataTableSettings>()->OnSettingChanged().AddUObject(this, &UExcelDataTableConverter::OnAutoSyncSettingsChanged);
+		AutoSyncTickerHandle = FTSTicker::GetCoreTicker().AddTicker(FTickerDelegate::CreateUObject(this, &UExcelDataTableConverter::TickAutoSync), ExcelDataTableConverterPrivate::AutoSyncTickInterval);
+	}
 }
 
 void UExcelDataTableConverter::Deinitialize()
 {
+	UPackage::PackageSavedWithContextEvent.Remove(PackageSavedHandle);
+	for (const TPair<TObjectKey<UDataTable>, FDelegateHandle>& Pair : VerifiedDataTables)
+	{
+		if (UDataTable* DataTable = Pair.Key.ResolveObjectPtr())
+		{
+			DataTable->OnDataTableChanged().Remove(Pair.Value);
+		}
+	}
+	VerifiedDataTables.Reset();
+	FTSTicker::GetCoreTicker().RemoveTicker(AutoSyncTickerHandle);
+	if (UExcelDataTableSettings* Settings = GetMutableDefault<UExcelDataTableSettings>())
+	{
+		Settings->OnSettingChanged().Remove(SettingsChangedHandle);
+	}
+	UnregisterAutoSyncWatchers();
+	
+	// 还在进行的读取不引用这个对象，直接丢弃结果
+	AutoSyncTasks.Reset();
+	
 	Super::Deinitialize();
 }
 
-FExcelOperationResult UExcelDataTableConverter::ImportExcelToDataTable(const FString& DataTablePath, const FString& ExcelFilePath, const FString& SheetName)
+void UExcelDataTableConverter::OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext)
 {
-	FExcelOperationResult Result;
-	Result.bSuccess = false;
+	// 烘焙等过程生成的保存不改变编辑器中的资源
+	if (!Package || ObjectSaveContext.IsProceduralSave())
+	{
+		return;
+	}
+	
+	// 导入时有修改的DataTable在保存时才计算内容的哈希；导入后被编辑过的不计算，保持为0，下次导入时不可信
+	UExcelDataTableSettings* Settings = GetMutableDefault<UExcelDataTableSettings>();
+	for (const TPair<TObjectKey<UDataTable>, FDelegateHandle>& Pair : VerifiedDataTables)
+	{
+		UDataTable* DataTable = Pair.Key.ResolveObjectPtr();
+		if (DataTable && DataTable->GetOutermost() == Package)
+		{
+			const FSoftObjectPath DataTablePath(DataTable);
+			const FExcelDataTableImportHashes* Hashes = Settings->FindImportHashes(DataTablePath);
+			if (Hashes && Hashes->ContentHash == 0)
+			{
+				Settings->SetImportContentHash(DataTablePath, ExcelDataTableConverterPrivate::GetContentHash(DataTable));
+			}
+		}
+	}
+	Settings->CommitImportHashes(Package->GetFName());
+}
+
+bool UExcelDataTableConverter::VerifyImportedContent(UDataTable* DataTable, uint64 ContentHash)
+{
+	if (VerifiedDataTables.Contains(TObjectKey<UDataTable>(DataTable)))
+	{
+		return true;
+	}
+	
+	// 内容的哈希为0时导入后还没有保存过，不能与重新加载的资源比较
+	if (ContentHash == 0 || ContentHash != ExcelDataTableConverterPrivate::GetContentHash(DataTable))
+	{
+		return false;
+	}
 	
-	// 检查文件是否存在
-	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*ExcelFilePath))
+	MarkVerified(DataTable);
+	return true;
+}
+
+void UExcelDataTableConverter::StoreImportHashes(UDataTable* DataTable, const FString& DataTablePath, FExcelDataTableImportHashes&& Hashes)
+{
+	using namespace ExcelDataTableConverterPrivate;
+	
+	// 包与磁盘上的资源一致时哈希立即写入哈希文件，需要内容的哈希；否则在包保存时再计算
+	const bool bPackageSaved = IsPackageSaved(DataTable);
+	if (bPackageSaved && Hashes.ContentHash == 0)
+	{
+		Hashes.ContentHash = GetContentHash(DataTable);
+	}
+	GetMutableDefault<UExcelDataTableSettings>()->SetImportHashes(FSoftObjectPath(DataTablePath), MoveTemp(Hashes), bPackageSaved);
+	MarkVerified(DataTable);
+}
+
+void UExcelDataTableConverter::MarkVerified(UDataTable* DataTable)
+{
+	const TObjectKey<UDataTable> Key(DataTable);
+	if (VerifiedDataTables.Contains(Key))
+	{
+		return;
+	}
+	
+	// 被回收或重新加载的DataTable不会再通知，顺便移除
+	for (auto It = VerifiedDataTables.CreateIterator(); It; ++It)
+	{
+		if (!It->Key.ResolveObjectPtr())
+		{
+			It.RemoveCurrent();
+		}
+	}
+	
+	VerifiedDataTables.Add(Key, DataTable->OnDataTableChanged().AddUObject(this, &UExcelDataTableConverter::OnVerifiedDataTableChanged, TWeakObjectPtr<UDataTable>(DataTable)));
+}
+
+void UExcelDataTableConverter::UnmarkVerified(UDataTable* DataTable)
+{
+	FDelegateHandle Handle;
+	if (VerifiedDataTables.RemoveAndCopyValue(TObjectKey<UDataTable>(DataTable), Handle))
+	{
+		DataTable->OnDataTableChanged().Remove(Handle);
+	}
+}
+
+void UExcelDataTableConverter::OnVerifiedDataTableChanged(TWeakObjectPtr<UDataTable> DataTable)
+{
+	if (UDataTable* ChangedDataTable = DataTable.Get())
+	{
+		UnmarkVerified(ChangedDataTable);
+	}
+}
+
+void UExcelDataTableConverter::RefreshAutoSyncWatchers()
+{
+	UnregisterAutoSyncWatchers();
+	
+	FDirectoryWatcherModule& DirectoryWatcherModule = FModuleManager::LoadModuleChecked<FDirectoryWatcherModule>(TEXT("DirectoryWatcher"));
+	IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule.Get();
+	if (!DirectoryWatcher)
+	{
+		return;
+	}
+	
+	// 多个映射在同一个目录时只监视一次
+	for (const FExcelDataTableMapping& Mapping : GetDefault<UExcelDataTableSettings>()->DataTableMappings)
+	{
+		if (!Mapping.bAutoSync || Mapping.DataTablePath.IsNull() || Mapping.ExcelFilePath.FilePath.IsEmpty())
+		{
+			continue;
+		}
+		
+		const FString Directory = FPaths::GetPath(ExcelDataTableConverterPrivate::GetFullPath(Mapping.ExcelFilePath.FilePath));
+		if (AutoSyncWatchers.Contains(Directory))
+		{
+			continue;
+		}
+		
+		FDelegateHandle Handle;
+		if (DirectoryWatcher->RegisterDirectoryChangedCallback_Handle(Directory,
+			IDirectoryWatcher::FDirectoryChanged::CreateUObject(this, &UExcelDataTableConverter::OnAutoSyncDirectoryChanged),
+			Handle, IDirectoryWatcher::WatchOptions::IgnoreChangesInSubtree))
+		{
+			AutoSyncWatchers.Add(Directory, Handle);
+		}
+		else
+		{
+			UE_LOG(LogTemp, Warning, TEXT("无法监视目录，自动同步不可用: %s"), *Directory);
+		}
+	}
+}
+
+void UExcelDataTableConverter::UnregisterAutoSyncWatchers()
+{
+	if (AutoSyncWatchers.Num() == 0)
+	{
+		return;
+	}
+	
+	// 关闭编辑器时DirectoryWatcher可能已经卸载
+	if (FDirectoryWatcherModule* DirectoryWatcherModule = FModuleManager::GetModulePtr<FDirectoryWatcherModule>(TEXT("DirectoryWatcher")))
+	{
+		if (IDirectoryWatcher* DirectoryWatcher = DirectoryWatcherModule->Get())
+		{
+			for (const TPair<FString, FDelegateHandle>& Watcher : AutoSyncWatchers)
+			{
+				DirectoryWatcher->UnregisterDirectoryChangedCallback_Handle(Watcher.Key, Watcher.Value);
+			}
+		}
+	}
+	AutoSyncWatchers.Reset();
+}
+
+void UExcelDataTableConverter::OnAutoSyncSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent)
+{
+	RefreshAutoSyncWatchers();
+}
+
+void UExcelDataTableConverter::OnAutoSyncDirectoryChanged(const TArray<FFileChangeData>& FileChanges)
+{
+	using namespace ExcelDataTableConverterPrivate;
+	
+	const double Now = FPlatformTime::Seconds();
+	for (const FFileChangeData& FileChange : FileChanges)
 	{
-		Result.Message = FString::Printf(TEXT("Excel文件不存在: %s"), *ExcelFilePath);
+		if (FileChange.Action == FFileChangeData::FCA_Removed)
+		{
+			continue;
+		}
+		
+		// Excel保存时先写入临时文件再重命名，最后总会有目标文件的新增或修改
+		const FString ChangedFile = GetFullPath(FileChange.Filename);
+		for (const FExcelDataTableMapping& Mapping : GetDefault<UExcelDataTableSettings>()->DataTableMappings)
+		{
+			if (!Mapping.bAutoSync || !FPaths::IsSamePath(GetFullPath(Mapping.ExcelFilePath.FilePath), ChangedFile))
+			{
+				continue;
+			}
+			
+			// 已经在等待的映射只推迟开始的时间，正在读取的映射读取完成后还要再同步一次
+			const FString DataTablePath = Mapping.DataTablePath.ToString();
+			FExcelAutoSyncTask* PendingTask = AutoSyncTasks.FindByPredicate([&DataTablePath](const FExcelAutoSyncTask& Task)
+			{
+				return Task.DataTablePath == DataTablePath && !Task.LoadTask.IsValid();
+			});
+			if (!PendingTask)
+			{
+				PendingTask = &AutoSyncTasks.AddDefaulted_GetRef();
+				PendingTask->DataTablePath = DataTablePath;
+			}
+			PendingTask->LastChangeTime = Now;
+		}
+	}
+}
+
+bool UExcelDataTableConverter::TickAutoSync(float DeltaTime)
+{
+	using namespace ExcelDataTableConverterPrivate;
+	
+	if (AutoSyncTasks.Num() == 0)
+	{
+		return true;
+	}
+	
+	UExcelDataTableSettings* Settings = GetMutableDefault<UExcelDataTableSettings>();
+	const double Now = FPlatformTime::Seconds();
+	bool bImported = false;
+	
+	for (int32 Index = 0; Index < AutoSyncTasks.Num(); Index++)
+	{
+		FExcelAutoSyncTask& Task = AutoSyncTasks[Index];
+		
+		// 映射已经删除或关闭了自动同步
+		const FExcelDataTableMapping* Mapping = Settings->GetMappingForDataTable(FSoftObjectPath(Task.DataTablePath));
+		if (!Mapping || !Mapping->bAutoSync)
+		{
+			AutoSyncTasks.RemoveAt(Index--);
+			continue;
+		}
+		
+		if (!Task.LoadTask.IsValid())
+		{
+			// 连续保存时等文件安静下来，同一个表格正在读取时等它完成
+			const FString& DataTablePath = Task.DataTablePath;
+			if (Now - Task.LastChangeTime < AutoSyncDebounceSeconds || AutoSyncTasks.ContainsByPredicate([&DataTablePath](const FExcelAutoSyncTask& Other)
+			{
+				return Other.DataTablePath == DataTablePath && Other.LoadTask.IsValid();
+			}))
+			{
+				continue;
+			}
+			
+			// 读取和解析在线程池中进行，源文件没有变化时不解析
+			const uint64 UnchangedHash = GetUnchangedSourceHash(Task.DataTablePath);
+			Task.LoadTask = Async(EAsyncExecution::ThreadPool, [ExcelFilePath = Mapping->ExcelFilePath.FilePath, SheetName = Mapping->SheetName, UnchangedHash]() -> TSharedPtr<FExcelTableRows>
+			{
+				TSharedPtr<FExcelTableRows> Rows = MakeShared<FExcelTableRows>();
+				Rows->Load(ExcelFilePath, SheetName, UnchangedHash);
+				return Rows;
+			});
+			continue;
+		}
+		
+		if (!Task.LoadTask.IsReady())
+		{
+			continue;
+		}
+		
+		const TSharedPtr<FExcelTableRows> Rows = Task.LoadTask.Get();
+		if (!Rows->GetError().IsEmpty())
+		{
+			// 文件可能还被Excel占用，稍后重试
+			if (Task.NumRetries < AutoSyncMaxRetries)
+			{
+				Task.LoadTask = TFuture<TSharedPtr<FExcelTableRows>>();
+				Task.LastChangeTime = Now;
+				Task.NumRetries++;
+				continue;
+			}
+			
+			UE_LOG(LogTemp, Error, TEXT("自动同步失败: %s, %s"), *Task.DataTablePath, *Rows->GetError());
+			ShowAutoSyncNotification(FString::Printf(TEXT("自动同步失败: %s"), *Rows->GetError()), false);
+			AutoSyncTasks.RemoveAt(Index--);
+			continue;
+		}
+		
+		const FExcelOperationResult Result = ImportRowsToDataTable(Task.DataTablePath, Mapping->ExcelFilePath.FilePath, Mapping->SheetName, *Rows);
+		bImported = true;
+		
+		// 文件没有变化时不提示，例如只是另存为了相同的内容
+		UE_LOG(LogTemp, Log, TEXT("自动同步 %s: %s"), *Task.DataTablePath, *Result.Message);
+		if (!Rows->IsUnchanged())
+		{
+			ShowAutoSyncNotification(FString::Printf(TEXT("已自动同步 %s\n%s"), *FPackageName::ObjectPathToObjectName(Task.DataTablePath), *Result.Message), Result.bSuccess && Result.ErrorRows.Num() == 0);
+		}
+		AutoSyncTasks.RemoveAt(Index--);
+	}
+	
+	if (bImported)
+	{
+		Settings->SaveImportHashes();
+	}
+	
+	return true;
+}
+
+FExcelOperationResult UExcelDataTableConverter::ImportExcelToDataTable(const FString& DataTablePath, const FString& ExcelFilePath, const FString& SheetName)
+{
+	FExcelTableRows Rows;
+	if (!Rows.Load(ExcelFilePath, SheetName, GetUnchangedSourceHash(DataTablePath)))
+	{
+		FExcelOperationResult Result;
+		Result.bSuccess = false;
+		Result.Message = Rows.GetError();
 		return Result;
 	}
+	
+	FExcelOperationResult Result = ImportRowsToDataTable(DataTablePath, ExcelFilePath, SheetName, Rows);
+	GetMutableDefault<UExcelDataTableSettings>()->SaveImportHashes();
+	return Result;
+}
+
+uint64 UExcelDataTableConverter::GetUnchangedSourceHash(const FString& DataTablePath) const
+{
+	UExcelDataTableSettings* Settings = GetMutableDefault<UExcelDataTableSettings>();
+	if (!Settings->bIncrementalImport)
+	{
+		return 0;
+	}
+	
+	// 没有导入哈希时使用缓存的源哈希，文件没有变化时可以从缓存恢复
+	const FExcelDataTableImportHashes* Previous = Settings->FindImportHashes(FSoftObjectPath(DataTablePath));
+	return Previous ? Previous->SourceHash : FExcelDataTableCache::ReadSourceHash(DataTablePath);
+}
 
+FExcelOperationResult UExcelDataTableConverter::ImportRowsToDataTable(const FString& DataTablePath, const FString& ExcelFilePath, const FString& SheetName, FExcelTableRows& Rows)
+{
+	using namespace ExcelDataTableConverterPrivate;
+	
+	FExcelOperationResult Result;
+	Result.bSuccess = false;
+	
 	// 加载DataTable资产
 	UDataTable* DataTable = LoadObject<UDataTable>(nullptr, *DataTablePath);
 	if (!DataTable)
@@ -51,45 +603,60 @@ FExcelOperationResult UExcelDataTableConverter::ImportExcelToDataTable(const FSt
 		Result.Message = TEXT("DataTable没有有效的行结构");
 		return Result;
 	}
-
-	// 使用Python桥接将Excel转换为CSV
-	auto PythonBridge = UPythonBridge::Get();
-	if (!PythonBridge)
-	{
-		Result.Message = TEXT("无法获取Python桥接接口");
-		return Result;
-	}
 	
-	// 调用Python脚本将Excel转换为CSV
-	FString CsvContent = PythonBridge->ExcelToCsv(ExcelFilePath);
-	if (CsvContent.IsEmpty())
+	UExcelDataTableSettings* Settings = GetMutableDefault<UExcelDataTableSettings>();
+	const bool bIncremental = Settings->bIncrementalImport;
+	const uint64 SchemaHash = GetSchemaHash(RowStruct);
+	
+	// 上次导入的哈希只有在行结构相同、DataTable的内容也与导入后相同时才可信
+	// 本次会话中导入或验证后没有被修改的DataTable直接可信，只有新加载的DataTable需要计算内容的哈希
+	// 资源在导入之后被编辑、还原或没有保存就重新加载时，内容的哈希不同
+	const FExcelDataTableImportHashes* Previous = bIncremental ? Settings->FindImportHashes(FSoftObjectPath(DataTablePath)) : nullptr;
+	if (Previous && (Previous->SchemaHash != SchemaHash || !VerifyImportedContent(DataTable, Previous->ContentHash)))
 	{
-		Result.Message = TEXT("Excel转换为CSV失败，请检查Python环境和pandas库是否已安装");
-		return Result;
+		Previous = nullptr;
 	}
 	
-	// 解析CSV内容
-	TArray<TArray<FString>> Rows;
-	TArray<FString> Lines;
-	CsvContent.ParseIntoArrayLines(Lines, false);
-	
-	for (const FString& Line : Lines)
+	if (Rows.IsUnchanged())
 	{
-		TArray<FString> Values;
-		Line.ParseIntoArray(Values, TEXT(","), true);
-		Rows.Add(Values);
+		if (Previous)
+		{
+			Result.bSuccess = true;
+			Result.ProcessedRows = Previous->RowHashes.Num();
+			Result.UnchangedRows = Result.ProcessedRows;
+			Result.Message = FString::Printf(TEXT("文件未变化，跳过导入: %s"), *ExcelFilePath);
+			return Result;
+		}
+		
+		// 文件没有变化但DataTable已经不同，先从缓存恢复，缓存不可用时解析后重新导入
+		FExcelDataTableCache Cache;
+		if (Cache.Open(DataTablePath, Rows.GetSourceHash(), SchemaHash))
+		{
+			FExcelDataTableImportHashes RestoredHashes;
+			Result = RestoreFromCache(DataTable, Cache, Rows.GetSourceHash(), SchemaHash, RestoredHashes);
+			StoreImportHashes(DataTable, DataTablePath, MoveTemp(RestoredHashes));
+			return Result;
+		}
+		
+		if (!Rows.Load(ExcelFilePath, SheetName))
+		{
+			Result.Message = Rows.GetError();
+			return Result;
+		}
 	}
-	
+
 	if (Rows.Num() < 3)  // 现在需要至少有表头、类型行和一行数据
 	{
-		Result.Message = TEXT("CSV内容不足，至少需要表头、类型行和一行数据");
+		Result.Message = TEXT("表格内容不足，至少需要表头、类型行和一行数据");
 		return Result;
 	}
 	
-	// 第一行是表头
-	TArray<FString> Headers = Rows[0];
-	
-	// 第二行是类型信息，我们可以跳过它
+	// 第一行是表头，第二行是类型信息，我们可以跳过它
+	TArray<FString> Headers;
+	for (const FStringView& Header : Rows.GetRow(0))
+	{
+		Headers.Emplace(Header);
+	}
 	
 	// 把第一列表头从"Row_Name"转换回"Name"
 	if (Headers.Num() > 0 && Headers[0] == TEXT("Row_Name"))
@@ -97,13 +664,57 @@ FExcelOperationResult UExcelDataTableConverter::ImportExcelToDataTable(const FSt
 		Headers[0] = TEXT("Name");
 	}
 	
-	// 清空现有数据
-	DataTable->EmptyTable();
+	// 表头只解析一次，每列直接对应属性和解析方式
+	const FExcelColumnPlan ColumnPlan(RowStruct, Headers);
+	
+	// 增量导入时更新变化的行、删除不再存在的行，只有内容真正改变时才标记为已修改
+	// 关闭增量导入时与之前一样清空现有数据
+	bool bChanged = false;
+	if (!bIncremental && DataTable->GetRowMap().Num() > 0)
+	{
+		DataTable->EmptyTable();
+		bChanged = true;
+	}
+	
+	// 整个导入只分配一次：默认值的行，以及导入已有行时复用的临时行
+	FStructOnScope DefaultRow(RowStruct);
+	FStructOnScope ScratchRow(RowStruct);
+	const uint8* DefaultRowData = DefaultRow.GetStructMemory();
+	uint8* ScratchRowData = ScratchRow.GetStructMemory();
+	
+	// 表头作为每行哈希的种子，列的顺序或名称变化时所有行都重新导入
+	const uint64 HeaderHash = HashCells(Rows.GetRow(0), SchemaHash);
+	FExcelDataTableImportHashes NewHashes;
+	NewHashes.SourceHash = Rows.GetSourceHash();
+	NewHashes.SchemaHash = SchemaHash;
+	NewHashes.RowHashes.Reserve(Rows.Num() - 2);
+	int32 UnchangedRows = 0;
+	
+	// 上次的哈希不可信时（DataTable被还原、同步后在命令行中导入等），使用上次导入的缓存
+	// 只有表头与当前文件相同时行的哈希才可比，哈希相同的行直接从缓存读取，不需要ImportText
+	FExcelDataTableCache Cache;
+	TMap<FName, int32> CachedRowIndices;
+	if (bIncremental && !Previous && Cache.Open(DataTablePath, SchemaHash))
+	{
+		if (Cache.GetHeaders() == Headers)
+		{
+			CachedRowIndices.Reserve(Cache.Num());
+			for (int32 Index = 0; Index < Cache.Num(); ++Index)
+			{
+				CachedRowIndices.Add(Cache.GetRowName(Index), Index);
+			}
+		}
+		else
+		{
+			Cache.Close();
+		}
+	}
+	int32 CachedRows = 0;
 	
 	// 从第三行开始处理数据
 	for (int32 RowIndex = 2; RowIndex < Rows.Num(); RowIndex++)
 	{
-		const TArray<FString>& RowData = Rows[RowIndex];
+		const TConstArrayView<FStringView> RowData = Rows.GetRow(RowIndex);
 		
 		// 检查第一列是否为有效的行名
 		if (RowData.Num() == 0 || RowData[0].IsEmpty())
@@ -112,57 +723,89 @@ FExcelOperationResult UExcelDataTableConverter::ImportExcelToDataTable(const FSt
 			continue;
 		}
 		
-		FName RowName(*RowData[0]);
+		FName RowName(RowData[0]);
+		const uint64 RowHash = HashCells(RowData, HeaderHash);
 		
-		// 创建新行
-		uint8* NewRowData = (uint8*)FMemory::Malloc(RowStruct->GetStructureSize());
-		RowStruct->InitializeStruct(NewRowData);
-		
-		// 填充行数据
-		bool bRowValid = true;
-		for (int32 ColIndex = 1; ColIndex < FMath::Min(Headers.Num(), RowData.Num()); ColIndex++)
+		// 与上次导入相同的行不需要解析，重复的行名总是重新导入，保证后面的行覆盖前面的行
+		if (Previous && !NewHashes.RowHashes.Contains(RowName))
 		{
-			FString PropertyName = Headers[ColIndex];
-			FString PropertyValue = RowData[ColIndex];
-			
-			FProperty* Property = RowStruct->FindPropertyByName(*PropertyName);
-			if (Property)
+			const uint64* PreviousHash = Previous->RowHashes.Find(RowName);
+			if (PreviousHash && *PreviousHash == RowHash)
 			{
-				// 设置属性值
-				void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(NewRowData);
-				
-				// 使用FProperty的ImportText_Direct方法，注意参数类型
-				const TCHAR* ErrorText = Property->ImportText_Direct(*PropertyValue, PropertyAddr, nullptr, PPF_None, nullptr);
-				if (ErrorText != nullptr)
-				{
-					UE_LOG(LogTemp, Error, TEXT("导入失败: %s"), ErrorText);
-					bRowValid = false;
-					break;
-				}
+				NewHashes.RowHashes.Add(RowName, RowHash);
+				Result.ProcessedRows++;
+				UnchangedRows++;
+				continue;
 			}
 		}
 		
+		// 重复的行名和从缓存读取失败的行仍然解析
+		const int32* CachedIndex = NewHashes.RowHashes.Contains(RowName) ? nullptr : CachedRowIndices.Find(RowName);
+		if (CachedIndex && Cache.GetRowHash(*CachedIndex) == RowHash
+			&& UpsertRow(DataTable, RowName, DefaultRowData, ScratchRowData, bChanged, [&](uint8* OutRowData)
+			{
+				return Cache.ReadRow(*CachedIndex, RowStruct, OutRowData);
+			}))
+		{
+			NewHashes.RowHashes.Add(RowName, RowHash);
+			Result.ProcessedRows++;
+			CachedRows++;
+			continue;
+		}
+		
+		int32 FailedColumn = INDEX_NONE;
+		const bool bRowValid = UpsertRow(DataTable, RowName, DefaultRowData, ScratchRowData, bChanged, [&](uint8* OutRowData)
+		{
+			return ColumnPlan.ImportRow(RowData, OutRowData, FailedColumn);
+		});
+		
 		if (bRowValid)
 		{
-			// 添加到DataTable
-			DataTable->AddRow(RowName, *(FTableRowBase*)NewRowData);
+			NewHashes.RowHashes.Add(RowName, RowHash);
 			Result.ProcessedRows++;
 		}
 		else
 		{
+			UE_LOG(LogTemp, Error, TEXT("导入失败: 行 %d, 列 %s, 值 %s"), RowIndex, *Headers[FailedColumn], *FString(RowData[FailedColumn]));
 			Result.ErrorRows.Add(RowIndex);
 		}
-		
-		// 清理内存
-		RowStruct->DestroyStruct(NewRowData);
-		FMemory::Free(NewRowData);
 	}
 	
-	// 标记DataTable为已修改
-	DataTable->MarkPackageDirty();
+	// 删除表格中已经没有的行，导入失败的行也删除，结果与完整导入相同
+	const int32 NumRemovedRows = RemoveRowsNotIn(DataTable, NewHashes.RowHashes);
+	bChanged |= NumRemovedRows > 0;
 	
+	// 只有内容改变时才标记DataTable为已修改
+	if (bChanged)
+	{
+		DataTable->MarkPackageDirty();
+		FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	}
+	
+	// 缓存导入的结果，之后源文件没有变化但DataTable不同时从缓存恢复；写入前先释放读取的缓存
+	Cache.Close();
+	if (bIncremental && (bChanged || FExcelDataTableCache::ReadSourceHash(DataTablePath) != NewHashes.SourceHash))
+	{
+		FExcelDataTableCache::Write(DataTablePath, DataTable, Headers, NewHashes);
+	}
+	
+	// 关闭增量导入时删除旧的哈希，之后重新开启时不会误判为没有变化
+	if (bIncremental)
+	{
+		// 没有修改时内容与验证过的上次导入相同，有修改时内容的哈希在保存时才计算
+		NewHashes.ContentHash = bChanged || !Previous ? 0 : Previous->ContentHash;
+		StoreImportHashes(DataTable, DataTablePath, MoveTemp(NewHashes));
+	}
+	else
+	{
+		UnmarkVerified(DataTable);
+		Settings->RemoveImportHashes(FSoftObjectPath(DataTablePath));
+	}
+	
+	Result.UnchangedRows = UnchangedRows;
 	Result.bSuccess = Result.ProcessedRows > 0;
-	Result.Message = FString::Printf(TEXT("成功导入 %d 行数据，%d 行数据出错"), Result.ProcessedRows, Result.ErrorRows.Num());
+	Result.Message = FString::Printf(TEXT("成功导入 %d 行数据（%d 行未变化，%d 行从缓存读取，删除 %d 行），%d 行数据出错%s"),
+		Result.ProcessedRows, UnchangedRows, CachedRows, NumRemovedRows, Result.ErrorRows.Num(), bChanged ? TEXT("") : TEXT("，DataTable没有变化"));
 	
 	return Result;
 }
@@ -188,9 +831,6 @@ FExcelOperationResult UExcelDataTableConverter::ExportDataTableToExcel(const FSt
 		return Result;
 	}
 
-	// 创建导出的行数据，先转换为CSV格式
-	TArray<TArray<FString>> ExportRows;
-	
 	// 添加表头
 	TArray<FString> Headers = CreateHeaderFromRowStruct(RowStruct);
 	
@@ -200,108 +840,175 @@ FExcelOperationResult UExcelDataTableConverter::ExportDataTableToExcel(const FSt
 		Headers[0] = TEXT("Row_Name");
 	}
 	
-	ExportRows.Add(Headers);
-	
 	// 添加类型行
 	TArray<FString> TypeRow = CreateTypeRowFromRowStruct(RowStruct);
-	ExportRows.Add(TypeRow);
 	
-	// 遍历DataTable中的所有行
-	for (auto& RowPair : DataTable->GetRowMap())
+	// 每列的属性只查找一次
+	TArray<FProperty*> ColumnProperties;
+	ColumnProperties.Add(nullptr); // 第一列是行名
+	for (int32 i = 1; i < Headers.Num(); i++)
 	{
-		FName RowName = RowPair.Key;
-		uint8* RowData = (uint8*)RowPair.Value;
-		
-		TArray<FString> RowValues;
-		RowValues.Add(RowName.ToString()); // 第一列是行名
+		ColumnProperties.Add(RowStruct->FindPropertyByName(*Headers[i]));
+	}
+	
+	// CSV文件直接写出
+	if (FPaths::GetExtension(ExcelFilePath).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		TArray<TArray<FString>> ExportRows;
+		ExportRows.Add(Headers);
+		ExportRows.Add(TypeRow);
 		
-		// 获取每个属性的值
-		for (int32 i = 1; i < Headers.Num(); i++)
+		for (auto& RowPair : DataTable->GetRowMap())
 		{
-			FString PropertyName;
-			
-			// 针对第一列表头的特殊处理
-			if (i == 0 && Headers[i] == TEXT("Row_Name"))
-			{
-				PropertyName = TEXT("Name");
-			}
-			else
-			{
-				PropertyName = Headers[i];
-			}
+			TArray<FString>& RowValues = ExportRows.AddDefaulted_GetRef();
+			RowValues.Add(RowPair.Key.ToString()); // 第一列是行名
 			
-			FProperty* Property = RowStruct->FindPropertyByName(*PropertyName);
-			
-			if (Property)
+			for (int32 i = 1; i < ColumnProperties.Num(); i++)
 			{
-				void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(RowData);
-				
-				// 使用Property的ExportTextItem_Direct方法
-				FString PropertyValue;
-				Property->ExportTextItem_Direct(PropertyValue, PropertyAddr, nullptr, nullptr, PPF_None);
-				RowValues.Add(PropertyValue);
-			}
-			else
-			{
-				RowValues.Add(TEXT(""));
+				FString& PropertyValue = RowValues.AddDefaulted_GetRef();
+				if (FProperty* Property = ColumnProperties[i])
+				{
+					Property->ExportTextItem_Direct(PropertyValue, Property->ContainerPtrToValuePtr<void>(RowPair.Value), nullptr, nullptr, PPF_None);
+				}
 			}
+			Result.ProcessedRows++;
 		}
 		
-		ExportRows.Add(RowValues);
-		Result.ProcessedRows++;
+		if (!WriteCSVFile(ExcelFilePath, ExportRows))
+		{
+			Result.Message = FString::Printf(TEXT("无法写入CSV文件: %s"), *ExcelFilePath);
+			return Result;
+		}
+		
+		Result.bSuccess = true;
+		Result.Message = FString::Printf(TEXT("成功导出 %d 行数据到 %s"), Result.ProcessedRows, *ExcelFilePath);
+		return Result;
 	}
 	
-	// 将行数据转换为CSV字符串，使用UTF-8编码
-	TArray<FString> Lines;
-	for (const TArray<FString>& Row : ExportRows)
+	using namespace ExcelDataTableConverterPrivate;
+	
+	// 导出会替换整个工作簿，其他工作表、样式和公式都不保留，只覆盖只有一个工作表的文件
+	if (FPaths::FileExists(ExcelFilePath))
 	{
-		TArray<FString> EscapedValues;
-		for (const FString& Value : Row)
+		FXlsxReader ExistingReader;
+		if (!ExistingReader.Open(ExcelFilePath))
 		{
-			// 如果值包含逗号或引号，需要用双引号包围
-			FString EscapedValue = Value;
-			
-			// 替换所有引号为两个引号，确保转义正确
-			if (EscapedValue.Contains(TEXT("\"")))
-			{
-				EscapedValue.ReplaceInline(TEXT("\""), TEXT("\"\""));
-			}
-			
-			// 所有值都用引号包围，以确保特殊字符和Unicode字符正确处理
-			EscapedValue = FString::Printf(TEXT("\"%s\""), *EscapedValue);
-			
-			EscapedValues.Add(EscapedValue);
+			Result.Message = FString::Printf(TEXT("无法读取已有的Excel文件，不覆盖: %s（%s）"), *ExcelFilePath, *ExistingReader.GetError());
+			return Result;
 		}
 		
-		Lines.Add(FString::Join(EscapedValues, TEXT(",")));
+		const TArray<FString> ExistingSheets = ExistingReader.GetSheetNames();
+		if (ExistingSheets.Num() > 1)
+		{
+			Result.Message = FString::Printf(TEXT("Excel文件中有 %d 个工作表（%s），导出会丢失其他工作表，不覆盖: %s"),
+				ExistingSheets.Num(), *FString::Join(ExistingSheets, TEXT(", ")), *ExcelFilePath);
+			return Result;
+		}
 	}
 	
-	FString CsvContent = FString::Join(Lines, TEXT("\n"));
-	
-	// 使用Python桥接将CSV转换为Excel
-	auto PythonBridge = UPythonBridge::Get();
-	if (!PythonBridge)
+	// XLSX逐行写出，不在内存中保留整个表格
+	FXlsxWriter Writer;
+	if (!Writer.Open(ExcelFilePath, SheetName))
 	{
-		Result.Message = TEXT("无法获取Python桥接接口");
+		Result.Message = Writer.GetError();
 		return Result;
 	}
 	
-	// 调用Python脚本将CSV转换为Excel
-	bool bSuccess = PythonBridge->CsvToExcel(CsvContent, ExcelFilePath, SheetName);
-	if (bSuccess)
+	for (const TArray<FString>* HeaderRow : { &Headers, &TypeRow })
 	{
-		Result.bSuccess = true;
-		Result.Message = FString::Printf(TEXT("成功导出 %d 行数据到 %s"), Result.ProcessedRows, *ExcelFilePath);
+		Writer.BeginRow();
+		for (const FString& Value : *HeaderRow)
+		{
+			Writer.AddString(Value);
+		}
+		Writer.EndRow();
 	}
-	else
+	
+	// 导出文本的缓冲在各单元格之间复用
+	FString PropertyValue;
+	
+	for (auto& RowPair : DataTable->GetRowMap())
 	{
-		Result.Message = FString::Printf(TEXT("无法将CSV转换为Excel，请检查Python环境和pandas库是否已安装"));
+		const uint8* RowData = RowPair.Value;
+		
+		Writer.BeginRow();
+		Writer.AddString(RowPair.Key.ToString()); // 第一列是行名
+		
+		for (int32 i = 1; i < ColumnProperties.Num(); i++)
+		{
+			FProperty* Property = ColumnProperties[i];
+			if (!Property)
+			{
+				Writer.AddEmpty();
+				continue;
+			}
+			
+			const void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(RowData);
+			
+			// 数字写为数字单元格，Excel中可以直接计算；超出double精度的64位整数仍写为文本
+			const FNumericProperty* NumericProperty = CastField<FNumericProperty>(Property);
+			if (NumericProperty && !NumericProperty->IsEnum())
+			{
+				if (Property->IsA<FFloatProperty>())
+				{
+					Writer.AddNumber(GetShortestFloatValue(*static_cast<const float*>(PropertyAddr)));
+					continue;
+				}
+				
+				if (NumericProperty->IsFloatingPoint())
+				{
+					Writer.AddNumber(NumericProperty->GetFloatingPointPropertyValue(PropertyAddr));
+					continue;
+				}
+				
+				constexpr uint64 MaxExactInteger = 1ull << 53;
+				if (Property->IsA<FUInt64Property>())
+				{
+					const uint64 Value = NumericProperty->GetUnsignedIntPropertyValue(PropertyAddr);
+					if (Value <= MaxExactInteger)
+					{
+						Writer.AddNumber(static_cast<double>(Value));
+						continue;
+					}
+				}
+				else
+				{
+					const int64 Value = NumericProperty->GetSignedIntPropertyValue(PropertyAddr);
+					if (static_cast<uint64>(FMath::Abs(Value)) <= MaxExactInteger)
+					{
+						Writer.AddNumber(static_cast<double>(Value));
+						continue;
+					}
+				}
+			}
+			
+			PropertyValue.Reset();
+			Property->ExportTextItem_Direct(PropertyValue, PropertyAddr, nullptr, nullptr, PPF_None);
+			Writer.AddString(PropertyValue);
+		}
+		
+		Writer.EndRow();
+		Result.ProcessedRows++;
+	}
+	
+	if (!Writer.Close())
+	{
+		Result.Message = Writer.GetError();
+		return Result;
 	}
 	
+	Result.bSuccess = true;
+	Result.Message = FString::Printf(TEXT("成功导出 %d 行数据到 %s"), Result.ProcessedRows, *ExcelFilePath);
+	
 	return Result;
 }
 
 TArray<FExcelOperationResult> UExcelDataTableConverter::BatchProcess(bool bImport)
+{
+	return BatchProcessOnPool(bImport, nullptr);
+}
+
+TArray<FExcelOperationResult> UExcelDataTableConverter::BatchProcessOnPool(bool bImport, FQueuedThreadPool* ThreadPool)
 {
 	TArray<FExcelOperationResult> Results;
 	
@@ -316,50 +1023,137 @@ TArray<FExcelOperationResult> UExcelDataTableConverter::BatchProcess(bool bImpor
 		return Results;
 	}
 	
-	// 处理每个映射
+	// 收集有效的映射
+	TArray<const FExcelDataTableMapping*> Mappings;
 	for (const FExcelDataTableMapping& Mapping : Settings->DataTableMappings)
 	{
-		FString DataTablePath = Mapping.DataTablePath.ToString();
-		FString ExcelFilePath = Mapping.ExcelFilePath.FilePath;
-		FString SheetName = Mapping.SheetName;
+		if (!Mapping.DataTablePath.ToString().IsEmpty() && !Mapping.ExcelFilePath.FilePath.IsEmpty())
+		{
+			Mappings.Add(&Mapping);
+		}
+	}
+	
+	if (Mappings.Num() == 0)
+	{
+		return Results;
+	}
+	
+	FScopedSlowTask SlowTask(Mappings.Num(), FText::FromString(bImport ? TEXT("批量导入DataTable") : TEXT("批量导出DataTable")));
+	SlowTask.MakeDialog(true);
+	
+	auto AddCancelledResult = [&Results](const FString& DataTablePath)
+	{
+		FExcelOperationResult Result;
+		Result.bSuccess = false;
+		Result.Message = FString::Printf(TEXT("已取消: %s"), *DataTablePath);
+		Result.DataTablePath = DataTablePath;
+		Results.Add(Result);
+	};
+	
+	// 导出需要读取DataTable，在游戏线程中逐个处理
+	if (!bImport)
+	{
+		for (const FExcelDataTableMapping* Mapping : Mappings)
+		{
+			const FString DataTablePath = Mapping->DataTablePath.ToString();
+			if (SlowTask.ShouldCancel())
+			{
+				AddCancelledResult(DataTablePath);
+				continue;
+			}
+			
+			SlowTask.EnterProgressFrame(1, FText::FromString(FString::Printf(TEXT("导出 %s"), *DataTablePath)));
+			const double StartTime = FPlatformTime::Seconds();
+			FExcelOperationResult& Result = Results.Add_GetRef(ExportDataTableToExcel(DataTablePath, Mapping->ExcelFilePath.FilePath, Mapping->SheetName));
+			Result.DataTablePath = DataTablePath;
+			Result.WriteSeconds = FPlatformTime::Seconds() - StartTime;
+		}
+		return Results;
+	}
+	
+	// 导入时读取和解析文件在线程池中同时进行，只有修改DataTable在游戏线程
+	// 取消后还没有开始的任务直接返回，已经在读取的任务结束后结果被丢弃
+	TSharedRef<FThreadSafeBool> bCancelled = MakeShared<FThreadSafeBool>(false);
+	// 上次导入的哈希在游戏线程中取出，源文件没有变化的表格不解析
+	TArray<TFuture<TSharedPtr<FExcelTableRows>>> LoadTasks;
+	for (const FExcelDataTableMapping* Mapping : Mappings)
+	{
+		const uint64 UnchangedHash = GetUnchangedSourceHash(Mapping->DataTablePath.ToString());
+		LoadTasks.Add(AsyncPool(ThreadPool ? *ThreadPool : *GThreadPool, [ExcelFilePath = Mapping->ExcelFilePath.FilePath, SheetName = Mapping->SheetName, UnchangedHash, bCancelled]() -> TSharedPtr<FExcelTableRows>
+		{
+			if (*bCancelled)
+			{
+				return nullptr;
+			}
+			
+			TSharedPtr<FExcelTableRows> Rows = MakeShared<FExcelTableRows>();
+			Rows->Load(ExcelFilePath, SheetName, UnchangedHash);
+			return Rows;
+		}));
+	}
+	
+	// 按映射的顺序写入DataTable，等待时保持对话框响应
+	for (int32 Index = 0; Index < Mappings.Num(); Index++)
+	{
+		const FString DataTablePath = Mappings[Index]->DataTablePath.ToString();
+		SlowTask.EnterProgressFrame(1, FText::FromString(FString::Printf(TEXT("导入 %s (%d/%d)"), *DataTablePath, Index + 1, Mappings.Num())));
 		
-		if (DataTablePath.IsEmpty() || ExcelFilePath.IsEmpty())
+		while (!*bCancelled && !LoadTasks[Index].WaitFor(FTimespan::FromMilliseconds(50)))
 		{
-			continue;
+			SlowTask.TickProgress();
+			if (SlowTask.ShouldCancel())
+			{
+				*bCancelled = true;
+			}
 		}
 		
-		FExcelOperationResult Result;
-		if (bImport)
+		if (*bCancelled || SlowTask.ShouldCancel())
 		{
-			Result = ImportExcelToDataTable(DataTablePath, ExcelFilePath, SheetName);
+			*bCancelled = true;
+			AddCancelledResult(DataTablePath);
+			continue;
 		}
-		else
+		
+		const TSharedPtr<FExcelTableRows> Rows = LoadTasks[Index].Get();
+		if (!Rows->GetError().IsEmpty())
 		{
-			Result = ExportDataTableToExcel(DataTablePath, ExcelFilePath, SheetName);
+			FExcelOperationResult Result;
+			Result.bSuccess = false;
+			Result.Message = Rows->GetError();
+			Result.DataTablePath = DataTablePath;
+			Result.ReadSeconds = Rows->GetLoadSeconds();
+			Results.Add(Result);
+			continue;
 		}
 		
-		Results.Add(Result);
+		const double StartTime = FPlatformTime::Seconds();
+		FExcelOperationResult& Result = Results.Add_GetRef(ImportRowsToDataTable(DataTablePath, Mappings[Index]->ExcelFilePath.FilePath, Mappings[Index]->SheetName, *Rows));
+		Result.DataTablePath = DataTablePath;
+		Result.ReadSeconds = Rows->GetLoadSeconds();
+		Result.WriteSeconds = FPlatformTime::Seconds() - StartTime;
 	}
 	
+	Settings->SaveImportHashes();
 	return Results;
 }
 
 bool UExcelDataTableConverter::ReadCSVFile(const FString& FilePath, TArray<TArray<FString>>& OutRows)
 {
-	FString FileContent;
-	if (!FFileHelper::LoadFileToString(FileContent, *FilePath))
+	FCsvParser Parser;
+	if (!Parser.LoadFile(FilePath))
 	{
 		return false;
 	}
 	
-	TArray<FString> Lines;
-	FileContent.ParseIntoArrayLines(Lines, false);
-	
-	for (const FString& Line : Lines)
+	TArray<FStringView> Cells;
+	while (Parser.ReadRow(Cells))
 	{
-		TArray<FString> Values;
-		Line.ParseIntoArray(Values, TEXT(","), true);
-		OutRows.Add(Values);
+		TArray<FString>& Values = OutRows.AddDefaulted_GetRef();
+		Values.Reserve(Cells.Num());
+		for (const FStringView& Cell : Cells)
+		{
+			Values.Emplace(Cell);
+		}
 	}
 	
 	return true;
@@ -374,9 +1168,9 @@ bool UExcelDataTableConverter::WriteCSVFile(const FString& FilePath, const TArra
 		TArray<FString> EscapedValues;
 		for (const FString& Value : Row)
 		{
-			// 如果值包含逗号或引号，需要用双引号包围
+			// 如果值包含逗号、引号或换行，需要用双引号包围
 			FString EscapedValue = Value;
-			bool bNeedsQuotes = Value.Contains(TEXT(",")) || Value.Contains(TEXT("\""));
+			bool bNeedsQuotes = Value.Contains(TEXT(",")) || Value.Contains(TEXT("\"")) || Value.Contains(TEXT("\n")) || Value.Contains(TEXT("\r"));
 			
 			if (bNeedsQuotes)
 			{
@@ -585,11 +1379,11 @@ uint8* UExcelDataTableConverter::CreateRowFromStringValues(UScriptStruct* RowStr
 			void* PropertyAddr = Property->ContainerPtrToValuePtr<void>(RowData);
 			
 			// 使用Property的ImportText_Direct方法，注意参数类型
-			const TCHAR* ErrorText = Property->ImportText_Direct(*Values[ValueIndex], PropertyAddr, nullptr, PPF_None, nullptr);
-			if (ErrorText != nullptr)
+			const TCHAR* ImportEnd = Property->ImportText_Direct(*Values[ValueIndex], PropertyAddr, nullptr, PPF_None, nullptr);
+			if (ImportEnd == nullptr)
 			{
 				// 设置属性值失败
-				UE_LOG(LogTemp, Error, TEXT("导入失败: %s"), ErrorText);
+				UE_LOG(LogTemp, Error, TEXT("导入失败: 列 %s, 值 %s"), *Property->GetName(), *Values[ValueIndex]);
 				RowStruct->DestroyStruct(RowData);
 				FMemory::Free(RowData);
 				return nullptr;
@@ -1,6 +1,24 @@
 // Fill out your copyright notice in the Description page of Project Settings.
 
 #include "ExcelDataTable/ExcelDataTableSettings.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+
+namespace ExcelDataTableSettingsPrivate
+{
+	/** 哈希文件的标识和版本，格式变化时增加版本，旧文件直接忽略 */
+	constexpr uint32 ImportHashesMagic = 0x48544445; // "EDTH"
+	constexpr int32 ImportHashesVersion = 2;
+}
+
+FArchive& operator<<(FArchive& Ar, FExcelDataTableImportHashes& Hashes)
+{
+	Ar << Hashes.SourceHash;
+	Ar << Hashes.SchemaHash;
+	Ar << Hashes.ContentHash;
+	Ar << Hashes.RowHashes;
+	return Ar;
+}
 
 UExcelDataTableSettings::UExcelDataTableSettings()
 {
@@ -38,4 +56,146 @@ FExcelDataTableMapping* UExcelDataTableSettings::GetMappingForExcelFile(const FS
 		}
 	}
 	return nullptr;
-}
\ No newline at end of file
+}
+
+const FExcelDataTableImportHashes* UExcelDataTableSettings::FindImportHashes(const FSoftObjectPath& DataTablePath)
+{
+	LoadImportHashes();
+	return ImportHashes.Find(DataTablePath.ToString());
+}
+
+void UExcelDataTableSettings::SetImportHashes(const FSoftObjectPath& DataTablePath, FExcelDataTableImportHashes&& Hashes, bool bPackageSaved)
+{
+	LoadImportHashes();
+
+	// 未保存时哈希文件中保留上次保存时的哈希，与磁盘上的资源一致
+	const FString Key = DataTablePath.ToString();
+	if (bPackageSaved)
+	{
+		SavedImportHashes.Add(Key, Hashes);
+		bImportHashesDirty = true;
+	}
+	ImportHashes.Add(Key, MoveTemp(Hashes));
+}
+
+void UExcelDataTableSettings::RemoveImportHashes(const FSoftObjectPath& DataTablePath)
+{
+	LoadImportHashes();
+
+	const FString Key = DataTablePath.ToString();
+	ImportHashes.Remove(Key);
+	if (SavedImportHashes.Remove(Key) > 0)
+	{
+		bImportHashesDirty = true;
+	}
+}
+
+void UExcelDataTableSettings::SetImportContentHash(const FSoftObjectPath& DataTablePath, uint64 ContentHash)
+{
+	LoadImportHashes();
+
+	if (FExcelDataTableImportHashes* Hashes = ImportHashes.Find(DataTablePath.ToString()))
+	{
+		Hashes->ContentHash = ContentHash;
+	}
+}
+
+void UExcelDataTableSettings::CommitImportHashes(FName PackageName)
+{
+	LoadImportHashes();
+
+	bool bCommitted = false;
+	for (const TPair<FString, FExcelDataTableImportHashes>& Pair : ImportHashes)
+	{
+		if (FSoftObjectPath(Pair.Key).GetLongPackageFName() == PackageName)
+		{
+			SavedImportHashes.Add(Pair.Key, Pair.Value);
+			bCommitted = true;
+		}
+	}
+
+	// 立即写入，哈希文件与刚保存的资源保持一致
+	if (bCommitted)
+	{
+		bImportHashesDirty = true;
+		SaveImportHashes();
+	}
+}
+
+void UExcelDataTableSettings::SaveImportHashes()
+{
+	using namespace ExcelDataTableSettingsPrivate;
+
+	if (!bImportHashesDirty)
+	{
+		return;
+	}
+
+	// 先写入临时文件，避免写入中断后留下损坏的文件
+	const FString FilePath = GetImportHashesPath();
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	TUniquePtr<FArchive> Writer(IFileManager::Get().CreateFileWriter(*TempFilePath));
+	if (!Writer)
+	{
+		UE_LOG(LogTemp, Warning, TEXT("无法写入导入哈希文件: %s"), *TempFilePath);
+		return;
+	}
+
+	uint32 Magic = ImportHashesMagic;
+	int32 Version = ImportHashesVersion;
+	*Writer << Magic;
+	*Writer << Version;
+	*Writer << SavedImportHashes;
+
+	const bool bWriteSucceeded = Writer->Close();
+	Writer.Reset();
+
+	if (!bWriteSucceeded || !IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		UE_LOG(LogTemp, Warning, TEXT("无法写入导入哈希文件: %s"), *FilePath);
+		IFileManager::Get().Delete(*TempFilePath);
+		return;
+	}
+
+	bImportHashesDirty = false;
+}
+
+void UExcelDataTableSettings::LoadImportHashes()
+{
+	using namespace ExcelDataTableSettingsPrivate;
+
+	if (bImportHashesLoaded)
+	{
+		return;
+	}
+	bImportHashesLoaded = true;
+
+	TUniquePtr<FArchive> Reader(IFileManager::Get().CreateFileReader(*GetImportHashesPath()));
+	if (!Reader)
+	{
+		return;
+	}
+
+	uint32 Magic = 0;
+	int32 Version = 0;
+	*Reader << Magic;
+	*Reader << Version;
+	if (Magic != ImportHashesMagic || Version != ImportHashesVersion)
+	{
+		return;
+	}
+
+	*Reader << SavedImportHashes;
+	if (Reader->IsError())
+	{
+		// 文件损坏时当作没有导入过，所有映射都完整导入一次
+		UE_LOG(LogTemp, Warning, TEXT("导入哈希文件已损坏，将重新完整导入: %s"), *GetImportHashesPath());
+		SavedImportHashes.Reset();
+	}
+	ImportHashes = SavedImportHashes;
+}
+
+FString UExcelDataTableSettings::GetImportHashesPath()
+{
+	return FPaths::ProjectSavedDir() / TEXT("ExcelDataTable") / TEXT("ImportHashes.bin");
+}
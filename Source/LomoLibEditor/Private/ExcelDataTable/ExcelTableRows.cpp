@@ -0,0 +1,101 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/ExcelTableRows.h"
+#include "ExcelDataTable/XlsxReader.h"
+#include "Hash/CityHash.h"
+#include "HAL/PlatformFileManager.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Misc/ScopeExit.h"
+
+bool FExcelTableRows::Load(const FString& InFilePath, const FString& InSheetName, uint64 InUnchangedHash)
+{
+	SheetRows.Reset();
+	Cells.Reset();
+	RowOffsets.Reset();
+	RowOffsets.Add(0);
+	SourceHash = 0;
+	bUnchanged = false;
+	Error.Reset();
+
+	const double StartTime = FPlatformTime::Seconds();
+	ON_SCOPE_EXIT
+	{
+		LoadSeconds = FPlatformTime::Seconds() - StartTime;
+	};
+
+	// 检查文件是否存在
+	if (!FPlatformFileManager::Get().GetPlatformFile().FileExists(*InFilePath))
+	{
+		Error = FString::Printf(TEXT("Excel文件不存在: %s"), *InFilePath);
+		return false;
+	}
+
+	TArray<uint8> FileData;
+	if (!FFileHelper::LoadFileToArray(FileData, *InFilePath))
+	{
+		Error = FString::Printf(TEXT("无法读取文件: %s"), *InFilePath);
+		return false;
+	}
+
+	// 工作表名称也计入哈希，映射改为其他工作表时需要重新导入
+	SourceHash = CityHash64WithSeed(reinterpret_cast<const char*>(FileData.GetData()), FileData.Num(), GetTypeHash(InSheetName));
+	if (InUnchangedHash != 0 && SourceHash == InUnchangedHash)
+	{
+		bUnchanged = true;
+		return true;
+	}
+
+	// CSV逐行解析，XLSX由原生读取器解析，不经过Python
+	if (FPaths::GetExtension(InFilePath).Equals(TEXT("csv"), ESearchCase::IgnoreCase))
+	{
+		// BufferToString会识别UTF-8和UTF-16的BOM
+		FString Text;
+		FFileHelper::BufferToString(Text, FileData.GetData(), FileData.Num());
+		FileData.Empty();
+		CsvParser = FCsvParser(MoveTemp(Text));
+
+		TArray<FStringView> RowCells;
+		while (CsvParser.ReadRow(RowCells))
+		{
+			AddRow(RowCells);
+		}
+		return true;
+	}
+
+	FXlsxReader Reader;
+	FXlsxSheet Sheet;
+	if (!Reader.Open(MoveTemp(FileData)))
+	{
+		Error = FString::Printf(TEXT("无法读取Excel文件: %s"), *Reader.GetError());
+		return false;
+	}
+
+	// 默认的Sheet1不存在时使用第一个工作表，与之前通过Python转换的行为一致
+	const bool bUseFirstSheet = InSheetName.IsEmpty() || (InSheetName == TEXT("Sheet1") && !Reader.GetSheetNames().Contains(InSheetName));
+	if (!Reader.ReadSheet(bUseFirstSheet ? FString() : InSheetName, Sheet))
+	{
+		Error = FString::Printf(TEXT("无法读取工作表: %s"), *Reader.GetError());
+		return false;
+	}
+
+	Sheet.ToStringRows(SheetRows);
+
+	TArray<FStringView> RowCells;
+	for (const TArray<FString>& Row : SheetRows)
+	{
+		RowCells.Reset();
+		for (const FString& Value : Row)
+		{
+			RowCells.Emplace(*Value, Value.Len());
+		}
+		AddRow(RowCells);
+	}
+	return true;
+}
+
+void FExcelTableRows::AddRow(TConstArrayView<FStringView> InCells)
+{
+	Cells.Append(InCells.GetData(), InCells.Num());
+	RowOffsets.Add(Cells.Num());
+}
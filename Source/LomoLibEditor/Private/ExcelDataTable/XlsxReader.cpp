@@ -0,0 +1,946 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/XlsxReader.h"
+#include "Misc/Compression.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+namespace XlsxReaderPrivate
+{
+	constexpr uint32 LocalHeaderSignature = 0x04034b50;
+	constexpr uint32 CentralHeaderSignature = 0x02014b50;
+	constexpr uint32 EndOfCentralDirectorySignature = 0x06054b50;
+
+	/** Excel工作表的行数和列数上限（XFD1048576） */
+	constexpr int32 MaxRows = 1048576;
+	constexpr int32 MaxColumns = 16384;
+
+	uint16 ReadU16(const uint8* InData)
+	{
+		return static_cast<uint16>(InData[0] | (InData[1] << 8));
+	}
+
+	uint32 ReadU32(const uint8* InData)
+	{
+		return static_cast<uint32>(InData[0]) | (static_cast<uint32>(InData[1]) << 8) | (static_cast<uint32>(InData[2]) << 16) | (static_cast<uint32>(InData[3]) << 24);
+	}
+
+	/** 标签名和属性名去掉命名空间前缀后比较 */
+	FAnsiStringView GetLocalName(FAnsiStringView InName)
+	{
+		int32 ColonIndex = INDEX_NONE;
+		if (InName.FindChar(':', ColonIndex))
+		{
+			return InName.RightChop(ColonIndex + 1);
+		}
+		return InName;
+	}
+
+	/** XML中的一个标签 */
+	struct FXmlTag
+	{
+		/** 去掉前缀的标签名 */
+		FAnsiStringView Name;
+		FAnsiStringView Attributes;
+		bool bClosing = false;
+		bool bSelfClosing = false;
+
+		bool Is(FAnsiStringView InName) const { return Name == InName; }
+		bool IsOpening() const { return !bClosing && !bSelfClosing; }
+	};
+
+	/** 顺序扫描XML的标签，跳过声明和注释，不处理DTD */
+	class FXmlScanner
+	{
+	public:
+		explicit FXmlScanner(TConstArrayView<uint8> InXml)
+			: Xml(InXml)
+		{
+		}
+
+		/** 读取下一个标签，之后GetText返回上一个标签与这个标签之间的原始文本 */
+		bool Next(FXmlTag& OutTag)
+		{
+			const int32 Num = Xml.Num();
+			const uint8* Data = Xml.GetData();
+
+			while (Pos < Num)
+			{
+				TextStart = Pos;
+				while (Pos < Num && Data[Pos] != '<')
+				{
+					++Pos;
+				}
+				TextEnd = Pos;
+				if (Pos >= Num)
+				{
+					return false;
+				}
+
+				++Pos;
+				if (Pos < Num && (Data[Pos] == '?' || Data[Pos] == '!'))
+				{
+					// 声明、注释和DOCTYPE
+					const bool bComment = Pos + 2 < Num && Data[Pos + 1] == '-' && Data[Pos + 2] == '-';
+					while (Pos < Num)
+					{
+						if (Data[Pos] == '>' && (!bComment || (Data[Pos - 1] == '-' && Data[Pos - 2] == '-')))
+						{
+							break;
+						}
+						++Pos;
+					}
+					++Pos;
+					continue;
+				}
+
+				OutTag.bClosing = Pos < Num && Data[Pos] == '/';
+				if (OutTag.bClosing)
+				{
+					++Pos;
+				}
+
+				const int32 NameStart = Pos;
+				while (Pos < Num && Data[Pos] != '>' && Data[Pos] != '/' && Data[Pos] != ' ' && Data[Pos] != '\t' && Data[Pos] != '\r' && Data[Pos] != '\n')
+				{
+					++Pos;
+				}
+				OutTag.Name = GetLocalName(MakeView(NameStart, Pos));
+
+				// 属性值中可能有'>'，跳过引号
+				const int32 AttributesStart = Pos;
+				uint8 Quote = 0;
+				while (Pos < Num && (Quote != 0 || Data[Pos] != '>'))
+				{
+					if (Quote != 0)
+					{
+						Quote = Data[Pos] == Quote ? 0 : Quote;
+					}
+					else if (Data[Pos] == '"' || Data[Pos] == '\'')
+					{
+						Quote = Data[Pos];
+					}
+					++Pos;
+				}
+				if (Pos >= Num)
+				{
+					return false;
+				}
+
+				OutTag.bSelfClosing = Data[Pos - 1] == '/';
+				OutTag.Attributes = MakeView(AttributesStart, OutTag.bSelfClosing ? Pos - 1 : Pos);
+				++Pos;
+				return true;
+			}
+			return false;
+		}
+
+		const uint8* GetTextBegin() const { return Xml.GetData() + TextStart; }
+		const uint8* GetTextEnd() const { return Xml.GetData() + TextEnd; }
+
+	private:
+		FAnsiStringView MakeView(int32 InStart, int32 InEnd) const
+		{
+			return FAnsiStringView(reinterpret_cast<const ANSICHAR*>(Xml.GetData() + InStart), InEnd - InStart);
+		}
+
+		TConstArrayView<uint8> Xml;
+		int32 Pos = 0;
+		int32 TextStart = 0;
+		int32 TextEnd = 0;
+	};
+
+	/** 按去掉前缀的属性名查找属性值，值中的实体没有解码 */
+	bool FindAttribute(FAnsiStringView InAttributes, FAnsiStringView InName, FAnsiStringView& OutValue)
+	{
+		const ANSICHAR* Data = InAttributes.GetData();
+		const int32 Num = InAttributes.Len();
+		int32 Pos = 0;
+
+		while (Pos < Num)
+		{
+			while (Pos < Num && (Data[Pos] == ' ' || Data[Pos] == '\t' || Data[Pos] == '\r' || Data[Pos] == '\n'))
+			{
+				++Pos;
+			}
+
+			const int32 NameStart = Pos;
+			while (Pos < Num && Data[Pos] != '=' && Data[Pos] != ' ')
+			{
+				++Pos;
+			}
+			const FAnsiStringView Name = GetLocalName(FAnsiStringView(Data + NameStart, Pos - NameStart));
+
+			while (Pos < Num && Data[Pos] != '"' && Data[Pos] != '\'')
+			{
+				++Pos;
+			}
+			if (Pos >= Num)
+			{
+				return false;
+			}
+
+			const ANSICHAR Quote = Data[Pos++];
+			const int32 ValueStart = Pos;
+			while (Pos < Num && Data[Pos] != Quote)
+			{
+				++Pos;
+			}
+
+			if (Name == InName)
+			{
+				OutValue = FAnsiStringView(Data + ValueStart, Pos - ValueStart);
+				return true;
+			}
+			++Pos;
+		}
+		return false;
+	}
+
+	void AppendUtf8CodePoint(uint32 InCodePoint, TArray<uint8>& OutUtf8)
+	{
+		if (InCodePoint < 0x80)
+		{
+			OutUtf8.Add(static_cast<uint8>(InCodePoint));
+		}
+		else if (InCodePoint < 0x800)
+		{
+			OutUtf8.Add(static_cast<uint8>(0xC0 | (InCodePoint >> 6)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | (InCodePoint & 0x3F)));
+		}
+		else if (InCodePoint < 0x10000)
+		{
+			OutUtf8.Add(static_cast<uint8>(0xE0 | (InCodePoint >> 12)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | ((InCodePoint >> 6) & 0x3F)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | (InCodePoint & 0x3F)));
+		}
+		else
+		{
+			OutUtf8.Add(static_cast<uint8>(0xF0 | (InCodePoint >> 18)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | ((InCodePoint >> 12) & 0x3F)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | ((InCodePoint >> 6) & 0x3F)));
+			OutUtf8.Add(static_cast<uint8>(0x80 | (InCodePoint & 0x3F)));
+		}
+	}
+
+	bool ParseHex(const uint8* InBegin, const uint8* InEnd, uint32& OutValue)
+	{
+		OutValue = 0;
+		if (InBegin == InEnd)
+		{
+			return false;
+		}
+		for (const uint8* Char = InBegin; Char != InEnd; ++Char)
+		{
+			if (!FChar::IsHexDigit(static_cast<TCHAR>(*Char)))
+			{
+				return false;
+			}
+			OutValue = OutValue * 16 + FParse::HexDigit(static_cast<TCHAR>(*Char));
+		}
+		return true;
+	}
+
+	/** 解码XML文本中的实体和OOXML的_xHHHH_转义，追加UTF-8到OutUtf8 */
+	void DecodeText(const uint8* InBegin, const uint8* InEnd, TArray<uint8>& OutUtf8)
+	{
+		const uint8* Char = InBegin;
+		while (Char < InEnd)
+		{
+			if (*Char == '&')
+			{
+				const uint8* Semicolon = Char + 1;
+				while (Semicolon < InEnd && *Semicolon != ';' && Semicolon - Char < 12)
+				{
+					++Semicolon;
+				}
+
+				const FAnsiStringView Entity(reinterpret_cast<const ANSICHAR*>(Char + 1), static_cast<int32>(Semicolon - Char - 1));
+				uint32 CodePoint = 0;
+				bool bDecoded = Semicolon < InEnd && *Semicolon == ';';
+				if (bDecoded)
+				{
+					if (Entity == "lt") { CodePoint = '<'; }
+					else if (Entity == "gt") { CodePoint = '>'; }
+					else if (Entity == "amp") { CodePoint = '&'; }
+					else if (Entity == "quot") { CodePoint = '"'; }
+					else if (Entity == "apos") { CodePoint = '\''; }
+					else if (Entity.Len() > 2 && Entity[0] == '#' && (Entity[1] == 'x' || Entity[1] == 'X'))
+					{
+						bDecoded = ParseHex(Char + 3, Semicolon, CodePoint);
+					}
+					else if (Entity.Len() > 1 && Entity[0] == '#')
+					{
+						for (int32 Index = 1; Index < Entity.Len() && bDecoded; ++Index)
+						{
+							bDecoded = FCharAnsi::IsDigit(Entity[Index]);
+							CodePoint = CodePoint * 10 + (Entity[Index] - '0');
+						}
+					}
+					else
+					{
+						bDecoded = false;
+					}
+				}
+
+				if (bDecoded)
+				{
+					AppendUtf8CodePoint(CodePoint, OutUtf8);
+					Char = Semicolon + 1;
+					continue;
+				}
+			}
+			else if (*Char == '_' && InEnd - Char >= 7 && Char[1] == 'x' && Char[6] == '_')
+			{
+				// Excel用_xHHHH_保存控制字符
+				uint32 CodePoint = 0;
+				if (ParseHex(Char + 2, Char + 6, CodePoint))
+				{
+					AppendUtf8CodePoint(CodePoint, OutUtf8);
+					Char += 7;
+					continue;
+				}
+			}
+
+			OutUtf8.Add(*Char);
+			++Char;
+		}
+	}
+
+	FString Utf8ToString(const TArray<uint8>& InUtf8)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(InUtf8.GetData()), InUtf8.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+
+	FString DecodeAttribute(FAnsiStringView InValue)
+	{
+		TArray<uint8> Utf8;
+		const uint8* Begin = reinterpret_cast<const uint8*>(InValue.GetData());
+		DecodeText(Begin, Begin + InValue.Len(), Utf8);
+		return Utf8ToString(Utf8);
+	}
+
+	/** 单元格引用如"AB12"，返回列的下标，超过MaxColumns时返回MaxColumns */
+	int32 ParseColumnIndex(FAnsiStringView InReference)
+	{
+		int32 Column = 0;
+		for (const ANSICHAR Char : InReference)
+		{
+			if (Column > MaxColumns)
+			{
+				return MaxColumns;
+			}
+
+			if (Char >= 'A' && Char <= 'Z')
+			{
+				Column = Column * 26 + (Char - 'A' + 1);
+			}
+			else if (Char >= 'a' && Char <= 'z')
+			{
+				Column = Column * 26 + (Char - 'a' + 1);
+			}
+			else
+			{
+				break;
+			}
+		}
+		return Column - 1;
+	}
+
+	/** 解析非负整数，超出int32时返回MAX_int32 */
+	int32 ParseInteger(FAnsiStringView InText)
+	{
+		int64 Value = 0;
+		for (const ANSICHAR Char : InText)
+		{
+			if (!FCharAnsi::IsDigit(Char))
+			{
+				break;
+			}
+			Value = Value * 10 + (Char - '0');
+			if (Value > MAX_int32)
+			{
+				return MAX_int32;
+			}
+		}
+		return static_cast<int32>(Value);
+	}
+
+	double ParseDouble(const uint8* InBegin, const uint8* InEnd)
+	{
+		ANSICHAR Digits[64];
+		const int32 Length = FMath::Min(static_cast<int32>(InEnd - InBegin), static_cast<int32>(UE_ARRAY_COUNT(Digits)) - 1);
+		FMemory::Memcpy(Digits, InBegin, Length);
+		Digits[Length] = 0;
+		return FCStringAnsi::Atod(Digits);
+	}
+
+	/** 相对于所在目录的路径，以'/'开头时相对于包的根目录 */
+	FString ResolvePartPath(const FString& InBaseDirectory, FAnsiStringView InTarget)
+	{
+		FString Target = DecodeAttribute(InTarget);
+		FString Path = Target.StartsWith(TEXT("/")) ? Target.RightChop(1) : InBaseDirectory / Target;
+		FPaths::CollapseRelativeDirectories(Path);
+		return Path;
+	}
+}
+
+const FXlsxCell* FXlsxSheet::GetCell(int32 InRow, int32 InColumn) const
+{
+	if (!Rows.IsValidIndex(InRow) || !Rows[InRow].IsValidIndex(InColumn))
+	{
+		return nullptr;
+	}
+	return &Rows[InRow][InColumn];
+}
+
+const FString* FXlsxSheet::FindString(int32 InStringIndex) const
+{
+	const int32 NumSharedStrings = SharedStrings ? SharedStrings->Num() : 0;
+	if (InStringIndex < 0)
+	{
+		return nullptr;
+	}
+	if (InStringIndex < NumSharedStrings)
+	{
+		return &(*SharedStrings)[InStringIndex];
+	}
+	return Strings.IsValidIndex(InStringIndex - NumSharedStrings) ? &Strings[InStringIndex - NumSharedStrings] : nullptr;
+}
+
+void FXlsxSheet::AppendCellText(const FXlsxCell& InCell, FString& OutText) const
+{
+	switch (InCell.Type)
+	{
+	case EXlsxCellType::Number:
+		AppendNumberText(InCell.Number, OutText);
+		break;
+
+	case EXlsxCellType::Bool:
+		OutText += InCell.Number != 0.0 ? TEXT("True") : TEXT("False");
+		break;
+
+	case EXlsxCellType::String:
+	case EXlsxCellType::Error:
+		if (const FString* String = FindString(InCell.StringIndex))
+		{
+			OutText += *String;
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+FString FXlsxSheet::GetCellText(int32 InRow, int32 InColumn) const
+{
+	FString Text;
+	if (const FXlsxCell* Cell = GetCell(InRow, InColumn))
+	{
+		AppendCellText(*Cell, Text);
+	}
+	return Text;
+}
+
+void FXlsxSheet::AppendNumberText(double InNumber, FString& OutText)
+{
+	if (InNumber == FMath::RoundToDouble(InNumber) && FMath::Abs(InNumber) < 1e15)
+	{
+		OutText.Appendf(TEXT("%lld"), static_cast<int64>(InNumber));
+		return;
+	}
+
+	// 使用能还原原值的最短表示，避免0.1显示为0.10000000000000001
+	FString Text = FString::Printf(TEXT("%.15g"), InNumber);
+	if (FCString::Atod(*Text) != InNumber)
+	{
+		Text = FString::Printf(TEXT("%.17g"), InNumber);
+	}
+	OutText += Text;
+}
+
+void FXlsxSheet::ToStringRows(TArray<TArray<FString>>& OutRows) const
+{
+	OutRows.Reset(Rows.Num());
+	for (const TArray<FXlsxCell>& Row : Rows)
+	{
+		TArray<FString>& OutRow = OutRows.AddDefaulted_GetRef();
+		OutRow.SetNum(Row.Num());
+		for (int32 Column = 0; Column < Row.Num(); ++Column)
+		{
+			AppendCellText(Row[Column], OutRow[Column]);
+		}
+	}
+}
+
+bool FXlsxReader::Open(const FString& InFilePath)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *InFilePath))
+	{
+		Error = FString::Printf(TEXT("无法读取文件: %s"), *InFilePath);
+		return false;
+	}
+
+	return Open(MoveTemp(Data));
+}
+
+bool FXlsxReader::Open(TArray<uint8>&& InFileData)
+{
+	Error.Reset();
+	FileData = MoveTemp(InFileData);
+	Entries.Reset();
+	Sheets.Reset();
+	SharedStrings = MakeShared<TArray<FString>>();
+	SharedStringsPath = TEXT("xl/sharedStrings.xml");
+
+	return ReadCentralDirectory() && ReadWorkbook() && ReadSharedStrings();
+}
+
+TArray<FString> FXlsxReader::GetSheetNames() const
+{
+	TArray<FString> Names;
+	for (const FSheetInfo& Sheet : Sheets)
+	{
+		Names.Add(Sheet.Name);
+	}
+	return Names;
+}
+
+bool FXlsxReader::ReadSheet(const FString& InSheetName, FXlsxSheet& OutSheet)
+{
+	const FSheetInfo* Sheet = Sheets.Num() > 0 && InSheetName.IsEmpty() ? &Sheets[0] : Sheets.FindByPredicate([&InSheetName](const FSheetInfo& InSheet)
+	{
+		return InSheet.Name.Equals(InSheetName, ESearchCase::IgnoreCase);
+	});
+
+	if (!Sheet)
+	{
+		return SetError(FString::Printf(TEXT("找不到工作表: %s，文件中的工作表: %s"), *InSheetName, *FString::Join(GetSheetNames(), TEXT(", "))));
+	}
+
+	TArray<uint8> Xml;
+	if (!ExtractEntry(Sheet->Path, Xml))
+	{
+		return Error.IsEmpty() ? SetError(FString::Printf(TEXT("找不到工作表的数据: %s"), *Sheet->Path)) : false;
+	}
+
+	OutSheet = FXlsxSheet();
+	OutSheet.Name = Sheet->Name;
+	OutSheet.SharedStrings = SharedStrings;
+	return ParseSheet(Xml, OutSheet);
+}
+
+bool FXlsxReader::ReadSheet(const FString& InFilePath, const FString& InSheetName, FXlsxSheet& OutSheet, FString* OutError)
+{
+	FXlsxReader Reader;
+	if (Reader.Open(InFilePath) && Reader.ReadSheet(InSheetName, OutSheet))
+	{
+		return true;
+	}
+
+	if (OutError)
+	{
+		*OutError = Reader.GetError();
+	}
+	return false;
+}
+
+bool FXlsxReader::ReadCentralDirectory()
+{
+	using namespace XlsxReaderPrivate;
+
+	const uint8* Data = FileData.GetData();
+	const int64 Num = FileData.Num();
+
+	// 中央目录结束记录在文件末尾，之后最多有65535字节的注释
+	int64 EndRecord = INDEX_NONE;
+	for (int64 Pos = Num - 22; Pos >= 0 && Pos >= Num - 22 - 65535; --Pos)
+	{
+		if (ReadU32(Data + Pos) == EndOfCentralDirectorySignature)
+		{
+			EndRecord = Pos;
+			break;
+		}
+	}
+
+	if (EndRecord == INDEX_NONE)
+	{
+		return SetError(TEXT("不是有效的XLSX文件（不支持旧的.xls格式）"));
+	}
+
+	const int32 NumEntries = ReadU16(Data + EndRecord + 10);
+	const uint32 DirectoryOffset = ReadU32(Data + EndRecord + 16);
+	if (DirectoryOffset == 0xFFFFFFFF || NumEntries == 0xFFFF)
+	{
+		return SetError(TEXT("不支持ZIP64格式的XLSX文件"));
+	}
+
+	int64 Pos = DirectoryOffset;
+	for (int32 Index = 0; Index < NumEntries; ++Index)
+	{
+		if (Pos + 46 > Num || ReadU32(Data + Pos) != CentralHeaderSignature)
+		{
+			return SetError(TEXT("XLSX文件的目录已损坏"));
+		}
+
+		const uint16 Flags = ReadU16(Data + Pos + 8);
+		const int32 NameLength = ReadU16(Data + Pos + 28);
+		const int32 ExtraLength = ReadU16(Data + Pos + 30);
+		const int32 CommentLength = ReadU16(Data + Pos + 32);
+		if (Pos + 46 + NameLength > Num)
+		{
+			return SetError(TEXT("XLSX文件的目录已损坏"));
+		}
+
+		if (Flags & 0x1)
+		{
+			return SetError(TEXT("不支持加密的XLSX文件"));
+		}
+
+		FZipEntry Entry;
+		Entry.Method = ReadU16(Data + Pos + 10);
+		Entry.CompressedSize = ReadU32(Data + Pos + 20);
+		Entry.UncompressedSize = ReadU32(Data + Pos + 24);
+		Entry.LocalHeaderOffset = ReadU32(Data + Pos + 42);
+
+		const FUTF8ToTCHAR Name(reinterpret_cast<const ANSICHAR*>(Data + Pos + 46), NameLength);
+		Entries.Add(FString(Name.Length(), Name.Get()), Entry);
+
+		Pos += 46 + NameLength + ExtraLength + CommentLength;
+	}
+
+	return true;
+}
+
+bool FXlsxReader::ExtractEntry(const FString& InPath, TArray<uint8>& OutData)
+{
+	using namespace XlsxReaderPrivate;
+
+	const FZipEntry* Entry = Entries.Find(InPath);
+	if (!Entry)
+	{
+		return false;
+	}
+
+	const uint8* Data = FileData.GetData();
+	const int64 Num = FileData.Num();
+	const int64 HeaderOffset = Entry->LocalHeaderOffset;
+	if (HeaderOffset + 30 > Num || ReadU32(Data + HeaderOffset) != LocalHeaderSignature)
+	{
+		return SetError(FString::Printf(TEXT("XLSX文件中的条目已损坏: %s"), *InPath));
+	}
+
+	// 本地头中的大小可能为0（数据描述符），大小以中央目录为准
+	const int64 DataOffset = HeaderOffset + 30 + ReadU16(Data + HeaderOffset + 26) + ReadU16(Data + HeaderOffset + 28);
+	if (DataOffset + Entry->CompressedSize > Num || Entry->UncompressedSize > MAX_int32)
+	{
+		return SetError(FString::Printf(TEXT("XLSX文件中的条目已损坏: %s"), *InPath));
+	}
+
+	OutData.SetNumUninitialized(static_cast<int32>(Entry->UncompressedSize));
+
+	if (Entry->Method == 0)
+	{
+		FMemory::Memcpy(OutData.GetData(), Data + DataOffset, Entry->UncompressedSize);
+		return true;
+	}
+
+	if (Entry->Method == 8)
+	{
+		// 负的窗口大小表示不带zlib头的原始deflate数据
+		if (FCompression::UncompressMemory(NAME_Zlib, OutData.GetData(), OutData.Num(), Data + DataOffset, static_cast<int32>(Entry->CompressedSize), COMPRESS_NoFlags, -DEFAULT_ZLIB_BIT_WINDOW))
+		{
+			return true;
+		}
+		return SetError(FString::Printf(TEXT("解压失败: %s"), *InPath));
+	}
+
+	return SetError(FString::Printf(TEXT("不支持的压缩方式%d: %s"), Entry->Method, *InPath));
+}
+
+bool FXlsxReader::ReadWorkbook()
+{
+	using namespace XlsxReaderPrivate;
+
+	// 包的关系中记录工作簿的位置
+	FString WorkbookPath = TEXT("xl/workbook.xml");
+	TArray<uint8> Xml;
+	if (ExtractEntry(TEXT("_rels/.rels"), Xml))
+	{
+		FXmlScanner Scanner(Xml);
+		FXmlTag Tag;
+		FAnsiStringView Type;
+		FAnsiStringView Target;
+		while (Scanner.Next(Tag))
+		{
+			if (Tag.Is("Relationship") && FindAttribute(Tag.Attributes, "Type", Type) && Type.EndsWith("/officeDocument") && FindAttribute(Tag.Attributes, "Target", Target))
+			{
+				WorkbookPath = ResolvePartPath(FString(), Target);
+				break;
+			}
+		}
+	}
+
+	const FString WorkbookDirectory = FPaths::GetPath(WorkbookPath);
+	const FString RelationshipsPath = WorkbookDirectory / TEXT("_rels") / FPaths::GetCleanFilename(WorkbookPath) + TEXT(".rels");
+
+	// 关系Id到工作表路径
+	TMap<FString, FString> RelationshipTargets;
+	if (ExtractEntry(RelationshipsPath, Xml))
+	{
+		FXmlScanner Scanner(Xml);
+		FXmlTag Tag;
+		FAnsiStringView Id;
+		FAnsiStringView Type;
+		FAnsiStringView Target;
+		while (Scanner.Next(Tag))
+		{
+			if (!Tag.Is("Relationship") || !FindAttribute(Tag.Attributes, "Id", Id) || !FindAttribute(Tag.Attributes, "Target", Target))
+			{
+				continue;
+			}
+
+			const FString TargetPath = ResolvePartPath(WorkbookDirectory, Target);
+			if (FindAttribute(Tag.Attributes, "Type", Type) && Type.EndsWith("/sharedStrings"))
+			{
+				SharedStringsPath = TargetPath;
+			}
+			RelationshipTargets.Add(DecodeAttribute(Id), TargetPath);
+		}
+	}
+
+	if (!ExtractEntry(WorkbookPath, Xml))
+	{
+		return Error.IsEmpty() ? SetError(TEXT("XLSX文件中没有工作簿")) : false;
+	}
+
+	FXmlScanner Scanner(Xml);
+	FXmlTag Tag;
+	FAnsiStringView Name;
+	FAnsiStringView Id;
+	while (Scanner.Next(Tag))
+	{
+		if (!Tag.Is("sheet") || Tag.bClosing || !FindAttribute(Tag.Attributes, "name", Name) || !FindAttribute(Tag.Attributes, "id", Id))
+		{
+			continue;
+		}
+
+		if (const FString* Target = RelationshipTargets.Find(DecodeAttribute(Id)))
+		{
+			FSheetInfo& Sheet = Sheets.AddDefaulted_GetRef();
+			Sheet.Name = DecodeAttribute(Name);
+			Sheet.Path = *Target;
+		}
+	}
+
+	if (Sheets.Num() == 0)
+	{
+		return SetError(TEXT("XLSX文件中没有工作表"));
+	}
+	return true;
+}
+
+bool FXlsxReader::ReadSharedStrings()
+{
+	using namespace XlsxReaderPrivate;
+
+	// 只有数字的工作簿没有共享字符串
+	TArray<uint8> Xml;
+	if (!ExtractEntry(SharedStringsPath, Xml))
+	{
+		return Error.IsEmpty();
+	}
+
+	FXmlScanner Scanner(Xml);
+	FXmlTag Tag;
+	TArray<uint8> Utf8;
+	int32 PhoneticDepth = 0;
+
+	while (Scanner.Next(Tag))
+	{
+		if (Tag.Is("si"))
+		{
+			if (Tag.IsOpening())
+			{
+				Utf8.Reset();
+			}
+			else
+			{
+				SharedStrings->Add(Tag.bSelfClosing ? FString() : Utf8ToString(Utf8));
+			}
+		}
+		else if (Tag.Is("rPh"))
+		{
+			// 注音不属于文本
+			PhoneticDepth += Tag.IsOpening() ? 1 : Tag.bClosing ? -1 : 0;
+		}
+		else if (Tag.Is("t") && Tag.bClosing && PhoneticDepth == 0)
+		{
+			DecodeText(Scanner.GetTextBegin(), Scanner.GetTextEnd(), Utf8);
+		}
+		else if (Tag.Is("sst") && Tag.IsOpening())
+		{
+			FAnsiStringView UniqueCount;
+			if (FindAttribute(Tag.Attributes, "uniqueCount", UniqueCount))
+			{
+				SharedStrings->Reserve(ParseInteger(UniqueCount));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FXlsxReader::ParseSheet(TConstArrayView<uint8> InXml, FXlsxSheet& OutSheet)
+{
+	using namespace XlsxReaderPrivate;
+
+	enum class ECellKind : uint8
+	{
+		Number,
+		Shared,
+		Inline,
+		FormulaString,
+		Bool,
+		Error,
+	};
+
+	FXmlScanner Scanner(InXml);
+	FXmlTag Tag;
+	FAnsiStringView Attribute;
+	TArray<uint8> Utf8;
+
+	int32 RowIndex = INDEX_NONE;
+	int32 ColumnIndex = INDEX_NONE;
+	ECellKind CellKind = ECellKind::Number;
+	FXlsxCell Cell;
+	int32 PhoneticDepth = 0;
+	const int32 NumSharedStrings = OutSheet.SharedStrings ? OutSheet.SharedStrings->Num() : 0;
+
+	while (Scanner.Next(Tag))
+	{
+		if (Tag.Is("c"))
+		{
+			if (Tag.bClosing)
+			{
+				if (CellKind == ECellKind::Inline)
+				{
+					Cell.Type = EXlsxCellType::String;
+					Cell.StringIndex = NumSharedStrings + OutSheet.Strings.Add(Utf8ToString(Utf8));
+				}
+
+				// 只有带值的单元格才扩展行，只有格式的单元格不占空间
+				if (Cell.Type != EXlsxCellType::Empty && RowIndex >= 0 && ColumnIndex >= 0)
+				{
+					if (OutSheet.Rows.Num() <= RowIndex)
+					{
+						OutSheet.Rows.SetNum(RowIndex + 1);
+					}
+					TArray<FXlsxCell>& Row = OutSheet.Rows[RowIndex];
+					if (Row.Num() <= ColumnIndex)
+					{
+						Row.SetNum(ColumnIndex + 1);
+					}
+					Row[ColumnIndex] = Cell;
+					OutSheet.NumColumns = FMath::Max(OutSheet.NumColumns, ColumnIndex + 1);
+				}
+				continue;
+			}
+
+			ColumnIndex = FindAttribute(Tag.Attributes, "r", Attribute) ? ParseColumnIndex(Attribute) : ColumnIndex + 1;
+			if (ColumnIndex >= MaxColumns)
+			{
+				return SetError(FString::Printf(TEXT("工作表第%d行的单元格超出了Excel的列数上限%d"), RowIndex + 1, MaxColumns));
+			}
+			if (Tag.bSelfClosing)
+			{
+				continue;
+			}
+
+			CellKind = ECellKind::Number;
+			if (FindAttribute(Tag.Attributes, "t", Attribute))
+			{
+				CellKind = Attribute == "s" ? ECellKind::Shared
+					: Attribute == "inlineStr" ? ECellKind::Inline
+					: Attribute == "str" ? ECellKind::FormulaString
+					: Attribute == "b" ? ECellKind::Bool
+					: Attribute == "e" ? ECellKind::Error
+					: ECellKind::Number;
+			}
+			Cell = FXlsxCell();
+			Utf8.Reset();
+		}
+		else if (Tag.Is("v") && Tag.bClosing)
+		{
+			const uint8* TextBegin = Scanner.GetTextBegin();
+			const uint8* TextEnd = Scanner.GetTextEnd();
+			const FAnsiStringView Text(reinterpret_cast<const ANSICHAR*>(TextBegin), static_cast<int32>(TextEnd - TextBegin));
+
+			switch (CellKind)
+			{
+			case ECellKind::Shared:
+				Cell.Type = EXlsxCellType::String;
+				Cell.StringIndex = ParseInteger(Text);
+
+				// 超出共享字符串表的下标无效，不能指向工作表自身的字符串
+				if (Cell.StringIndex >= NumSharedStrings)
+				{
+					Cell.StringIndex = INDEX_NONE;
+				}
+				break;
+
+			case ECellKind::Bool:
+				Cell.Type = EXlsxCellType::Bool;
+				Cell.Number = Text == "1" ? 1.0 : 0.0;
+				break;
+
+			case ECellKind::FormulaString:
+			case ECellKind::Error:
+				Utf8.Reset();
+				DecodeText(TextBegin, TextEnd, Utf8);
+				Cell.Type = CellKind == ECellKind::Error ? EXlsxCellType::Error : EXlsxCellType::String;
+				Cell.StringIndex = NumSharedStrings + OutSheet.Strings.Add(Utf8ToString(Utf8));
+				break;
+
+			case ECellKind::Number:
+				if (TextBegin != TextEnd)
+				{
+					Cell.Type = EXlsxCellType::Number;
+					Cell.Number = ParseDouble(TextBegin, TextEnd);
+				}
+				break;
+
+			default:
+				break;
+			}
+		}
+		else if (Tag.Is("t") && Tag.bClosing && CellKind == ECellKind::Inline && PhoneticDepth == 0)
+		{
+			DecodeText(Scanner.GetTextBegin(), Scanner.GetTextEnd(), Utf8);
+		}
+		else if (Tag.Is("rPh"))
+		{
+			PhoneticDepth += Tag.IsOpening() ? 1 : Tag.bClosing ? -1 : 0;
+		}
+		else if (Tag.Is("row") && !Tag.bClosing)
+		{
+			RowIndex = FindAttribute(Tag.Attributes, "r", Attribute) ? ParseInteger(Attribute) - 1 : RowIndex + 1;
+			ColumnIndex = INDEX_NONE;
+			if (RowIndex >= MaxRows)
+			{
+				return SetError(FString::Printf(TEXT("工作表的行号%d超出了Excel的行数上限%d"), RowIndex + 1, MaxRows));
+			}
+		}
+	}
+
+	return true;
+}
+
+bool FXlsxReader::SetError(const FString& InMessage)
+{
+	Error = InMessage;
+	return false;
+}
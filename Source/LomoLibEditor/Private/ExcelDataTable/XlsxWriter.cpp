@@ -0,0 +1,486 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "ExcelDataTable/XlsxWriter.h"
+#include "ExcelDataTable/XlsxReader.h"
+#include "HAL/FileManager.h"
+#include "Misc/Paths.h"
+#include "zlib.h"
+
+namespace XlsxWriterPrivate
+{
+	constexpr int32 XmlFlushSize = 64 * 1024;
+	constexpr int32 DeflateBufferSize = 64 * 1024;
+
+	/** 数据描述符和UTF-8文件名 */
+	constexpr uint16 EntryFlags = 0x0008 | 0x0800;
+	constexpr uint16 MethodDeflate = 8;
+	constexpr uint16 ZipVersion = 20;
+
+	void AppendAnsi(TArray<uint8>& OutData, FAnsiStringView InText)
+	{
+		OutData.Append(reinterpret_cast<const uint8*>(InText.GetData()), InText.Len());
+	}
+
+	void AppendU16(TArray<uint8>& OutData, uint16 InValue)
+	{
+		OutData.Add(static_cast<uint8>(InValue));
+		OutData.Add(static_cast<uint8>(InValue >> 8));
+	}
+
+	void AppendU32(TArray<uint8>& OutData, uint32 InValue)
+	{
+		AppendU16(OutData, static_cast<uint16>(InValue));
+		AppendU16(OutData, static_cast<uint16>(InValue >> 16));
+	}
+
+	bool IsHexDigit(uint8 InChar)
+	{
+		return (InChar >= '0' && InChar <= '9') || (InChar >= 'a' && InChar <= 'f') || (InChar >= 'A' && InChar <= 'F');
+	}
+
+	/**
+	 * 转义XML文本，控制字符写为OOXML的_xHHHH_
+	 * 原文中形如_xHHHH_的文本把'_'写为_x005F_，读取时还原
+	 */
+	void AppendEscaped(TArray<uint8>& OutData, FStringView InText, bool bAttribute)
+	{
+		const FTCHARToUTF8 Utf8(InText.GetData(), InText.Len());
+		const uint8* Data = reinterpret_cast<const uint8*>(Utf8.Get());
+		const int32 Num = Utf8.Length();
+
+		for (int32 Index = 0; Index < Num; ++Index)
+		{
+			const uint8 Char = Data[Index];
+			switch (Char)
+			{
+			case '&': AppendAnsi(OutData, "&amp;"); break;
+			case '<': AppendAnsi(OutData, "&lt;"); break;
+			case '>': AppendAnsi(OutData, "&gt;"); break;
+			case '"':
+				if (bAttribute)
+				{
+					AppendAnsi(OutData, "&quot;");
+				}
+				else
+				{
+					OutData.Add(Char);
+				}
+				break;
+
+			case '_':
+				if (Index + 6 < Num && Data[Index + 1] == 'x' && Data[Index + 6] == '_'
+					&& IsHexDigit(Data[Index + 2]) && IsHexDigit(Data[Index + 3]) && IsHexDigit(Data[Index + 4]) && IsHexDigit(Data[Index + 5]))
+				{
+					AppendAnsi(OutData, "_x005F_");
+				}
+				else
+				{
+					OutData.Add(Char);
+				}
+				break;
+
+			default:
+				if (Char < 0x20 && Char != '\t' && Char != '\n' && Char != '\r')
+				{
+					const FString Escaped = FString::Printf(TEXT("_x%04X_"), Char);
+					AppendAnsi(OutData, TCHAR_TO_ANSI(*Escaped));
+				}
+				else
+				{
+					OutData.Add(Char);
+				}
+				break;
+			}
+		}
+	}
+
+	/** Excel的工作表名称最多31个字符，不能包含[]:*?/\ */
+	FString SanitizeSheetName(const FString& InSheetName)
+	{
+		FString SheetName = InSheetName.Left(31);
+		for (TCHAR& Char : SheetName)
+		{
+			if (FCString::Strchr(TEXT("[]:*?/\\"), Char))
+			{
+				Char = TEXT('_');
+			}
+		}
+		return SheetName.IsEmpty() ? FString(TEXT("Sheet1")) : SheetName;
+	}
+
+	void GetDosDateTime(uint16& OutTime, uint16& OutDate)
+	{
+		const FDateTime Now = FDateTime::Now();
+		OutTime = static_cast<uint16>((Now.GetHour() << 11) | (Now.GetMinute() << 5) | (Now.GetSecond() / 2));
+		OutDate = static_cast<uint16>(((Now.GetYear() - 1980) << 9) | (Now.GetMonth() << 5) | Now.GetDay());
+	}
+}
+
+FXlsxWriter::FXlsxWriter()
+{
+}
+
+FXlsxWriter::~FXlsxWriter()
+{
+	if (File.IsValid())
+	{
+		Abort(TEXT("写入未完成"));
+	}
+}
+
+bool FXlsxWriter::Open(const FString& InFilePath, const FString& InSheetName)
+{
+	using namespace XlsxWriterPrivate;
+
+	check(!File.IsValid());
+
+	FilePath = InFilePath;
+	TempFilePath = InFilePath + TEXT(".tmp");
+	SheetName = SanitizeSheetName(InSheetName);
+	Records.Reset();
+	NumRows = 0;
+	Error.Reset();
+
+	File.Reset(IFileManager::Get().CreateFileWriter(*TempFilePath));
+	if (!File.IsValid())
+	{
+		Error = FString::Printf(TEXT("无法创建文件: %s"), *TempFilePath);
+		return false;
+	}
+
+	XmlBuffer.Reset(XmlFlushSize + 4096);
+	DeflateBuffer.SetNumUninitialized(DeflateBufferSize);
+
+	BeginEntry(TEXT("xl/worksheets/sheet1.xml"));
+	AppendAnsi(XmlBuffer, "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<worksheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\"><sheetData>");
+	return true;
+}
+
+void FXlsxWriter::BeginRow()
+{
+	using namespace XlsxWriterPrivate;
+
+	check(File.IsValid() && !bInRow);
+
+	bInRow = true;
+	ColumnIndex = 0;
+	++NumRows;
+
+	AppendAnsi(XmlBuffer, "<row r=\"");
+	AppendAnsi(XmlBuffer, TCHAR_TO_ANSI(*LexToString(NumRows)));
+	AppendAnsi(XmlBuffer, "\">");
+}
+
+void FXlsxWriter::AddString(FStringView InValue)
+{
+	using namespace XlsxWriterPrivate;
+
+	check(bInRow);
+
+	if (InValue.IsEmpty())
+	{
+		AddEmpty();
+		return;
+	}
+
+	AppendAnsi(XmlBuffer, "<c r=\"");
+	AppendCellReference();
+	AppendAnsi(XmlBuffer, "\" t=\"inlineStr\"><is><t xml:space=\"preserve\">");
+	AppendEscaped(XmlBuffer, InValue, false);
+	AppendAnsi(XmlBuffer, "</t></is></c>");
+	++ColumnIndex;
+}
+
+void FXlsxWriter::AddNumber(double InValue)
+{
+	using namespace XlsxWriterPrivate;
+
+	check(bInRow);
+
+	// Excel不能保存NaN和无穷大
+	if (!FMath::IsFinite(InValue))
+	{
+		AddString(LexToString(InValue));
+		return;
+	}
+
+	FString Text;
+	FXlsxSheet::AppendNumberText(InValue, Text);
+
+	AppendAnsi(XmlBuffer, "<c r=\"");
+	AppendCellReference();
+	AppendAnsi(XmlBuffer, "\"><v>");
+	AppendAnsi(XmlBuffer, TCHAR_TO_ANSI(*Text));
+	AppendAnsi(XmlBuffer, "</v></c>");
+	++ColumnIndex;
+}
+
+void FXlsxWriter::AddEmpty()
+{
+	check(bInRow);
+	++ColumnIndex;
+}
+
+void FXlsxWriter::EndRow()
+{
+	using namespace XlsxWriterPrivate;
+
+	check(bInRow);
+
+	bInRow = false;
+	AppendAnsi(XmlBuffer, "</row>");
+
+	if (XmlBuffer.Num() >= XmlFlushSize)
+	{
+		FlushXml();
+	}
+}
+
+bool FXlsxWriter::Close()
+{
+	using namespace XlsxWriterPrivate;
+
+	if (!File.IsValid())
+	{
+		return false;
+	}
+
+	check(!bInRow);
+
+	AppendAnsi(XmlBuffer, "</sheetData></worksheet>");
+	FlushXml();
+	EndEntry();
+
+	WriteEntry(TEXT("[Content_Types].xml"), TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<Types xmlns=\"http://schemas.openxmlformats.org/package/2006/content-types\">"
+		"<Default Extension=\"rels\" ContentType=\"application/vnd.openxmlformats-package.relationships+xml\"/>"
+		"<Default Extension=\"xml\" ContentType=\"application/xml\"/>"
+		"<Override PartName=\"/xl/workbook.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.sheet.main+xml\"/>"
+		"<Override PartName=\"/xl/worksheets/sheet1.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.worksheet+xml\"/>"
+		"<Override PartName=\"/xl/styles.xml\" ContentType=\"application/vnd.openxmlformats-officedocument.spreadsheetml.styles+xml\"/>"
+		"</Types>"));
+
+	WriteEntry(TEXT("_rels/.rels"), TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+		"<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/officeDocument\" Target=\"xl/workbook.xml\"/>"
+		"</Relationships>"));
+
+	TArray<uint8> EscapedSheetName;
+	AppendEscaped(EscapedSheetName, SheetName, true);
+	const FUTF8ToTCHAR SheetNameText(reinterpret_cast<const ANSICHAR*>(EscapedSheetName.GetData()), EscapedSheetName.Num());
+
+	WriteEntry(TEXT("xl/workbook.xml"), FString(TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<workbook xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\" xmlns:r=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships\">"
+		"<sheets><sheet name=\"")) + FString(SheetNameText.Length(), SheetNameText.Get()) + TEXT("\" sheetId=\"1\" r:id=\"rId1\"/></sheets></workbook>"));
+
+	WriteEntry(TEXT("xl/_rels/workbook.xml.rels"), TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<Relationships xmlns=\"http://schemas.openxmlformats.org/package/2006/relationships\">"
+		"<Relationship Id=\"rId1\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/worksheet\" Target=\"worksheets/sheet1.xml\"/>"
+		"<Relationship Id=\"rId2\" Type=\"http://schemas.openxmlformats.org/officeDocument/2006/relationships/styles\" Target=\"styles.xml\"/>"
+		"</Relationships>"));
+
+	WriteEntry(TEXT("xl/styles.xml"), TEXT("<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\"?>\n"
+		"<styleSheet xmlns=\"http://schemas.openxmlformats.org/spreadsheetml/2006/main\">"
+		"<fonts count=\"1\"><font><sz val=\"11\"/><name val=\"Calibri\"/></font></fonts>"
+		"<fills count=\"2\"><fill><patternFill patternType=\"none\"/></fill><fill><patternFill patternType=\"gray125\"/></fill></fills>"
+		"<borders count=\"1\"><border><left/><right/><top/><bottom/><diagonal/></border></borders>"
+		"<cellStyleXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\"/></cellStyleXfs>"
+		"<cellXfs count=\"1\"><xf numFmtId=\"0\" fontId=\"0\" fillId=\"0\" borderId=\"0\" xfId=\"0\"/></cellXfs>"
+		"<cellStyles count=\"1\"><cellStyle name=\"Normal\" xfId=\"0\" builtinId=\"0\"/></cellStyles>"
+		"</styleSheet>"));
+
+	// 中央目录
+	uint16 DosTime = 0;
+	uint16 DosDate = 0;
+	GetDosDateTime(DosTime, DosDate);
+
+	const int64 DirectoryOffset = File->Tell();
+	TArray<uint8> Directory;
+	for (const FZipRecord& Record : Records)
+	{
+		const FTCHARToUTF8 Name(*Record.Path);
+		AppendU32(Directory, 0x02014b50);
+		AppendU16(Directory, ZipVersion);
+		AppendU16(Directory, ZipVersion);
+		AppendU16(Directory, EntryFlags);
+		AppendU16(Directory, MethodDeflate);
+		AppendU16(Directory, DosTime);
+		AppendU16(Directory, DosDate);
+		AppendU32(Directory, Record.Crc);
+		AppendU32(Directory, static_cast<uint32>(Record.CompressedSize));
+		AppendU32(Directory, static_cast<uint32>(Record.UncompressedSize));
+		AppendU16(Directory, static_cast<uint16>(Name.Length()));
+		AppendU16(Directory, 0);
+		AppendU16(Directory, 0);
+		AppendU16(Directory, 0);
+		AppendU16(Directory, 0);
+		AppendU32(Directory, 0);
+		AppendU32(Directory, static_cast<uint32>(Record.LocalHeaderOffset));
+		Directory.Append(reinterpret_cast<const uint8*>(Name.Get()), Name.Length());
+	}
+
+	AppendU32(Directory, 0x06054b50);
+	AppendU16(Directory, 0);
+	AppendU16(Directory, 0);
+	AppendU16(Directory, static_cast<uint16>(Records.Num()));
+	AppendU16(Directory, static_cast<uint16>(Records.Num()));
+	AppendU32(Directory, static_cast<uint32>(Directory.Num() - 22));
+	AppendU32(Directory, static_cast<uint32>(DirectoryOffset));
+	AppendU16(Directory, 0);
+	File->Serialize(Directory.GetData(), Directory.Num());
+
+	// 不使用ZIP64，超过4GB的文件无法打开
+	if (File->Tell() > MAX_uint32)
+	{
+		Abort(TEXT("文件超过4GB，不支持ZIP64"));
+		return false;
+	}
+
+	const bool bWriteError = File->IsError() || !File->Close();
+	File.Reset();
+	if (bWriteError)
+	{
+		Abort(FString::Printf(TEXT("写入文件失败: %s"), *TempFilePath));
+		return false;
+	}
+
+	if (!IFileManager::Get().Move(*FilePath, *TempFilePath, true, true))
+	{
+		Abort(FString::Printf(TEXT("无法替换文件，文件可能已被Excel打开: %s"), *FilePath));
+		return false;
+	}
+	return true;
+}
+
+void FXlsxWriter::BeginEntry(const FString& InPath)
+{
+	using namespace XlsxWriterPrivate;
+
+	CurrentRecord = FZipRecord();
+	CurrentRecord.Path = InPath;
+	CurrentRecord.LocalHeaderOffset = File->Tell();
+	CurrentRecord.Crc = crc32(0, nullptr, 0);
+
+	// 大小和CRC在数据之后的数据描述符中
+	uint16 DosTime = 0;
+	uint16 DosDate = 0;
+	GetDosDateTime(DosTime, DosDate);
+
+	const FTCHARToUTF8 Name(*InPath);
+	TArray<uint8> Header;
+	AppendU32(Header, 0x04034b50);
+	AppendU16(Header, ZipVersion);
+	AppendU16(Header, EntryFlags);
+	AppendU16(Header, MethodDeflate);
+	AppendU16(Header, DosTime);
+	AppendU16(Header, DosDate);
+	AppendU32(Header, 0);
+	AppendU32(Header, 0);
+	AppendU32(Header, 0);
+	AppendU16(Header, static_cast<uint16>(Name.Length()));
+	AppendU16(Header, 0);
+	Header.Append(reinterpret_cast<const uint8*>(Name.Get()), Name.Length());
+	File->Serialize(Header.GetData(), Header.Num());
+
+	Stream = new z_stream();
+	FMemory::Memzero(*Stream);
+	deflateInit2(Stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, -MAX_WBITS, 8, Z_DEFAULT_STRATEGY);
+}
+
+void FXlsxWriter::WriteEntryData(const uint8* InData, int32 InSize)
+{
+	CurrentRecord.Crc = crc32(CurrentRecord.Crc, InData, InSize);
+	CurrentRecord.UncompressedSize += InSize;
+	Deflate(InData, InSize, false);
+}
+
+void FXlsxWriter::EndEntry()
+{
+	using namespace XlsxWriterPrivate;
+
+	Deflate(nullptr, 0, true);
+	deflateEnd(Stream);
+	delete Stream;
+	Stream = nullptr;
+
+	TArray<uint8> Descriptor;
+	AppendU32(Descriptor, 0x08074b50);
+	AppendU32(Descriptor, CurrentRecord.Crc);
+	AppendU32(Descriptor, static_cast<uint32>(CurrentRecord.CompressedSize));
+	AppendU32(Descriptor, static_cast<uint32>(CurrentRecord.UncompressedSize));
+	File->Serialize(Descriptor.GetData(), Descriptor.Num());
+
+	Records.Add(CurrentRecord);
+}
+
+void FXlsxWriter::WriteEntry(const FString& InPath, const FString& InContent)
+{
+	const FTCHARToUTF8 Content(*InContent);
+	BeginEntry(InPath);
+	WriteEntryData(reinterpret_cast<const uint8*>(Content.Get()), Content.Length());
+	EndEntry();
+}
+
+void FXlsxWriter::Deflate(const uint8* InData, int32 InSize, bool bFinish)
+{
+	Stream->next_in = const_cast<Bytef*>(InData);
+	Stream->avail_in = static_cast<uInt>(InSize);
+
+	// 输出缓冲写满时继续，直到输入用完；结束时直到流结束
+	int32 Status = Z_OK;
+	do
+	{
+		Stream->next_out = DeflateBuffer.GetData();
+		Stream->avail_out = static_cast<uInt>(DeflateBuffer.Num());
+		Status = deflate(Stream, bFinish ? Z_FINISH : Z_NO_FLUSH);
+
+		const int32 NumOut = DeflateBuffer.Num() - static_cast<int32>(Stream->avail_out);
+		if (NumOut > 0)
+		{
+			File->Serialize(DeflateBuffer.GetData(), NumOut);
+			CurrentRecord.CompressedSize += NumOut;
+		}
+	}
+	while (Stream->avail_out == 0 || (bFinish && Status == Z_OK));
+}
+
+void FXlsxWriter::FlushXml()
+{
+	if (XmlBuffer.Num() > 0)
+	{
+		WriteEntryData(XmlBuffer.GetData(), XmlBuffer.Num());
+		XmlBuffer.Reset();
+	}
+}
+
+void FXlsxWriter::AppendCellReference()
+{
+	// 列号转为字母，如0为A，27为AB
+	ANSICHAR Letters[4];
+	int32 NumLetters = 0;
+	for (int32 Column = ColumnIndex + 1; Column > 0 && NumLetters < UE_ARRAY_COUNT(Letters); Column = (Column - 1) / 26)
+	{
+		Letters[NumLetters++] = static_cast<ANSICHAR>('A' + (Column - 1) % 26);
+	}
+	while (NumLetters > 0)
+	{
+		XmlBuffer.Add(static_cast<uint8>(Letters[--NumLetters]));
+	}
+	XlsxWriterPrivate::AppendAnsi(XmlBuffer, TCHAR_TO_ANSI(*LexToString(NumRows)));
+}
+
+void FXlsxWriter::Abort(const FString& InMessage)
+{
+	Error = InMessage;
+
+	if (Stream)
+	{
+		deflateEnd(Stream);
+		delete Stream;
+		Stream = nullptr;
+	}
+
+	File.Reset();
+	IFileManager::Get().Delete(*TempFilePath, false, true, true);
+}
@@ -25,6 +25,7 @@
 #include "ContentBrowserModule.h"
 #include "IContentBrowserSingleton.h"
 #include "PythonBridge.h"
+#include "StructPickerIndex.h"
 
 #define LOCTEXT_NAMESPACE "FLomoLibEditorModule"
 
@@ -54,6 +55,9 @@ void FLomoLibEditorModule::ShutdownModule()
 	
 	// 注销命令
 	UnregisterExcelDataTableCommands();
+	
+	// 释放结构体索引
+	FStructPickerIndex::Shutdown();
 }
 
 void FLomoLibEditorModule::RegisterExcelDataTableCommands()
@@ -0,0 +1,234 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#include "StructPickerIndex.h"
+#include "Misc/App.h"
+#include "UObject/UObjectHash.h"
+
+namespace StructPickerIndexPrivate
+{
+	TUniquePtr<FStructPickerIndex>& GetInstance()
+	{
+		static TUniquePtr<FStructPickerIndex> Instance;
+		return Instance;
+	}
+
+	/** 所有词都出现在名字或模块名中 */
+	bool MatchesTokens(const FStructPickerEntry& InEntry, const TArray<FString>& InTokens)
+	{
+		for (const FString& Token : InTokens)
+		{
+			if (!InEntry.Name.Contains(Token) && !InEntry.Module.Contains(Token))
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+FStructPickerIndex::FStructPickerIndex()
+	: ProjectName(FApp::GetProjectName())
+{
+	ModulesChangedHandle = FModuleManager::Get().OnModulesChanged().AddRaw(this, &FStructPickerIndex::HandleModulesChanged);
+	ReloadCompleteHandle = FCoreUObjectDelegates::ReloadCompleteDelegate.AddRaw(this, &FStructPickerIndex::HandleReloadComplete);
+}
+
+FStructPickerIndex::~FStructPickerIndex()
+{
+	FModuleManager::Get().OnModulesChanged().Remove(ModulesChangedHandle);
+	FCoreUObjectDelegates::ReloadCompleteDelegate.Remove(ReloadCompleteHandle);
+}
+
+FStructPickerIndex& FStructPickerIndex::Get()
+{
+	check(IsInGameThread());
+
+	TUniquePtr<FStructPickerIndex>& Instance = StructPickerIndexPrivate::GetInstance();
+	if (!Instance.IsValid())
+	{
+		Instance.Reset(new FStructPickerIndex());
+	}
+	return *Instance;
+}
+
+void FStructPickerIndex::Shutdown()
+{
+	StructPickerIndexPrivate::GetInstance().Reset();
+}
+
+void FStructPickerIndex::Filter(const FString& InSearchText, bool bInProjectOnly, TArray<TSharedPtr<FStructPickerEntry>>& OutEntries)
+{
+	EnsureBuilt();
+
+	TArray<FString> Tokens;
+	InSearchText.ParseIntoArrayWS(Tokens);
+
+	OutEntries.Reset();
+	TArray<TSharedPtr<FStructPickerEntry>> OtherEntries;
+
+	for (const TSharedPtr<FStructPickerEntry>& Entry : SortedEntries)
+	{
+		if ((bInProjectOnly && !Entry->bProjectModule) || !StructPickerIndexPrivate::MatchesTokens(*Entry, Tokens))
+		{
+			continue;
+		}
+
+		// 以第一个词开头的排在前面，组内保持名字顺序
+		if (Tokens.Num() > 0 && Entry->Name.StartsWith(Tokens[0]))
+		{
+			OutEntries.Add(Entry);
+		}
+		else
+		{
+			OtherEntries.Add(Entry);
+		}
+	}
+
+	OutEntries.Append(MoveTemp(OtherEntries));
+}
+
+int32 FStructPickerIndex::Num(bool bInProjectOnly)
+{
+	EnsureBuilt();
+
+	if (!bInProjectOnly)
+	{
+		return SortedEntries.Num();
+	}
+
+	int32 NumProjectEntries = 0;
+	for (const TSharedPtr<FStructPickerEntry>& Entry : SortedEntries)
+	{
+		NumProjectEntries += Entry->bProjectModule ? 1 : 0;
+	}
+	return NumProjectEntries;
+}
+
+void FStructPickerIndex::EnsureBuilt()
+{
+	if (!bBuilt)
+	{
+		const double StartTime = FPlatformTime::Seconds();
+
+		TArray<FModuleStatus> ModuleStatuses;
+		FModuleManager::Get().QueryModules(ModuleStatuses);
+		for (const FModuleStatus& ModuleStatus : ModuleStatuses)
+		{
+			if (ModuleStatus.bIsLoaded)
+			{
+				IndexModule(FName(*ModuleStatus.Name));
+			}
+		}
+
+		bBuilt = true;
+		bSortedEntriesDirty = true;
+
+		UE_LOG(LogTemp, Log, TEXT("结构体索引: %d 个模块, 耗时 %.1f ms"), EntriesByModule.Num(), (FPlatformTime::Seconds() - StartTime) * 1000.0);
+	}
+
+	if (bSortedEntriesDirty)
+	{
+		RebuildSortedEntries();
+	}
+}
+
+void FStructPickerIndex::IndexModule(FName InModuleName)
+{
+	EntriesByModule.Remove(InModuleName);
+
+	// 原生结构体都在模块的/Script包中
+	const FString PackageName = TEXT("/Script/") + InModuleName.ToString();
+	UPackage* Package = FindPackage(nullptr, *PackageName);
+	if (!Package)
+	{
+		return;
+	}
+
+	TArray<UObject*> Objects;
+	GetObjectsWithPackage(Package, Objects, false);
+
+	const FString ModuleNameString = InModuleName.ToString();
+	const FText ModuleDisplayName = FText::FromString(ModuleNameString);
+	const bool bProjectModule = ModuleNameString.StartsWith(ProjectName);
+
+	TArray<TSharedPtr<FStructPickerEntry>> ModuleEntries;
+	for (UObject* Object : Objects)
+	{
+		UScriptStruct* Struct = Cast<UScriptStruct>(Object);
+		if (!Struct)
+		{
+			continue;
+		}
+
+		TSharedPtr<FStructPickerEntry> Entry = MakeShared<FStructPickerEntry>();
+		Entry->Struct = Struct;
+		Entry->Name = Struct->GetName();
+		Entry->Module = ModuleNameString;
+		Entry->DisplayName = FText::FromString(Entry->Name);
+		Entry->ModuleDisplayName = ModuleDisplayName;
+		Entry->bProjectModule = bProjectModule;
+		ModuleEntries.Add(MoveTemp(Entry));
+	}
+
+	if (ModuleEntries.Num() > 0)
+	{
+		EntriesByModule.Add(InModuleName, MoveTemp(ModuleEntries));
+	}
+}
+
+void FStructPickerIndex::RebuildSortedEntries()
+{
+	SortedEntries.Reset();
+	for (const TPair<FName, TArray<TSharedPtr<FStructPickerEntry>>>& Pair : EntriesByModule)
+	{
+		SortedEntries.Append(Pair.Value);
+	}
+
+	SortedEntries.Sort([](const TSharedPtr<FStructPickerEntry>& A, const TSharedPtr<FStructPickerEntry>& B)
+	{
+		return A->Name < B->Name;
+	});
+
+	bSortedEntriesDirty = false;
+}
+
+void FStructPickerIndex::HandleModulesChanged(FName InModuleName, EModuleChangeReason InReason)
+{
+	// 还没有建立索引时，第一次使用会索引当时已加载的所有模块
+	if (!bBuilt)
+	{
+		return;
+	}
+
+	switch (InReason)
+	{
+	case EModuleChangeReason::ModuleLoaded:
+		IndexModule(InModuleName);
+		MarkDirty();
+		break;
+
+	case EModuleChangeReason::ModuleUnloaded:
+		if (EntriesByModule.Remove(InModuleName) > 0)
+		{
+			MarkDirty();
+		}
+		break;
+
+	default:
+		break;
+	}
+}
+
+void FStructPickerIndex::HandleReloadComplete(EReloadCompleteReason InReason)
+{
+	// 热重载会替换结构体对象，重新建立整个索引
+	EntriesByModule.Reset();
+	bBuilt = false;
+	MarkDirty();
+}
+
+void FStructPickerIndex::MarkDirty()
+{
+	bSortedEntriesDirty = true;
+	++Version;
+}
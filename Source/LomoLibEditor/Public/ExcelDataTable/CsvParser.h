@@ -0,0 +1,45 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * 按RFC 4180逐行读取CSV，单趟扫描，不为单元格分配内存
+ * - 支持引号字段、字段中的逗号和换行、转义的引号("")和空单元格
+ * - 行尾可以是\r\n、\n或\r，文件末尾的换行不会产生空行
+ * - 单元格是指向内部文本的视图，引号字段就地去除转义，并在单元格之后写入'\0'，可以直接传给ImportText
+ * 对不规范的内容与Excel一样宽松处理：未加引号字段中的引号按原样保留，引号未闭合时字段延续到文件末尾
+ */
+class LOMOLIBEDITOR_API FCsvParser
+{
+public:
+	FCsvParser() = default;
+
+	/** 接管文本，读取时会修改文本 */
+	explicit FCsvParser(FString&& InText);
+
+	/** 读取文件，自动识别BOM */
+	bool LoadFile(const FString& InFilePath);
+
+	/**
+	 * 读取下一行
+	 * @param OutCells - 本行的单元格，在FCsvParser销毁或重新加载前有效
+	 * @return 没有更多行时返回false
+	 */
+	bool ReadRow(TArray<FStringView>& OutCells);
+
+	/** 刚读取的行在文件中开始的行号，从1开始，引号字段中的换行也计入 */
+	int32 GetLineNumber() const { return RowLineNumber; }
+
+private:
+	FString Text;
+
+	/** 下一行开始的位置 */
+	int32 Position = 0;
+
+	/** Position所在的行号 */
+	int32 LineNumber = 1;
+
+	int32 RowLineNumber = 0;
+};
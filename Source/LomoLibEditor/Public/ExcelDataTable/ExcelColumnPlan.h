@@ -0,0 +1,68 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 列的解析方式，按内存中的具体类型区分 */
+enum class EExcelColumnOp : uint8
+{
+	/** 行名列，或表头在行结构中找不到的列 */
+	Skip,
+	Bool,
+	Int8,
+	Int16,
+	Int32,
+	Int64,
+	UInt8,
+	UInt16,
+	UInt32,
+	UInt64,
+	Float,
+	Double,
+	Name,
+	String,
+	/** 其他类型（枚举、文本、结构体、容器、对象引用等），使用ImportText */
+	Generic,
+};
+
+/** 表格中的一列 */
+struct FExcelColumn
+{
+	EExcelColumnOp Op = EExcelColumnOp::Skip;
+
+	/** 值在行中的偏移 */
+	int32 Offset = 0;
+
+	FProperty* Property = nullptr;
+};
+
+/**
+ * 表头解析为列计划，导入时每列不再按名称查找属性
+ * - 整数、浮点、布尔、名称和字符串直接写入内存
+ * - 快速解析只接受导出时的写法（如十进制整数、True/False），其他写法交给ImportText，结果与之前相同
+ * - 复杂类型使用ImportText
+ */
+class LOMOLIBEDITOR_API FExcelColumnPlan
+{
+public:
+	/**
+	 * @param InRowStruct - DataTable的行结构
+	 * @param InHeaders - 表头，第一列是行名
+	 */
+	FExcelColumnPlan(const UScriptStruct* InRowStruct, TConstArrayView<FString> InHeaders);
+
+	/**
+	 * 把一行的单元格写入已初始化的行，单元格需要以'\0'结尾
+	 * @param OutFailedColumn - 失败时ImportText不能解析的列
+	 */
+	bool ImportRow(TConstArrayView<FStringView> InCells, uint8* InRowData, int32& OutFailedColumn) const;
+
+	TConstArrayView<FExcelColumn> GetColumns() const { return Columns; }
+
+	/** 使用ImportText的列数 */
+	int32 NumGenericColumns() const;
+
+private:
+	TArray<FExcelColumn> Columns;
+};
@@ -0,0 +1,86 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+class IMappedFileHandle;
+class IMappedFileRegion;
+class UDataTable;
+struct FExcelDataTableImportHashes;
+
+/**
+ * 每个映射导入结果的二进制缓存，保存在Saved/ExcelDataTable/Cache
+ * - 记录缓存格式的版本、源文件和行结构的哈希、表头、行名、行的哈希和序列化后的行
+ * - 行使用带标签的属性序列化，不直接保存内存中的字节（FString等类型包含指针）
+ * - 源文件没有变化但DataTable与上次导入不同时（例如资源被还原），从缓存恢复，不需要再解析表格
+ * - 源文件变化且上次导入的哈希不可信时，表头相同的缓存中哈希相同的行直接读取，不需要ImportText
+ * 读取时映射整个文件，行按需反序列化
+ */
+class LOMOLIBEDITOR_API FExcelDataTableCache
+{
+public:
+	FExcelDataTableCache();
+	~FExcelDataTableCache();
+
+	/** 缓存中记录的源哈希，只读取文件头，没有缓存时返回0 */
+	static uint64 ReadSourceHash(const FString& InDataTablePath);
+
+	/**
+	 * 把DataTable当前的行写入缓存，行的哈希从InHashes中取
+	 * @param InHeaders - 导入时的表头
+	 */
+	static bool Write(const FString& InDataTablePath, const UDataTable* InDataTable, TConstArrayView<FString> InHeaders, const FExcelDataTableImportHashes& InHashes);
+
+	/** 打开缓存，版本、源哈希或行结构哈希不同时返回false */
+	bool Open(const FString& InDataTablePath, uint64 InSourceHash, uint64 InSchemaHash);
+
+	/** 打开任意源文件的缓存，版本或行结构哈希不同时返回false */
+	bool Open(const FString& InDataTablePath, uint64 InSchemaHash);
+
+	/** 释放映射的文件，之后才能重新写入缓存 */
+	void Close();
+
+	/** 写入缓存时的源哈希 */
+	uint64 GetSourceHash() const { return SourceHash; }
+
+	int32 Num() const { return Rows.Num(); }
+
+	FName GetRowName(int32 InIndex) const { return Rows[InIndex].Name; }
+
+	uint64 GetRowHash(int32 InIndex) const { return Rows[InIndex].Hash; }
+
+	/** 导入时的表头 */
+	const TArray<FString>& GetHeaders() const { return Headers; }
+
+	/** 把一行反序列化到已初始化的行内存 */
+	bool ReadRow(int32 InIndex, const UScriptStruct* InRowStruct, uint8* OutRowData) const;
+
+	/** 映射的缓存文件路径 */
+	static FString GetCachePath(const FString& InDataTablePath);
+
+private:
+	struct FRowEntry
+	{
+		FName Name;
+		uint64 Hash = 0;
+
+		/** 在行数据区中的位置 */
+		int64 Offset = 0;
+		int64 Size = 0;
+	};
+
+	/** 映射的文件，不支持映射时读取到FileData */
+	TUniquePtr<IMappedFileHandle> MappedFile;
+	TUniquePtr<IMappedFileRegion> MappedRegion;
+	TArray<uint8> FileData;
+
+	/** 行数据区 */
+	TConstArrayView<uint8> RowData;
+
+	TArray<FString> Headers;
+
+	TArray<FRowEntry> Rows;
+
+	uint64 SourceHash = 0;
+};
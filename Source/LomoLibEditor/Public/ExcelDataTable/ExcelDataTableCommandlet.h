@@ -0,0 +1,26 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "ExcelDataTableCommandlet.generated.h"
+
+/**
+ * 在命令行中批量转换设置中的所有映射，不显示编辑器界面，用于构建机
+ * UnrealEditor-Cmd.exe <Project>.uproject -run=ExcelDataTable [-Export] [-Workers=N] [-Report=<Path>] [-NoSave]
+ * - 默认导入，-Export时导出；导入时读取和解析文件在N个工作线程中同时进行，默认使用全局线程池
+ * - 导入后保存被修改的DataTable，-NoSave时不保存；只有实际保存的DataTable的导入哈希写入哈希文件
+ * - 输出每个表格的耗时，并把结果写入JSON报告，默认为Saved/ExcelDataTable/BatchReport.json
+ * 全部成功时返回0，否则返回1；有出错的行的表格也算失败
+ */
+UCLASS()
+class LOMOLIBEDITOR_API UExcelDataTableCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	UExcelDataTableCommandlet();
+
+	virtual int32 Main(const FString& Params) override;
+};
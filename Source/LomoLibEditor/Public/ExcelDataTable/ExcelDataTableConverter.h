@@ -4,8 +4,32 @@
 
 #include "CoreMinimal.h"
 #include "Engine/DataTable.h"
+#include "Async/Future.h"
+#include "Containers/Ticker.h"
+#include "UObject/ObjectKey.h"
 #include "ExcelDataTableConverter.generated.h"
 
+class FExcelTableRows;
+class FObjectPostSaveContext;
+class FQueuedThreadPool;
+struct FExcelDataTableImportHashes;
+struct FFileChangeData;
+
+/** 一个等待自动同步的映射 */
+struct FExcelAutoSyncTask
+{
+	FString DataTablePath;
+
+	/** 最后一次文件变化的时间，之后安静一段时间才开始读取 */
+	double LastChangeTime = 0.0;
+
+	/** 读取失败的重试次数，Excel保存时文件可能短暂被占用 */
+	int32 NumRetries = 0;
+
+	/** 后台的读取，开始读取前无效 */
+	TFuture<TSharedPtr<FExcelTableRows>> LoadTask;
+};
+
 /**
  * 定义Excel操作的结果
  */
@@ -29,6 +53,22 @@ struct FExcelOperationResult
 	/** 成功转换的数据行数 */
 	UPROPERTY(BlueprintReadOnly, Category = "Excel Operation")
 	int32 ProcessedRows = 0;
+
+	/** 增量导入时与上次导入相同、没有重新解析的行数，包含在ProcessedRows中 */
+	UPROPERTY(BlueprintReadOnly, Category = "Excel Operation")
+	int32 UnchangedRows = 0;
+
+	/** 批量处理时对应的DataTable路径 */
+	UPROPERTY(BlueprintReadOnly, Category = "Excel Operation")
+	FString DataTablePath;
+
+	/** 批量导入时在工作线程中读取和解析文件的秒数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Excel Operation")
+	double ReadSeconds = 0.0;
+
+	/** 在游戏线程中写入DataTable或导出文件的秒数 */
+	UPROPERTY(BlueprintReadOnly, Category = "Excel Operation")
+	double WriteSeconds = 0.0;
 };
 
 /**
@@ -44,7 +84,8 @@ public:
 	virtual void Deinitialize() override;
 
 	/**
-	 * 将Excel文件导入到DataTable, Todo: 该函数存在功能错误，暂不研究
+	 * 将Excel文件导入到DataTable，XLSX由FXlsxReader直接读取，也可以是CSV文件
+	 * 开启增量导入时只更新变化的行，文件没有变化时直接跳过
 	 * @param DataTablePath - DataTable资源的路径
 	 * @param ExcelFilePath - Excel文件的绝对路径
 	 * @param SheetName - 要导入的工作表名称
@@ -64,14 +105,73 @@ public:
 	FExcelOperationResult ExportDataTableToExcel(const FString& DataTablePath, const FString& ExcelFilePath, const FString& SheetName = TEXT("Sheet1"));
 
 	/**
-	 * 批量处理DataTable与Excel之间的转换
+	 * 批量处理DataTable与Excel之间的转换，显示进度对话框，可以取消
+	 * 导入时各文件的读取和解析在线程池中同时进行，只有写入DataTable在游戏线程
 	 * @param bImport - 如果为true，则从Excel导入到DataTable；否则从DataTable导出到Excel
 	 * @return 操作结果
 	 */
 	UFUNCTION(BlueprintCallable, Category = "Excel DataTable Converter")
 	TArray<FExcelOperationResult> BatchProcess(bool bImport = true);
 
+	/**
+	 * 与BatchProcess相同，读取文件使用指定的线程池，命令行中用来控制并行的数量
+	 * @param ThreadPool - 为空时使用全局线程池
+	 */
+	TArray<FExcelOperationResult> BatchProcessOnPool(bool bImport, FQueuedThreadPool* ThreadPool);
+
 private:
+	/**
+	 * 把读取的表格写入DataTable，只能在游戏线程调用
+	 * 增量导入时只更新哈希变化的行，文件未变化时跳过，哈希需要调用者保存
+	 */
+	FExcelOperationResult ImportRowsToDataTable(const FString& DataTablePath, const FString& ExcelFilePath, const FString& SheetName, FExcelTableRows& Rows);
+
+	/** 上次导入的源哈希，关闭增量导入或没有导入过时返回0 */
+	uint64 GetUnchangedSourceHash(const FString& DataTablePath) const;
+
+	/** 包保存后把其中DataTable的导入哈希写入哈希文件 */
+	void OnPackageSaved(const FString& PackageFileName, UPackage* Package, FObjectPostSaveContext ObjectSaveContext);
+
+	/** DataTable的内容是否与上次导入的结果相同，本次会话中已验证过时不需要计算内容的哈希 */
+	bool VerifyImportedContent(UDataTable* DataTable, uint64 ContentHash);
+
+	/** 记录导入后的哈希，之后DataTable没有被修改时不需要再验证 */
+	void StoreImportHashes(UDataTable* DataTable, const FString& DataTablePath, FExcelDataTableImportHashes&& Hashes);
+
+	void MarkVerified(UDataTable* DataTable);
+
+	void UnmarkVerified(UDataTable* DataTable);
+
+	/** 验证过的DataTable被编辑、撤销或重新导入时不再可信 */
+	void OnVerifiedDataTableChanged(TWeakObjectPtr<UDataTable> DataTable);
+
+	/** 按设置中开启bAutoSync的映射重新注册目录监视 */
+	void RefreshAutoSyncWatchers();
+
+	void UnregisterAutoSyncWatchers();
+
+	void OnAutoSyncSettingsChanged(UObject* Settings, FPropertyChangedEvent& PropertyChangedEvent);
+
+	/** 映射的文件变化后加入等待列表 */
+	void OnAutoSyncDirectoryChanged(const TArray<FFileChangeData>& FileChanges);
+
+	/** 开始安静足够久的读取，把完成的读取写入DataTable */
+	bool TickAutoSync(float DeltaTime);
+
+	/** 正在监视的目录和回调句柄 */
+	TMap<FString, FDelegateHandle> AutoSyncWatchers;
+
+	TArray<FExcelAutoSyncTask> AutoSyncTasks;
+
+	FTSTicker::FDelegateHandle AutoSyncTickerHandle;
+
+	FDelegateHandle SettingsChangedHandle;
+
+	FDelegateHandle PackageSavedHandle;
+
+	/** 内容与当前的导入哈希一致的DataTable和它们的OnDataTableChanged句柄，重新加载的资源是新的对象，需要重新验证 */
+	TMap<TObjectKey<UDataTable>, FDelegateHandle> VerifiedDataTables;
+
 	/** 读取CSV文件的内容 */
 	bool ReadCSVFile(const FString& FilePath, TArray<TArray<FString>>& OutRows);
 
@@ -31,6 +31,29 @@ struct FExcelDataTableMapping
 	bool bAutoSync = false;
 };
 
+/**
+ * 一个映射上次导入时的哈希，用于增量导入
+ */
+struct FExcelDataTableImportHashes
+{
+	/** 源文件内容和工作表名称的哈希 */
+	uint64 SourceHash = 0;
+
+	/** 行结构的哈希，变化时所有行都需要重新导入 */
+	uint64 SchemaHash = 0;
+
+	/**
+	 * 导入后DataTable内容的哈希，与资源当前的内容不同时说明DataTable在导入之后被修改或还原过
+	 * 导入时有修改的DataTable在保存时才计算，之前为0
+	 */
+	uint64 ContentHash = 0;
+
+	/** 每行单元格的哈希，表头也计入其中 */
+	TMap<FName, uint64> RowHashes;
+
+	friend FArchive& operator<<(FArchive& Ar, FExcelDataTableImportHashes& Hashes);
+};
+
 /**
  * DataTable与Excel转换工具的配置设置
  */
@@ -56,4 +79,47 @@ public:
 
 	/** 获取与特定Excel文件相关联的映射 */
 	FExcelDataTableMapping* GetMappingForExcelFile(const FString& ExcelFilePath);
+
+	/** 只导入变化的行，文件没有变化时直接跳过；关闭时每次清空DataTable后重新导入 */
+	UPROPERTY(config, EditAnywhere, Category = "Import")
+	bool bIncrementalImport = true;
+
+	/**
+	 * 上次导入时的哈希，包括还没有保存的DataTable，不存在时返回nullptr
+	 * 哈希保存在Saved/ExcelDataTable/ImportHashes.bin，是本机的状态，不写入配置文件
+	 */
+	const FExcelDataTableImportHashes* FindImportHashes(const FSoftObjectPath& DataTablePath);
+
+	/**
+	 * 记录导入后的哈希
+	 * @param bPackageSaved - DataTable所在的包是否与磁盘上的资源一致；不一致时哈希只在内存中使用，包保存后才写入哈希文件
+	 */
+	void SetImportHashes(const FSoftObjectPath& DataTablePath, FExcelDataTableImportHashes&& Hashes, bool bPackageSaved);
+
+	void RemoveImportHashes(const FSoftObjectPath& DataTablePath);
+
+	/** 设置当前哈希中内容的哈希，在CommitImportHashes之前调用 */
+	void SetImportContentHash(const FSoftObjectPath& DataTablePath, uint64 ContentHash);
+
+	/** 包保存后调用，包中DataTable的哈希之后写入哈希文件 */
+	void CommitImportHashes(FName PackageName);
+
+	/** 写入已保存的DataTable的哈希，没有修改时不写入 */
+	void SaveImportHashes();
+
+private:
+	void LoadImportHashes();
+
+	static FString GetImportHashesPath();
+
+	/** 当前的哈希，包括导入后还没有保存的DataTable */
+	TMap<FString, FExcelDataTableImportHashes> ImportHashes;
+
+	/** 写入哈希文件的哈希，只包含与磁盘上的资源一致的DataTable */
+	TMap<FString, FExcelDataTableImportHashes> SavedImportHashes;
+
+	bool bImportHashesLoaded = false;
+
+	/** SavedImportHashes是否与哈希文件不同 */
+	bool bImportHashesDirty = false;
 }; 
\ No newline at end of file
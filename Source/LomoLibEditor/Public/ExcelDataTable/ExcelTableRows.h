@@ -0,0 +1,67 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "ExcelDataTable/CsvParser.h"
+
+/**
+ * 读取到内存中的表格，CSV和XLSX的每行都是以'\0'结尾的单元格视图，可以直接传给ImportText
+ * Load不访问UObject，可以在工作线程中调用；单元格指向内部的存储，所以不能复制
+ */
+class LOMOLIBEDITOR_API FExcelTableRows
+{
+public:
+	FExcelTableRows() = default;
+	UE_NONCOPYABLE(FExcelTableRows);
+
+	/**
+	 * 按扩展名读取CSV或XLSX文件并解析所有行
+	 * @param InSheetName - XLSX的工作表名称，为空或默认的Sheet1不存在时使用第一个工作表
+	 * @param InUnchangedHash - 上次导入的源哈希，与文件的哈希相同时不解析，IsUnchanged返回true
+	 */
+	bool Load(const FString& InFilePath, const FString& InSheetName, uint64 InUnchangedHash = 0);
+
+	/** 文件内容和工作表名称的哈希 */
+	uint64 GetSourceHash() const { return SourceHash; }
+
+	/** 文件与上次导入时相同，没有解析 */
+	bool IsUnchanged() const { return bUnchanged; }
+
+	/** 行数 */
+	int32 Num() const { return FMath::Max(RowOffsets.Num() - 1, 0); }
+
+	TConstArrayView<FStringView> GetRow(int32 InRowIndex) const
+	{
+		return TConstArrayView<FStringView>(Cells.GetData() + RowOffsets[InRowIndex], RowOffsets[InRowIndex + 1] - RowOffsets[InRowIndex]);
+	}
+
+	const FString& GetError() const { return Error; }
+
+	/** 上次Load的秒数，包括读取文件和解析 */
+	double GetLoadSeconds() const { return LoadSeconds; }
+
+private:
+	/** 把刚读取的一行追加到Cells */
+	void AddRow(TConstArrayView<FStringView> InCells);
+
+	/** CSV的文本 */
+	FCsvParser CsvParser;
+
+	/** XLSX单元格的文本 */
+	TArray<TArray<FString>> SheetRows;
+
+	/** 所有行的单元格 */
+	TArray<FStringView> Cells;
+
+	/** 每行在Cells中开始的位置，最后一个是Cells.Num() */
+	TArray<int32> RowOffsets;
+
+	uint64 SourceHash = 0;
+
+	bool bUnchanged = false;
+
+	double LoadSeconds = 0.0;
+
+	FString Error;
+};
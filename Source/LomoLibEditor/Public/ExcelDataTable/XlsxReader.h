@@ -0,0 +1,140 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/** 单元格的类型，对应工作表XML中c元素的t属性 */
+enum class EXlsxCellType : uint8
+{
+	Empty,
+	Number,
+	/** 共享字符串、内联字符串和公式的字符串结果 */
+	String,
+	Bool,
+	/** 公式错误，如#DIV/0!，文本保存在字符串中 */
+	Error,
+};
+
+/** 单元格，字符串保存在所属FXlsxSheet中 */
+struct FXlsxCell
+{
+	EXlsxCellType Type = EXlsxCellType::Empty;
+
+	/** 数字和布尔的值 */
+	double Number = 0.0;
+
+	/** 字符串和错误的下标，见FXlsxSheet::FindString */
+	int32 StringIndex = INDEX_NONE;
+};
+
+/** 读取的一个工作表，行和列都从0开始，行内缺少的单元格补为空 */
+struct LOMOLIBEDITOR_API FXlsxSheet
+{
+	FString Name;
+
+	TArray<TArray<FXlsxCell>> Rows;
+
+	/** 工作簿的共享字符串表，同一个FXlsxReader读取的工作表共用，不复制 */
+	TSharedPtr<const TArray<FString>> SharedStrings;
+
+	/** 工作表自身的内联字符串、公式字符串和错误，下标接在共享字符串之后 */
+	TArray<FString> Strings;
+
+	/** 最宽一行的列数 */
+	int32 NumColumns = 0;
+
+	const FXlsxCell* GetCell(int32 InRow, int32 InColumn) const;
+
+	/** 单元格字符串下标对应的文本，小于共享字符串数量时在SharedStrings中，否则在Strings中；无效时返回nullptr */
+	const FString* FindString(int32 InStringIndex) const;
+
+	/**
+	 * 单元格的文本，追加到OutText
+	 * 整数不带小数点，其他数字使用能还原原值的最短表示，布尔为True/False
+	 */
+	void AppendCellText(const FXlsxCell& InCell, FString& OutText) const;
+
+	FString GetCellText(int32 InRow, int32 InColumn) const;
+
+	/** 转换为字符串表格，与CSV读取的结果相同 */
+	void ToStringRows(TArray<TArray<FString>>& OutRows) const;
+
+	/** 数字的文本，FXlsxWriter写入时使用相同的格式 */
+	static void AppendNumberText(double InNumber, FString& OutText);
+};
+
+/**
+ * 直接读取XLSX文件，不依赖Python
+ * - 解析ZIP的中央目录，只解压需要的条目（workbook、关系、共享字符串和目标工作表）
+ * - 顺序扫描XML，不构建DOM，单元格直接存为类型化的值
+ * 不支持ZIP64和加密的文件
+ */
+class LOMOLIBEDITOR_API FXlsxReader
+{
+public:
+	/** 读取文件并解析工作簿，之后可以读取多个工作表 */
+	bool Open(const FString& InFilePath);
+
+	/** 解析已经读取到内存中的文件内容 */
+	bool Open(TArray<uint8>&& InFileData);
+
+	/** 工作表名称，按工作簿中的顺序 */
+	TArray<FString> GetSheetNames() const;
+
+	/**
+	 * 读取工作表
+	 * @param InSheetName - 工作表名称，为空时读取第一个工作表
+	 */
+	bool ReadSheet(const FString& InSheetName, FXlsxSheet& OutSheet);
+
+	/** 打开文件并读取一个工作表 */
+	static bool ReadSheet(const FString& InFilePath, const FString& InSheetName, FXlsxSheet& OutSheet, FString* OutError = nullptr);
+
+	const FString& GetError() const { return Error; }
+
+private:
+	/** ZIP中的一个条目 */
+	struct FZipEntry
+	{
+		uint16 Method = 0;
+		int64 CompressedSize = 0;
+		int64 UncompressedSize = 0;
+		int64 LocalHeaderOffset = 0;
+	};
+
+	struct FSheetInfo
+	{
+		FString Name;
+		/** ZIP中的路径，如xl/worksheets/sheet1.xml */
+		FString Path;
+	};
+
+	bool ReadCentralDirectory();
+
+	/** 解压一个条目，不存在时返回false */
+	bool ExtractEntry(const FString& InPath, TArray<uint8>& OutData);
+
+	bool ReadWorkbook();
+
+	bool ReadSharedStrings();
+
+	bool ParseSheet(TConstArrayView<uint8> InXml, FXlsxSheet& OutSheet);
+
+	bool SetError(const FString& InMessage);
+
+	/** 整个文件的内容，XLSX是压缩的，通常不大 */
+	TArray<uint8> FileData;
+
+	TMap<FString, FZipEntry> Entries;
+
+	TArray<FSheetInfo> Sheets;
+
+	/** 读取的工作表共用，重新打开时替换为新的数组，不影响已经读取的工作表 */
+	TSharedRef<TArray<FString>> SharedStrings = MakeShared<TArray<FString>>();
+
+	/** 工作簿关系中的共享字符串路径 */
+	FString SharedStringsPath;
+
+	FString Error;
+};
@@ -0,0 +1,93 @@
+// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+struct z_stream_s;
+
+/**
+ * 流式写入只有一个工作表的XLSX文件，不依赖Python
+ * - 行的XML写入固定大小的缓冲，满了就压缩并写入文件，内存占用与行数无关
+ * - 字符串写为内联字符串，不需要在内存中保留共享字符串表
+ * - 先写入临时文件，Close成功后替换目标文件；原文件中的其他工作表、样式等都不保留
+ * 用法：Open，之后每行BeginRow、AddString/AddNumber、EndRow，最后Close
+ */
+class LOMOLIBEDITOR_API FXlsxWriter
+{
+public:
+	FXlsxWriter();
+	~FXlsxWriter();
+
+	/** 创建文件并开始写入工作表，工作表名称中Excel不允许的字符替换为'_' */
+	bool Open(const FString& InFilePath, const FString& InSheetName);
+
+	void BeginRow();
+	void AddString(FStringView InValue);
+	void AddNumber(double InValue);
+	/** 空单元格，只占一列 */
+	void AddEmpty();
+	void EndRow();
+
+	/** 完成工作表并写入工作簿的其他部分，失败时删除临时文件 */
+	bool Close();
+
+	/** 已写入的行数 */
+	int32 GetNumRows() const { return NumRows; }
+
+	const FString& GetError() const { return Error; }
+
+private:
+	/** ZIP中央目录中的一个条目 */
+	struct FZipRecord
+	{
+		FString Path;
+		uint32 Crc = 0;
+		int64 CompressedSize = 0;
+		int64 UncompressedSize = 0;
+		int64 LocalHeaderOffset = 0;
+	};
+
+	void BeginEntry(const FString& InPath);
+	void WriteEntryData(const uint8* InData, int32 InSize);
+	void EndEntry();
+
+	/** 写入一个完整的小条目 */
+	void WriteEntry(const FString& InPath, const FString& InContent);
+
+	/** 压缩输入，bFinish时结束deflate流 */
+	void Deflate(const uint8* InData, int32 InSize, bool bFinish);
+
+	/** 把缓冲中的XML压缩写入 */
+	void FlushXml();
+
+	void AppendCellReference();
+
+	void Abort(const FString& InMessage);
+
+	FString FilePath;
+	FString TempFilePath;
+	FString SheetName;
+
+	TUniquePtr<FArchive> File;
+
+	z_stream_s* Stream = nullptr;
+
+	/** 待压缩的XML */
+	TArray<uint8> XmlBuffer;
+
+	/** 压缩输出 */
+	TArray<uint8> DeflateBuffer;
+
+	TArray<FZipRecord> Records;
+
+	/** 正在写入的条目 */
+	FZipRecord CurrentRecord;
+
+	int32 NumRows = 0;
+	int32 ColumnIndex = 0;
+
+	bool bInRow = false;
+
+	FString Error;
+};
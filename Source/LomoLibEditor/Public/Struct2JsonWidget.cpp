@@ -5,9 +5,14 @@
 #include "ClassViewerFilter.h"
 #include "DesktopPlatformModule.h"
 #include "IDesktopPlatform.h"
-#include "JsonObjectConverter.h"
+#include "StructPickerIndex.h"
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+#include "RapidUI/JsonPanel/RapidJsonStructWriter.h"
 #include "Misc/FileHelper.h"
 #include "Framework/Application/SlateApplication.h"
+#include "Widgets/Input/SCheckBox.h"
+#include "Widgets/Input/SSearchBox.h"
+#include "Widgets/Views/SListView.h"
 
 class FStructFilter : public IClassViewerFilter
 {
@@ -91,6 +96,15 @@ void SStructToJsonWidget::Construct(const FArguments& InArgs)
             .OnClicked(this, &SStructToJsonWidget::OnExportToJsonClicked)
             .IsEnabled(this, &SStructToJsonWidget::IsStructSelected)
         ]
+        + SVerticalBox::Slot()
+        .AutoHeight()
+        .Padding(5)
+        [
+            SNew(SButton)
+            .Text(FText::FromString(TEXT("查看序列化计划")))
+            .OnClicked(this, &SStructToJsonWidget::OnShowPlanClicked)
+            .IsEnabled(this, &SStructToJsonWidget::IsStructSelected)
+        ]
     ];
 }
 
@@ -101,28 +115,9 @@ bool SStructToJsonWidget::IsStructSelected() const
 
 FReply SStructToJsonWidget::OnSelectStructClicked()
 {
-    // 创建选择对话框
-    TArray<const UScriptStruct*> OutStructs;
-
-    FString ProjectName = FApp::GetProjectName();
-    
-    // 收集所有已注册的结构体
-    for (TObjectIterator<UScriptStruct> It; It; ++It)
-    {
-        const UScriptStruct* Struct = *It;
-
-        if (Struct->GetOutermost() == GetTransientPackage())
-        {
-            continue;
-        }
-        // PathName 打印结果为: /Script/ProjectName.StructName
-        FString PathName = Struct->GetPathName();
-        PathName = PathName.Replace(TEXT("/Script/"), TEXT(""));
-        if (PathName.StartsWith(ProjectName))
-        {
-            OutStructs.Add(Struct);
-        }
-    }
+    // 结构体列表来自缓存的索引，打开对话框时不再遍历所有结构体
+    StructSearchText = FText::GetEmpty();
+    RefreshStructList();
     
     // 获取当前 StructToJsonWidget 所在的窗口
     TSharedPtr<SWindow> ParentWindow = FSlateApplication::Get().FindWidgetWindow(AsShared());
@@ -132,31 +127,59 @@ FReply SStructToJsonWidget::OnSelectStructClicked()
     }
     
     // 显示结构体选择对话框
-    TSharedRef<SWindow> PickerWindow = SNew(SWindow)
+    TSharedRef<SWindow> Window = SNew(SWindow)
         .Title(NSLOCTEXT("StructToJson", "PickStruct", "选择一个结构体"))
         .ClientSize(FVector2D(500, 600))
         .SupportsMinimize(false)
         .SupportsMaximize(false);
+    PickerWindow = Window;
     
-    TSharedPtr<SListView<const UScriptStruct*>> ListView;
+    TSharedPtr<SSearchBox> SearchBox;
     
-    PickerWindow->SetContent(
+    Window->SetContent(
         SNew(SBorder)
         .BorderImage(FAppStyle::GetBrush("Menu.Background"))
         [
             SNew(SVerticalBox)
             + SVerticalBox::Slot()
-            .FillHeight(1.0f)
+            .AutoHeight()
+            .Padding(5)
             [
-                SAssignNew(ListView, SListView<const UScriptStruct*>)
-                .ListItemsSource(&OutStructs)
-                .OnGenerateRow_Lambda([](const UScriptStruct* InStruct, const TSharedRef<STableViewBase>& OwnerTable) {
-                    return SNew(STableRow<const UScriptStruct*>, OwnerTable)
+                SNew(SHorizontalBox)
+                + SHorizontalBox::Slot()
+                .FillWidth(1.0f)
+                [
+                    SAssignNew(SearchBox, SSearchBox)
+                    .HintText(NSLOCTEXT("StructToJson", "SearchHint", "输入结构体名或模块名，空格分隔多个词"))
+                    .OnTextChanged(this, &SStructToJsonWidget::OnStructSearchChanged)
+                    .OnTextCommitted(this, &SStructToJsonWidget::OnStructSearchCommitted)
+                ]
+                + SHorizontalBox::Slot()
+                .AutoWidth()
+                .VAlign(VAlign_Center)
+                .Padding(5, 0, 0, 0)
+                [
+                    SNew(SCheckBox)
+                    .IsChecked_Lambda([this]() { return bProjectStructsOnly ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+                    .OnCheckStateChanged_Lambda([this](ECheckBoxState InState) {
+                        bProjectStructsOnly = InState == ECheckBoxState::Checked;
+                        RefreshStructList();
+                    })
                     [
                         SNew(STextBlock)
-                        .Text(FText::FromString(InStruct->GetName()))
-                    ];
-                })
+                        .Text(NSLOCTEXT("StructToJson", "ProjectOnly", "仅项目模块"))
+                    ]
+                ]
+            ]
+            + SVerticalBox::Slot()
+            .FillHeight(1.0f)
+            [
+                // 列表只为可见的行生成控件
+                SAssignNew(StructListView, SListView<TSharedPtr<FStructPickerEntry>>)
+                .ListItemsSource(&FilteredStructs)
+                .SelectionMode(ESelectionMode::Single)
+                .OnGenerateRow(this, &SStructToJsonWidget::OnGenerateStructRow)
+                .OnMouseButtonDoubleClick(this, &SStructToJsonWidget::PickStruct)
             ]
             + SVerticalBox::Slot()
             .AutoHeight()
@@ -165,21 +188,21 @@ FReply SStructToJsonWidget::OnSelectStructClicked()
                 SNew(SHorizontalBox)
                 + SHorizontalBox::Slot()
                 .FillWidth(1.0f)
+                .VAlign(VAlign_Center)
+                [
+                    SNew(STextBlock)
+                    .Text_Lambda([this]() {
+                        return FText::Format(NSLOCTEXT("StructToJson", "StructCount", "{0} 个结构体"), FText::AsNumber(FilteredStructs.Num()));
+                    })
+                ]
                 + SHorizontalBox::Slot()
                 .AutoWidth()
                 [
                     SNew(SButton)
                     .Text(NSLOCTEXT("StructToJson", "Select", "选择"))
-                    .OnClicked_Lambda([this, ListView, &PickerWindow]() {
-                        if (ListView->GetNumItemsSelected() > 0)
-                        {
-                            UScriptStruct* SelectedStruct = const_cast<UScriptStruct*>(ListView->GetSelectedItems()[0]);
-                            this->SelectedStruct = SelectedStruct; // 直接赋值，不使用 MakeShareable
-                            this->StructData = MakeShareable(new FStructOnScope(SelectedStruct));
-                            this->StructureDetailsView->SetStructureData(this->StructData);
-                            this->DetailsViewBox->SetContent(this->StructureDetailsView->GetWidget().ToSharedRef());
-                        }
-                        PickerWindow->RequestDestroyWindow();
+                    .OnClicked_Lambda([this]() {
+                        TArray<TSharedPtr<FStructPickerEntry>> SelectedItems = StructListView->GetSelectedItems();
+                        PickStruct(SelectedItems.Num() > 0 ? SelectedItems[0] : nullptr);
                         return FReply::Handled();
                     })
                 ]
@@ -189,8 +212,8 @@ FReply SStructToJsonWidget::OnSelectStructClicked()
                 [
                     SNew(SButton)
                     .Text(NSLOCTEXT("StructToJson", "Cancel", "取消"))
-                    .OnClicked_Lambda([&PickerWindow]() {
-                        PickerWindow->RequestDestroyWindow();
+                    .OnClicked_Lambda([this]() {
+                        CloseStructPicker();
                         return FReply::Handled();
                     })
                 ]
@@ -198,11 +221,91 @@ FReply SStructToJsonWidget::OnSelectStructClicked()
         ]
     );
     
-    FSlateApplication::Get().AddModalWindow(PickerWindow, ParentWindow);
+    Window->SetWidgetToFocusOnActivate(SearchBox);
+    FSlateApplication::Get().AddModalWindow(Window, ParentWindow);
+    
+    StructListView.Reset();
+    FilteredStructs.Reset();
     
     return FReply::Handled();
 }
 
+void SStructToJsonWidget::RefreshStructList()
+{
+    FStructPickerIndex::Get().Filter(StructSearchText.ToString(), bProjectStructsOnly, FilteredStructs);
+    
+    if (StructListView.IsValid())
+    {
+        StructListView->RequestListRefresh();
+        
+        // 输入时默认选中第一项，回车直接选择
+        if (FilteredStructs.Num() > 0)
+        {
+            StructListView->SetSelection(FilteredStructs[0]);
+            StructListView->RequestScrollIntoView(FilteredStructs[0]);
+        }
+    }
+}
+
+void SStructToJsonWidget::OnStructSearchChanged(const FText& InText)
+{
+    StructSearchText = InText;
+    RefreshStructList();
+}
+
+void SStructToJsonWidget::OnStructSearchCommitted(const FText& InText, ETextCommit::Type InCommitType)
+{
+    if (InCommitType == ETextCommit::OnEnter && StructListView.IsValid())
+    {
+        TArray<TSharedPtr<FStructPickerEntry>> SelectedItems = StructListView->GetSelectedItems();
+        PickStruct(SelectedItems.Num() > 0 ? SelectedItems[0] : nullptr);
+    }
+}
+
+TSharedRef<ITableRow> SStructToJsonWidget::OnGenerateStructRow(TSharedPtr<FStructPickerEntry> InEntry, const TSharedRef<STableViewBase>& OwnerTable)
+{
+    return SNew(STableRow<TSharedPtr<FStructPickerEntry>>, OwnerTable)
+    [
+        SNew(SHorizontalBox)
+        + SHorizontalBox::Slot()
+        .FillWidth(1.0f)
+        [
+            SNew(STextBlock)
+            .Text(InEntry->DisplayName)
+            .HighlightText_Lambda([this]() { return StructSearchText; })
+        ]
+        + SHorizontalBox::Slot()
+        .AutoWidth()
+        [
+            SNew(STextBlock)
+            .Text(InEntry->ModuleDisplayName)
+            .ColorAndOpacity(FSlateColor::UseSubduedForeground())
+        ]
+    ];
+}
+
+void SStructToJsonWidget::PickStruct(TSharedPtr<FStructPickerEntry> InEntry)
+{
+    // 模块卸载后条目中的结构体可能已经无效
+    UScriptStruct* Struct = InEntry.IsValid() ? InEntry->Struct.Get() : nullptr;
+    if (Struct)
+    {
+        SelectedStruct = Struct;
+        StructData = MakeShareable(new FStructOnScope(Struct));
+        StructureDetailsView->SetStructureData(StructData);
+        DetailsViewBox->SetContent(StructureDetailsView->GetWidget().ToSharedRef());
+    }
+    CloseStructPicker();
+}
+
+void SStructToJsonWidget::CloseStructPicker()
+{
+    if (TSharedPtr<SWindow> Window = PickerWindow.Pin())
+    {
+        Window->RequestDestroyWindow();
+    }
+}
+
 FReply SStructToJsonWidget::OnExportToJsonClicked()
 {
     if (!SelectedStruct || !StructData.IsValid())
@@ -230,30 +333,14 @@ FReply SStructToJsonWidget::OnExportToJsonClicked()
         if (bFileSelected && SaveFilenames.Num() > 0)
         {
             SavePath = SaveFilenames[0];
-            FString JsonString;
             bool bSuccess = false;
             FString MessageContent;
             
-            // 创建临时变量来存储结构体数据的副本
-            UScriptStruct* TempStruct = SelectedStruct;
-            void* TempMemory = FMemory::Malloc(TempStruct->GetStructureSize());
-            TempStruct->InitializeStruct(TempMemory);
-            TempStruct->CopyScriptStruct(TempMemory, StructData->GetStructMemory());
-            
-            {
-                TSharedPtr<FJsonObject> JsonObject = MakeShareable(new FJsonObject);
-                FJsonObjectConverter::UStructToJsonObject(TempStruct, TempMemory, 
-                    JsonObject.ToSharedRef(), 0, 0);
-                
-                TSharedRef<TJsonWriter<>> Writer = TJsonWriterFactory<>::Create(&JsonString);
-                FJsonSerializer::Serialize(JsonObject.ToSharedRef(), Writer);
-            }
-            
-            // 清理临时内存
-            TempStruct->DestroyStruct(TempMemory);
-            FMemory::Free(TempMemory);
+            // 直接从编辑中的结构体内存写出UTF-8 JSON，不复制结构体也不构建FJsonObject
+            TArray<uint8> JsonData;
+            FRapidJsonStructWriter::Write(SelectedStruct, StructData->GetStructMemory(), JsonData, true);
             
-            if (FFileHelper::SaveStringToFile(JsonString, *SavePath))
+            if (FFileHelper::SaveArrayToFile(JsonData, *SavePath))
             {
                 MessageContent = FString::Printf(TEXT("已成功导出JSON到: %s"), *SavePath);
                 bSuccess = true;
@@ -275,5 +362,28 @@ FReply SStructToJsonWidget::OnExportToJsonClicked()
         }
     }
 
+    return FReply::Handled();
+}
+
+FReply SStructToJsonWidget::OnShowPlanClicked()
+{
+    if (!SelectedStruct)
+    {
+        return FReply::Handled();
+    }
+
+    // 完整的计划输出到日志，对话框只显示摘要
+    const TSharedRef<const FRapidJsonStructPlan> Plan = FRapidJsonStructPlan::Get(SelectedStruct);
+    UE_LOG(LogTemp, Log, TEXT("%s"), *Plan->Describe());
+
+    const FString MessageContent = FString::Printf(
+        TEXT("%s 的序列化计划:\n段: %d\n步骤: %d\n通用步骤: %d\n字面量: %d 字节\n\n完整内容已输出到日志"),
+        *SelectedStruct->GetName(),
+        Plan->GetBlocks().Num(),
+        Plan->GetSteps().Num(),
+        Plan->NumGenericSteps(),
+        Plan->GetLiterals().Num());
+    FMessageDialog::Open(EAppMsgType::Ok, FText::FromString(MessageContent));
+
     return FReply::Handled();
 }
\ No newline at end of file
@@ -5,6 +5,10 @@
 #include "Widgets/SCompoundWidget.h"
 #include "PropertyEditorModule.h"
 #include "IStructureDetailsView.h"
+#include "Widgets/Views/SListView.h"
+#include "Widgets/Views/STableRow.h"
+
+struct FStructPickerEntry;
 
 class SStructToJsonWidget : public SCompoundWidget
 {
@@ -19,10 +23,26 @@ public:
 private:
     FReply OnSelectStructClicked();
     FReply OnExportToJsonClicked();
+    FReply OnShowPlanClicked();
+
+    // 结构体选择对话框
+    void RefreshStructList();
+    void OnStructSearchChanged(const FText& InText);
+    void OnStructSearchCommitted(const FText& InText, ETextCommit::Type InCommitType);
+    TSharedRef<ITableRow> OnGenerateStructRow(TSharedPtr<FStructPickerEntry> InEntry, const TSharedRef<STableViewBase>& OwnerTable);
+    void PickStruct(TSharedPtr<FStructPickerEntry> InEntry);
+    void CloseStructPicker();
+
     bool IsStructSelected() const;
     TSharedPtr<SBox> DetailsViewBox;
     TSharedPtr<IStructureDetailsView> StructureDetailsView;
     UScriptStruct* SelectedStruct;
     TSharedPtr<FStructOnScope> StructData;
     FString SavePath;
+
+    TArray<TSharedPtr<FStructPickerEntry>> FilteredStructs;
+    TSharedPtr<SListView<TSharedPtr<FStructPickerEntry>>> StructListView;
+    TWeakPtr<SWindow> PickerWindow;
+    FText StructSearchText;
+    bool bProjectStructsOnly = true;
 };
\ No newline at end of file
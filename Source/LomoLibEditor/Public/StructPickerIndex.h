@@ -0,0 +1,87 @@
+﻿// Fill out your copyright notice in the Description page of Project Settings.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Modules/ModuleManager.h"
+#include "UObject/WeakObjectPtrTemplates.h"
+
+/** 索引中的一个结构体，名字和显示文本在建立索引时计算一次 */
+struct FStructPickerEntry
+{
+	TWeakObjectPtr<UScriptStruct> Struct;
+
+	/** 结构体名，用于搜索和排序 */
+	FString Name;
+
+	/** 所在的模块 */
+	FString Module;
+
+	FText DisplayName;
+	FText ModuleDisplayName;
+
+	/** 模块名以项目名开头 */
+	bool bProjectModule = false;
+};
+
+/**
+ * 结构体选择器使用的结构体索引
+ * - 按模块记录每个模块的/Script包中的结构体，第一次使用时建立
+ * - 模块加载和卸载时只更新对应模块，热重载后整体重建
+ * - 搜索只比较建立索引时缓存的名字，不再遍历所有UObject
+ * 只能在游戏线程使用
+ */
+class LOMOLIBEDITOR_API FStructPickerIndex
+{
+public:
+	~FStructPickerIndex();
+
+	static FStructPickerIndex& Get();
+
+	/** 注销回调并释放索引，模块关闭时调用 */
+	static void Shutdown();
+
+	/**
+	 * 按搜索文本过滤，空白分隔的每个词都要出现在结构体名或模块名中，不区分大小写
+	 * 以第一个词开头的结构体排在前面，其余按名字排序
+	 */
+	void Filter(const FString& InSearchText, bool bInProjectOnly, TArray<TSharedPtr<FStructPickerEntry>>& OutEntries);
+
+	/** 索引中结构体的数量 */
+	int32 Num(bool bInProjectOnly);
+
+	/** 索引有变化时递增，列表可以据此判断是否需要重新过滤 */
+	uint32 GetVersion() const { return Version; }
+
+private:
+	FStructPickerIndex();
+
+	/** 第一次使用时索引所有已加载的模块 */
+	void EnsureBuilt();
+
+	void IndexModule(FName InModuleName);
+
+	/** 合并各模块的条目并排序 */
+	void RebuildSortedEntries();
+
+	void HandleModulesChanged(FName InModuleName, EModuleChangeReason InReason);
+
+	void HandleReloadComplete(EReloadCompleteReason InReason);
+
+	void MarkDirty();
+
+	TMap<FName, TArray<TSharedPtr<FStructPickerEntry>>> EntriesByModule;
+
+	/** 按名字排序的全部条目 */
+	TArray<TSharedPtr<FStructPickerEntry>> SortedEntries;
+
+	FString ProjectName;
+
+	uint32 Version = 0;
+
+	bool bBuilt = false;
+	bool bSortedEntriesDirty = true;
+
+	FDelegateHandle ModulesChangedHandle;
+	FDelegateHandle ReloadCompleteHandle;
+};
@@ -19,7 +19,10 @@ public class LomoLibTest : ModuleRules
                 "CoreUObject",
                 "Engine",
                 "Slate",
-                "SlateCore", "LomoLib"
+                "SlateCore", "LomoLib", "LomoLibEditor",
+                "UnrealEd",
+                "Json",
+                "JsonUtilities"
             }
         );
     }
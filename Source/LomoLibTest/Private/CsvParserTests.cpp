@@ -0,0 +1,153 @@
+﻿#include "LomoLibTest.h"
+#include "ExcelDataTable/CsvParser.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCsvParserTest,
+	"LomoLib.Excel.CsvParser",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCsvParserBenchmarkTest,
+	"LomoLib.Excel.CsvParserBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCsvParserTest,
+	"LomoLib.Excel.CsvParser",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FCsvParserBenchmarkTest,
+	"LomoLib.Excel.CsvParserBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#endif
+
+namespace
+{
+	TArray<TArray<FString>> ParseCsv(const TCHAR* InText)
+	{
+		TArray<TArray<FString>> Rows;
+		FCsvParser Parser{ FString(InText) };
+		TArray<FStringView> Cells;
+		while (Parser.ReadRow(Cells))
+		{
+			TArray<FString>& Row = Rows.AddDefaulted_GetRef();
+			for (const FStringView& Cell : Cells)
+			{
+				// 单元格之后是'\0'，可以直接当作C字符串使用
+				check(Cell.GetData()[Cell.Len()] == TEXT('\0'));
+				Row.Emplace(Cell);
+			}
+		}
+		return Rows;
+	}
+}
+
+bool FCsvParserTest::RunTest(const FString& Parameters)
+{
+	using FRows = TArray<TArray<FString>>;
+
+	TestTrue(TEXT("空文本没有行"), ParseCsv(TEXT("")).IsEmpty());
+	TestTrue(TEXT("末尾的换行不产生空行"), ParseCsv(TEXT("a,b\r\nc,d\r\n")) == FRows{ { TEXT("a"), TEXT("b") }, { TEXT("c"), TEXT("d") } });
+	TestTrue(TEXT("\\n和\\r行尾"), ParseCsv(TEXT("a\nb\rc")) == FRows{ { TEXT("a") }, { TEXT("b") }, { TEXT("c") } });
+	TestTrue(TEXT("保留空单元格"), ParseCsv(TEXT(",a,,\n")) == FRows{ { TEXT(""), TEXT("a"), TEXT(""), TEXT("") } });
+	TestTrue(TEXT("空行是一个空单元格"), ParseCsv(TEXT("a\n\nb")) == FRows{ { TEXT("a") }, { TEXT("") }, { TEXT("b") } });
+	TestTrue(TEXT("引号字段中的逗号"), ParseCsv(TEXT("\"a,b\",c")) == FRows{ { TEXT("a,b"), TEXT("c") } });
+	TestTrue(TEXT("转义的引号"), ParseCsv(TEXT("\"say \"\"hi\"\"\",\"\"\"\"")) == FRows{ { TEXT("say \"hi\""), TEXT("\"") } });
+	TestTrue(TEXT("空的引号字段"), ParseCsv(TEXT("\"\",x")) == FRows{ { TEXT(""), TEXT("x") } });
+	TestTrue(TEXT("引号字段中的换行"), ParseCsv(TEXT("\"多行\r\n文本\",1\n2")) == FRows{ { TEXT("多行\r\n文本"), TEXT("1") }, { TEXT("2") } });
+	TestTrue(TEXT("未加引号字段中的引号按原样保留"), ParseCsv(TEXT("a\"b,c")) == FRows{ { TEXT("a\"b"), TEXT("c") } });
+	TestTrue(TEXT("闭合引号之后的内容"), ParseCsv(TEXT("\"ab\"cd,e")) == FRows{ { TEXT("abcd"), TEXT("e") } });
+	TestTrue(TEXT("未闭合的引号延续到末尾"), ParseCsv(TEXT("\"a,b\nc")) == FRows{ { TEXT("a,b\nc") } });
+	TestTrue(TEXT("结构体文本"), ParseCsv(TEXT("Row_1,\"(X=1.000000,Y=2.000000)\"")) == FRows{ { TEXT("Row_1"), TEXT("(X=1.000000,Y=2.000000)") } });
+
+	// 行号计入引号字段中的换行
+	FCsvParser Parser{ FString(TEXT("a\n\"b\nc\"\nd")) };
+	TArray<FStringView> Cells;
+	TArray<int32> LineNumbers;
+	while (Parser.ReadRow(Cells))
+	{
+		LineNumbers.Add(Parser.GetLineNumber());
+	}
+	TestTrue(TEXT("行号"), LineNumbers == TArray<int32>{ 1, 2, 4 });
+
+	return true;
+}
+
+bool FCsvParserBenchmarkTest::RunTest(const FString& Parameters)
+{
+	constexpr int32 NumRows = 100000;
+	constexpr int32 NumIterations = 3;
+
+	// 与导出的DataTable相同的形式：行名、数字、空单元格、带引号的结构体和多行文本
+	FString Text = TEXT("Row_Name,Id,Scale,Tag,Location,Description\nstring,int,float,name,struct:Vector,string\n");
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		Text += FString::Printf(TEXT("Row_%d,%d,%.3f,%s,\"(X=%d.000000,Y=0.000000,Z=1.000000)\",%s\n"),
+			Row, Row, Row * 0.25f, Row % 3 == 0 ? TEXT("") : TEXT("Tag"), Row,
+			Row % 10 == 0 ? TEXT("\"第一行\n\"\"第二行\"\"\"") : TEXT("描述"));
+	}
+
+	const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("CsvParserBenchmark.csv"));
+	TestTrue(TEXT("写入文件"), FFileHelper::SaveStringToFile(Text, *FilePath, FFileHelper::EEncodingOptions::ForceUTF8));
+	const int64 FileSize = IFileManager::Get().FileSize(*FilePath);
+
+	// 之前的实现：按行拆分再按逗号拆分，每个单元格一个FString
+	int32 OldCells = 0;
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FString FileContent;
+		FFileHelper::LoadFileToString(FileContent, *FilePath);
+
+		TArray<FString> Lines;
+		FileContent.ParseIntoArrayLines(Lines, false);
+
+		TArray<TArray<FString>> Rows;
+		for (const FString& Line : Lines)
+		{
+			TArray<FString> Values;
+			Line.ParseIntoArray(Values, TEXT(","), true);
+			OldCells += Values.Num();
+			Rows.Add(Values);
+		}
+	}
+	const double OldTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	int32 NumParsedRows = 0;
+	int32 NumCells = 0;
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FCsvParser Parser;
+		Parser.LoadFile(FilePath);
+
+		NumParsedRows = 0;
+		NumCells = 0;
+		TArray<FStringView> Cells;
+		while (Parser.ReadRow(Cells))
+		{
+			++NumParsedRows;
+			NumCells += Cells.Num();
+		}
+	}
+	const double ParserTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	TestEqual(TEXT("行数"), NumParsedRows, NumRows + 2);
+	TestEqual(TEXT("单元格数"), NumCells, (NumRows + 2) * 6);
+
+	const double FileSizeMB = FileSize / (1024.0 * 1024.0);
+	UE_LOG(LogLomoLibTests, Display, TEXT("CSV读取(%d行, %.1f MB): ParseIntoArray %.1f ms (%d个单元格), FCsvParser %.1f ms, %.0f MB/s, %.1fx"),
+		NumRows, FileSizeMB, OldTime * 1000.0, OldCells / NumIterations, ParserTime * 1000.0,
+		FileSizeMB / FMath::Max(ParserTime, UE_SMALL_NUMBER), OldTime / FMath::Max(ParserTime, UE_SMALL_NUMBER));
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
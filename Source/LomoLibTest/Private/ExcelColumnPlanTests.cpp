@@ -0,0 +1,122 @@
+﻿#include "LomoLibTest.h"
+#include "ExcelTestTypes.h"
+#include "ExcelDataTable/ExcelColumnPlan.h"
+#include "Misc/AutomationTest.h"
+#include "UObject/PropertyPortFlags.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelColumnPlanTest,
+	"LomoLib.Excel.ColumnPlan",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelColumnPlanTest,
+	"LomoLib.Excel.ColumnPlan",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#endif
+
+namespace
+{
+	/** 之前的导入方式：每个单元格按表头查找属性，再用ImportText解析 */
+	bool ImportRowByName(const UScriptStruct* InRowStruct, TConstArrayView<FString> InHeaders, TConstArrayView<FStringView> InCells, uint8* InRowData)
+	{
+		for (int32 Index = 1; Index < FMath::Min(InHeaders.Num(), InCells.Num()); ++Index)
+		{
+			FProperty* Property = InRowStruct->FindPropertyByName(*InHeaders[Index]);
+			if (Property && Property->ImportText_Direct(InCells[Index].GetData(), Property->ContainerPtrToValuePtr<void>(InRowData), nullptr, PPF_None, nullptr) == nullptr)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	/** 单元格视图，FString以'\0'结尾 */
+	TArray<FStringView> MakeCells(const TArray<FString>& InValues)
+	{
+		TArray<FStringView> Cells;
+		for (const FString& Value : InValues)
+		{
+			Cells.Emplace(*Value, Value.Len());
+		}
+		return Cells;
+	}
+}
+
+bool FExcelColumnPlanTest::RunTest(const FString& Parameters)
+{
+	const UScriptStruct* RowStruct = FExcelTestRow::StaticStruct();
+
+	// 与导出时相同的表头，最后一列在行结构中不存在
+	TArray<FString> Headers = { TEXT("Name") };
+	for (TFieldIterator<FProperty> PropIt(RowStruct); PropIt; ++PropIt)
+	{
+		Headers.Add(PropIt->GetName());
+	}
+	Headers.Add(TEXT("Removed"));
+
+	const FExcelColumnPlan Plan(RowStruct, Headers);
+	TestEqual(TEXT("列数"), Plan.GetColumns().Num(), Headers.Num());
+	TestEqual(TEXT("需要ImportText的列（枚举、结构体和数组）"), Plan.NumGenericColumns(), 3);
+	TestTrue(TEXT("找不到的列跳过"), Plan.GetColumns().Last().Op == EExcelColumnOp::Skip);
+
+	// 顺序与行结构中的属性相同：Id Count Level Rarity Flags Armor Cost Weight Speed Ratio bEnabled bHidden Tag Category Title Description Kind Location Scores
+	const TArray<TArray<FString>> Rows = {
+		// 导出时的写法，全部走快速解析
+		{ TEXT("Row_1"), TEXT("42"), TEXT("-9000000000"), TEXT("200"), TEXT("-300"), TEXT("4000000000"), TEXT("7"), TEXT("0"), TEXT("0.25"), TEXT("1e-3"), TEXT("0.1"),
+			TEXT("True"), TEXT("true"), TEXT("Tag_A"), TEXT("None"), TEXT("标题, 带逗号"), TEXT(""), TEXT("Shield"), TEXT("(X=1.000000,Y=2.000000,Z=3.000000)"), TEXT("(1,2,3)"), TEXT("多余") },
+		// 其他写法交给ImportText，结果与之前相同
+		{ TEXT("Row_2"), TEXT("0x10"), TEXT(" 5"), TEXT("-1"), TEXT("1.5"), TEXT("+8"), TEXT("3.9"), TEXT(""), TEXT("1.5f"), TEXT("-.5"), TEXT("1E+2"),
+			TEXT("Yes"), TEXT("0"), TEXT(""), TEXT("中文名称"), TEXT("\"引号\""), TEXT("多行\n文本"), TEXT("Sword"), TEXT("(X=1,Y=2,Z=3)"), TEXT("()") },
+		// 超出属性类型范围的整数交给ImportText，不在快速解析中截断
+		{ TEXT("Row_5"), TEXT("3000000000"), TEXT("999999999999999999"), TEXT("256"), TEXT("-40000"), TEXT("-1"), TEXT("-2147483649") },
+		// 缺少的列保持默认值
+		{ TEXT("Row_3"), TEXT("1"), TEXT("2") },
+		// ImportText失败的行
+		{ TEXT("Row_4"), TEXT("1"), TEXT("2"), TEXT("3"), TEXT("4"), TEXT("5"), TEXT("6"), TEXT("7"), TEXT("8"), TEXT("9"), TEXT("10"),
+			TEXT("False"), TEXT("False"), TEXT("A"), TEXT("B"), TEXT("C"), TEXT("D"), TEXT("NotAKind") },
+	};
+
+	for (const TArray<FString>& Values : Rows)
+	{
+		const TArray<FStringView> Cells = MakeCells(Values);
+
+		FExcelTestRow ExpectedRow;
+		const bool bExpected = ImportRowByName(RowStruct, Headers, Cells, reinterpret_cast<uint8*>(&ExpectedRow));
+
+		FExcelTestRow PlanRow;
+		int32 FailedColumn = INDEX_NONE;
+		const bool bPlan = Plan.ImportRow(Cells, reinterpret_cast<uint8*>(&PlanRow), FailedColumn);
+
+		TestEqual(FString::Printf(TEXT("%s 导入结果"), *Values[0]), bPlan, bExpected);
+		TestTrue(FString::Printf(TEXT("%s 与按名称导入相同"), *Values[0]), RowStruct->CompareScriptStruct(&ExpectedRow, &PlanRow, PPF_None));
+	}
+
+	// 宽表格的导入时间
+	constexpr int32 NumRows = 20000;
+	const TArray<FStringView> Cells = MakeCells(Rows[0]);
+	FExcelTestRow Row;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Index = 0; Index < NumRows; ++Index)
+	{
+		ImportRowByName(RowStruct, Headers, Cells, reinterpret_cast<uint8*>(&Row));
+	}
+	const double ByNameTime = FPlatformTime::Seconds() - StartTime;
+
+	StartTime = FPlatformTime::Seconds();
+	int32 FailedColumn = INDEX_NONE;
+	for (int32 Index = 0; Index < NumRows; ++Index)
+	{
+		Plan.ImportRow(Cells, reinterpret_cast<uint8*>(&Row), FailedColumn);
+	}
+	const double PlanTime = FPlatformTime::Seconds() - StartTime;
+
+	UE_LOG(LogLomoLibTests, Display, TEXT("Excel行导入(%d行, %d列, 通用列%d): FindPropertyByName+ImportText %.1f ms, 列计划 %.1f ms, %.1fx"),
+		NumRows, Headers.Num(), Plan.NumGenericColumns(), ByNameTime * 1000.0, PlanTime * 1000.0, ByNameTime / FMath::Max(PlanTime, UE_SMALL_NUMBER));
+
+	return true;
+}
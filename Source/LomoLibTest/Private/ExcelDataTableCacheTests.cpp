@@ -0,0 +1,138 @@
+﻿#include "LomoLibTest.h"
+#include "ExcelTestTypes.h"
+#include "DataTableEditorUtils.h"
+#include "ExcelDataTable/ExcelDataTableCache.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/StructOnScope.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelDataTableCacheTest,
+	"LomoLib.Excel.DataTableCache",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelDataTableCacheTest,
+	"LomoLib.Excel.DataTableCache",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#endif
+
+namespace ExcelDataTableCacheTests
+{
+	/** 缓存中一行的Id，读取失败时返回INDEX_NONE */
+	int32 ReadCachedId(const FExcelDataTableCache& InCache, FName InRowName)
+	{
+		for (int32 Index = 0; Index < InCache.Num(); ++Index)
+		{
+			if (InCache.GetRowName(Index) == InRowName)
+			{
+				FStructOnScope Row(FExcelTestRow::StaticStruct());
+				return InCache.ReadRow(Index, FExcelTestRow::StaticStruct(), Row.GetStructMemory()) ? reinterpret_cast<const FExcelTestRow*>(Row.GetStructMemory())->Id : INDEX_NONE;
+			}
+		}
+		return INDEX_NONE;
+	}
+}
+
+bool FExcelDataTableCacheTest::RunTest(const FString& Parameters)
+{
+	using namespace ExcelDataTableCacheTests;
+
+	const FExcelImportTestFixture Fixture(TEXT("ExcelDataTableCache"));
+	if (!Fixture.Converter)
+	{
+		AddError(TEXT("需要在编辑器中运行"));
+		return false;
+	}
+
+	// 先导入一次得到哈希和缓存
+	UExcelDataTableConverter* Converter = Fixture.Converter;
+	UExcelDataTableSettings* Settings = Fixture.Settings;
+	UDataTable* DataTable = Fixture.DataTable;
+	const FString& DataTablePath = Fixture.DataTablePath;
+	const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("ExcelDataTableCache.csv"));
+	const FString CachePath = FExcelDataTableCache::GetCachePath(DataTablePath);
+
+	TestTrue(TEXT("写入文件"), FFileHelper::SaveStringToFile(TEXT("Row_Name,Id,Title\nstring,int,string\nA,1,a\nB,2,b\n"), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8));
+	const FExcelOperationResult Result = Converter->ImportExcelToDataTable(DataTablePath, FilePath, FString());
+	TestTrue(FString::Printf(TEXT("导入 %s"), *Result.Message), Result.bSuccess);
+
+	const FExcelDataTableImportHashes* ImportedHashes = Settings->FindImportHashes(FSoftObjectPath(DataTablePath));
+	if (!TestNotNull(TEXT("导入的哈希"), ImportedHashes))
+	{
+		return false;
+	}
+	const FExcelDataTableImportHashes Hashes = *ImportedHashes;
+	TestEqual(TEXT("缓存的源哈希"), FExcelDataTableCache::ReadSourceHash(DataTablePath), Hashes.SourceHash);
+
+	// 从DataTable写入缓存后重新打开
+	DataTable->FindRow<FExcelTestRow>(TEXT("A"), FString())->Id = 10;
+	const TArray<FString> Headers = { TEXT("Name"), TEXT("Id"), TEXT("Title") };
+	TestTrue(TEXT("写入缓存"), FExcelDataTableCache::Write(DataTablePath, DataTable, Headers, Hashes));
+	{
+		FExcelDataTableCache Cache;
+		TestTrue(TEXT("打开缓存"), Cache.Open(DataTablePath, Hashes.SourceHash, Hashes.SchemaHash));
+		TestEqual(TEXT("缓存的行数"), Cache.Num(), 2);
+		TestTrue(TEXT("缓存的表头"), Cache.GetHeaders() == Headers);
+		TestEqual(TEXT("缓存的行"), ReadCachedId(Cache, TEXT("A")), 10);
+		TestEqual(TEXT("缓存的行哈希"), Cache.GetRowHash(0), Hashes.RowHashes.FindRef(Cache.GetRowName(0)));
+
+		TestFalse(TEXT("源哈希不同时不打开"), Cache.Open(DataTablePath, Hashes.SourceHash + 1, Hashes.SchemaHash));
+		TestFalse(TEXT("行结构哈希不同时不打开"), Cache.Open(DataTablePath, Hashes.SourceHash, Hashes.SchemaHash + 1));
+	}
+
+	// 行不是导入的结果时不写入
+	{
+		FExcelDataTableImportHashes PartialHashes = Hashes;
+		PartialHashes.RowHashes.Remove(FName(TEXT("B")));
+		TestFalse(TEXT("缺少行哈希时不写入"), FExcelDataTableCache::Write(DataTablePath, DataTable, Headers, PartialHashes));
+	}
+
+	// 截断的文件
+	TArray<uint8> CacheBytes;
+	TestTrue(TEXT("读取缓存文件"), FFileHelper::LoadFileToArray(CacheBytes, *CachePath));
+	for (const int32 TruncatedSize : { 8, CacheBytes.Num() / 2, CacheBytes.Num() - 1 })
+	{
+		const TArray<uint8> TruncatedBytes(CacheBytes.GetData(), TruncatedSize);
+		TestTrue(TEXT("写入截断的缓存"), FFileHelper::SaveArrayToFile(TruncatedBytes, *CachePath));
+
+		FExcelDataTableCache Cache;
+		TestFalse(FString::Printf(TEXT("截断为 %d 字节时不打开"), TruncatedSize), Cache.Open(DataTablePath, Hashes.SourceHash, Hashes.SchemaHash));
+	}
+	TestTrue(TEXT("恢复缓存文件"), FFileHelper::SaveArrayToFile(CacheBytes, *CachePath));
+
+	// DataTable被还原后，文件没有变化时从缓存恢复；缓存中A的值与文件不同，可以确认没有重新解析
+	DataTable->EmptyTable();
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	const FExcelOperationResult RestoreResult = Converter->ImportExcelToDataTable(DataTablePath, FilePath, FString());
+	TestTrue(FString::Printf(TEXT("从缓存恢复 %s"), *RestoreResult.Message), RestoreResult.bSuccess);
+	TestEqual(TEXT("恢复的行数"), DataTable->GetRowMap().Num(), 2);
+	TestEqual(TEXT("从缓存恢复的行"), Fixture.GetRowId(TEXT("A")), 10);
+	TestEqual(TEXT("恢复的其他行"), Fixture.GetRowId(TEXT("B")), 2);
+
+	// 文件变化且DataTable被修改后，表头相同时哈希相同的行从缓存读取，其他行重新解析
+	DataTable->EmptyTable();
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	TestTrue(TEXT("修改文件"), FFileHelper::SaveStringToFile(TEXT("Row_Name,Id,Title\nstring,int,string\nA,1,a\nB,3,b\n"), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8));
+	const FExcelOperationResult ChangedResult = Converter->ImportExcelToDataTable(DataTablePath, FilePath, FString());
+	TestTrue(FString::Printf(TEXT("文件变化后导入 %s"), *ChangedResult.Message), ChangedResult.bSuccess);
+	TestEqual(TEXT("哈希相同的行从缓存读取"), Fixture.GetRowId(TEXT("A")), 10);
+	TestEqual(TEXT("变化的行重新解析"), Fixture.GetRowId(TEXT("B")), 3);
+
+	// 表头与缓存不同时行的哈希不可比，不使用缓存
+	DataTable->EmptyTable();
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowList);
+	TestTrue(TEXT("修改表头"), FFileHelper::SaveStringToFile(TEXT("Row_Name,Title,Id\nstring,string,int\nA,a,1\nB,b,3\n"), *FilePath, FFileHelper::EEncodingOptions::ForceUTF8));
+	const FExcelOperationResult HeaderResult = Converter->ImportExcelToDataTable(DataTablePath, FilePath, FString());
+	TestTrue(FString::Printf(TEXT("表头变化后导入 %s"), *HeaderResult.Message), HeaderResult.bSuccess);
+	TestEqual(TEXT("表头不同时不使用缓存"), Fixture.GetRowId(TEXT("A")), 1);
+
+	IFileManager::Get().Delete(*FilePath);
+	IFileManager::Get().Delete(*CachePath);
+	return true;
+}
@@ -0,0 +1,123 @@
+﻿#include "LomoLibTest.h"
+#include "ExcelTestTypes.h"
+#include "DataTableEditorUtils.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelIncrementalImportTest,
+	"LomoLib.Excel.IncrementalImport",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FExcelIncrementalImportTest,
+	"LomoLib.Excel.IncrementalImport",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#endif
+
+namespace ExcelIncrementalImportTests
+{
+	/** 写入导入用的CSV，前两行是表头和类型行 */
+	bool WriteCsv(const FString& InFilePath, TConstArrayView<const TCHAR*> InRows)
+	{
+		FString Text = TEXT("Row_Name,Id,Title\nstring,int,string\n");
+		for (const TCHAR* Row : InRows)
+		{
+			Text += Row;
+			Text += TEXT("\n");
+		}
+		return FFileHelper::SaveStringToFile(Text, *InFilePath, FFileHelper::EEncodingOptions::ForceUTF8);
+	}
+}
+
+bool FExcelIncrementalImportTest::RunTest(const FString& Parameters)
+{
+	using namespace ExcelIncrementalImportTests;
+
+	const FExcelImportTestFixture Fixture(TEXT("ExcelIncrementalImport"));
+	if (!Fixture.Converter)
+	{
+		AddError(TEXT("需要在编辑器中运行"));
+		return false;
+	}
+
+	UExcelDataTableSettings* Settings = Fixture.Settings;
+	UPackage* Package = Fixture.Package;
+	UDataTable* DataTable = Fixture.DataTable;
+	const FString& DataTablePath = Fixture.DataTablePath;
+	const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("ExcelIncrementalImport.csv"));
+
+	// 每次导入前清除已修改标记，导入后检查是否真的修改了DataTable
+	auto Import = [&](TConstArrayView<const TCHAR*> InRows)
+	{
+		Package->SetDirtyFlag(false);
+		TestTrue(TEXT("写入文件"), WriteCsv(FilePath, InRows));
+		return Fixture.Converter->ImportExcelToDataTable(DataTablePath, FilePath, FString());
+	};
+
+	// 首次导入所有行
+	FExcelOperationResult Result = Import({ TEXT("A,1,a"), TEXT("B,2,b"), TEXT("C,3,c") });
+	TestTrue(FString::Printf(TEXT("首次导入 %s"), *Result.Message), Result.bSuccess);
+	TestEqual(TEXT("首次导入的行数"), DataTable->GetRowMap().Num(), 3);
+	TestEqual(TEXT("首次导入没有未变化的行"), Result.UnchangedRows, 0);
+	TestTrue(TEXT("首次导入后已修改"), Package->IsDirty());
+
+	// 文件没有变化时跳过
+	Result = Import({ TEXT("A,1,a"), TEXT("B,2,b"), TEXT("C,3,c") });
+	TestEqual(TEXT("文件未变化时跳过所有行"), Result.UnchangedRows, 3);
+	TestFalse(TEXT("文件未变化时不修改"), Package->IsDirty());
+
+	// 修改一行，只重新导入这一行
+	Result = Import({ TEXT("A,1,a"), TEXT("B,20,b"), TEXT("C,3,c") });
+	TestEqual(TEXT("修改一行后的未变化行数"), Result.UnchangedRows, 2);
+	TestEqual(TEXT("修改的行"), Fixture.GetRowId(TEXT("B")), 20);
+	TestTrue(TEXT("修改一行后已修改"), Package->IsDirty());
+
+	// 删除一行
+	Result = Import({ TEXT("A,1,a"), TEXT("B,20,b") });
+	TestEqual(TEXT("删除一行后的未变化行数"), Result.UnchangedRows, 2);
+	TestEqual(TEXT("删除一行后的行数"), DataTable->GetRowMap().Num(), 2);
+	TestEqual(TEXT("删除的行"), Fixture.GetRowId(TEXT("C")), INDEX_NONE);
+	TestTrue(TEXT("删除一行后已修改"), Package->IsDirty());
+
+	// DataTable在导入之后被修改，与在编辑器中编辑一样通知修改，上次的哈希不再可信，文件没有变化时从缓存恢复
+	DataTable->FindRow<FExcelTestRow>(TEXT("A"), FString())->Id = 99;
+	FDataTableEditorUtils::BroadcastPostChange(DataTable, FDataTableEditorUtils::EDataTableChangeInfo::RowData);
+	Result = Import({ TEXT("A,1,a"), TEXT("B,20,b") });
+	TestEqual(TEXT("DataTable被修改后不跳过"), Result.UnchangedRows, 0);
+	TestEqual(TEXT("被修改的行恢复为导入的值"), Fixture.GetRowId(TEXT("A")), 1);
+	TestTrue(TEXT("恢复后已修改"), Package->IsDirty());
+
+	// 重复的行名由后面的行覆盖前面的行，修改前面的行后结果不变
+	Result = Import({ TEXT("A,1,a"), TEXT("B,20,b"), TEXT("A,5,e") });
+	TestEqual(TEXT("重复的行名使用后面的行"), Fixture.GetRowId(TEXT("A")), 5);
+	TestEqual(TEXT("重复的行名只有一行"), DataTable->GetRowMap().Num(), 2);
+	Result = Import({ TEXT("A,7,a"), TEXT("B,20,b"), TEXT("A,5,e") });
+	TestEqual(TEXT("修改前面的重复行后仍使用后面的行"), Fixture.GetRowId(TEXT("A")), 5);
+
+	// 行结构变化后上次的哈希不再可信，所有行重新比较，内容相同时不修改
+	auto ChangeSchemaHash = [&]()
+	{
+		FExcelDataTableImportHashes Hashes = *Settings->FindImportHashes(FSoftObjectPath(DataTablePath));
+		Hashes.SchemaHash ^= 1;
+		Settings->SetImportHashes(FSoftObjectPath(DataTablePath), MoveTemp(Hashes), false);
+	};
+	ChangeSchemaHash();
+	Result = Import({ TEXT("A,7,a"), TEXT("B,20,b"), TEXT("A,5,e") });
+	TestEqual(TEXT("行结构变化后不跳过"), Result.UnchangedRows, 0);
+	TestFalse(TEXT("行结构变化但内容相同时不修改"), Package->IsDirty());
+
+	ChangeSchemaHash();
+	Result = Import({ TEXT("A,7,a"), TEXT("B,21,b"), TEXT("A,5,e") });
+	TestEqual(TEXT("行结构变化后所有行重新导入"), Result.UnchangedRows, 0);
+	TestEqual(TEXT("行结构变化后修改的行"), Fixture.GetRowId(TEXT("B")), 21);
+	TestTrue(TEXT("行结构变化并修改一行后已修改"), Package->IsDirty());
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}
@@ -0,0 +1,131 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "Editor.h"
+#include "Engine/DataTable.h"
+#include "ExcelDataTable/ExcelDataTableConverter.h"
+#include "ExcelDataTable/ExcelDataTableSettings.h"
+#include "JsonStructTestTypes.h"
+#include "UObject/Package.h"
+#include "ExcelTestTypes.generated.h"
+
+/**
+ * Excel导入测试用的宽表格行，覆盖快速解析的类型和需要ImportText的类型
+ */
+USTRUCT()
+struct FExcelTestRow : public FTableRowBase
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	int32 Id = 0;
+
+	UPROPERTY(EditAnywhere)
+	int64 Count = 0;
+
+	UPROPERTY(EditAnywhere)
+	uint8 Level = 0;
+
+	UPROPERTY(EditAnywhere)
+	int16 Rarity = 0;
+
+	UPROPERTY(EditAnywhere)
+	uint32 Flags = 0;
+
+	UPROPERTY(EditAnywhere)
+	int32 Armor = 0;
+
+	UPROPERTY(EditAnywhere)
+	int32 Cost = 0;
+
+	UPROPERTY(EditAnywhere)
+	float Weight = 0.f;
+
+	UPROPERTY(EditAnywhere)
+	float Speed = 0.f;
+
+	UPROPERTY(EditAnywhere)
+	double Ratio = 0.0;
+
+	UPROPERTY(EditAnywhere)
+	bool bEnabled = false;
+
+	UPROPERTY(EditAnywhere)
+	uint8 bHidden : 1;
+
+	UPROPERTY(EditAnywhere)
+	FName Tag;
+
+	UPROPERTY(EditAnywhere)
+	FName Category;
+
+	UPROPERTY(EditAnywhere)
+	FString Title;
+
+	UPROPERTY(EditAnywhere)
+	FString Description;
+
+	UPROPERTY(EditAnywhere)
+	ERapidJsonTestItemKind Kind = ERapidJsonTestItemKind::None;
+
+	UPROPERTY(EditAnywhere)
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY(EditAnywhere)
+	TArray<int32> Scores;
+
+	FExcelTestRow()
+		: bHidden(false)
+	{
+	}
+};
+
+/**
+ * 导入测试用的DataTable：只在内存中的/Temp包，行结构为FExcelTestRow，包不保存，导入的哈希不写入哈希文件
+ * 构造时开启增量导入，析构时删除导入的哈希、恢复设置并回收DataTable
+ */
+struct FExcelImportTestFixture
+{
+	explicit FExcelImportTestFixture(const TCHAR* InName)
+	{
+		Converter = GEditor ? GEditor->GetEditorSubsystem<UExcelDataTableConverter>() : nullptr;
+
+		Settings = GetMutableDefault<UExcelDataTableSettings>();
+		bWasIncremental = Settings->bIncrementalImport;
+		Settings->bIncrementalImport = true;
+
+		Package = CreatePackage(*FString::Printf(TEXT("/Temp/LomoLibTests/%s_%s"), InName, *FGuid::NewGuid().ToString()));
+		DataTable = NewObject<UDataTable>(Package, TEXT("TestTable"));
+		DataTable->RowStruct = FExcelTestRow::StaticStruct();
+		DataTablePath = DataTable->GetPathName();
+	}
+
+	~FExcelImportTestFixture()
+	{
+		Settings->RemoveImportHashes(FSoftObjectPath(DataTablePath));
+		Settings->bIncrementalImport = bWasIncremental;
+		Package->SetDirtyFlag(false);
+		DataTable->MarkAsGarbage();
+		Package->MarkAsGarbage();
+	}
+
+	UE_NONCOPYABLE(FExcelImportTestFixture);
+
+	/** 行的Id，行不存在时返回INDEX_NONE */
+	int32 GetRowId(FName InRowName) const
+	{
+		const FExcelTestRow* Row = DataTable->FindRow<FExcelTestRow>(InRowName, FString(), false);
+		return Row ? Row->Id : INDEX_NONE;
+	}
+
+	/** 不在编辑器中运行时为空 */
+	UExcelDataTableConverter* Converter = nullptr;
+
+	UExcelDataTableSettings* Settings = nullptr;
+	UPackage* Package = nullptr;
+	UDataTable* DataTable = nullptr;
+	FString DataTablePath;
+
+private:
+	bool bWasIncremental = false;
+};
@@ -0,0 +1,80 @@
+﻿#pragma once
+
+#include "CoreMinimal.h"
+#include "JsonStructTestTypes.generated.h"
+
+UENUM()
+enum class ERapidJsonTestItemKind : uint8
+{
+	None,
+	Sword,
+	Shield,
+	Potion,
+};
+
+/**
+ * Json读写测试用的物品
+ */
+USTRUCT()
+struct FRapidJsonTestItem
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	int32 Id = 0;
+
+	UPROPERTY()
+	FString Name;
+
+	UPROPERTY()
+	FName Tag;
+
+	UPROPERTY()
+	ERapidJsonTestItemKind Kind = ERapidJsonTestItemKind::None;
+
+	UPROPERTY()
+	float Weight = 0.f;
+
+	UPROPERTY()
+	double Durability = 0.0;
+
+	UPROPERTY()
+	bool bEquipped = false;
+
+	UPROPERTY()
+	FVector Location = FVector::ZeroVector;
+
+	UPROPERTY()
+	TArray<int32> Upgrades;
+
+	/** 运行时缓存，不写入Json */
+	UPROPERTY(Transient)
+	int32 CachedScore = 0;
+};
+
+/**
+ * Json读写测试用的存档，覆盖嵌套结构体、数组、映射、集合和ExportText结构体
+ */
+USTRUCT()
+struct FRapidJsonTestSave
+{
+	GENERATED_BODY()
+
+	UPROPERTY()
+	FString SlotName;
+
+	UPROPERTY()
+	int64 PlayTime = 0;
+
+	UPROPERTY()
+	FGuid SaveId;
+
+	UPROPERTY()
+	TArray<FRapidJsonTestItem> Items;
+
+	UPROPERTY()
+	TMap<FString, int32> Counters;
+
+	UPROPERTY()
+	TSet<FName> UnlockedTags;
+};
@@ -0,0 +1,280 @@
+﻿#include "LomoLibTest.h"
+#include "JsonStructTestTypes.h"
+#include "JsonObjectConverter.h"
+#include "LomoLibBlueprintFunctionLibrary.h"
+#include "Misc/AutomationTest.h"
+#include "RapidUI/JsonPanel/RapidJsonStructPlan.h"
+#include "RapidUI/JsonPanel/RapidJsonStructReader.h"
+#include "RapidUI/JsonPanel/RapidJsonStructWriter.h"
+
+namespace RapidJsonStructTests
+{
+	/** 生成测试存档，数值都可以精确表示，方便与FJsonObjectConverter的结果比较 */
+	FRapidJsonTestSave MakeTestSave(int32 InNumItems)
+	{
+		FRapidJsonTestSave Save;
+		Save.SlotName = TEXT("存档 \"1\"\n\t\\");
+		Save.PlayTime = 123456789012LL;
+		Save.SaveId = FGuid(1, 2, 3, 4);
+
+		Save.Items.Reserve(InNumItems);
+		for (int32 Index = 0; Index < InNumItems; ++Index)
+		{
+			FRapidJsonTestItem& Item = Save.Items.AddDefaulted_GetRef();
+			Item.Id = Index - InNumItems / 2;
+			Item.Name = FString::Printf(TEXT("物品_%d"), Index);
+			Item.Tag = FName(TEXT("Tag"), Index % 16);
+			Item.Kind = static_cast<ERapidJsonTestItemKind>(Index % 4);
+			Item.Weight = 0.5f * Index;
+			Item.Durability = 0.25 * Index;
+			Item.bEquipped = Index % 3 == 0;
+			Item.Location = FVector(Index, Index * 2, -Index);
+			Item.Upgrades = { Index, Index + 1, Index + 2 };
+		}
+
+		for (int32 Index = 0; Index < 32; ++Index)
+		{
+			Save.Counters.Add(FString::Printf(TEXT("Counter%d"), Index), Index * 10);
+			Save.UnlockedTags.Add(FName(TEXT("Unlocked"), Index));
+		}
+		return Save;
+	}
+
+	bool IsSameSave(const FRapidJsonTestSave& A, const FRapidJsonTestSave& B)
+	{
+		return FRapidJsonTestSave::StaticStruct()->CompareScriptStruct(&A, &B, PPF_None);
+	}
+
+	FString Utf8ToString(const TArray<uint8>& InData)
+	{
+		const FUTF8ToTCHAR Converter(reinterpret_cast<const ANSICHAR*>(InData.GetData()), InData.Num());
+		return FString(Converter.Length(), Converter.Get());
+	}
+}
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRapidJsonStructRoundTripTest,
+	"LomoLib.Json.StructRoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRapidJsonStructBenchmark,
+	"LomoLib.Json.StructBenchmark",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::PerfFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRapidJsonStructRoundTripTest,
+	"LomoLib.Json.StructRoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FRapidJsonStructBenchmark,
+	"LomoLib.Json.StructBenchmark",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::PerfFilter
+);
+#endif
+
+bool FRapidJsonStructRoundTripTest::RunTest(const FString& Parameters)
+{
+	using namespace RapidJsonStructTests;
+
+	const FRapidJsonTestSave Save = MakeTestSave(64);
+	const UScriptStruct* SaveStruct = FRapidJsonTestSave::StaticStruct();
+
+	// 自身的写入和读取
+	for (const bool bPrettyPrint : { false, true })
+	{
+		TArray<uint8> JsonData;
+		FRapidJsonStructWriter::Write(SaveStruct, &Save, JsonData, bPrettyPrint);
+
+		FRapidJsonTestSave Loaded;
+		FString Error;
+		TestTrue(TEXT("读取写出的Json"), FRapidJsonStructReader::Read(SaveStruct, &Loaded, JsonData, &Error));
+		TestTrue(FString::Printf(TEXT("往返后相同 (bPrettyPrint=%d) %s"), bPrettyPrint, *Error), IsSameSave(Save, Loaded));
+	}
+
+	// FJsonObjectConverter能读取写出的Json
+	{
+		TArray<uint8> JsonData;
+		FRapidJsonStructWriter::Write(SaveStruct, &Save, JsonData);
+
+		FRapidJsonTestSave Loaded;
+		TestTrue(TEXT("FJsonObjectConverter读取"), FJsonObjectConverter::JsonObjectStringToUStruct(Utf8ToString(JsonData), &Loaded, 0, 0));
+		TestTrue(TEXT("FJsonObjectConverter读取后相同"), IsSameSave(Save, Loaded));
+	}
+
+	// 能读取FJsonObjectConverter写出的Json
+	{
+		FString JsonString;
+		FJsonObjectConverter::UStructToJsonObjectString(Save, JsonString);
+
+		const FTCHARToUTF8 Converter(*JsonString, JsonString.Len());
+		FRapidJsonTestSave Loaded;
+		FString Error;
+		TestTrue(TEXT("读取FJsonObjectConverter的Json"), FRapidJsonStructReader::Read(SaveStruct, &Loaded, TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length()), &Error));
+		TestTrue(FString::Printf(TEXT("读取FJsonObjectConverter的Json后相同 %s"), *Error), IsSameSave(Save, Loaded));
+	}
+
+	// 与FJsonObjectConverter一样跳过Transient属性
+	{
+		FRapidJsonTestSave TransientSave = Save;
+		TransientSave.Items[0].CachedScore = 99;
+
+		FString ConverterJson;
+		FJsonObjectConverter::UStructToJsonObjectString(TransientSave, ConverterJson);
+		TestFalse(TEXT("FJsonObjectConverter不写出Transient属性"), ConverterJson.Contains(TEXT("cachedScore")));
+
+		TArray<uint8> JsonData;
+		FRapidJsonStructWriter::Write(SaveStruct, &TransientSave, JsonData);
+		TestFalse(TEXT("不写出Transient属性"), Utf8ToString(JsonData).Contains(TEXT("cachedScore")));
+
+		// Json中带有Transient属性的键时忽略
+		const FString JsonString = TEXT("{\"items\":[{\"id\":7,\"cachedScore\":99}]}");
+		const FTCHARToUTF8 Converter(*JsonString, JsonString.Len());
+		FRapidJsonTestSave Loaded;
+		FString Error;
+		TestTrue(TEXT("读取带Transient键的Json"), FRapidJsonStructReader::Read(SaveStruct, &Loaded, TConstArrayView<uint8>(reinterpret_cast<const uint8*>(Converter.Get()), Converter.Length()), &Error));
+		if (TestEqual(TEXT("读取物品"), Loaded.Items.Num(), 1))
+		{
+			TestEqual(TEXT("读取Id"), Loaded.Items[0].Id, 7);
+			TestEqual(TEXT("不读取Transient属性"), Loaded.Items[0].CachedScore, 0);
+		}
+	}
+
+	// 计划的输出与紧凑格式相同，并且能按计划读回
+	{
+		const TSharedRef<const FRapidJsonStructPlan> Plan = FRapidJsonStructPlan::Get(SaveStruct);
+		TestEqual(TEXT("计划缓存"), &Plan.Get(), &FRapidJsonStructPlan::Get(SaveStruct).Get());
+
+		TArray<uint8> JsonData;
+		FRapidJsonStructWriter::Write(SaveStruct, &Save, JsonData);
+
+		TArray<uint8> PlanJsonData;
+		FRapidJsonStructWriter PlanWriter(PlanJsonData);
+		PlanWriter.WritePlan(*Plan, &Save);
+		TestTrue(TEXT("计划的输出与紧凑格式相同"), JsonData == PlanJsonData);
+
+		FRapidJsonTestSave Loaded;
+		FRapidJsonStructReader Reader(PlanJsonData);
+		TestTrue(TEXT("按计划读取"), Reader.ReadPlan(*Plan, &Loaded));
+		TestTrue(FString::Printf(TEXT("按计划读取后相同 %s"), *Reader.GetError()), IsSameSave(Save, Loaded));
+
+		// 带格式的Json与计划不符，退回到通用路径
+		TArray<uint8> PrettyJsonData;
+		FRapidJsonStructWriter::Write(SaveStruct, &Save, PrettyJsonData, true);
+		FRapidJsonTestSave PrettyLoaded;
+		FRapidJsonStructReader PrettyReader(PrettyJsonData);
+		TestTrue(TEXT("按计划读取带格式的Json"), PrettyReader.ReadPlan(*Plan, &PrettyLoaded));
+		TestTrue(TEXT("按计划读取带格式的Json后相同"), IsSameSave(Save, PrettyLoaded));
+	}
+
+	// 未知的键被忽略，缺少的字段保持原值，键不区分大小写
+	{
+		FRapidJsonTestSave Loaded;
+		Loaded.PlayTime = 7;
+		const FString JsonString = TEXT("{\"Unknown\":{\"a\":[1,\"]\"]},\"SLOTNAME\":\"A\",\"items\":[{\"kind\":\"Shield\"},{\"kind\":2}]}");
+		TestTrue(TEXT("读取部分字段"), ULomoLibBlueprintFunctionLibrary::FromJson(JsonString, Loaded));
+		TestEqual(TEXT("键不区分大小写"), Loaded.SlotName, FString(TEXT("A")));
+		TestEqual(TEXT("缺少的字段保持原值"), Loaded.PlayTime, 7LL);
+		TestTrue(TEXT("枚举名和数值"), Loaded.Items.Num() == 2 && Loaded.Items[0].Kind == ERapidJsonTestItemKind::Shield && Loaded.Items[1].Kind == ERapidJsonTestItemKind::Shield);
+	}
+
+	// 格式错误
+	{
+		FRapidJsonTestSave Loaded;
+		TestFalse(TEXT("格式错误时返回false"), ULomoLibBlueprintFunctionLibrary::FromJson(TEXT("{\"slotName\":"), Loaded));
+	}
+
+	return true;
+}
+
+bool FRapidJsonStructBenchmark::RunTest(const FString& Parameters)
+{
+	using namespace RapidJsonStructTests;
+
+	constexpr int32 NumItems = 5000;
+	constexpr int32 NumIterations = 10;
+
+	const FRapidJsonTestSave Save = MakeTestSave(NumItems);
+	const UScriptStruct* SaveStruct = FRapidJsonTestSave::StaticStruct();
+	const TSharedRef<const FRapidJsonStructSchema> Schema = FRapidJsonStructSchema::Get(SaveStruct);
+
+	FString ConverterJson;
+	TArray<uint8> RapidJson;
+
+	double StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		ConverterJson.Reset();
+		FJsonObjectConverter::UStructToJsonObjectString(Save, ConverterJson, 0, 0, 0, nullptr, false);
+	}
+	const double ConverterWriteTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		// 复用同一个缓冲
+		RapidJson.Reset();
+		FRapidJsonStructWriter Writer(RapidJson);
+		Writer.WriteStruct(*Schema, &Save);
+	}
+	const double RapidWriteTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	const TSharedRef<const FRapidJsonStructPlan> Plan = FRapidJsonStructPlan::Get(SaveStruct);
+	TArray<uint8> PlanJson;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		PlanJson.Reset();
+		FRapidJsonStructWriter Writer(PlanJson);
+		Writer.WritePlan(*Plan, &Save);
+	}
+	const double PlanWriteTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	TestTrue(TEXT("计划的输出与紧凑格式相同"), PlanJson == RapidJson);
+
+	FRapidJsonTestSave Loaded;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FJsonObjectConverter::JsonObjectStringToUStruct(ConverterJson, &Loaded, 0, 0);
+	}
+	const double ConverterReadTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FRapidJsonStructReader Reader(RapidJson);
+		Reader.ReadStruct(*Schema, &Loaded);
+	}
+	const double RapidReadTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	TestTrue(TEXT("读取后相同"), IsSameSave(Save, Loaded));
+
+	FRapidJsonTestSave PlanLoaded;
+
+	StartTime = FPlatformTime::Seconds();
+	for (int32 Iteration = 0; Iteration < NumIterations; ++Iteration)
+	{
+		FRapidJsonStructReader Reader(RapidJson);
+		Reader.ReadPlan(*Plan, &PlanLoaded);
+	}
+	const double PlanReadTime = (FPlatformTime::Seconds() - StartTime) / NumIterations;
+
+	TestTrue(TEXT("按计划读取后相同"), IsSameSave(Save, PlanLoaded));
+
+	UE_LOG(LogLomoLibTests, Display, TEXT("Json结构体写入(%d个物品, %d字节): FJsonObjectConverter %.3f ms, FRapidJsonStructWriter %.3f ms, %.1fx"),
+		NumItems, RapidJson.Num(), ConverterWriteTime * 1000.0, RapidWriteTime * 1000.0, ConverterWriteTime / FMath::Max(RapidWriteTime, UE_SMALL_NUMBER));
+	UE_LOG(LogLomoLibTests, Display, TEXT("Json结构体读取(%d个物品): FJsonObjectConverter %.3f ms, FRapidJsonStructReader %.3f ms, %.1fx"),
+		NumItems, ConverterReadTime * 1000.0, RapidReadTime * 1000.0, ConverterReadTime / FMath::Max(RapidReadTime, UE_SMALL_NUMBER));
+	UE_LOG(LogLomoLibTests, Display, TEXT("Json结构体计划(%d步, 通用步骤%d): 写入 %.3f ms, %.1fx, 读取 %.3f ms, %.1fx"),
+		Plan->GetSteps().Num(), Plan->NumGenericSteps(),
+		PlanWriteTime * 1000.0, ConverterWriteTime / FMath::Max(PlanWriteTime, UE_SMALL_NUMBER),
+		PlanReadTime * 1000.0, ConverterReadTime / FMath::Max(PlanReadTime, UE_SMALL_NUMBER));
+
+	return true;
+}
@@ -0,0 +1,92 @@
+﻿#include "LomoLibTest.h"
+#include "ExcelDataTable/XlsxReader.h"
+#include "ExcelDataTable/XlsxWriter.h"
+#include "HAL/FileManager.h"
+#include "Misc/AutomationTest.h"
+#include "Misc/Paths.h"
+
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 5
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FXlsxRoundTripTest,
+	"LomoLib.Excel.XlsxRoundTrip",
+	EAutomationTestFlags_ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#else
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(
+	FXlsxRoundTripTest,
+	"LomoLib.Excel.XlsxRoundTrip",
+	EAutomationTestFlags::ApplicationContextMask | EAutomationTestFlags::ProductFilter
+);
+#endif
+
+bool FXlsxRoundTripTest::RunTest(const FString& Parameters)
+{
+	const FString FilePath = FPaths::ConvertRelativePathToFull(FPaths::AutomationTransientDir() / TEXT("XlsxRoundTrip.xlsx"));
+	const TArray<FString> Strings = {
+		TEXT("Row_Name"),
+		TEXT("中文 & <标签> \"引号\""),
+		TEXT("多行\n文本\t制表符"),
+		TEXT("控制字符\x01"),
+		TEXT("_x0041_不是转义"),
+		TEXT("(X=1.000000,Y=2.000000)"),
+	};
+	const TArray<double> Numbers = { 0.0, -5.0, 0.1, 1.0 / 3.0, 1e20, 123456789012.0 };
+
+	// 足够多的行，数据会分多次压缩写入
+	constexpr int32 NumRows = 5000;
+
+	FXlsxWriter Writer;
+	TestTrue(TEXT("创建文件"), Writer.Open(FilePath, TEXT("数据[1]")));
+
+	Writer.BeginRow();
+	for (const FString& String : Strings)
+	{
+		Writer.AddString(String);
+	}
+	Writer.EndRow();
+
+	for (int32 Row = 0; Row < NumRows; ++Row)
+	{
+		Writer.BeginRow();
+		Writer.AddString(FString::Printf(TEXT("Row_%d"), Row));
+		Writer.AddEmpty();
+		for (const double Number : Numbers)
+		{
+			Writer.AddNumber(Number * (Row + 1));
+		}
+		Writer.EndRow();
+	}
+	TestTrue(FString::Printf(TEXT("写入完成 %s"), *Writer.GetError()), Writer.Close());
+
+	FXlsxReader Reader;
+	TestTrue(FString::Printf(TEXT("打开文件 %s"), *Reader.GetError()), Reader.Open(FilePath));
+	TestTrue(TEXT("工作表名称中的非法字符被替换"), Reader.GetSheetNames() == TArray<FString>{ TEXT("数据_1_") });
+
+	FXlsxSheet Sheet;
+	TestTrue(FString::Printf(TEXT("读取工作表 %s"), *Reader.GetError()), Reader.ReadSheet(FString(), Sheet));
+	TestEqual(TEXT("行数"), Sheet.Rows.Num(), NumRows + 1);
+	TestEqual(TEXT("列数"), Sheet.NumColumns, Numbers.Num() + 2);
+
+	for (int32 Column = 0; Column < Strings.Num(); ++Column)
+	{
+		TestEqual(FString::Printf(TEXT("字符串 %d"), Column), Sheet.GetCellText(0, Column), Strings[Column]);
+	}
+
+	for (const int32 Row : { 1, NumRows / 2, NumRows })
+	{
+		TestEqual(TEXT("行名"), Sheet.GetCellText(Row, 0), FString::Printf(TEXT("Row_%d"), Row - 1));
+		const FXlsxCell* EmptyCell = Sheet.GetCell(Row, 1);
+		TestTrue(TEXT("空单元格"), !EmptyCell || EmptyCell->Type == EXlsxCellType::Empty);
+		for (int32 Index = 0; Index < Numbers.Num(); ++Index)
+		{
+			const FXlsxCell* Cell = Sheet.GetCell(Row, Index + 2);
+			TestTrue(TEXT("数字单元格"), Cell && Cell->Type == EXlsxCellType::Number && Cell->Number == Numbers[Index] * Row);
+		}
+	}
+
+	TestEqual(TEXT("小数使用最短表示"), Sheet.GetCellText(1, 4), FString(TEXT("0.1")));
+	TestEqual(TEXT("整数不带小数点"), Sheet.GetCellText(2, 3), FString(TEXT("-10")));
+
+	IFileManager::Get().Delete(*FilePath);
+	return true;
+}